@@ -122,10 +122,16 @@ void ApplySecureContext(rpc::SecureContext* context, rpc::MessengerBuilder* buil
   auto buffer_tracker = MemTracker::FindOrCreateTracker(
       -1, "Encrypted Read Buffer", parent_mem_tracker);
 
+  // Encrypted streams are layered over the TCP stream factory of the builder, so they use
+  // io_uring when the builder was set up with it.
+  auto tcp_factory = builder->stream_factory(rpc::TcpStream::StaticProtocol());
+  if (!tcp_factory) {
+    tcp_factory = rpc::TcpStream::Factory();
+  }
   builder->SetListenProtocol(rpc::SecureStreamProtocol());
   builder->AddStreamFactory(
       rpc::SecureStreamProtocol(),
-      rpc::SecureStreamFactory(rpc::TcpStream::Factory(), buffer_tracker, context));
+      rpc::SecureStreamFactory(std::move(tcp_factory), buffer_tracker, context));
 }
 
 } // namespace server
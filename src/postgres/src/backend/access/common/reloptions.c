@@ -359,6 +359,16 @@ static relopt_int intRelOpts[] =
 		},
 		-1, 0, 1024
 	},
+	{
+		{
+			"bloom_filter_range_components",
+			"Number of leading range key columns the SST bloom filter is built on",
+			RELOPT_KIND_HEAP,
+			AccessExclusiveLock
+		},
+		/* 0 keeps the default bloom filter; only valid for tables without hash columns. */
+		0, 0, INDEX_MAX_KEYS
+	},
 
 	/* list terminator */
 	{{NULL}}
@@ -1396,6 +1406,8 @@ default_reloptions(Datum reloptions, bool validate, relopt_kind kind)
 		offsetof(StdRdOptions, vacuum_cleanup_index_scale_factor)},
 		{"colocated", RELOPT_TYPE_BOOL,
 		offsetof(StdRdOptions, colocated)},
+		{"bloom_filter_range_components", RELOPT_TYPE_INT,
+		offsetof(StdRdOptions, bloom_filter_range_components)},
 	};
 
 	options = parseRelOptions(reloptions, validate, kind, &numoptions);
@@ -487,7 +487,8 @@ YBCCreateTable(CreateStmt *stmt, char relkind, TupleDesc desc, Oid relationId, O
 	// Set the default option to true so that tables created in a colocated database will be
 	// colocated by default. For regular database, this argument will be ignored.
 	bool		colocated = true;
-	/* Scan list to see if colocated was included */
+	int			bloom_filter_range_components = 0;
+	/* Scan list to see if colocated or bloom_filter_range_components was included */
 	foreach(opt_cell, stmt->options)
 	{
 		DefElem *def = (DefElem *) lfirst(opt_cell);
@@ -496,6 +497,10 @@ YBCCreateTable(CreateStmt *stmt, char relkind, TupleDesc desc, Oid relationId, O
 		{
 			colocated = defGetBoolean(def);
 		}
+		else if (strcmp(def->defname, "bloom_filter_range_components") == 0)
+		{
+			bloom_filter_range_components = defGetInt32(def);
+		}
 	}
 
 	HandleYBStatus(YBCPgNewCreateTable(db_name,
@@ -510,6 +515,9 @@ YBCCreateTable(CreateStmt *stmt, char relkind, TupleDesc desc, Oid relationId, O
 
 	CreateTableAddColumns(handle, desc, primary_key);
 	HandleYBStmtStatus(YBCPgCreateTableSetColocated(handle, colocated), handle);
+	HandleYBStmtStatus(YBCPgCreateTableSetBloomFilterRangeComponents(handle,
+																	 bloom_filter_range_components),
+					   handle);
 
 	/* Handle SPLIT statement, if present */
 	OptSplit *split_options = stmt->split_options;
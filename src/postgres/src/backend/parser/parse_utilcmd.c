@@ -341,6 +341,8 @@ transformCreateStmt(CreateStmt *stmt, const char *queryString)
 		}
 		else if (strcmp(def->defname, "colocated") == 0)
 			(void) defGetBoolean(def);
+		else if (strcmp(def->defname, "bloom_filter_range_components") == 0)
+			(void) defGetInt32(def);
 		else
 			ereport(WARNING,
 					(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
@@ -108,6 +108,7 @@ DECLARE_int32(tablet_server_svc_queue_length);
 DECLARE_int32(replication_factor);
 
 DEFINE_int32(test_scan_num_rows, 1000, "Number of rows to insert and scan");
+DEFINE_bool(test_run_lookup_benchmark, false, "Run the meta cache tablet lookup benchmark");
 DECLARE_int32(min_backoff_ms_exponent);
 DECLARE_int32(max_backoff_ms_exponent);
 
@@ -1754,6 +1755,67 @@ TEST_F(ClientTest, TestMasterLookupPermits) {
             client_->data_->meta_cache_->master_lookup_sem_.GetValue());
 }
 
+// Measures throughput of concurrent tablet lookups served from the meta cache.
+TEST_F(ClientTest, BenchmarkLookupTabletByKey) {
+  if (!FLAGS_test_run_lookup_benchmark) {
+    LOG(INFO) << "Skipping benchmark, use --test_run_lookup_benchmark to run it";
+    return;
+  }
+
+  constexpr int kNumThreads = 16;
+  const auto kTestTime = 5s;
+
+  auto& meta_cache = *client_->data_->meta_cache_;
+  const YBTable* table = client_table_.table().get();
+  const auto& partitions = table->GetPartitions();
+  const auto deadline = CoarseMonoClock::Now() + 10s;
+
+  // Populate the cache.
+  for (const auto& partition : partitions) {
+    ASSERT_OK(meta_cache.LookupTabletByKeyFuture(table, partition, deadline).get());
+  }
+  auto version = meta_cache.tablets_snapshot_version();
+
+  // Shared with callbacks, so it outlives lookups that complete after the test body.
+  struct Counters {
+    std::atomic<uint64_t> num_lookups{0};
+    std::atomic<uint64_t> num_completed{0};
+    std::atomic<uint64_t> num_failures{0};
+  };
+  auto counters = std::make_shared<Counters>();
+  TestThreadHolder thread_holder;
+  for (int i = 0; i != kNumThreads; ++i) {
+    thread_holder.AddThreadFunctor(
+        [&meta_cache, table, &partitions, deadline, counters,
+         &stop = thread_holder.stop_flag(), i] {
+      size_t idx = i;
+      while (!stop.load(std::memory_order_acquire)) {
+        counters->num_lookups.fetch_add(1, std::memory_order_acq_rel);
+        meta_cache.LookupTabletByKey(
+            table, partitions[idx++ % partitions.size()], deadline,
+            [counters](const Result<internal::RemoteTabletPtr>& result) {
+              if (!result.ok()) {
+                counters->num_failures.fetch_add(1, std::memory_order_acq_rel);
+              }
+              counters->num_completed.fetch_add(1, std::memory_order_acq_rel);
+            });
+      }
+    });
+  }
+  thread_holder.WaitAndStop(kTestTime);
+
+  const auto num_lookups = counters->num_lookups.load(std::memory_order_acquire);
+  ASSERT_OK(WaitFor([counters, num_lookups] {
+    return counters->num_completed.load(std::memory_order_acquire) == num_lookups;
+  }, 30s, "Wait outstanding lookups"));
+
+  LOG(INFO) << "Lookups: " << num_lookups << ", per second: "
+            << num_lookups / ToSeconds(kTestTime) << ", threads: " << kNumThreads;
+  ASSERT_EQ(counters->num_failures.load(), 0);
+  // All lookups should be served by the published snapshot, without updating it.
+  ASSERT_EQ(version, meta_cache.tablets_snapshot_version());
+}
+
 // Define callback for deadlock simulation, as well as various helper methods.
 namespace {
 
@@ -46,6 +46,7 @@ Result<std::unique_ptr<rpc::Messenger>> CreateClientMessenger(
   if (secure_context) {
     server::ApplySecureContext(secure_context, &builder);
   }
+  builder.UseCompression();
   auto messenger = VERIFY_RESULT(builder.Build());
   if (PREDICT_FALSE(FLAGS_running_test)) {
     messenger->TEST_SetOutboundIpBase(VERIFY_RESULT(HostToAddress("127.0.0.1")));
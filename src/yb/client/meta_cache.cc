@@ -268,18 +268,17 @@ void RemoteTablet::Refresh(
     CHECK(it != tservers.end());
     replicas_.emplace_back(it->second.get(), r.role());
   }
-  stale_ = false;
+  UpdateHasLeaderUnlocked();
+  stale_.store(false, std::memory_order_release);
   refresh_time_.store(MonoTime::Now(), std::memory_order_release);
 }
 
 void RemoteTablet::MarkStale() {
-  std::lock_guard<rw_spinlock> lock(mutex_);
-  stale_ = true;
+  stale_.store(true, std::memory_order_release);
 }
 
 bool RemoteTablet::stale() const {
-  SharedLock<rw_spinlock> lock(mutex_);
-  return stale_;
+  return stale_.load(std::memory_order_acquire);
 }
 
 bool RemoteTablet::MarkReplicaFailed(RemoteTabletServer *ts, const Status& status) {
@@ -290,6 +289,7 @@ bool RemoteTablet::MarkReplicaFailed(RemoteTabletServer *ts, const Status& statu
   for (RemoteReplica& rep : replicas_) {
     if (rep.ts == ts) {
       rep.MarkFailed();
+      UpdateHasLeaderUnlocked();
       return true;
     }
   }
@@ -317,8 +317,15 @@ RemoteTabletServer* RemoteTablet::LeaderTServer() const {
   return nullptr;
 }
 
-bool RemoteTablet::HasLeader() const {
-  return LeaderTServer() != nullptr;
+void RemoteTablet::UpdateHasLeaderUnlocked() {
+  bool has_leader = false;
+  for (const RemoteReplica& replica : replicas_) {
+    if (!replica.Failed() && replica.role == RaftPeerPB::LEADER) {
+      has_leader = true;
+      break;
+    }
+  }
+  has_leader_.store(has_leader, std::memory_order_release);
 }
 
 void RemoteTablet::GetRemoteTabletServers(
@@ -412,6 +419,7 @@ void RemoteTablet::GetRemoteTabletServers(
         update.replica->ClearFailed();
       }
     }
+    UpdateHasLeaderUnlocked();
   }
 }
 
@@ -426,6 +434,7 @@ bool RemoteTablet::MarkTServerAsLeader(const RemoteTabletServer* server) {
       replica.role = RaftPeerPB::FOLLOWER;
     }
   }
+  UpdateHasLeaderUnlocked();
   VLOG_WITH_PREFIX(3) << "Latest replicas: " << ReplicasAsStringUnlocked();
   VLOG_IF_WITH_PREFIX(3, !found) << "Specified server not found: " << server->ToString()
                                  << ". Replicas: " << ReplicasAsStringUnlocked();
@@ -441,6 +450,7 @@ void RemoteTablet::MarkTServerAsFollower(const RemoteTabletServer* server) {
       found = true;
     }
   }
+  UpdateHasLeaderUnlocked();
   VLOG_WITH_PREFIX(3) << "Latest replicas: " << ReplicasAsStringUnlocked();
   DCHECK(found) << "Tablet " << tablet_id_ << ": Specified server not found: "
                 << server->ToString() << ". Replicas: " << ReplicasAsStringUnlocked();
@@ -691,8 +701,10 @@ RemoteTabletPtr MetaCache::ProcessTabletLocations(
 
   {
     std::lock_guard<decltype(mutex_)> l(mutex_);
+    std::unordered_set<TableId> changed_tables;
     for (const TabletLocationsPB& loc : locations) {
       for (const std::string& table_id : loc.table_ids()) {
+        changed_tables.insert(table_id);
         auto& table_data = tables_[table_id];
         auto& tablets_by_key = table_data.tablets_by_partition;
         // First, update the tserver cache, needed for the Refresh calls below.
@@ -753,6 +765,8 @@ RemoteTabletPtr MetaCache::ProcessTabletLocations(
         }
       }
     }
+    // Callbacks are notified after new mappings become visible to lookups.
+    PublishTabletsSnapshotUnlocked(changed_tables);
   }
 
   for (const auto& callback_and_remote_tablet : to_notify) {
@@ -928,7 +942,7 @@ class LookupByKeyRpc : public LookupRpc {
 
   void Notify(const Status& status, const RemoteTabletPtr& result) override {
     if (status.ok()) {
-      return; // This case is handled by LookupTabletByKeyFastPathUnlocked.
+      return; // This case is handled by LookupTabletByKeyFastPath.
     }
     meta_cache()->LookupFailed(table_.get(), partition_group_start_, status);
   }
@@ -946,22 +960,49 @@ class LookupByKeyRpc : public LookupRpc {
   GetTableLocationsResponsePB resp_;
 };
 
-RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(const YBTable* table,
-                                                             const std::string& partition_key) {
-  auto it = tables_.find(table->id());
-  if (PREDICT_FALSE(it == tables_.end())) {
-    // No cache available for this table.
-    return nullptr;
+void MetaCache::PublishTabletsSnapshotUnlocked(const std::unordered_set<TableId>& changed_tables) {
+  if (changed_tables.empty()) {
+    return;
   }
 
-  DCHECK_EQ(partition_key, table->FindPartitionStart(partition_key));
-  auto tablet_it = it->second.tablets_by_partition.find(partition_key);
-  if (PREDICT_FALSE(tablet_it == it->second.tablets_by_partition.end())) {
-    // No tablets with a start partition key lower than 'partition_key'.
-    return nullptr;
+  TabletsSnapshot snapshot;
+  {
+    auto current = tablets_snapshot_.get();
+    snapshot = *current;
   }
+  ++snapshot.version;
+  for (const auto& table_id : changed_tables) {
+    auto it = tables_.find(table_id);
+    if (it == tables_.end()) {
+      snapshot.tables.erase(table_id);
+    } else {
+      snapshot.tables[table_id] = std::make_shared<const TabletsByPartition>(
+          it->second.tablets_by_partition);
+    }
+  }
+  tablets_snapshot_.Set(std::move(snapshot));
+}
+
+RemoteTabletPtr MetaCache::LookupTabletByKeyFastPath(const YBTable* table,
+                                                     const std::string& partition_key) {
+  RemoteTabletPtr result;
+  {
+    auto snapshot = tablets_snapshot_.get();
+    auto it = snapshot->tables.find(table->id());
+    if (PREDICT_FALSE(it == snapshot->tables.end())) {
+      // No cache available for this table.
+      return nullptr;
+    }
 
-  const auto& result = tablet_it->second;
+    DCHECK_EQ(partition_key, table->FindPartitionStart(partition_key));
+    auto tablet_it = it->second->find(partition_key);
+    if (PREDICT_FALSE(tablet_it == it->second->end())) {
+      // No tablets with a start partition key lower than 'partition_key'.
+      return nullptr;
+    }
+
+    result = tablet_it->second;
+  }
 
   // Stale entries must be re-fetched.
   if (result->stale()) {
@@ -977,25 +1018,6 @@ RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(const YBTable* tabl
   return nullptr;
 }
 
-// We disable thread safety analysis in this function due to manual conditional locking.
-template <class Lock>
-bool MetaCache::FastLookupTabletByKeyUnlocked(
-    const YBTable* table,
-    const std::string& partition_start,
-    const LookupTabletCallback& callback,
-    Lock* lock) NO_THREAD_SAFETY_ANALYSIS {
-  // Fast path: lookup in the cache.
-  auto result = LookupTabletByKeyFastPathUnlocked(table, partition_start);
-  if (result && result->HasLeader()) {
-    lock->unlock();
-    VLOG(3) << "Fast lookup: found tablet " << result->tablet_id();
-    callback(result);
-    return true;
-  }
-
-  return false;
-}
-
 // We disable thread safety analysis in this function due to manual conditional locking.
 void MetaCache::LookupTabletByKey(const YBTable* table,
                                   const string& partition_key,
@@ -1003,19 +1025,25 @@ void MetaCache::LookupTabletByKey(const YBTable* table,
                                   LookupTabletCallback callback) NO_THREAD_SAFETY_ANALYSIS {
   const auto& partition_start = table->FindPartitionStart(partition_key);
 
-  rpc::Rpcs::Handle rpc;
-  {
-    std::shared_lock<boost::shared_mutex> lock(mutex_);
-    if (FastLookupTabletByKeyUnlocked(table, partition_start, callback, &lock)) {
-      return;
-    }
+  // Fast path: lookup in the published snapshot, without locking.
+  auto result = LookupTabletByKeyFastPath(table, partition_start);
+  if (result && result->HasLeader()) {
+    VLOG(3) << "Fast lookup: found tablet " << result->tablet_id();
+    callback(result);
+    return;
   }
 
   const std::string& partition_group_start =
       table->FindPartitionStart(partition_start, kPartitionGroupSize);
   {
     std::unique_lock<boost::shared_mutex> lock(mutex_);
-    if (FastLookupTabletByKeyUnlocked(table, partition_start, callback, &lock)) {
+    // Snapshot is published under mutex_, so tablet could not appear between this check and
+    // registering the lookup.
+    result = LookupTabletByKeyFastPath(table, partition_start);
+    if (result && result->HasLeader()) {
+      lock.unlock();
+      VLOG(3) << "Fast lookup: found tablet " << result->tablet_id();
+      callback(result);
       return;
     }
 
@@ -37,6 +37,7 @@
 #include <string>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <boost/thread/shared_mutex.hpp>
@@ -58,6 +59,7 @@
 
 #include "yb/util/async_util.h"
 #include "yb/util/capabilities.h"
+#include "yb/util/concurrent_value.h"
 #include "yb/util/locks.h"
 #include "yb/util/monotime.h"
 #include "yb/util/semaphore.h"
@@ -218,8 +220,7 @@ class RemoteTablet : public RefCountedThreadSafe<RemoteTablet> {
                Partition partition)
       : tablet_id_(std::move(tablet_id)),
         log_prefix_(Format("T $0: ", tablet_id_)),
-        partition_(std::move(partition)),
-        stale_(false) {
+        partition_(std::move(partition)) {
   }
 
   ~RemoteTablet();
@@ -271,8 +272,11 @@ class RemoteTablet : public RefCountedThreadSafe<RemoteTablet> {
   }
 
   // Return true if the tablet currently has a known LEADER replica
-  // (i.e the next call to LeaderTServer() is likely to return non-NULL)
-  bool HasLeader() const;
+  // (i.e the next call to LeaderTServer() is likely to return non-NULL).
+  // Does not acquire mutex_, so could be used on the fast lookup path.
+  bool HasLeader() const {
+    return has_leader_.load(std::memory_order_acquire);
+  }
 
   const std::string& tablet_id() const { return tablet_id_; }
 
@@ -300,15 +304,22 @@ class RemoteTablet : public RefCountedThreadSafe<RemoteTablet> {
   // Same as ReplicasAsString(), except that the caller must hold mutex_.
   std::string ReplicasAsStringUnlocked() const;
 
+  // Recalculates has_leader_ after replicas_ were changed, the caller must hold mutex_.
+  void UpdateHasLeaderUnlocked();
+
   const std::string tablet_id_;
   const std::string log_prefix_;
   const Partition partition_;
 
-  // All non-const members are protected by 'mutex_'.
+  // All non-const and non-atomic members are protected by 'mutex_'.
   mutable rw_spinlock mutex_;
-  bool stale_;
   std::vector<RemoteReplica> replicas_;
 
+  std::atomic<bool> stale_{false};
+
+  // Whether replicas_ contain non failed leader. Updated under mutex_, read without it.
+  std::atomic<bool> has_leader_{false};
+
   // Last time this object was refreshed. Initialized to MonoTime::Min() so we don't have to be
   // checking whether it has been initialized everytime we use this value.
   std::atomic<MonoTime> refresh_time_{MonoTime::Min()};
@@ -384,6 +395,11 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
       const google::protobuf::RepeatedPtrField<master::TabletLocationsPB>& locations,
       const std::string* partition_group_start);
 
+  // Version of the published partition to tablet mappings, incremented on each update.
+  uint64_t tablets_snapshot_version() {
+    return tablets_snapshot_.get()->version;
+  }
+
  private:
   friend class LookupRpc;
   friend class LookupByKeyRpc;
@@ -392,10 +408,11 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   FRIEND_TEST(client::ClientTest, TestMasterLookupPermits);
 
   // Lookup the given tablet by key, only consulting local information.
-  // Returns true and sets *remote_tablet if successful.
-  RemoteTabletPtr LookupTabletByKeyFastPathUnlocked(
+  // Uses published snapshot of partition to tablet mappings, so does not acquire mutex_.
+  // Returns nullptr if tablet is not cached or stale.
+  RemoteTabletPtr LookupTabletByKeyFastPath(
       const YBTable* table,
-      const std::string& partition_key) REQUIRES_SHARED(mutex_);
+      const std::string& partition_key);
 
   RemoteTabletPtr LookupTabletByIdFastPath(const TabletId& tablet_id);
 
@@ -410,12 +427,10 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   void LookupFailed(
       const YBTable* table, const std::string& partition_group_start, const Status& status);
 
-  template <class Lock>
-  bool FastLookupTabletByKeyUnlocked(
-      const YBTable* table,
-      const std::string& partition_start,
-      const LookupTabletCallback& callback,
-      Lock* lock) REQUIRES_SHARED(mutex_);
+  // Publishes new snapshot of partition to tablet mappings, that reflects tables_ for specified
+  // tables.
+  void PublishTabletsSnapshotUnlocked(const std::unordered_set<TableId>& changed_tables)
+      REQUIRES(mutex_);
 
   YBClient* const client_;
 
@@ -449,13 +464,25 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   typedef std::string PartitionKey;
   typedef std::string PartitionGroupKey;
 
+  typedef std::unordered_map<PartitionKey, RemoteTabletPtr> TabletsByPartition;
+
   struct TableData {
-    std::unordered_map<PartitionKey, RemoteTabletPtr> tablets_by_partition;
+    TabletsByPartition tablets_by_partition;
     std::unordered_map<PartitionGroupKey, PartitionToLookupData> tablet_lookups_by_group;
   };
 
   std::unordered_map<TableId, TableData> tables_ GUARDED_BY(mutex_);
 
+  // Immutable copy of partition to tablet mappings of tables_. Tables that were not changed share
+  // their mappings with the previous snapshot.
+  struct TabletsSnapshot {
+    uint64_t version = 0;
+    std::unordered_map<TableId, std::shared_ptr<const TabletsByPartition>> tables;
+  };
+
+  // Snapshot is replaced under mutex_, while readers access it without locking.
+  ConcurrentValue<TabletsSnapshot> tablets_snapshot_;
+
   // Cache of tablets, keyed by tablet ID.
   std::unordered_map<std::string, RemoteTabletPtr> tablets_by_id_ GUARDED_BY(mutex_);
 
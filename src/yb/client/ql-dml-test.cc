@@ -23,6 +23,7 @@
 #include "yb/master/master_util.h"
 
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_peer.h"
 
 #include "yb/tserver/mini_tablet_server.h"
@@ -34,6 +35,7 @@
 #include "yb/util/jsonreader.h"
 #include "yb/util/random.h"
 #include "yb/util/random_util.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/tostring.h"
 #include "yb/util/tsan_util.h"
 
@@ -44,6 +46,7 @@ DECLARE_bool(rocksdb_disable_compactions);
 DECLARE_int32(yb_num_shards_per_tserver);
 DECLARE_int64(db_block_cache_size_bytes);
 DECLARE_bool(flush_rocksdb_on_shutdown);
+DECLARE_int64(tablet_row_cache_size_bytes);
 
 using namespace std::literals;
 
@@ -1284,5 +1287,55 @@ TEST_F(QLDmlTest, DeletePartialRangeKey) {
   ASSERT_TRUE(!row.ok() && row.status().IsNotFound()) << "Unexpected result: " << row;
 }
 
+class QLDmlRowCacheTest : public QLDmlTest {
+ public:
+  void SetUp() override {
+    FLAGS_tablet_row_cache_size_bytes = 1_MB;
+    QLDmlTest::SetUp();
+  }
+
+  int64_t RowCacheHits() {
+    int64_t result = 0;
+    for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kAll)) {
+      if (peer->tablet() && peer->tablet()->metrics()) {
+        result += peer->tablet()->metrics()->ql_row_cache_hits->value();
+      }
+    }
+    return result;
+  }
+};
+
+TEST_F_EX(QLDmlTest, RowCache, QLDmlRowCacheTest) {
+  auto session = NewSession();
+  RowKey row_key{1, "a", 2, "b"};
+
+  InsertRow(session, row_key, {3, "c"});
+  ASSERT_OK(session->Flush());
+  ASSERT_EQ(ASSERT_RESULT(ReadRow(session, row_key)), (RowValue{3, "c"}));
+  auto hits = RowCacheHits();
+  ASSERT_EQ(ASSERT_RESULT(ReadRow(session, row_key)), (RowValue{3, "c"}));
+  ASSERT_GT(RowCacheHits(), hits);
+
+  // Write invalidates cached row.
+  InsertRow(session, row_key, {4, "d"});
+  ASSERT_OK(session->Flush());
+  ASSERT_EQ(ASSERT_RESULT(ReadRow(session, row_key)), (RowValue{4, "d"}));
+  ASSERT_EQ(ASSERT_RESULT(ReadRow(session, row_key)), (RowValue{4, "d"}));
+
+  // Delete by partial range key affects several rows, so it drops the whole cache.
+  {
+    const YBqlWriteOpPtr op = table_.NewWriteOp(QLWriteRequestPB::QL_STMT_DELETE);
+    auto* const req = op->mutable_request();
+    QLAddInt32HashValue(req, row_key.h1);
+    QLAddStringHashValue(req, row_key.h2);
+    QLAddInt32RangeValue(req, row_key.r1);
+    ASSERT_OK(session->ApplyAndFlush(op));
+    ASSERT_EQ(op->response().status(), QLResponsePB::YQL_STATUS_OK);
+  }
+
+  auto row = ReadRow(session, row_key);
+  ASSERT_TRUE(!row.ok() && row.status().IsNotFound()) << "Unexpected result: " << row;
+}
+
 }  // namespace client
 }  // namespace yb
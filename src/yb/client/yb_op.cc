@@ -625,6 +625,9 @@ Status YBPgsqlReadOp::GetPartitionKey(string* partition_key) const {
       const uint16 hash_code = VERIFY_RESULT(docdb::DocKey::DecodeHash(ybctid.binary_value()));
       read_request_->set_hash_code(hash_code);
       *partition_key = PartitionSchema::EncodeMultiColumnHashValue(hash_code);
+    } else if (read_request_->has_hash_code()) {
+      // Scan of the hash code range, start from its lower bound.
+      *partition_key = PartitionSchema::EncodeMultiColumnHashValue(read_request_->hash_code());
     } else {
       // Default to empty key, this will start a scan from the beginning.
       partition_key->clear();
@@ -0,0 +1,440 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//
+// This file contains the class that represents a batch of QL rows stored column by column.
+
+#include "yb/common/ql_row_batch.h"
+
+#include "yb/common/ql_expr.h"
+#include "yb/common/ql_value.h"
+
+namespace yb {
+
+namespace {
+
+void GetColumnKind(DataType data_type, QLRowBatch::ColumnKind* kind, InternalType* value_type) {
+  *kind = QLRowBatch::ColumnKind::kValue;
+  switch (data_type) {
+    case INT8:
+      *kind = QLRowBatch::ColumnKind::kInt;
+      *value_type = InternalType::kInt8Value;
+      return;
+    case INT16:
+      *kind = QLRowBatch::ColumnKind::kInt;
+      *value_type = InternalType::kInt16Value;
+      return;
+    case INT32:
+      *kind = QLRowBatch::ColumnKind::kInt;
+      *value_type = InternalType::kInt32Value;
+      return;
+    case INT64:
+      *kind = QLRowBatch::ColumnKind::kInt;
+      *value_type = InternalType::kInt64Value;
+      return;
+    case BOOL:
+      *kind = QLRowBatch::ColumnKind::kInt;
+      *value_type = InternalType::kBoolValue;
+      return;
+    case TIMESTAMP:
+      *kind = QLRowBatch::ColumnKind::kInt;
+      *value_type = InternalType::kTimestampValue;
+      return;
+    case DATE:
+      *kind = QLRowBatch::ColumnKind::kInt;
+      *value_type = InternalType::kDateValue;
+      return;
+    case TIME:
+      *kind = QLRowBatch::ColumnKind::kInt;
+      *value_type = InternalType::kTimeValue;
+      return;
+    case STRING:
+      *kind = QLRowBatch::ColumnKind::kString;
+      *value_type = InternalType::kStringValue;
+      return;
+    case BINARY:
+      *kind = QLRowBatch::ColumnKind::kString;
+      *value_type = InternalType::kBinaryValue;
+      return;
+    case UINT32:
+      *value_type = InternalType::kUint32Value;
+      return;
+    case UINT64:
+      *value_type = InternalType::kUint64Value;
+      return;
+    case FLOAT:
+      *value_type = InternalType::kFloatValue;
+      return;
+    case DOUBLE:
+      *value_type = InternalType::kDoubleValue;
+      return;
+    case DECIMAL:
+      *value_type = InternalType::kDecimalValue;
+      return;
+    case VARINT:
+      *value_type = InternalType::kVarintValue;
+      return;
+    case INET:
+      *value_type = InternalType::kInetaddressValue;
+      return;
+    case UUID:
+      *value_type = InternalType::kUuidValue;
+      return;
+    case TIMEUUID:
+      *value_type = InternalType::kTimeuuidValue;
+      return;
+    case JSONB:
+      *value_type = InternalType::kJsonbValue;
+      return;
+    default:
+      // Collections and user-defined types are not comparable.
+      *value_type = InternalType::VALUE_NOT_SET;
+      return;
+  }
+}
+
+int64_t GetIntValue(const QLValuePB& value) {
+  switch (value.value_case()) {
+    case InternalType::kInt8Value: return value.int8_value();
+    case InternalType::kInt16Value: return value.int16_value();
+    case InternalType::kInt32Value: return value.int32_value();
+    case InternalType::kInt64Value: return value.int64_value();
+    case InternalType::kBoolValue: return value.bool_value();
+    case InternalType::kTimestampValue: return value.timestamp_value();
+    case InternalType::kDateValue: return value.date_value();
+    case InternalType::kTimeValue: return value.time_value();
+    default:
+      LOG(FATAL) << "Not an integer value: " << value.ShortDebugString();
+  }
+  return 0;
+}
+
+void SetIntValue(InternalType value_type, int64_t value, QLValuePB* out) {
+  switch (value_type) {
+    case InternalType::kInt8Value: out->set_int8_value(static_cast<int8_t>(value)); return;
+    case InternalType::kInt16Value: out->set_int16_value(static_cast<int16_t>(value)); return;
+    case InternalType::kInt32Value: out->set_int32_value(static_cast<int32_t>(value)); return;
+    case InternalType::kInt64Value: out->set_int64_value(value); return;
+    case InternalType::kBoolValue: out->set_bool_value(value != 0); return;
+    case InternalType::kTimestampValue: out->set_timestamp_value(value); return;
+    case InternalType::kDateValue: out->set_date_value(static_cast<uint32_t>(value)); return;
+    case InternalType::kTimeValue: out->set_time_value(value); return;
+    default:
+      LOG(FATAL) << "Not an integer type: " << value_type;
+  }
+}
+
+Slice GetStringValue(const QLValuePB& value) {
+  return value.value_case() == InternalType::kBinaryValue ? Slice(value.binary_value())
+                                                          : Slice(value.string_value());
+}
+
+// Keeps only the rows of selection that satisfy predicate.
+template <class Predicate>
+void Select(const Predicate& predicate, std::vector<size_t>* selection) {
+  auto out = selection->begin();
+  for (auto row : *selection) {
+    if (predicate(row)) {
+      *out++ = row;
+    }
+  }
+  selection->erase(out, selection->end());
+}
+
+inline int CompareValues(int64_t lhs, int64_t rhs) {
+  return lhs < rhs ? -1 : (lhs > rhs ? 1 : 0);
+}
+
+inline int CompareValues(const Slice& lhs, const Slice& rhs) {
+  return lhs.compare(rhs);
+}
+
+// Applies the comparison to a column with fixed-width or string values. Follows the QLValuePB
+// comparison rules: null is only not equal to a non-null value.
+template <class Value>
+void SelectByComparison(QLOperator op, const std::vector<uint8_t>& nulls,
+                        const std::vector<Value>& values, const Value& rhs,
+                        std::vector<size_t>* selection) {
+  switch (op) {
+    case QL_OP_EQUAL:
+      Select([&](size_t row) { return !nulls[row] && CompareValues(values[row], rhs) == 0; },
+             selection);
+      return;
+    case QL_OP_NOT_EQUAL:
+      Select([&](size_t row) { return nulls[row] || CompareValues(values[row], rhs) != 0; },
+             selection);
+      return;
+    case QL_OP_LESS_THAN:
+      Select([&](size_t row) { return !nulls[row] && CompareValues(values[row], rhs) < 0; },
+             selection);
+      return;
+    case QL_OP_LESS_THAN_EQUAL:
+      Select([&](size_t row) { return !nulls[row] && CompareValues(values[row], rhs) <= 0; },
+             selection);
+      return;
+    case QL_OP_GREATER_THAN:
+      Select([&](size_t row) { return !nulls[row] && CompareValues(values[row], rhs) > 0; },
+             selection);
+      return;
+    case QL_OP_GREATER_THAN_EQUAL:
+      Select([&](size_t row) { return !nulls[row] && CompareValues(values[row], rhs) >= 0; },
+             selection);
+      return;
+    default:
+      LOG(FATAL) << "Unsupported operator: " << op;
+  }
+}
+
+// Applies the comparison to a column with QLValuePB values, unset values are nulls.
+void SelectByComparison(QLOperator op, const std::vector<QLValuePB>& values,
+                        const QLValuePB& rhs, std::vector<size_t>* selection) {
+  switch (op) {
+    case QL_OP_EQUAL:
+      Select([&](size_t row) { return values[row] == rhs; }, selection);
+      return;
+    case QL_OP_NOT_EQUAL:
+      Select([&](size_t row) { return values[row] != rhs; }, selection);
+      return;
+    case QL_OP_LESS_THAN:
+      Select([&](size_t row) { return values[row] < rhs; }, selection);
+      return;
+    case QL_OP_LESS_THAN_EQUAL:
+      Select([&](size_t row) { return values[row] <= rhs; }, selection);
+      return;
+    case QL_OP_GREATER_THAN:
+      Select([&](size_t row) { return values[row] > rhs; }, selection);
+      return;
+    case QL_OP_GREATER_THAN_EQUAL:
+      Select([&](size_t row) { return values[row] >= rhs; }, selection);
+      return;
+    default:
+      LOG(FATAL) << "Unsupported operator: " << op;
+  }
+}
+
+} // namespace
+
+QLRowBatch::QLRowBatch(const Schema& schema, const Schema& projection) {
+  columns_.reserve(schema.num_key_columns() + projection.num_columns() -
+                   projection.num_key_columns());
+  auto add_column = [this](const Schema& source, size_t idx, bool is_key) {
+    columns_.emplace_back();
+    auto& column = columns_.back();
+    column.id = source.column_id(idx);
+    column.type = source.column(idx).type();
+    column.is_key = is_key;
+    GetColumnKind(column.type->main(), &column.kind, &column.value_type);
+  };
+  for (size_t i = 0; i < schema.num_key_columns(); i++) {
+    add_column(schema, i, /* is_key = */ true);
+  }
+  for (size_t i = projection.num_key_columns(); i < projection.num_columns(); i++) {
+    add_column(projection, i, /* is_key = */ false);
+  }
+}
+
+QLRowBatch::~QLRowBatch() {
+}
+
+void QLRowBatch::Clear() {
+  for (auto& column : columns_) {
+    column.nulls.clear();
+    column.ints.clear();
+    column.strings.clear();
+    column.values.clear();
+    column.ttl_seconds.clear();
+    column.write_times.clear();
+  }
+  num_rows_ = 0;
+  selection_.clear();
+  arena_.Reset();
+}
+
+size_t QLRowBatch::AddRow() {
+  for (auto& column : columns_) {
+    column.nulls.push_back(true);
+    switch (column.kind) {
+      case ColumnKind::kInt:
+        column.ints.push_back(0);
+        break;
+      case ColumnKind::kString:
+        column.strings.emplace_back();
+        break;
+      case ColumnKind::kValue:
+        column.values.emplace_back();
+        break;
+    }
+    if (!column.is_key) {
+      column.ttl_seconds.push_back(0);
+      column.write_times.push_back(QLTableColumn::kUninitializedWriteTime);
+    }
+  }
+  selection_.push_back(num_rows_);
+  return num_rows_++;
+}
+
+void QLRowBatch::SetInt(size_t column, size_t row, int64_t value) {
+  auto& col = columns_[column];
+  DCHECK(col.kind == ColumnKind::kInt);
+  col.nulls[row] = false;
+  col.ints[row] = value;
+}
+
+void QLRowBatch::SetString(size_t column, size_t row, const Slice& value) {
+  auto& col = columns_[column];
+  DCHECK(col.kind == ColumnKind::kString);
+  col.nulls[row] = false;
+  CHECK(arena_.RelocateSlice(value, &col.strings[row]));
+}
+
+QLValuePB* QLRowBatch::mutable_value(size_t column, size_t row) {
+  auto& col = columns_[column];
+  DCHECK(col.kind == ColumnKind::kValue);
+  col.nulls[row] = false;
+  return &col.values[row];
+}
+
+void QLRowBatch::SetTtl(size_t column, size_t row, int64_t ttl_seconds) {
+  columns_[column].ttl_seconds[row] = ttl_seconds;
+}
+
+void QLRowBatch::SetWriteTime(size_t column, size_t row, int64_t write_time) {
+  columns_[column].write_times[row] = write_time;
+}
+
+size_t QLRowBatch::FindColumn(int32_t column_id) const {
+  for (size_t i = 0; i < columns_.size(); i++) {
+    if (columns_[i].id.rep() == column_id) {
+      return i;
+    }
+  }
+  return columns_.size();
+}
+
+bool QLRowBatch::CanFilter(const QLConditionPB& condition) const {
+  const auto& operands = condition.operands();
+  switch (condition.op()) {
+    case QL_OP_AND:
+      for (const auto& operand : operands) {
+        if (operand.expr_case() != QLExpressionPB::ExprCase::kCondition ||
+            !CanFilter(operand.condition())) {
+          return false;
+        }
+      }
+      return operands.size() > 0;
+
+    case QL_OP_IS_NULL: FALLTHROUGH_INTENDED;
+    case QL_OP_IS_NOT_NULL:
+      return operands.size() == 1 &&
+             operands.Get(0).expr_case() == QLExpressionPB::ExprCase::kColumnId &&
+             FindColumn(operands.Get(0).column_id()) != columns_.size();
+
+    case QL_OP_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_NOT_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_LESS_THAN: FALLTHROUGH_INTENDED;
+    case QL_OP_LESS_THAN_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_GREATER_THAN: FALLTHROUGH_INTENDED;
+    case QL_OP_GREATER_THAN_EQUAL: {
+      if (operands.size() != 2 ||
+          operands.Get(0).expr_case() != QLExpressionPB::ExprCase::kColumnId ||
+          operands.Get(1).expr_case() != QLExpressionPB::ExprCase::kValue) {
+        return false;
+      }
+      const size_t idx = FindColumn(operands.Get(0).column_id());
+      if (idx == columns_.size()) {
+        return false;
+      }
+      // Values of different types are not comparable, let row by row evaluation report it.
+      const auto value_type = columns_[idx].value_type;
+      return value_type != InternalType::VALUE_NOT_SET &&
+             operands.Get(1).value().value_case() == value_type;
+    }
+
+    default:
+      return false;
+  }
+}
+
+void QLRowBatch::Filter(const QLConditionPB& condition) {
+  if (condition.op() == QL_OP_AND) {
+    for (const auto& operand : condition.operands()) {
+      if (selection_.empty()) {
+        return;
+      }
+      Filter(operand.condition());
+    }
+    return;
+  }
+  FilterComparison(condition);
+}
+
+void QLRowBatch::FilterComparison(const QLConditionPB& condition) {
+  const auto& operands = condition.operands();
+  const auto& column = columns_[FindColumn(operands.Get(0).column_id())];
+  const auto op = condition.op();
+
+  if (op == QL_OP_IS_NULL || op == QL_OP_IS_NOT_NULL) {
+    const bool is_null = op == QL_OP_IS_NULL;
+    if (column.kind == ColumnKind::kValue) {
+      Select([&](size_t row) { return IsNull(column.values[row]) == is_null; }, &selection_);
+    } else {
+      Select([&](size_t row) { return static_cast<bool>(column.nulls[row]) == is_null; },
+             &selection_);
+    }
+    return;
+  }
+
+  const QLValuePB& rhs = operands.Get(1).value();
+  switch (column.kind) {
+    case ColumnKind::kInt:
+      SelectByComparison(op, column.nulls, column.ints, GetIntValue(rhs), &selection_);
+      return;
+    case ColumnKind::kString:
+      SelectByComparison(op, column.nulls, column.strings, GetStringValue(rhs), &selection_);
+      return;
+    case ColumnKind::kValue:
+      SelectByComparison(op, column.values, rhs, &selection_);
+      return;
+  }
+}
+
+void QLRowBatch::GetRow(size_t row, QLTableRow* table_row) const {
+  for (const auto& column : columns_) {
+    if (column.nulls[row]) {
+      continue;
+    }
+    QLTableColumn& table_column = table_row->AllocColumn(column.id);
+    switch (column.kind) {
+      case ColumnKind::kInt:
+        SetIntValue(column.value_type, column.ints[row], &table_column.value);
+        break;
+      case ColumnKind::kString:
+        if (column.value_type == InternalType::kBinaryValue) {
+          table_column.value.set_binary_value(column.strings[row].cdata(),
+                                              column.strings[row].size());
+        } else {
+          table_column.value.set_string_value(column.strings[row].cdata(),
+                                              column.strings[row].size());
+        }
+        break;
+      case ColumnKind::kValue:
+        table_column.value = column.values[row];
+        break;
+    }
+    if (!column.is_key) {
+      table_column.ttl_seconds = column.ttl_seconds[row];
+      table_column.write_time = column.write_times[row];
+    }
+  }
+}
+
+} // namespace yb
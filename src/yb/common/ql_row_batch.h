@@ -0,0 +1,125 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//
+// This file contains the class that represents a batch of QL rows stored column by column.
+
+#ifndef YB_COMMON_QL_ROW_BATCH_H
+#define YB_COMMON_QL_ROW_BATCH_H
+
+#include <memory>
+#include <vector>
+
+#include "yb/common/common.pb.h"
+#include "yb/common/ql_datatype.h"
+#include "yb/common/ql_type.h"
+#include "yb/common/schema.h"
+
+#include "yb/util/memory/arena.h"
+#include "yb/util/slice.h"
+
+namespace yb {
+
+class QLTableRow;
+
+//------------------------------------------ QL row batch -----------------------------------------
+// A batch of rows read by a scan, stored in column vectors. Integer-like values (including bool,
+// timestamp, date and time) are kept in a fixed-width array, string and binary values are kept
+// in an arena owned by the batch, and values of all other types are kept as QLValuePB.
+//
+// The batch keeps a selection vector of the row indexes that satisfy the conditions applied so
+// far using Filter(). Only selected rows need to be materialized into QLTableRow.
+class QLRowBatch {
+ public:
+  enum class ColumnKind {
+    kInt,
+    kString,
+    kValue,
+  };
+
+  // Create a batch for the key columns of the table with the given schema and the non-key columns
+  // of the given projection. Key columns come first, in the schema order.
+  QLRowBatch(const Schema& schema, const Schema& projection);
+  ~QLRowBatch();
+
+  QLRowBatch(const QLRowBatch&) = delete;
+  void operator=(const QLRowBatch&) = delete;
+
+  // Remove all rows from the batch. Columns are kept.
+  void Clear();
+
+  size_t num_columns() const { return columns_.size(); }
+  size_t num_rows() const { return num_rows_; }
+
+  ColumnKind column_kind(size_t column) const { return columns_[column].kind; }
+  const std::shared_ptr<QLType>& column_type(size_t column) const {
+    return columns_[column].type;
+  }
+
+  // Append a new row with all columns set to null. Returns the index of the row. The new row is
+  // selected.
+  size_t AddRow();
+
+  // Set the column value of the given row. The setter used should match the column kind.
+  void SetInt(size_t column, size_t row, int64_t value);
+  void SetString(size_t column, size_t row, const Slice& value);
+  QLValuePB* mutable_value(size_t column, size_t row);
+
+  void SetTtl(size_t column, size_t row, int64_t ttl_seconds);
+  void SetWriteTime(size_t column, size_t row, int64_t write_time);
+
+  // Indexes of the rows that satisfy all the conditions applied so far.
+  const std::vector<size_t>& selection() const { return selection_; }
+
+  // Whether the given condition could be evaluated on column vectors. Only comparisons between a
+  // column and a constant of the column type, IS [NOT] NULL checks and their conjunctions are
+  // supported.
+  bool CanFilter(const QLConditionPB& condition) const;
+
+  // Narrow the selection down to the rows satisfying the given condition. The condition should
+  // pass CanFilter().
+  void Filter(const QLConditionPB& condition);
+
+  // Copy the values of the given row into table_row.
+  void GetRow(size_t row, QLTableRow* table_row) const;
+
+ private:
+  struct Column {
+    ColumnId id;
+    std::shared_ptr<QLType> type;
+    bool is_key = false;
+    ColumnKind kind = ColumnKind::kValue;
+    // Type of the QLValuePB values of this column, or VALUE_NOT_SET for types that are not
+    // comparable.
+    InternalType value_type = InternalType::VALUE_NOT_SET;
+    std::vector<uint8_t> nulls;
+    std::vector<int64_t> ints;
+    std::vector<Slice> strings;
+    std::vector<QLValuePB> values;
+    std::vector<int64_t> ttl_seconds;
+    std::vector<int64_t> write_times;
+  };
+
+  // Find the column with the given id, returns num_columns() if the column is not in the batch.
+  size_t FindColumn(int32_t column_id) const;
+
+  void FilterComparison(const QLConditionPB& condition);
+
+  std::vector<Column> columns_;
+  size_t num_rows_ = 0;
+  std::vector<size_t> selection_;
+  Arena arena_;
+};
+
+} // namespace yb
+
+#endif // YB_COMMON_QL_ROW_BATCH_H
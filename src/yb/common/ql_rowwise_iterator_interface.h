@@ -27,6 +27,7 @@ class PgsqlReadRequestPB;
 class PgsqlResponsePB;
 class QLReadRequestPB;
 class QLResponsePB;
+class QLRowBatch;
 class QLTableRow;
 class Schema;
 
@@ -80,6 +81,12 @@ class YQLRowwiseIteratorIf {
     return STATUS(NotSupported, "This iterator cannot seek by tuple id");
   }
 
+  // Reads up to max_rows next rows using the specified projection into batch. Returns the number
+  // of rows read, 0 when the iteration is done. See DocRowwiseIterator for details.
+  virtual Result<size_t> NextBatch(const Schema& projection, size_t max_rows, QLRowBatch* batch) {
+    return STATUS(NotSupported, "This iterator does not read row batches");
+  }
+
   //------------------------------------------------------------------------------------------------
   // Common API methods.
   //------------------------------------------------------------------------------------------------
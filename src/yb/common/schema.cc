@@ -97,6 +97,9 @@ void TableProperties::ToTablePropertiesPB(TablePropertiesPB *pb) const {
   }
   pb->set_is_ysql_catalog_table(is_ysql_catalog_table_);
   pb->set_is_backfilling(is_backfilling_);
+  if (bloom_filter_range_components_ > 0) {
+    pb->set_bloom_filter_range_components(bloom_filter_range_components_);
+  }
 }
 
 TableProperties TableProperties::FromTablePropertiesPB(const TablePropertiesPB& pb) {
@@ -128,6 +131,9 @@ TableProperties TableProperties::FromTablePropertiesPB(const TablePropertiesPB&
   if (pb.has_is_backfilling()) {
     table_properties.SetIsBackfilling(pb.is_backfilling());
   }
+  if (pb.has_bloom_filter_range_components()) {
+    table_properties.SetBloomFilterRangeComponents(pb.bloom_filter_range_components());
+  }
   return table_properties;
 }
 
@@ -156,6 +162,8 @@ void TableProperties::AlterFromTablePropertiesPB(const TablePropertiesPB& pb) {
   if (pb.has_is_backfilling()) {
     SetIsBackfilling(pb.is_backfilling());
   }
+  // bloom_filter_range_components is not altered, tablets pick the filter policy when they are
+  // opened, and readers should agree with it.
 }
 
 void TableProperties::Reset() {
@@ -168,6 +176,7 @@ void TableProperties::Reset() {
   num_tablets_ = 0;
   is_ysql_catalog_table_ = false;
   is_backfilling_ = false;
+  bloom_filter_range_components_ = 0;
 }
 
 string TableProperties::ToString() const {
@@ -458,6 +458,10 @@ class TableProperties {
 
   void SetIsBackfilling(bool is_backfilling) { is_backfilling_ = is_backfilling; }
 
+  int bloom_filter_range_components() const { return bloom_filter_range_components_; }
+
+  void SetBloomFilterRangeComponents(int value) { bloom_filter_range_components_ = value; }
+
   void ToTablePropertiesPB(TablePropertiesPB *pb) const;
 
   static TableProperties FromTablePropertiesPB(const TablePropertiesPB& pb);
@@ -480,6 +484,7 @@ class TableProperties {
   bool use_mangled_column_name_ = false;
   int num_tablets_ = 0;
   bool is_ysql_catalog_table_ = false;
+  int bloom_filter_range_components_ = 0;
 };
 
 typedef uint32_t PgTableOid;
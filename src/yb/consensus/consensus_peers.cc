@@ -57,6 +57,7 @@
 #include "yb/rpc/periodic.h"
 #include "yb/tserver/tserver.pb.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/backoff_waiter.h"
 #include "yb/util/fault_injection.h"
 #include "yb/util/flag_tags.h"
@@ -81,6 +82,12 @@ DEFINE_int32(max_wait_for_processresponse_before_closing_ms,
              "finish before returning proceding to close the Peer and return");
 TAG_FLAG(max_wait_for_processresponse_before_closing_ms, advanced);
 
+DEFINE_bool(consensus_send_serialized_ops, true,
+            "Attach operations to consensus update RPCs in the serialized form cached by the log "
+            "cache, so each operation is serialized once for all the peers it is sent to.");
+TAG_FLAG(consensus_send_serialized_ops, runtime);
+TAG_FLAG(consensus_send_serialized_ops, advanced);
+
 DECLARE_int32(raft_heartbeat_interval_ms);
 
 DEFINE_test_flag(double, fault_crash_on_leader_request_fraction, 0.0,
@@ -297,6 +304,16 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
   processing_lock.unlock();
   performing_lock.release();
 
+  if (request_.ops_size() > 0 && GetAtomicFlag(&FLAGS_consensus_send_serialized_ops) &&
+      proxy_->SupportsSerializedOps()) {
+    // The serialized operations are shared with the requests to the other peers and keep the data
+    // alive while the call is in flight, so the operations are not needed in the request anymore.
+    for (auto& op : queue_->SerializeOps(msgs_holder.messages())) {
+      controller_.AddRequestFields(std::move(op));
+    }
+    msgs_holder.Reset();
+  }
+
   // We will cleanup ops from request in ProcessResponse, because otherwise there could be race
   // condition. When rest of this function is running in parallel to ProcessResponse.
   msgs_holder.ReleaseOps();
@@ -247,6 +247,11 @@ class PeerMessageQueue {
       RaftPeerPB::MemberType* member_type = nullptr,
       bool* last_exchange_successful = nullptr);
 
+  // Returns the operations serialized for sending to peers, see LogCache::SerializeOps().
+  std::vector<RefCntBuffer> SerializeOps(const ReplicateMsgs& msgs) {
+    return log_cache_.SerializeOps(msgs);
+  }
+
   // Fill in a StartRemoteBootstrapRequest for the specified peer.  If that peer should not remotely
   // bootstrap, returns a non-OK status.  On success, also internally resets
   // peer->needs_remote_bootstrap to false.
@@ -141,6 +141,21 @@ DEFINE_int32(taskstream_queue_max_size, 100000,
 DEFINE_int32(taskstream_queue_max_wait_ms, 1000,
              "Maximum time in ms to wait for items in the taskstream queue to arrive.");
 
+// Group commit flags.
+DEFINE_int32(log_group_commit_max_wait_us, 500,
+             "Maximum time in microseconds the log appender waits for entries from concurrent "
+             "appenders to join a group before syncing it, when durable_wal_write is on. "
+             "The actual wait is adapted to the observed fsync latency and group sizes. "
+             "0 disables waiting.");
+TAG_FLAG(log_group_commit_max_wait_us, runtime);
+TAG_FLAG(log_group_commit_max_wait_us, advanced);
+
+DEFINE_double(log_group_commit_sync_latency_ratio, 0.5,
+              "Fraction of the average fsync latency the log appender waits for more entries "
+              "to join a group before syncing it.");
+TAG_FLAG(log_group_commit_sync_latency_ratio, runtime);
+TAG_FLAG(log_group_commit_sync_latency_ratio, advanced);
+
 // Validate that log_min_segments_to_retain >= 1
 static bool ValidateLogsToRetain(const char* flagname, int value) {
   if (value >= 1) {
@@ -196,6 +211,11 @@ class Log::Appender {
   void ProcessBatch(LogEntryBatch* entry_batch);
   void GroupWork();
 
+  // Returns how long to wait for more entry batches to join the current group before syncing it.
+  // Waiting only pays off when there are concurrent appenders, i.e. recent groups were larger
+  // than the current one, and is bounded by a fraction of the observed fsync latency.
+  MonoDelta GroupCommitWait();
+
   Log* const log_;
 
   // Lock to protect access to thread_ during shutdown.
@@ -207,6 +227,14 @@ class Log::Appender {
 
   // Time at which current group was started
   MonoTime time_started_;
+
+  // Number of log entries in the current group.
+  size_t group_entries_ = 0;
+
+  // Moving averages of the number of entry batches per group and the fsync latency, used to
+  // adapt the group commit wait. Only accessed from the append task.
+  double avg_batches_per_group_ = 0;
+  double avg_sync_latency_us_ = 0;
 };
 
 Log::Appender::Appender(Log *log, ThreadPool* append_thread_pool)
@@ -216,6 +244,7 @@ Log::Appender::Appender(Log *log, ThreadPool* append_thread_pool)
           FLAGS_taskstream_queue_max_size,
           MonoDelta::FromMilliseconds(FLAGS_taskstream_queue_max_wait_ms))) {
   DCHECK(dummy);
+  task_stream_->SetGroupWait(std::bind(&Log::Appender::GroupCommitWait, this));
 }
 
 Status Log::Appender::Init() {
@@ -260,18 +289,44 @@ void Log::Appender::ProcessBatch(LogEntryBatch* entry_batch) {
     }
     log_->periodic_sync_unsynced_bytes_ += entry_batch->total_size_bytes();
   }
+  group_entries_ += entry_batch->count();
   sync_batch_.emplace_back(entry_batch);
 }
 
+MonoDelta Log::Appender::GroupCommitWait() {
+  // Groups of a single batch mean there are no concurrent appenders to wait for.
+  constexpr double kMinAvgBatchesPerGroupToWait = 1.5;
+
+  const auto max_wait_us = GetAtomicFlag(&FLAGS_log_group_commit_max_wait_us);
+  if (max_wait_us <= 0 || !log_->durable_wal_write_ || log_->sync_disabled_ ||
+      sync_batch_.empty()) {
+    return MonoDelta::kZero;
+  }
+  if (avg_batches_per_group_ < kMinAvgBatchesPerGroupToWait ||
+      sync_batch_.size() >= avg_batches_per_group_) {
+    return MonoDelta::kZero;
+  }
+  const auto window_us = std::min<double>(
+      max_wait_us,
+      avg_sync_latency_us_ * GetAtomicFlag(&FLAGS_log_group_commit_sync_latency_ratio));
+  return time_started_ + MonoDelta::FromMicroseconds(window_us) - MonoTime::Now();
+}
+
 void Log::Appender::GroupWork() {
+  // Weight of the most recent value in the moving averages used by GroupCommitWait.
+  constexpr double kMovingAverageWeight = 0.1;
+
   if (sync_batch_.empty()) {
     Status s = log_->Sync();
     return;
   }
   if (log_->metrics_) {
     log_->metrics_->entry_batches_per_group->Increment(sync_batch_.size());
+    log_->metrics_->entries_per_sync->Increment(group_entries_);
   }
   TRACE_EVENT1("log", "batch", "batch_size", sync_batch_.size());
+  avg_batches_per_group_ +=
+      (sync_batch_.size() - avg_batches_per_group_) * kMovingAverageWeight;
 
   auto se = ScopeExit([this] {
     if (log_->metrics_) {
@@ -280,9 +335,13 @@ void Log::Appender::GroupWork() {
           time_now.GetDeltaSince(time_started_).ToMicroseconds());
     }
     sync_batch_.clear();
+    group_entries_ = 0;
   });
 
+  const auto sync_start = MonoTime::Now();
   Status s = log_->Sync();
+  const auto sync_latency_us = MonoTime::Now().GetDeltaSince(sync_start).ToMicroseconds();
+  avg_sync_latency_us_ += (sync_latency_us - avg_sync_latency_us_) * kMovingAverageWeight;
   if (PREDICT_FALSE(!s.ok())) {
     LOG_WITH_PREFIX(DFATAL) << "Error syncing log: " << s;
     for (std::unique_ptr<LogEntryBatch>& entry_batch : sync_batch_) {
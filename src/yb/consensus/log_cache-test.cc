@@ -258,6 +258,45 @@ TEST_F(LogCacheTest, TestCacheEdgeCases) {
 }
 
 
+TEST_F(LogCacheTest, TestSerializeOps) {
+  constexpr int kNumOps = 10;
+  ASSERT_OK(AppendReplicateMessagesToCache(1, kNumOps, 100 /* payload_size */));
+  ASSERT_OK(log_->WaitUntilAllFlushed());
+
+  auto read_result = ASSERT_RESULT(cache_->ReadOps(0, 8_MB));
+  ASSERT_EQ(kNumOps, read_result.messages.size());
+  auto size_before = cache_->metrics_.size->value();
+
+  auto serialized = cache_->SerializeOps(read_result.messages);
+  ASSERT_EQ(kNumOps, serialized.size());
+  ASSERT_GT(cache_->metrics_.size->value(), size_before);
+
+  // Serialized ops form a valid request, equal to the one with the ops added directly.
+  std::string wire;
+  for (const auto& op : serialized) {
+    wire.append(op.data(), op.size());
+  }
+  ConsensusRequestPB request;
+  ASSERT_TRUE(request.ParseFromString(wire));
+  ASSERT_EQ(kNumOps, request.ops_size());
+  for (int i = 0; i != kNumOps; ++i) {
+    ASSERT_EQ(read_result.messages[i]->SerializeAsString(), request.ops(i).SerializeAsString());
+  }
+
+  // Cached ops are serialized once and shared.
+  auto serialized_again = cache_->SerializeOps(read_result.messages);
+  for (int i = 0; i != kNumOps; ++i) {
+    ASSERT_EQ(serialized[i].data(), serialized_again[i].data());
+  }
+
+  // Evicted ops are serialized on each request.
+  cache_->EvictThroughOp(kNumOps);
+  ASSERT_EQ(0, cache_->metrics_.size->value());
+  serialized_again = cache_->SerializeOps(read_result.messages);
+  ASSERT_NE(serialized[0].data(), serialized_again[0].data());
+  ASSERT_EQ(serialized[0].as_slice(), serialized_again[0].as_slice());
+}
+
 TEST_F(LogCacheTest, TestMemoryLimit) {
   FLAGS_log_cache_size_limit_mb = 1;
   CloseAndReopenCache(MinimumOpId());
@@ -401,5 +440,56 @@ TEST_F(LogCacheTest, TestMTReadAndWrite) {
   ASSERT_GT(num_appended, 0);
 }
 
+// Measures throughput of appending operations to the cache and of reading cached operations, as the
+// leader does for every peer, and memory used per cached operation.
+TEST_F(LogCacheTest, AppendAndReadBenchmark) {
+  const int64_t kNumOps = AllowSlowTests() ? 200000 : 20000;
+  constexpr int64_t kOpsPerBatch = 10;
+  constexpr int kReadIterations = 10;
+  constexpr size_t kPayloadSize = 32;
+
+  std::vector<ReplicateMsgs> batches;
+  for (int64_t index = 1; index <= kNumOps; index += kOpsPerBatch) {
+    ReplicateMsgs batch;
+    for (int64_t i = index; i != index + kOpsPerBatch; ++i) {
+      batch.push_back(CreateDummyReplicate(i / kTermDivisor, i, clock_->Now(), kPayloadSize));
+    }
+    batches.push_back(std::move(batch));
+  }
+
+  // Includes queueing the operations to the log, but not writing them.
+  auto start = MonoTime::Now();
+  for (const auto& batch : batches) {
+    ASSERT_OK(cache_->AppendOperations(
+        batch, yb::OpId() /* committed_op_id */, RestartSafeCoarseMonoClock().Now(),
+        Bind(&FatalOnError)));
+  }
+  MonoDelta append_time = MonoTime::Now() - start;
+  ASSERT_OK(log_->WaitUntilAllFlushed());
+  ASSERT_EQ(kNumOps, cache_->num_cached_ops());
+
+  int64_t num_read = 0;
+  start = MonoTime::Now();
+  for (int i = 0; i != kReadIterations; ++i) {
+    int64_t index = 0;
+    while (index < kNumOps) {
+      auto read_result = ASSERT_RESULT(cache_->ReadOps(index, 1_MB));
+      ASSERT_FALSE(read_result.messages.empty());
+      index += read_result.messages.size();
+    }
+    num_read += index;
+  }
+  MonoDelta read_time = MonoTime::Now() - start;
+
+  LOG(INFO) << "Appended " << kNumOps << " ops in " << append_time << ": "
+            << kNumOps / append_time.ToSeconds() << " ops/s";
+  LOG(INFO) << "Read " << num_read << " ops in " << read_time << ": "
+            << num_read / read_time.ToSeconds() << " ops/s";
+  LOG(INFO) << "Memory per cached op: "
+            << cache_->metrics_.size->value() / kNumOps << " bytes of messages, "
+            << cache_->entries_.capacity() * sizeof(LogCache::CacheEntry) / kNumOps
+            << " bytes of cache structure";
+}
+
 } // namespace consensus
 } // namespace yb
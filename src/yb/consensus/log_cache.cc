@@ -92,6 +92,9 @@ namespace {
 
 const std::string kParentMemTrackerId = "log_cache"s;
 
+// Initial number of entries the cache buffer has room for. The buffer is never shrunk below it.
+constexpr size_t kMinCacheCapacity = 64;
+
 }
 
 typedef vector<const ReplicateMsg*>::const_iterator MsgIter;
@@ -120,10 +123,7 @@ LogCache::LogCache(const scoped_refptr<MetricEntity>& metric_entity,
       AddToParent::kTrue, CreateMetrics::kFalse);
   tracker_->SetMetricEntity(metric_entity, kParentMemTrackerId);
 
-  // Put a fake message at index 0, since this simplifies a lot of our code paths elsewhere.
-  auto zero_op = std::make_shared<ReplicateMsg>();
-  *zero_op->mutable_id() = MinimumOpId();
-  InsertOrDie(&cache_, 0, { zero_op, zero_op->SpaceUsed() });
+  entries_.set_capacity(kMinCacheCapacity);
 }
 
 MemTrackerPtr LogCache::GetServerMemTracker(const MemTrackerPtr& server_tracker) {
@@ -134,14 +134,14 @@ MemTrackerPtr LogCache::GetServerMemTracker(const MemTrackerPtr& server_tracker)
 
 LogCache::~LogCache() {
   tracker_->Release(tracker_->consumption());
-  cache_.clear();
+  entries_.clear();
 
   tracker_->UnregisterFromParent();
 }
 
 void LogCache::Init(const OpId& preceding_op) {
   std::lock_guard<simple_spinlock> l(lock_);
-  CHECK_EQ(cache_.size(), 1) << "Cache should have only our special '0' op";
+  CHECK(entries_.empty()) << "Cache should be empty";
   next_sequential_op_index_ = preceding_op.index() + 1;
   min_pinned_op_index_ = next_sequential_op_index_;
 }
@@ -169,18 +169,23 @@ Result<LogCache::PrepareAppendResult> LogCache::PrepareAppendOperations(const Re
     CHECK_LE(first_idx_in_batch, next_sequential_op_index_);
 
     // Now remove the overwritten operations.
-    for (int64_t i = first_idx_in_batch; i < next_sequential_op_index_; ++i) {
-      auto it = cache_.find(i);
-      if (it != cache_.end()) {
-        AccountForMessageRemovalUnlocked(it->second);
-        cache_.erase(it);
-      }
+    while (!entries_.empty() && EndCachedIndexUnlocked() > first_idx_in_batch) {
+      AccountForMessageRemovalUnlocked(entries_.back());
+      entries_.pop_back();
     }
   }
 
   for (auto& e : entries_to_insert) {
     auto index = e.msg->id().index();
-    EmplaceOrDie(&cache_, index, std::move(e));
+    if (entries_.empty()) {
+      first_cached_index_ = index;
+    } else {
+      CHECK_EQ(index, EndCachedIndexUnlocked());
+    }
+    if (entries_.full()) {
+      entries_.set_capacity(entries_.capacity() * 2);
+    }
+    entries_.push_back(std::move(e));
     next_sequential_op_index_ = index + 1;
   }
 
@@ -249,9 +254,12 @@ Result<yb::OpId> LogCache::LookupOpId(int64_t op_index) const {
                                            "(next sequential op: $1)",
                                            op_index, next_sequential_op_index_));
     }
-    auto iter = cache_.find(op_index);
-    if (iter != cache_.end()) {
-      return yb::OpId::FromPB(iter->second.msg->id());
+    if (op_index == 0) {
+      return yb::OpId::FromPB(MinimumOpId());
+    }
+    auto* entry = FindEntryUnlocked(op_index);
+    if (entry) {
+      return yb::OpId::FromPB(entry->msg->id());
     }
   }
 
@@ -270,6 +278,22 @@ int64_t TotalByteSizeForMessage(const ReplicateMsg& msg) {
   return msg_size;
 }
 
+RefCntBuffer SerializeOp(const ReplicateMsg& msg) {
+  using google::protobuf::internal::WireFormatLite;
+  using google::protobuf::io::CodedOutputStream;
+
+  const uint32_t tag = WireFormatLite::MakeTag(
+      ConsensusRequestPB::kOpsFieldNumber, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+  const int msg_size = msg.ByteSize();
+  RefCntBuffer result(CodedOutputStream::VarintSize32(tag) +
+                      WireFormatLite::LengthDelimitedSize(msg_size));
+  auto* dst = CodedOutputStream::WriteVarint32ToArray(tag, result.udata());
+  dst = CodedOutputStream::WriteVarint32ToArray(msg_size, dst);
+  dst = msg.SerializeWithCachedSizesToArray(dst);
+  DCHECK_EQ(dst, result.udata() + result.size());
+  return result;
+}
+
 } // anonymous namespace
 
 Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
@@ -297,15 +321,15 @@ Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
   int64_t remaining_space = max_size_bytes;
   while (remaining_space > 0 && next_index < to_index) {
     // If the messages the peer needs haven't been loaded into the queue yet, load them.
-    MessageCache::const_iterator iter = cache_.lower_bound(next_index);
-    if (iter == cache_.end() || iter->first != next_index) {
+    if (entries_.empty() || next_index < first_cached_index_ ||
+        next_index >= EndCachedIndexUnlocked()) {
       int64_t up_to;
-      if (iter == cache_.end()) {
+      if (entries_.empty() || next_index >= EndCachedIndexUnlocked()) {
         // Read all the way to the current op.
         up_to = to_index - 1;
       } else {
         // Read up to the next entry that's in the cache or to_index whichever is lesser.
-        up_to = std::min(iter->first - 1, static_cast<uint64_t>(to_index - 1));
+        up_to = std::min(first_cached_index_ - 1, to_index - 1);
       }
 
       l.unlock();
@@ -336,17 +360,13 @@ Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
 
     } else {
       // Pull contiguous messages from the cache until the size limit is achieved.
-      for (; iter != cache_.end(); ++iter) {
-        if (to_op_index > 0 && next_index > to_op_index) {
-          break;
-        }
-        const ReplicateMsgPtr& msg = iter->second.msg;
-        int64_t index = msg->id().index();
-        if (index != next_index) {
-          continue;
-        }
-
-        auto current_message_size = TotalByteSizeForMessage(*msg);
+      const int64_t end_index = std::min(EndCachedIndexUnlocked(), to_index);
+      for (; next_index < end_index; ++next_index) {
+        const CacheEntry& entry = entries_[next_index - first_cached_index_];
+        const ReplicateMsgPtr& msg = entry.msg;
+        const auto& serialized_op = entry.serialized_op;
+        int64_t current_message_size =
+            serialized_op ? serialized_op.size() : TotalByteSizeForMessage(*msg);
         remaining_space -= current_message_size;
         if (remaining_space < 0 && !result.messages.empty()) {
           result.have_more_messages = true;
@@ -354,7 +374,6 @@ Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
         }
 
         result.messages.push_back(msg);
-        next_index++;
       }
     }
   }
@@ -362,6 +381,46 @@ Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
   return result;
 }
 
+std::vector<RefCntBuffer> LogCache::SerializeOps(const ReplicateMsgs& msgs) {
+  std::vector<RefCntBuffer> result(msgs.size());
+  std::vector<size_t> missing;
+  {
+    std::lock_guard<simple_spinlock> lock(lock_);
+    for (size_t i = 0; i != msgs.size(); ++i) {
+      auto* entry = FindEntryUnlocked(msgs[i]->id().index());
+      if (entry && entry->msg == msgs[i] && entry->serialized_op) {
+        result[i] = entry->serialized_op;
+      } else {
+        missing.push_back(i);
+      }
+    }
+  }
+  if (missing.empty()) {
+    return result;
+  }
+
+  // Serialize outside of the lock, a batch could be large.
+  for (auto i : missing) {
+    result[i] = SerializeOp(*msgs[i]);
+  }
+
+  std::lock_guard<simple_spinlock> lock(lock_);
+  for (auto i : missing) {
+    auto* entry = FindEntryUnlocked(msgs[i]->id().index());
+    if (!entry || entry->msg != msgs[i] || entry->serialized_op) {
+      continue;
+    }
+    int64_t size = result[i].size();
+    entry->serialized_op = result[i];
+    entry->mem_usage += size;
+    metrics_.size->IncrementBy(size);
+    if (entry->tracked) {
+      tracker_->Consume(size);
+    }
+  }
+  return result;
+}
+
 size_t LogCache::EvictThroughOp(int64_t index, int64_t bytes_to_evict) {
   std::lock_guard<simple_spinlock> lock(lock_);
   return EvictSomeUnlocked(index, bytes_to_evict);
@@ -379,17 +438,11 @@ size_t LogCache::EvictSomeUnlocked(int64_t stop_after_index, int64_t bytes_to_ev
   }
 
   int64_t bytes_evicted = 0;
-  for (auto iter = cache_.begin(); iter != cache_.end();) {
-    const CacheEntry& entry = iter->second;
+  while (!entries_.empty()) {
+    const CacheEntry& entry = entries_.front();
     const ReplicateMsgPtr& msg = entry.msg;
     VLOG_WITH_PREFIX_UNLOCKED(2) << "considering for eviction: " << msg->id();
-    int64_t msg_index = msg->id().index();
-    if (msg_index == 0) {
-      // Always keep our special '0' op.
-      ++iter;
-      continue;
-    }
-
+    int64_t msg_index = first_cached_index_;
     if (msg_index > stop_after_index || msg_index >= min_pinned_op_index_) {
       break;
     }
@@ -397,17 +450,30 @@ size_t LogCache::EvictSomeUnlocked(int64_t stop_after_index, int64_t bytes_to_ev
     VLOG_WITH_PREFIX_UNLOCKED(2) << "Evicting cache. Removing: " << msg->id();
     AccountForMessageRemovalUnlocked(entry);
     bytes_evicted += entry.mem_usage;
-    cache_.erase(iter++);
+    entries_.pop_front();
+    ++first_cached_index_;
 
     if (bytes_evicted >= bytes_to_evict) {
       break;
     }
   }
+
+  // Give back memory of the buffer after the cache shrinks, e.g. when followers caught up.
+  if (entries_.capacity() > kMinCacheCapacity && entries_.size() * 4 < entries_.capacity()) {
+    entries_.set_capacity(std::max(entries_.capacity() / 2, kMinCacheCapacity));
+  }
   VLOG_WITH_PREFIX_UNLOCKED(1) << "Evicting log cache: after state: " << ToStringUnlocked();
 
   return bytes_evicted;
 }
 
+const LogCache::CacheEntry* LogCache::FindEntryUnlocked(int64_t index) const {
+  if (index < first_cached_index_ || index >= EndCachedIndexUnlocked()) {
+    return nullptr;
+  }
+  return &entries_[index - first_cached_index_];
+}
+
 void LogCache::AccountForMessageRemovalUnlocked(const CacheEntry& entry) {
   if (entry.tracked) {
     tracker_->Release(entry.mem_usage);
@@ -462,8 +528,8 @@ void LogCache::DumpToStrings(vector<string>* lines) const {
   int counter = 0;
   lines->push_back(ToStringUnlocked());
   lines->push_back("Messages:");
-  for (const auto& entry : cache_) {
-    const ReplicateMsgPtr msg = entry.second.msg;
+  for (const auto& entry : entries_) {
+    const ReplicateMsgPtr msg = entry.msg;
     lines->push_back(
       Substitute("Message[$0] $1.$2 : REPLICATE. Type: $3, Size: $4",
                  counter++, msg->id().term(), msg->id().index(),
@@ -481,8 +547,8 @@ void LogCache::DumpToHtml(std::ostream& out) const {
   out << "<tr><th>Entry</th><th>OpId</th><th>Type</th><th>Size</th><th>Status</th></tr>" << endl;
 
   int counter = 0;
-  for (const auto& entry : cache_) {
-    const ReplicateMsgPtr msg = entry.second.msg;
+  for (const auto& entry : entries_) {
+    const ReplicateMsgPtr msg = entry.msg;
     out << Substitute("<tr><th>$0</th><th>$1.$2</th><td>REPLICATE $3</td>"
                       "<td>$4</td><td>$5</td></tr>",
                       counter++, msg->id().term(), msg->id().index(),
@@ -501,10 +567,10 @@ void LogCache::TrackOperationsMemory(const OpIds& op_ids) {
 
   int mem_required = 0;
   for (const auto& op_id : op_ids) {
-    auto it = cache_.find(op_id.index);
-    if (it != cache_.end() && it->second.msg->id().term() == op_id.term) {
-      mem_required += it->second.mem_usage;
-      it->second.tracked = true;
+    auto* entry = FindEntryUnlocked(op_id.index);
+    if (entry && entry->msg->id().term() == op_id.term) {
+      mem_required += entry->mem_usage;
+      entry->tracked = true;
     }
   }
 
@@ -32,11 +32,12 @@
 #ifndef YB_CONSENSUS_LOG_CACHE_H
 #define YB_CONSENSUS_LOG_CACHE_H
 
-#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include <boost/circular_buffer.hpp>
+
 #include "yb/consensus/consensus_fwd.h"
 #include "yb/consensus/consensus.pb.h"
 #include "yb/consensus/opid_util.h"
@@ -47,6 +48,7 @@
 #include "yb/util/locks.h"
 #include "yb/util/metrics.h"
 #include "yb/util/opid.h"
+#include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/restart_safe_clock.h"
 #include "yb/util/result.h"
 
@@ -119,6 +121,11 @@ class LogCache {
                                 int64_t to_op_index,
                                 int max_size_bytes);
 
+  // Returns the given operations serialized as 'ops' fields of ConsensusRequestPB, to be sent using
+  // rpc::RpcController::AddRequestFields(). Cached operations are serialized at most once, and the
+  // result is shared by all the peers they are sent to.
+  std::vector<RefCntBuffer> SerializeOps(const ReplicateMsgs& msgs);
+
   // Append the operations into the log and the cache.  When the messages have completed writing
   // into the on-disk log, fires 'callback'.
   //
@@ -174,6 +181,8 @@ class LogCache {
   FRIEND_TEST(LogCacheTest, TestAppendAndGetMessages);
   FRIEND_TEST(LogCacheTest, TestGlobalMemoryLimit);
   FRIEND_TEST(LogCacheTest, TestReplaceMessages);
+  FRIEND_TEST(LogCacheTest, TestSerializeOps);
+  FRIEND_TEST(LogCacheTest, AppendAndReadBenchmark);
   friend class LogCacheTest;
 
   // An entry in the cache.
@@ -183,6 +192,10 @@ class LogCache {
     // to compute, so we compute it only once upon insertion.
     int64_t mem_usage;
 
+    // msg serialized as an 'ops' field of ConsensusRequestPB, set when it is first sent to a peer.
+    // Accounted in mem_usage.
+    RefCntBuffer serialized_op;
+
     // Did we start memory tracking for this entry.
     bool tracked = false;
   };
@@ -216,6 +229,18 @@ class LogCache {
 
   Result<PrepareAppendResult> PrepareAppendOperations(const ReplicateMsgs& msgs);
 
+  // Returns the cache entry for the given op index, or nullptr if it is not cached.
+  const CacheEntry* FindEntryUnlocked(int64_t index) const;
+
+  CacheEntry* FindEntryUnlocked(int64_t index) {
+    return const_cast<CacheEntry*>(static_cast<const LogCache*>(this)->FindEntryUnlocked(index));
+  }
+
+  // Op index following the last cached entry.
+  int64_t EndCachedIndexUnlocked() const {
+    return first_cached_index_ + entries_.size();
+  }
+
   scoped_refptr<log::Log> const log_;
 
   // The UUID of the local peer.
@@ -226,12 +251,13 @@ class LogCache {
 
   mutable simple_spinlock lock_;
 
-  // An ordered map that serves as the buffer for the cached messages.
-  // Maps from log index -> ReplicateMsg
-  // An ordered map that serves as the buffer for the cached messages.  Maps from log index ->
-  // CacheEntry
-  typedef std::map<uint64_t, CacheEntry> MessageCache;
-  MessageCache cache_;
+  // Cached messages. Operations are appended at the back and evicted from the front, so cached
+  // indexes are always contiguous: the entry for op index i is at i - first_cached_index_. The
+  // buffer grows by doubling when full and shrinks after evictions.
+  boost::circular_buffer<CacheEntry> entries_;
+
+  // Op index of the first entry in entries_, meaningful only when entries_ is not empty.
+  int64_t first_cached_index_ = 0;
 
   // The next log index to append. Each append operation must either start with this log index, or
   // go backward (but never skip forward).
@@ -63,6 +63,11 @@ METRIC_DEFINE_histogram(tablet, log_entry_batches_per_group, "Log Group Commit B
                         "Number of log entry batches in a group commit group",
                         1024, 2);
 
+METRIC_DEFINE_histogram(tablet, log_entries_per_sync, "Log Entries Per Sync",
+                        yb::MetricUnit::kRequests,
+                        "Number of log entries persisted by a single group commit sync",
+                        65536, 2);
+
 namespace yb {
 namespace log {
 
@@ -73,7 +78,8 @@ LogMetrics::LogMetrics(const scoped_refptr<MetricEntity>& metric_entity)
       MINIT(append_latency),
       MINIT(group_commit_latency),
       MINIT(roll_latency),
-      MINIT(entry_batches_per_group) {
+      MINIT(entry_batches_per_group),
+      MINIT(entries_per_sync) {
 }
 #undef MINIT
 
@@ -50,6 +50,9 @@ DEFINE_int32(num_writer_threads, 1, "Number of threads writing to the log");
 DEFINE_int32(num_batches_per_thread, 2000, "Number of batches per thread");
 DEFINE_int32(num_ops_per_batch_avg, 5, "Target average number of ops per batch");
 
+METRIC_DECLARE_histogram(log_entries_per_sync);
+METRIC_DECLARE_histogram(log_entry_batches_per_group);
+
 namespace yb {
 namespace log {
 
@@ -191,5 +194,30 @@ TEST_F(MultiThreadedLogTest, TestAppends) {
   ASSERT_TRUE(std::is_sorted(ids.begin(), ids.end()));
 }
 
+TEST_F(MultiThreadedLogTest, TestDurableGroupCommit) {
+  FLAGS_num_writer_threads = 4;
+  FLAGS_num_batches_per_thread = 200;
+  options_.durable_wal_write = true;
+  BuildLog();
+  int start_current_id = current_index_;
+  ASSERT_NO_FATALS(Run());
+  ASSERT_OK(log_->Close());
+
+  // Every appended entry and batch should be accounted for by exactly one sync.
+  const uint64_t num_batches = FLAGS_num_writer_threads * FLAGS_num_batches_per_thread;
+  auto entries_per_sync = METRIC_log_entries_per_sync.Instantiate(metric_entity_);
+  auto batches_per_sync = METRIC_log_entry_batches_per_group.Instantiate(metric_entity_);
+  ASSERT_EQ(current_index_ - start_current_id, entries_per_sync->histogram()->TotalSum());
+  ASSERT_EQ(num_batches, batches_per_sync->histogram()->TotalSum());
+  ASSERT_EQ(entries_per_sync->TotalCount(), batches_per_sync->TotalCount());
+  LOG(INFO) << "Syncs: " << entries_per_sync->TotalCount()
+            << ", average entries per sync: " << entries_per_sync->MeanValueForTests()
+            << ", average batches per sync: " << batches_per_sync->MeanValueForTests();
+
+  // Writers don't wait for their batches to be synced, so concurrent batches should share syncs.
+  ASSERT_LT(batches_per_sync->TotalCount(), num_batches);
+  ASSERT_GT(batches_per_sync->MeanValueForTests(), 1.0);
+}
+
 } // namespace log
 } // namespace yb
@@ -46,6 +46,10 @@ class ReplicateMsgsHolder {
     ops_ = nullptr;
   }
 
+  const ReplicateMsgs& messages() const {
+    return messages_;
+  }
+
  private:
   google::protobuf::RepeatedPtrField<ReplicateMsg>* ops_;
 
@@ -465,11 +465,15 @@ class TransactionConflictResolverContext : public ConflictResolverContext {
       // DB where the provisional record has already been removed.
       resolver->EnsureIntentIteratorCreated();
 
+      // Intent keys could be prefixes of range keys, that the bloom filter does not index.
+      const auto bloom_filter_mode = VERIFY_RESULT(HasAllFilterComponents(key_slice))
+          ? BloomFilterMode::USE_BLOOM_FILTER : BloomFilterMode::DONT_USE_BLOOM_FILTER;
+
       // TODO(dtxn) reuse iterator
       auto value_iter = CreateRocksDBIterator(
           resolver->doc_db().regular,
           resolver->doc_db().key_bounds,
-          BloomFilterMode::USE_BLOOM_FILTER,
+          bloom_filter_mode,
           key_slice,
           rocksdb::kDefaultQueryId);
 
@@ -18,6 +18,7 @@
 #include "yb/common/partition.h"
 #include "yb/common/ql_protocol_util.h"
 #include "yb/common/ql_resultset.h"
+#include "yb/common/ql_row_batch.h"
 #include "yb/common/ql_storage_interface.h"
 #include "yb/common/ql_value.h"
 
@@ -42,6 +43,11 @@ DEFINE_bool(ycql_consistent_transactional_paging, false,
             "be stale. The latter is preferable for long scans. The data returned for the first "
             "page of results is never stale regardless of this flag.");
 
+DEFINE_int32(ycql_scan_batch_size, 256,
+             "Number of rows YCQL scans decode at once into a columnar batch, so simple WHERE "
+             "conditions are evaluated on column values before building rows. 0 disables it.");
+TAG_FLAG(ycql_scan_batch_size, advanced);
+
 DECLARE_bool(trace_docdb_calls);
 
 namespace yb {
@@ -1213,7 +1219,11 @@ Status QLReadOperation::Execute(const common::YQLStorageIf& ql_storage,
   // Begin the normal fetch.
   int match_count = 0;
   bool static_dealt_with = true;
-  while (resultset->rsrow_count() < row_count_limit && VERIFY_RESULT(iter->HasNext())) {
+  const bool scanned_in_batches = VERIFY_RESULT(ExecuteScanInBatches(
+      iter.get(), schema, non_static_projection, spec, row_count_limit, offset, resultset,
+      &match_count, &num_rows_skipped));
+  while (!scanned_in_batches && resultset->rsrow_count() < row_count_limit &&
+         VERIFY_RESULT(iter->HasNext())) {
     const bool last_read_static = iter->IsNextStaticColumn();
 
     // Note that static columns are sorted before non-static columns in DocDB as follows. This is
@@ -1308,6 +1318,70 @@ Status QLReadOperation::Execute(const common::YQLStorageIf& ql_storage,
   return Status::OK();
 }
 
+Result<bool> QLReadOperation::ExecuteScanInBatches(common::YQLRowwiseIteratorIf* iter,
+                                                   const Schema& schema,
+                                                   const Schema& projection,
+                                                   const std::unique_ptr<common::QLScanSpec>& spec,
+                                                   const size_t row_count_limit,
+                                                   const size_t offset,
+                                                   QLResultSet* resultset,
+                                                   int* match_count,
+                                                   size_t* num_rows_skipped) {
+  // Static columns and DISTINCT need rows to be joined, so they are read row by row.
+  if (FLAGS_ycql_scan_batch_size <= 0 || schema.has_statics() || request_.distinct() ||
+      request_.has_if_expr()) {
+    return false;
+  }
+
+  QLRowBatch batch(schema, projection);
+  const QLConditionPB* condition =
+      request_.has_where_expr() ? &request_.where_expr().condition() : nullptr;
+  if (condition != nullptr && !batch.CanFilter(*condition)) {
+    return false;
+  }
+
+  QLTableRow row;
+  bool first_batch = true;
+  while (resultset->rsrow_count() < row_count_limit) {
+    // Each row produces at most one result row, so we never read past the row the paging state
+    // should point to.
+    const size_t max_rows = std::min<size_t>(
+        FLAGS_ycql_scan_batch_size, row_count_limit - resultset->rsrow_count());
+    batch.Clear();
+    auto num_rows = iter->NextBatch(projection, max_rows, &batch);
+    if (!num_rows.ok()) {
+      if (first_batch && num_rows.status().IsNotSupported()) {
+        return false;
+      }
+      return num_rows.status();
+    }
+    first_batch = false;
+    if (*num_rows == 0) {
+      break;
+    }
+
+    if (condition != nullptr) {
+      batch.Filter(*condition);
+    }
+    for (const size_t idx : batch.selection()) {
+      if (*num_rows_skipped < offset) {
+        (*num_rows_skipped)++;
+        continue;
+      }
+      (*match_count)++;
+      row.Clear();
+      batch.GetRow(idx, &row);
+      if (request_.is_aggregate()) {
+        RETURN_NOT_OK(EvalAggregate(row));
+      } else {
+        RETURN_NOT_OK(PopulateResultSet(spec, row, resultset));
+      }
+    }
+  }
+
+  return true;
+}
+
 Status QLReadOperation::SetPagingStateIfNecessary(const common::YQLRowwiseIteratorIf* iter,
                                                   const QLResultSet* resultset,
                                                   const size_t row_count_limit,
@@ -223,6 +223,18 @@ class QLReadOperation : public DocExprExecutor {
   QLResponsePB& response() { return response_; }
 
  private:
+  // Reads rows in columnar batches, evaluating the WHERE condition on the batch columns and
+  // materializing only the matching rows. Returns false without reading anything when the
+  // request could not be processed this way.
+  Result<bool> ExecuteScanInBatches(common::YQLRowwiseIteratorIf* iter,
+                                    const Schema& schema,
+                                    const Schema& projection,
+                                    const std::unique_ptr<common::QLScanSpec>& spec,
+                                    const size_t row_count_limit,
+                                    const size_t offset,
+                                    QLResultSet* resultset,
+                                    int* match_count,
+                                    size_t* num_rows_skipped);
 
   // Checks whether we have processed enough rows for a page and sets the appropriate paging
   // state in the response object.
@@ -433,6 +433,66 @@ TEST_F(DocKeyTest, TestKeyMatching) {
   ASSERT_FALSE(may_match(EncodeSimpleSubDocKey(absent_key))) << "Key: " << absent_key;
 }
 
+std::string EncodeRangeSubDocKey(
+    const std::vector<PrimitiveValue>& range_components, const std::string& sub_key) {
+  return SubDocKey(DocKey(range_components), PrimitiveValue(sub_key),
+      HybridTime::FromMicros(12345L)).Encode().AsStringRef();
+}
+
+TEST_F(DocKeyTest, TestRangeComponentsKeyMatching) {
+  DocDbAwareRangeFilterPolicy policy(
+      rocksdb::FilterPolicy::kDefaultFixedSizeFilterBits, nullptr, 2 /* num_range_components */);
+  ASSERT_STRNE(policy.Name(), DocDbAwareFilterPolicy(
+      rocksdb::FilterPolicy::kDefaultFixedSizeFilterBits, nullptr).Name());
+
+  std::unique_ptr<FilterBitsBuilder> builder(policy.GetFilterBitsBuilder());
+  ASSERT_NE(builder, nullptr);
+  for (const auto& key : { "foo", "bar", "test" }) {
+    builder->AddKey(policy.GetKeyTransformer()->Transform(EncodeRangeSubDocKey(
+        PrimitiveValues(key, 1, "range_key"), "sub_key")));
+  }
+  builder->AddKey(policy.GetKeyTransformer()->Transform(EncodeSimpleSubDocKey("hashed")));
+  std::unique_ptr<const char[]> buf;
+  rocksdb::Slice filter = builder->Finish(&buf);
+
+  std::unique_ptr<FilterBitsReader> reader(policy.GetFilterBitsReader(filter));
+
+  auto may_match = [&](const std::string& sub_doc_key_str) {
+    return reader->MayMatch(policy.GetKeyTransformer()->Transform(sub_doc_key_str));
+  };
+
+  // Only the first two range components are taken into account.
+  ASSERT_TRUE(may_match(EncodeRangeSubDocKey(PrimitiveValues("foo", 1, "another"), "sub_key")));
+  ASSERT_TRUE(may_match(EncodeRangeSubDocKey(PrimitiveValues("bar", 1, "range_key"), "another")));
+  ASSERT_FALSE(may_match(EncodeRangeSubDocKey(PrimitiveValues("foo", 2, "range_key"), "sub_key")));
+  ASSERT_FALSE(may_match(EncodeRangeSubDocKey(PrimitiveValues("fake", 1, "range_key"), "sub_key")));
+  // Keys with hashed components are still filtered by them.
+  ASSERT_TRUE(may_match(EncodeSimpleSubDocKeyWithDifferentNonHashPart("hashed")));
+  ASSERT_FALSE(may_match(EncodeSimpleSubDocKey("fake")));
+
+  auto encode_doc_key = [](const std::vector<PrimitiveValue>& range_components) {
+    return DocKey(range_components).Encode();
+  };
+  const auto key = encode_doc_key(PrimitiveValues("foo", 1, "range_key"));
+  ASSERT_TRUE(ASSERT_RESULT(RangeComponentsEqual(
+      key, encode_doc_key(PrimitiveValues("foo", 1, "another")), 2)));
+  ASSERT_FALSE(ASSERT_RESULT(RangeComponentsEqual(
+      key, encode_doc_key(PrimitiveValues("foo", 1, "another")), 3)));
+  // Bounds that don't have all filtered components could not use the filter.
+  ASSERT_FALSE(ASSERT_RESULT(RangeComponentsEqual(
+      encode_doc_key(PrimitiveValues("foo")), encode_doc_key(PrimitiveValues("foo")), 2)));
+  const auto lowest = encode_doc_key(
+      {PrimitiveValue("foo"), PrimitiveValue(ValueType::kLowest)});
+  ASSERT_FALSE(ASSERT_RESULT(RangeComponentsEqual(lowest, lowest, 2)));
+
+  ASSERT_TRUE(ASSERT_RESULT(HasAllFilterComponents(key)));
+  ASSERT_TRUE(ASSERT_RESULT(HasAllFilterComponents(EncodeSimpleSubDocKey("foo"))));
+  Slice key_without_group_end = key.AsSlice();
+  key_without_group_end.remove_suffix(1);
+  ASSERT_FALSE(ASSERT_RESULT(HasAllFilterComponents(key_without_group_end)));
+  ASSERT_FALSE(ASSERT_RESULT(HasAllFilterComponents(encode_doc_key({}))));
+}
+
 TEST_F(DocKeyTest, TestWriteId) {
   SubDocKey subdoc_key(DocKey({PrimitiveValue("a"), PrimitiveValue(135)}),
                        DocHybridTime(1000000, 4091, 135));
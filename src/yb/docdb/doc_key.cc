@@ -977,30 +977,74 @@ class HashedComponentsExtractor : public rocksdb::FilterPolicy::KeyTransformer {
   }
 };
 
-} // namespace
+struct RangeFilterKey {
+  // Size of the encoded key prefix that is added to the filter.
+  size_t size;
+  // Whether the prefix has all the range components indexed by the filter.
+  bool complete;
+};
+
+// Decodes the filter key of DocDbAwareRangeFilterPolicy for a key without hashed components, the
+// decoder should be positioned at the range group.
+Result<RangeFilterKey> DecodeRangeFilterKey(
+    const Slice& key, size_t num_range_components, DocKeyDecoder* decoder) {
+  for (size_t i = 0; i != num_range_components; ++i) {
+    // Special values are only used in bounds, so stored keys never have the same filter key.
+    if (decoder->GroupEnded() ||
+        IsSpecialValueType(DecodeValueType(decoder->left_input()))) {
+      return RangeFilterKey{decoder->ConsumedSizeFrom(key.data()), false};
+    }
+    RETURN_NOT_OK(decoder->DecodePrimitiveValue(AllowSpecial::kTrue));
+  }
+  return RangeFilterKey{decoder->ConsumedSizeFrom(key.data()), true};
+}
 
+class RangeComponentsExtractor : public rocksdb::FilterPolicy::KeyTransformer {
+ public:
+  explicit RangeComponentsExtractor(size_t num_range_components)
+      : num_range_components_(num_range_components) {}
+
+  RangeComponentsExtractor(const RangeComponentsExtractor&) = delete;
+  RangeComponentsExtractor& operator=(const RangeComponentsExtractor&) = delete;
+
+  Slice Transform(Slice key) const override {
+    DocKeyDecoder decoder(key);
+    CHECK_OK(decoder.DecodeCotableId());
+    CHECK_OK(decoder.DecodePgtableId());
+    if (CHECK_RESULT(decoder.DecodeHashCode(AllowSpecial::kTrue))) {
+      return HashedComponentsExtractor::GetInstance().Transform(key);
+    }
+    auto filter_key = CHECK_RESULT(DecodeRangeFilterKey(key, num_range_components_, &decoder));
+    return Slice(key.data(), filter_key.size);
+  }
 
-void DocDbAwareFilterPolicy::CreateFilter(
+ private:
+  const size_t num_range_components_;
+};
+
+} // namespace
+
+void DocDbAwareFilterPolicyBase::CreateFilter(
     const rocksdb::Slice* keys, int n, std::string* dst) const {
   CHECK_GT(n, 0);
   return builtin_policy_->CreateFilter(keys, n, dst);
 }
 
-bool DocDbAwareFilterPolicy::KeyMayMatch(
+bool DocDbAwareFilterPolicyBase::KeyMayMatch(
     const rocksdb::Slice& key, const rocksdb::Slice& filter) const {
   return builtin_policy_->KeyMayMatch(key, filter);
 }
 
-rocksdb::FilterBitsBuilder* DocDbAwareFilterPolicy::GetFilterBitsBuilder() const {
+rocksdb::FilterBitsBuilder* DocDbAwareFilterPolicyBase::GetFilterBitsBuilder() const {
   return builtin_policy_->GetFilterBitsBuilder();
 }
 
-rocksdb::FilterBitsReader* DocDbAwareFilterPolicy::GetFilterBitsReader(
+rocksdb::FilterBitsReader* DocDbAwareFilterPolicyBase::GetFilterBitsReader(
     const rocksdb::Slice& contents) const {
   return builtin_policy_->GetFilterBitsReader(contents);
 }
 
-rocksdb::FilterPolicy::FilterType DocDbAwareFilterPolicy::GetFilterType() const {
+rocksdb::FilterPolicy::FilterType DocDbAwareFilterPolicyBase::GetFilterType() const {
   return builtin_policy_->GetFilterType();
 }
 
@@ -1008,6 +1052,22 @@ const rocksdb::FilterPolicy::KeyTransformer* DocDbAwareFilterPolicy::GetKeyTrans
   return &HashedComponentsExtractor::GetInstance();
 }
 
+DocDbAwareRangeFilterPolicy::DocDbAwareRangeFilterPolicy(
+    size_t filter_block_size_bits, rocksdb::Logger* logger, size_t num_range_components)
+    : DocDbAwareFilterPolicyBase(filter_block_size_bits, logger),
+      num_range_components_(num_range_components),
+      name_(Format("DocKeyRangeComponentsFilter$0", num_range_components)),
+      key_transformer_(new RangeComponentsExtractor(num_range_components)) {
+}
+
+DocDbAwareRangeFilterPolicy::~DocDbAwareRangeFilterPolicy() {
+}
+
+const rocksdb::FilterPolicy::KeyTransformer*
+    DocDbAwareRangeFilterPolicy::GetKeyTransformer() const {
+  return key_transformer_.get();
+}
+
 DocKeyEncoderAfterTableIdStep DocKeyEncoder::CotableId(const Uuid& cotable_id) {
   if (!cotable_id.IsNil()) {
     std::string bytes;
@@ -1215,6 +1275,51 @@ Result<bool> HashedComponentsEqual(const Slice& lhs, const Slice& rhs) {
   return rhs_decoder.GroupEnded();
 }
 
+Result<bool> RangeComponentsEqual(
+    const Slice& lhs, const Slice& rhs, size_t num_range_components) {
+  DocKeyDecoder lhs_decoder(lhs);
+  DocKeyDecoder rhs_decoder(rhs);
+  RETURN_NOT_OK(lhs_decoder.DecodeCotableId());
+  RETURN_NOT_OK(rhs_decoder.DecodeCotableId());
+  RETURN_NOT_OK(lhs_decoder.DecodePgtableId());
+  RETURN_NOT_OK(rhs_decoder.DecodePgtableId());
+
+  const bool lhs_hash_present = VERIFY_RESULT(lhs_decoder.DecodeHashCode(AllowSpecial::kTrue));
+  const bool rhs_hash_present = VERIFY_RESULT(rhs_decoder.DecodeHashCode(AllowSpecial::kTrue));
+  if (lhs_hash_present || rhs_hash_present) {
+    return HashedComponentsEqual(lhs, rhs);
+  }
+
+  auto lhs_filter_key = VERIFY_RESULT(
+      DecodeRangeFilterKey(lhs, num_range_components, &lhs_decoder));
+  auto rhs_filter_key = VERIFY_RESULT(
+      DecodeRangeFilterKey(rhs, num_range_components, &rhs_decoder));
+  return lhs_filter_key.complete && rhs_filter_key.complete &&
+         lhs_filter_key.size == rhs_filter_key.size &&
+         strings::memeq(lhs.data(), rhs.data(), lhs_filter_key.size);
+}
+
+Result<bool> HasAllFilterComponents(const Slice& prefix) {
+  DocKeyDecoder decoder(prefix);
+  RETURN_NOT_OK(decoder.DecodeCotableId());
+  RETURN_NOT_OK(decoder.DecodePgtableId());
+  if (VERIFY_RESULT(decoder.DecodeHashCode(AllowSpecial::kTrue))) {
+    return true;
+  }
+
+  // An empty range group is used for intents on the whole table.
+  if (decoder.GroupEnded()) {
+    return false;
+  }
+  while (!decoder.GroupEnded()) {
+    if (IsSpecialValueType(DecodeValueType(decoder.left_input()))) {
+      return false;
+    }
+    RETURN_NOT_OK(decoder.DecodePrimitiveValue(AllowSpecial::kTrue));
+  }
+  return !decoder.left_input().empty();
+}
+
 bool DocKeyBelongsTo(Slice doc_key, const Schema& schema) {
   bool has_table_id = !doc_key.empty() &&
       (doc_key[0] == ValueTypeAsChar::kTableId || doc_key[0] == ValueTypeAsChar::kPgTableOid);
@@ -816,16 +816,15 @@ inline std::ostream& operator <<(std::ostream& out, const SubDocKey& subdoc_key)
 std::string BestEffortDocDBKeyToStr(const KeyBytes &key_bytes);
 std::string BestEffortDocDBKeyToStr(const rocksdb::Slice &slice);
 
-// This filter policy only takes into account hashed components of keys for filtering.
-class DocDbAwareFilterPolicy : public rocksdb::FilterPolicy {
+// Base class for DocDB filter policies. They use the fixed-size bloom filter and only differ by the
+// part of the key that is added to the filter.
+class DocDbAwareFilterPolicyBase : public rocksdb::FilterPolicy {
  public:
-  explicit DocDbAwareFilterPolicy(size_t filter_block_size_bits, rocksdb::Logger* logger) {
+  DocDbAwareFilterPolicyBase(size_t filter_block_size_bits, rocksdb::Logger* logger) {
     builtin_policy_.reset(rocksdb::NewFixedSizeFilterPolicy(
         filter_block_size_bits, rocksdb::FilterPolicy::kDefaultFixedSizeFilterErrorRate, logger));
   }
 
-  const char* Name() const override { return "DocKeyHashedComponentsFilter"; }
-
   void CreateFilter(const rocksdb::Slice* keys, int n, std::string* dst) const override;
 
   bool KeyMayMatch(const rocksdb::Slice& key, const rocksdb::Slice& filter) const override;
@@ -836,12 +835,57 @@ class DocDbAwareFilterPolicy : public rocksdb::FilterPolicy {
 
   FilterType GetFilterType() const override;
 
+ private:
+  std::unique_ptr<const rocksdb::FilterPolicy> builtin_policy_;
+};
+
+// This filter policy only takes into account hashed components of keys for filtering.
+class DocDbAwareFilterPolicy : public DocDbAwareFilterPolicyBase {
+ public:
+  explicit DocDbAwareFilterPolicy(size_t filter_block_size_bits, rocksdb::Logger* logger)
+      : DocDbAwareFilterPolicyBase(filter_block_size_bits, logger) {}
+
+  const char* Name() const override { return "DocKeyHashedComponentsFilter"; }
+
   const KeyTransformer* GetKeyTransformer() const override;
+};
+
+// This filter policy takes into account hashed components of keys that have them, and up to
+// num_range_components leading range components of keys that don't. So lookups on tables with
+// range primary keys could skip SST files as well.
+//
+// The number of range components is a part of the policy name, so files written with a different
+// number are not filtered instead of giving false negatives.
+class DocDbAwareRangeFilterPolicy : public DocDbAwareFilterPolicyBase {
+ public:
+  DocDbAwareRangeFilterPolicy(
+      size_t filter_block_size_bits, rocksdb::Logger* logger, size_t num_range_components);
+
+  ~DocDbAwareRangeFilterPolicy();
+
+  const char* Name() const override { return name_.c_str(); }
+
+  const KeyTransformer* GetKeyTransformer() const override;
+
+  size_t num_range_components() const { return num_range_components_; }
 
  private:
-  std::unique_ptr<const rocksdb::FilterPolicy> builtin_policy_;
+  const size_t num_range_components_;
+  const std::string name_;
+  std::unique_ptr<const KeyTransformer> key_transformer_;
 };
 
+// Returns true if both keys have the same filter key for DocDbAwareRangeFilterPolicy with the given
+// number of range components, and have all of these components. So all keys between lhs and rhs
+// have this filter key as well. Keys with hashed components are compared by HashedComponentsEqual.
+Result<bool> RangeComponentsEqual(
+    const Slice& lhs, const Slice& rhs, size_t num_range_components);
+
+// Returns true if the bloom filter could be used to look up keys starting with the given prefix,
+// whatever DocDB filter policy is used. Prefixes of keys without hashed components should contain
+// the whole range group for that.
+Result<bool> HasAllFilterComponents(const Slice& prefix);
+
 // Optional inclusive lower bound and exclusive upper bound for keys served by DocDB.
 // Could be used to split tablet without doing actual splitting of RocksDB files.
 // DocDBCompactionFilter also respects these bounds, so it will filter out non-relevant keys
@@ -23,6 +23,7 @@
 #include "yb/common/transaction-test-util.h"
 
 #include "yb/docdb/cql_operation.h"
+#include "yb/docdb/docdb.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/docdb_test_base.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
@@ -270,6 +271,101 @@ TEST_F(DocOperationTest, TestRedisSetKVWithTTL) {
   EXPECT_EQ(2000, ttl.ToMilliseconds());
 }
 
+namespace {
+
+constexpr int32_t kSortedSetHashCode = 123;
+const char* const kSortedSetKey = "zset";
+
+void WriteRedis(DocDBRocksDBUtil* util, RedisWriteRequestPB* request, HybridTime hybrid_time) {
+  request->mutable_key_value()->set_key(kSortedSetKey);
+  request->mutable_key_value()->set_type(REDIS_TYPE_SORTEDSET);
+  request->mutable_key_value()->set_hash_code(kSortedSetHashCode);
+  RedisWriteOperation redis_write_operation(request);
+  auto doc_write_batch = util->MakeDocWriteBatch();
+  ASSERT_OK(redis_write_operation.Apply(
+      {&doc_write_batch, CoarseTimePoint::max() /* deadline */, ReadHybridTime::Max()}));
+  ASSERT_OK(util->WriteToRocksDB(doc_write_batch, hybrid_time));
+}
+
+// Adds members with the given scores, members could be repeated.
+void ZAdd(DocDBRocksDBUtil* util, const std::vector<std::pair<double, std::string>>& members,
+          HybridTime hybrid_time) {
+  RedisWriteRequestPB request;
+  request.mutable_set_request();
+  for (const auto& member : members) {
+    request.mutable_key_value()->add_subkey()->set_double_subkey(member.first);
+    request.mutable_key_value()->add_value(member.second);
+  }
+  WriteRedis(util, &request, hybrid_time);
+}
+
+// Removes members, members could be repeated.
+void ZRem(DocDBRocksDBUtil* util, const std::vector<std::string>& members,
+          HybridTime hybrid_time) {
+  RedisWriteRequestPB request;
+  request.mutable_del_request();
+  for (const auto& member : members) {
+    request.mutable_key_value()->add_subkey()->set_string_subkey(member);
+  }
+  WriteRedis(util, &request, hybrid_time);
+}
+
+} // namespace
+
+// Members repeated in one ZADD or ZREM should be counted once in the rank index.
+TEST_F(DocOperationTest, TestRedisSortedSetRankIndexCounts) {
+  int64_t micros = 1000;
+  // Returns the number of members in the root node of the rank index.
+  auto index_size = [this]() -> Result<int64_t> {
+    KeyBytes root_key = DocKey::EncodedFromRedisKey(kSortedSetHashCode, kSortedSetKey);
+    PrimitiveValue(ValueType::kSSRank).AppendToKey(&root_key);
+    PrimitiveValue(std::string()).AppendToKey(&root_key);
+    SubDocument root;
+    bool root_found = false;
+    GetSubDocumentData data = { root_key, &root, &root_found };
+    RETURN_NOT_OK(GetSubDocument(
+        doc_db(), data, rocksdb::kDefaultQueryId, kNonTransactionalOperationContext,
+        CoarseTimePoint::max() /* deadline */));
+    int64_t result = 0;
+    if (root_found && IsObjectType(root.value_type())) {
+      for (const auto& child : root.object_container()) {
+        result += child.second.GetInt64();
+      }
+    }
+    return result;
+  };
+  auto zcard = [this]() -> Result<int64_t> {
+    RedisReadRequestPB request;
+    request.mutable_get_request()->set_request_type(RedisGetRequestPB::ZCARD);
+    request.mutable_key_value()->set_key(kSortedSetKey);
+    request.mutable_key_value()->set_hash_code(kSortedSetHashCode);
+    RedisReadOperation read_op(
+        request, doc_db(), CoarseTimePoint::max() /* deadline */, ReadHybridTime::Max());
+    RETURN_NOT_OK(read_op.Execute());
+    return read_op.response().int_response();
+  };
+  auto check_size = [&](int64_t expected) {
+    ASSERT_EQ(expected, ASSERT_RESULT(zcard()));
+    ASSERT_EQ(expected, ASSERT_RESULT(index_size()));
+  };
+
+  // The last occurrence of a repeated member wins.
+  ZAdd(this, {{1.0, "a"}, {2.0, "b"}, {3.0, "a"}}, HybridTime::FromMicros(++micros));
+  ASSERT_NO_FATALS(check_size(2));
+  ZAdd(this, {{2.0, "c"}, {2.0, "c"}, {5.0, "b"}, {4.0, "b"}}, HybridTime::FromMicros(++micros));
+  ASSERT_NO_FATALS(check_size(3));
+
+  // Repeated and missing members are removed once.
+  ZRem(this, {"a", "a", "x"}, HybridTime::FromMicros(++micros));
+  ASSERT_NO_FATALS(check_size(2));
+  ZAdd(this, {{2.0, "a"}, {2.0, "b"}}, HybridTime::FromMicros(++micros));
+  ASSERT_NO_FATALS(check_size(3));
+  ZRem(this, {"b", "c", "c", "b"}, HybridTime::FromMicros(++micros));
+  ASSERT_NO_FATALS(check_size(1));
+  ZRem(this, {"a", "a"}, HybridTime::FromMicros(++micros));
+  ASSERT_NO_FATALS(check_size(0));
+}
+
 TEST_F(DocOperationTest, TestQLInsertWithTTL) {
   RunTestQLInsertUpdate(QLWriteRequestPB_QLStmtType_QL_STMT_INSERT, 2000);
 }
@@ -15,6 +15,7 @@
 
 #include "yb/common/partition.h"
 #include "yb/common/transaction.h"
+#include "yb/common/ql_row_batch.h"
 #include "yb/common/ql_scanspec.h"
 #include "yb/common/ql_value.h"
 
@@ -505,6 +506,7 @@ Status DocRowwiseIterator::Init() {
   row_key_ = iter_key_;
   row_hash_key_ = row_key_;
   VLOG(3) << __PRETTY_FUNCTION__ << " Seeking to " << row_key_;
+  db_iter_->PrepareForwardScan(row_key_);
   db_iter_->Seek(row_key_);
   row_ready_ = false;
   has_bound_key_ = false;
@@ -557,9 +559,12 @@ Status DocRowwiseIterator::DoInit(const T& doc_spec) {
           << ", " << DocKey::DebugSliceToString(upper_doc_key.AsSlice());
 
   // TODO(bogdan): decide if this is a good enough heuristic for using blooms for scans.
+  const auto bloom_filter_range_components = BloomFilterRangeComponents(schema_);
   const bool is_fixed_point_get =
       !lower_doc_key.empty() &&
-      VERIFY_RESULT(HashedComponentsEqual(lower_doc_key, upper_doc_key));
+      VERIFY_RESULT(bloom_filter_range_components > 0
+          ? RangeComponentsEqual(lower_doc_key, upper_doc_key, bloom_filter_range_components)
+          : HashedComponentsEqual(lower_doc_key, upper_doc_key));
   const auto mode = is_fixed_point_get ? BloomFilterMode::USE_BLOOM_FILTER
                                        : BloomFilterMode::DONT_USE_BLOOM_FILTER;
 
@@ -585,6 +590,9 @@ Status DocRowwiseIterator::DoInit(const T& doc_spec) {
   if (!VERIFY_RESULT(InitScanChoices(doc_spec, lower_doc_key, upper_doc_key))) {
     if (is_forward_scan_) {
       VLOG(3) << __PRETTY_FUNCTION__ << " Seeking to " << DocKey::DebugSliceToString(lower_doc_key);
+      if (!is_fixed_point_get) {
+        db_iter_->PrepareForwardScan(lower_doc_key);
+      }
       db_iter_->Seek(lower_doc_key);
     } else {
       // TODO consider adding an operator bool to DocKey to use instead of empty() here.
@@ -767,6 +775,79 @@ CHECKED_STATUS SetQLPrimaryKeyColumnValues(const Schema& schema,
   return decoder->ConsumeGroupEnd();
 }
 
+int64_t GetBatchIntValue(const PrimitiveValue& primitive_value, DataType data_type) {
+  // Should match conversions done by PrimitiveValue::ToQLValuePB.
+  switch (data_type) {
+    case INT8:
+      return static_cast<int8_t>(primitive_value.GetInt32());
+    case INT16:
+      return static_cast<int16_t>(primitive_value.GetInt32());
+    case INT32:
+      return primitive_value.GetInt32();
+    case INT64: FALLTHROUGH_INTENDED;
+    case TIME:
+      return primitive_value.GetInt64();
+    case BOOL:
+      return primitive_value.value_type() == ValueType::kTrue ||
+             primitive_value.value_type() == ValueType::kTrueDescending;
+    case TIMESTAMP:
+      return primitive_value.GetTimestamp().ToInt64();
+    case DATE:
+      return primitive_value.GetUInt32();
+    default:
+      break;
+  }
+  LOG(DFATAL) << "Unexpected integer column type: " << data_type;
+  return 0;
+}
+
+// Stores the primitive value into the given column of the batch row. Null values are skipped,
+// since all columns of a new batch row are null.
+void SetBatchPrimitiveValue(const PrimitiveValue& primitive_value,
+                            const size_t column,
+                            const size_t row,
+                            QLRowBatch* batch) {
+  if (primitive_value.value_type() == ValueType::kNullLow ||
+      primitive_value.value_type() == ValueType::kNullHigh ||
+      primitive_value.value_type() == ValueType::kInvalid) {
+    return;
+  }
+  const auto& ql_type = batch->column_type(column);
+  switch (batch->column_kind(column)) {
+    case QLRowBatch::ColumnKind::kInt:
+      batch->SetInt(column, row, GetBatchIntValue(primitive_value, ql_type->main()));
+      return;
+    case QLRowBatch::ColumnKind::kString:
+      batch->SetString(column, row, primitive_value.GetString());
+      return;
+    case QLRowBatch::ColumnKind::kValue:
+      PrimitiveValue::ToQLValuePB(primitive_value, ql_type, batch->mutable_value(column, row));
+      return;
+  }
+}
+
+CHECKED_STATUS SetBatchPrimaryKeyColumnValues(const Schema& schema,
+                                              const size_t begin_index,
+                                              const size_t column_count,
+                                              const char* column_type,
+                                              DocKeyDecoder* decoder,
+                                              const size_t row,
+                                              QLRowBatch* batch) {
+  if (begin_index + column_count > schema.num_columns()) {
+    return STATUS_SUBSTITUTE(
+        Corruption,
+        "$0 primary key columns between positions $1 and $2 go beyond table columns $3",
+        column_type, begin_index, begin_index + column_count - 1, schema.num_columns());
+  }
+  PrimitiveValue primitive_value;
+  for (size_t i = 0, j = begin_index; i < column_count; i++, j++) {
+    RETURN_NOT_OK(decoder->DecodePrimitiveValue(&primitive_value));
+    // Key columns are the first columns of the batch, in the schema order.
+    SetBatchPrimitiveValue(primitive_value, j, row, batch);
+  }
+  return decoder->ConsumeGroupEnd();
+}
+
 } // namespace
 
 void DocRowwiseIterator::SkipRow() {
@@ -836,6 +917,60 @@ Status DocRowwiseIterator::DoNextRow(const Schema& projection, QLTableRow* table
   return Status::OK();
 }
 
+Result<size_t> DocRowwiseIterator::NextBatch(
+    const Schema& projection, size_t max_rows, QLRowBatch* batch) {
+  DCHECK_EQ(batch->num_columns(),
+            schema_.num_key_columns() + projection.num_columns() - projection.num_key_columns());
+
+  size_t num_rows = 0;
+  while (num_rows < max_rows && VERIFY_RESULT(HasNext())) {
+    RETURN_NOT_OK(NextBatchRow(projection, batch));
+    ++num_rows;
+  }
+  return num_rows;
+}
+
+Status DocRowwiseIterator::NextBatchRow(const Schema& projection, QLRowBatch* batch) {
+  const size_t row = batch->AddRow();
+
+  DocKeyDecoder decoder(row_key_);
+  RETURN_NOT_OK(decoder.DecodeCotableId());
+  RETURN_NOT_OK(decoder.DecodePgtableId());
+  bool has_hash_components = VERIFY_RESULT(decoder.DecodeHashCode());
+
+  if (has_hash_components) {
+    RETURN_NOT_OK(SetBatchPrimaryKeyColumnValues(
+        schema_, 0, schema_.num_hash_key_columns(), "hash", &decoder, row, batch));
+  }
+  if (!decoder.GroupEnded()) {
+    RETURN_NOT_OK(SetBatchPrimaryKeyColumnValues(
+        schema_, schema_.num_hash_key_columns(), schema_.num_range_key_columns(),
+        "range", &decoder, row, batch));
+  }
+
+  // Non-key columns follow the key columns in the batch, in the projection order.
+  size_t column = schema_.num_key_columns();
+  for (size_t i = projection.num_key_columns(); i < projection.num_columns(); i++, column++) {
+    const SubDocument* column_value = row_.GetChild(PrimitiveValue(projection.column_id(i)));
+    if (column_value == nullptr) {
+      continue;
+    }
+    if (batch->column_kind(column) == QLRowBatch::ColumnKind::kValue) {
+      SubDocument::ToQLValuePB(
+          *column_value, batch->column_type(column), batch->mutable_value(column, row));
+    } else {
+      SetBatchPrimitiveValue(*column_value, column, row, batch);
+    }
+    batch->SetTtl(column, row, column_value->GetTtl());
+    if (column_value->IsWriteTimeSet()) {
+      batch->SetWriteTime(column, row, column_value->GetWriteTime());
+    }
+  }
+
+  row_ready_ = false;
+  return Status::OK();
+}
+
 bool DocRowwiseIterator::LivenessColumnExists() const {
   const SubDocument* subdoc = row_.GetChild(
       PrimitiveValue::SystemColumnId(SystemColumnIds::kLivenessColumn));
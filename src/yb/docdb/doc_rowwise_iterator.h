@@ -110,6 +110,12 @@ class DocRowwiseIterator : public common::YQLRowwiseIteratorIf {
   // Retrieves the next key to read after the iterator finishes for the given page.
   CHECKED_STATUS GetNextReadSubDocKey(SubDocKey* sub_doc_key) const override;
 
+  // Reads up to max_rows next rows into the columnar batch, which should be created for the table
+  // schema and the same projection. Values are decoded directly into the batch columns without
+  // building a QLTableRow per row.
+  Result<size_t> NextBatch(
+      const Schema& projection, size_t max_rows, QLRowBatch* batch) override;
+
  private:
   template <class T>
   CHECKED_STATUS DoInit(const T& spec);
@@ -157,6 +163,9 @@ class DocRowwiseIterator : public common::YQLRowwiseIteratorIf {
   // Read next row into a value map using the specified projection.
   CHECKED_STATUS DoNextRow(const Schema& projection, QLTableRow* table_row) override;
 
+  // Read next row into a new row of the batch using the specified projection.
+  CHECKED_STATUS NextBatchRow(const Schema& projection, QLRowBatch* batch);
+
   const Schema& projection_;
   // Used to maintain ownership of projection_.
   // Separate field is used since ownership could be optional.
@@ -16,6 +16,9 @@
 #include <thread>
 #include <memory>
 
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/optional.hpp>
+
 #include "yb/common/transaction.h"
 
 #include "yb/rocksdb/memtablerep.h"
@@ -105,6 +108,60 @@ DEFINE_int32(num_reserved_small_compaction_threads, -1, "Number of reserved smal
 
 DEFINE_bool(enable_ondisk_compression, true,
             "Determines whether SSTable compression is enabled or not.");
+DEFINE_string(rocksdb_compression_type, "snappy",
+              "Compression type of SSTables: none, snappy, zlib, lz4, lz4hc or zstd. "
+              "Types that are not supported by this build, e.g. zstd in builds without zstd, "
+              "are rejected.");
+DEFINE_string(rocksdb_large_compaction_output_compression_type, "zlib",
+              "Compression type of compaction outputs that are at least "
+              "rocksdb_large_compaction_output_threshold_bytes large: none, snappy, zlib, lz4, "
+              "lz4hc or zstd. Types that are not supported by this build are rejected.");
+DEFINE_uint64(rocksdb_large_compaction_output_threshold_bytes, 0,
+              "Compaction outputs of at least this size are compressed with "
+              "rocksdb_large_compaction_output_compression_type. 0 - use "
+              "rocksdb_compression_type for all outputs.");
+
+namespace {
+
+const std::pair<const char*, rocksdb::CompressionType> kCompressionTypes[] = {
+  { "none", rocksdb::kNoCompression },
+  { "snappy", rocksdb::kSnappyCompression },
+  { "zlib", rocksdb::kZlibCompression },
+  { "lz4", rocksdb::kLZ4Compression },
+  { "lz4hc", rocksdb::kLZ4HCCompression },
+  { "zstd", rocksdb::kZSTD },
+};
+
+// Returns compression type with specified name, or none if the name is unknown.
+boost::optional<rocksdb::CompressionType> CompressionTypeByName(const std::string& name) {
+  for (const auto& entry : kCompressionTypes) {
+    if (boost::iequals(name, entry.first)) {
+      return entry.second;
+    }
+  }
+  return boost::none;
+}
+
+bool ValidateCompressionType(const char* flagname, const std::string& value) {
+  const auto type = CompressionTypeByName(value);
+  if (!type) {
+    LOG(ERROR) << "Unknown compression type " << value << " for " << flagname;
+    return false;
+  }
+  if (!rocksdb::CompressionTypeSupported(*type)) {
+    LOG(ERROR) << "Compression type " << value << " for " << flagname
+               << " is not supported by this build";
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+__attribute__((unused))
+DEFINE_validator(rocksdb_compression_type, &ValidateCompressionType);
+__attribute__((unused))
+DEFINE_validator(rocksdb_large_compaction_output_compression_type, &ValidateCompressionType);
 
 DEFINE_int32(priority_thread_pool_size, -1,
              "Max running workers in compaction thread pool. "
@@ -372,6 +429,19 @@ rocksdb::InternalIterator* WrapIterator(
   return iterator;
 }
 
+// Returns compression type with specified name, or fallback if it is unknown or not supported.
+// Flag validators reject such names, so the fallback is used only if validation was bypassed.
+rocksdb::CompressionType CompressionTypeFromName(
+    const std::string& name, rocksdb::CompressionType fallback) {
+  const auto type = CompressionTypeByName(name);
+  if (type && rocksdb::CompressionTypeSupported(*type)) {
+    return *type;
+  }
+  LOG_FIRST_N(WARNING, 1) << "Compression type " << name << " is not supported, using "
+                          << rocksdb::CompressionTypeToString(fallback);
+  return fallback;
+}
+
 } // namespace
 
 void InitRocksDBOptions(
@@ -403,8 +473,11 @@ void InitRocksDBOptions(
     options->num_reserved_small_compaction_threads = FLAGS_num_reserved_small_compaction_threads;
   }
 
-  options->compression = rocksdb::Snappy_Supported() && FLAGS_enable_ondisk_compression
+  const auto default_compression = rocksdb::Snappy_Supported()
       ? rocksdb::kSnappyCompression : rocksdb::kNoCompression;
+  options->compression = FLAGS_enable_ondisk_compression
+      ? CompressionTypeFromName(FLAGS_rocksdb_compression_type, default_compression)
+      : rocksdb::kNoCompression;
 
   options->listeners.insert(
       options->listeners.end(), tablet_options.listeners.begin(),
@@ -414,6 +487,7 @@ void InitRocksDBOptions(
   rocksdb::BlockBasedTableOptions table_options;
   if (tablet_options.block_cache) {
     table_options.block_cache = tablet_options.block_cache;
+    table_options.block_cache_compressed = tablet_options.block_cache_compressed;
     // Cache the bloom filters in the block cache.
     table_options.cache_index_and_filter_blocks = true;
   } else {
@@ -465,6 +539,13 @@ void InitRocksDBOptions(
         FLAGS_rocksdb_universal_compaction_always_include_size_threshold;
     options->compaction_options_universal.min_merge_width =
         FLAGS_rocksdb_universal_compaction_min_merge_width;
+    if (FLAGS_enable_ondisk_compression &&
+        FLAGS_rocksdb_large_compaction_output_threshold_bytes > 0) {
+      options->compaction_options_universal.large_output_compression_threshold =
+          FLAGS_rocksdb_large_compaction_output_threshold_bytes;
+      options->compaction_options_universal.large_output_compression = CompressionTypeFromName(
+          FLAGS_rocksdb_large_compaction_output_compression_type, options->compression);
+    }
     options->compaction_size_threshold_bytes = FLAGS_rocksdb_compaction_size_threshold_bytes;
     if (FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec > 0) {
       options->rate_limiter.reset(
@@ -488,6 +569,27 @@ void InitRocksDBOptions(
   options->iterator_replacer = std::make_shared<rocksdb::IteratorReplacer>(&WrapIterator);
 }
 
+size_t BloomFilterRangeComponents(const Schema& schema) {
+  // Tables sharing a tablet could have different settings, while the filter is per tablet.
+  if (!FLAGS_use_docdb_aware_bloom_filter || schema.num_hash_key_columns() > 0 ||
+      schema.has_cotable_id() || schema.pgtable_id() > 0) {
+    return 0;
+  }
+  const auto value = schema.table_properties().bloom_filter_range_components();
+  return value > 0 ? std::min<size_t>(value, schema.num_range_key_columns()) : 0;
+}
+
+void SetBloomFilterRangeComponents(rocksdb::Options* options, size_t num_range_components) {
+  if (num_range_components == 0 || !FLAGS_use_docdb_aware_bloom_filter) {
+    return;
+  }
+  auto table_options = *static_cast<rocksdb::BlockBasedTableOptions*>(
+      options->table_factory->GetOptions());
+  table_options.filter_policy = std::make_shared<DocDbAwareRangeFilterPolicy>(
+      table_options.filter_block_size * 8, options->info_log.get(), num_range_components);
+  options->table_factory.reset(rocksdb::NewBlockBasedTableFactory(table_options));
+}
+
 void SetLogPrefix(rocksdb::Options* options, const std::string& log_prefix) {
   options->log_prefix = log_prefix;
   options->info_log = std::make_shared<YBRocksDBLogger>(options->log_prefix);
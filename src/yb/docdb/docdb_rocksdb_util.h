@@ -113,6 +113,17 @@ void InitRocksDBOptions(
     const std::shared_ptr<rocksdb::Statistics>& statistics,
     const tablet::TabletOptions& tablet_options);
 
+// Returns the number of leading range components that the bloom filter indexes for the table with
+// the given schema. 0 means that keys are only indexed by their hashed components.
+// Only non-colocated tables without hash columns qualify, i.e. YSQL tables created with a range
+// primary key and the bloom_filter_range_components storage parameter. YCQL tables always have
+// hash columns, so the YCQL table property is accepted but has no effect.
+size_t BloomFilterRangeComponents(const Schema& schema);
+
+// Makes the bloom filter set up by InitRocksDBOptions index the given number of leading range
+// components of keys without hashed components, see DocDbAwareRangeFilterPolicy.
+void SetBloomFilterRangeComponents(rocksdb::Options* options, size_t num_range_components);
+
 // Sets logs prefix for RocksDB options. This will also reinitialize options->info_log.
 void SetLogPrefix(rocksdb::Options* options, const std::string& log_prefix);
 
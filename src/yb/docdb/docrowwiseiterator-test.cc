@@ -14,6 +14,7 @@
 #include <memory>
 #include <string>
 
+#include "yb/common/ql_row_batch.h"
 #include "yb/common/ql_value.h"
 #include "yb/common/transaction-test-util.h"
 
@@ -30,6 +31,7 @@
 #include "yb/util/test_util.h"
 
 DECLARE_bool(docdb_sort_weak_intents_in_tests);
+DECLARE_bool(skip_intents_for_scan_range_without_intents);
 
 namespace yb {
 namespace docdb {
@@ -1059,5 +1061,196 @@ TEST_F(DocRowwiseIteratorTest, ScanWithinTheSameTxn) {
   ASSERT_FALSE(ASSERT_RESULT(iter.HasNext()));
 }
 
+TEST_F(DocRowwiseIteratorTest, NextBatchAndFilter) {
+  ASSERT_OK(SetPrimitive(
+      DocPath(kEncodedDocKey1, PrimitiveValue(30_ColId)),
+      PrimitiveValue("row1_c"), HybridTime::FromMicros(1000)));
+  ASSERT_OK(SetPrimitive(
+      DocPath(kEncodedDocKey1, PrimitiveValue(40_ColId)),
+      PrimitiveValue(10000), HybridTime::FromMicros(1000)));
+  ASSERT_OK(SetPrimitive(
+      DocPath(kEncodedDocKey2, PrimitiveValue(40_ColId)),
+      PrimitiveValue(30000), HybridTime::FromMicros(2000)));
+  ASSERT_OK(SetPrimitive(
+      DocPath(kEncodedDocKey2, PrimitiveValue(50_ColId)),
+      PrimitiveValue("row2_e"), HybridTime::FromMicros(2000)));
+
+  const Schema &schema = kSchemaForIteratorTests;
+  const Schema &projection = kProjectionForIteratorTests;
+
+  DocRowwiseIterator iter(
+      projection, schema, kNonTransactionalOperationContext, doc_db(),
+      CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(3000));
+  ASSERT_OK(iter.Init());
+
+  QLRowBatch batch(schema, projection);
+  ASSERT_EQ(5, batch.num_columns());
+  ASSERT_EQ(1, ASSERT_RESULT(iter.NextBatch(projection, 1, &batch)));
+  ASSERT_EQ(1, ASSERT_RESULT(iter.NextBatch(projection, 10, &batch)));
+  ASSERT_EQ(0, ASSERT_RESULT(iter.NextBatch(projection, 10, &batch)));
+  ASSERT_EQ(2, batch.num_rows());
+
+  // WHERE d > 20000 AND c IS NULL
+  QLConditionPB condition;
+  condition.set_op(QL_OP_AND);
+  auto* greater = condition.add_operands()->mutable_condition();
+  greater->set_op(QL_OP_GREATER_THAN);
+  greater->add_operands()->set_column_id(40);
+  greater->add_operands()->mutable_value()->set_int64_value(20000);
+  auto* is_null = condition.add_operands()->mutable_condition();
+  is_null->set_op(QL_OP_IS_NULL);
+  is_null->add_operands()->set_column_id(30);
+
+  ASSERT_TRUE(batch.CanFilter(condition));
+  batch.Filter(condition);
+  ASSERT_EQ(std::vector<size_t>{1}, batch.selection());
+
+  QLTableRow row;
+  QLValue value;
+  batch.GetRow(batch.selection()[0], &row);
+
+  ASSERT_OK(row.GetValue(schema.column_id(0), &value));
+  ASSERT_EQ("row2", value.string_value());
+  ASSERT_OK(row.GetValue(schema.column_id(1), &value));
+  ASSERT_EQ(22222, value.int64_value());
+  ASSERT_OK(row.GetValue(projection.column_id(0), &value));
+  ASSERT_TRUE(value.IsNull());
+  ASSERT_OK(row.GetValue(projection.column_id(1), &value));
+  ASSERT_EQ(30000, value.int64_value());
+  ASSERT_OK(row.GetValue(projection.column_id(2), &value));
+  ASSERT_EQ("row2_e", value.string_value());
+
+  // Values of a different type are not comparable and should be left to row by row evaluation.
+  greater->mutable_operands(1)->mutable_value()->set_string_value("20000");
+  ASSERT_FALSE(batch.CanFilter(condition));
+}
+
+// Checks that intents are not skipped when the only intent affecting the scan range is written for
+// a prefix of the lower bound, i.e. a row tombstone below a lower bound that points inside the row.
+TEST_F(DocRowwiseIteratorTest, SkipIntentsWithPrefixIntentBelowLowerBound) {
+  SetTransactionIsolationLevel(IsolationLevel::SNAPSHOT_ISOLATION);
+  FLAGS_skip_intents_for_scan_range_without_intents = true;
+
+  ASSERT_OK(SetPrimitive(
+      DocPath(kEncodedDocKey1, PrimitiveValue(30_ColId)),
+      PrimitiveValue("row1_c"), HybridTime::FromMicros(300)));
+  ASSERT_OK(SetPrimitive(
+      DocPath(kEncodedDocKey1, PrimitiveValue(40_ColId)),
+      PrimitiveValue(10000), HybridTime::FromMicros(300)));
+  ASSERT_OK(SetPrimitive(
+      DocPath(kEncodedDocKey2, PrimitiveValue(30_ColId)),
+      PrimitiveValue("row2_c"), HybridTime::FromMicros(300)));
+
+  TransactionStatusManagerMock txn_status_manager;
+  Result<TransactionId> txn = FullyDecodeTransactionId("0000000000000001");
+  ASSERT_OK(txn);
+
+  // Delete row1 within the transaction.
+  SetCurrentTransactionId(*txn);
+  ASSERT_OK(DeleteSubDoc(DocPath(kEncodedDocKey1), HybridTime::FromMicros(500)));
+  ResetCurrentTransactionId();
+
+  LOG(INFO) << "Dump:\n" << DocDBDebugDumpToStr();
+
+  const auto txn_context = TransactionOperationContext(*txn, &txn_status_manager);
+
+  {
+    // Row tombstone intent is below the lower bound, but still applies to the scanned keys.
+    IntentAwareIterator iter(
+        doc_db(), rocksdb::ReadOptions(), CoarseTimePoint::max() /* deadline */,
+        ReadHybridTime::FromMicros(1000), txn_context);
+    const KeyBytes lower_bound(
+        SubDocKey(DocKey(PrimitiveValues("row1", 11111)), PrimitiveValue(40_ColId)).Encode());
+    iter.PrepareForwardScan(lower_bound);
+    ASSERT_TRUE(iter.intents_used());
+
+    iter.Seek(kEncodedDocKey1);
+    ASSERT_TRUE(iter.valid());
+    auto key_data = ASSERT_RESULT(iter.FetchKey());
+    SubDocKey subdoc_key;
+    ASSERT_OK(subdoc_key.FullyDecodeFrom(key_data.key, HybridTimeRequired::kFalse));
+    ASSERT_EQ(subdoc_key.ToString(), R"#(SubDocKey(DocKey([], ["row1", 11111]), []))#");
+    ASSERT_TRUE(key_data.same_transaction);
+    ASSERT_EQ(key_data.write_time.hybrid_time(), HybridTime::FromMicros(500));
+  }
+
+  {
+    // There are no intents starting from row2, so they are skipped.
+    IntentAwareIterator iter(
+        doc_db(), rocksdb::ReadOptions(), CoarseTimePoint::max() /* deadline */,
+        ReadHybridTime::FromMicros(1000), txn_context);
+    iter.PrepareForwardScan(kEncodedDocKey2);
+    ASSERT_FALSE(iter.intents_used());
+
+    iter.Seek(kEncodedDocKey2);
+    ASSERT_TRUE(iter.valid());
+    auto key_data = ASSERT_RESULT(iter.FetchKey());
+    SubDocKey subdoc_key;
+    ASSERT_OK(subdoc_key.FullyDecodeFrom(key_data.key, HybridTimeRequired::kFalse));
+    ASSERT_EQ(subdoc_key.ToString(), R"#(SubDocKey(DocKey([], ["row2", 22222]), [ColumnId(30)]))#");
+    ASSERT_EQ(key_data.write_time.hybrid_time(), HybridTime::FromMicros(300));
+  }
+
+  {
+    // Scan within the transaction should not see the deleted row.
+    DocRowwiseIterator iter(
+        kProjectionForIteratorTests, kSchemaForIteratorTests, txn_context, doc_db(),
+        CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(1000));
+    ASSERT_OK(iter.Init());
+
+    QLTableRow row;
+    QLValue value;
+    ASSERT_TRUE(ASSERT_RESULT(iter.HasNext()));
+    ASSERT_OK(iter.NextRow(&row));
+    ASSERT_OK(row.GetValue(kProjectionForIteratorTests.column_id(0), &value));
+    ASSERT_EQ("row2_c", value.string_value());
+    ASSERT_FALSE(ASSERT_RESULT(iter.HasNext()));
+  }
+}
+
+// Compares transactional full scan throughput over a range that does not have any intents, with
+// and without skipping of intents DB lookups.
+TEST_F(DocRowwiseIteratorTest, ScanWithoutIntentsPerformance) {
+  const int kNumRows = AllowSlowTests() ? 100000 : 5000;
+  const int kNumIterations = 3;
+
+  for (int i = 0; i != kNumRows; ++i) {
+    const KeyBytes encoded_doc_key(DocKey(PrimitiveValues(Format("row$0", i), i)).Encode());
+    ASSERT_OK(SetPrimitive(
+        DocPath(encoded_doc_key, PrimitiveValue(30_ColId)),
+        PrimitiveValue(Format("row$0_c", i)), HybridTime::FromMicros(1000)));
+    ASSERT_OK(SetPrimitive(
+        DocPath(encoded_doc_key, PrimitiveValue(40_ColId)),
+        PrimitiveValue(i), HybridTime::FromMicros(1000)));
+  }
+
+  TransactionStatusManagerMock txn_status_manager;
+  Result<TransactionId> txn = FullyDecodeTransactionId("0000000000000001");
+  ASSERT_OK(txn);
+  const auto txn_context = TransactionOperationContext(*txn, &txn_status_manager);
+
+  for (bool skip_intents : {false, true}) {
+    FLAGS_skip_intents_for_scan_range_without_intents = skip_intents;
+    MonoDelta total_time = MonoDelta::kZero;
+    for (int iteration = 0; iteration != kNumIterations; ++iteration) {
+      DocRowwiseIterator iter(
+          kProjectionForIteratorTests, kSchemaForIteratorTests, txn_context, doc_db(),
+          CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(2000));
+      QLTableRow row;
+      int num_rows = 0;
+      auto start = MonoTime::Now();
+      ASSERT_OK(iter.Init());
+      while (ASSERT_RESULT(iter.HasNext())) {
+        ASSERT_OK(iter.NextRow(&row));
+        ++num_rows;
+      }
+      total_time += MonoTime::Now() - start;
+      ASSERT_EQ(kNumRows, num_rows);
+    }
+    LOG(INFO) << "Skip intents: " << skip_intents << ", rows/sec: "
+              << kNumRows * kNumIterations / total_time.ToSeconds();
+  }
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -37,6 +37,10 @@ using namespace std::literals;
 DEFINE_bool(transaction_allow_rerequest_status_in_tests, true,
             "Allow rerequest transaction status when try again is received.");
 
+DEFINE_bool(skip_intents_for_scan_range_without_intents, false,
+            "Do not look up intents during a forward scan if intents DB does not have any keys "
+            "in the scanned range.");
+
 namespace yb {
 namespace docdb {
 
@@ -269,6 +273,53 @@ IntentAwareIterator::IntentAwareIterator(
   iter_ = BoundedRocksDbIterator(doc_db.regular, read_opts, doc_db.key_bounds);
 }
 
+void IntentAwareIterator::PrepareForwardScan(const Slice& lower_bound) {
+  if (!intent_iter_.Initialized() || !FLAGS_skip_intents_for_scan_range_without_intents) {
+    return;
+  }
+
+  // Intents written for a prefix of a key in the scan range, like a row tombstone or a static
+  // column of the hash key, are located before lower_bound when it points inside the document.
+  // So look for intents starting from the hash part of the lower bound document key, or from its
+  // whole document key when there is no hash part.
+  Slice probe_start;
+  if (!lower_bound.empty()) {
+    auto sizes = DocKey::EncodedHashPartAndDocKeySizes(lower_bound, AllowSpecial::kTrue);
+    if (sizes.ok()) {
+      probe_start = Slice(lower_bound.data(), sizes->first != 0 ? sizes->first : sizes->second);
+    }
+  }
+
+  ResetIntentUpperbound();
+  ROCKSDB_SEEK(&intent_iter_, probe_start);
+  if (intent_iter_.Valid() && intent_iter_.key()[0] == ValueTypeAsChar::kTransactionId) {
+    // Skip transaction metadata and reverse index region.
+    static const std::array<char, 1> kAfterTransactionId{ValueTypeAsChar::kTransactionId + 1};
+    static const Slice kAfterTxnRegion(kAfterTransactionId);
+    intent_iter_.Seek(kAfterTxnRegion);
+  }
+  if (!intent_iter_.status().ok()) {
+    status_ = intent_iter_.status();
+    return;
+  }
+  if (intent_iter_.Valid()) {
+    // Upperbound is compared with the key the intent is written for, not with the intent key that
+    // has intent types and hybrid time appended.
+    auto decoded_intent = DecodeIntentKey(intent_iter_.key());
+    if (!decoded_intent.ok() || SatisfyBounds(decoded_intent->intent_prefix)) {
+      VLOG(4) << "Found intent in scan range: " << DebugIntentKeyToString(intent_iter_.key());
+      return;
+    }
+  }
+
+  VLOG(4) << "No intents in scan range starting at "
+          << SubDocKey::DebugSliceToString(lower_bound) << ", ignoring intents";
+  intent_iter_ = BoundedRocksDbIterator();
+  seek_intent_iter_needed_ = SeekIntentIterNeeded::kNoNeed;
+  skip_future_intents_needed_ = false;
+  resolved_intent_state_ = ResolvedIntentState::kNoIntent;
+}
+
 void IntentAwareIterator::Seek(const DocKey &doc_key) {
   Seek(doc_key.Encode());
 }
@@ -173,6 +173,18 @@ class IntentAwareIterator {
     upperbound_ = upperbound;
   }
 
+  // Prepares iterator for forward scan of keys starting from lower_bound up to the upperbound set
+  // by SetUpperbound (if any). Should be called before the first seek.
+  // If intents DB does not have any keys in this range, intents are ignored for the rest of the
+  // scan, so it does not pay for seeking and checking the intent iterator on each key.
+  // It is safe, because intent iterator works on the snapshot taken at iterator creation.
+  void PrepareForwardScan(const Slice& lower_bound);
+
+  // Whether intents DB is consulted by this iterator.
+  bool intents_used() const {
+    return intent_iter_.Initialized();
+  }
+
   void DebugDump();
 
  private:
@@ -13,6 +13,10 @@
 
 #include "yb/docdb/redis_operation.h"
 
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+
 #include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/doc_write_batch.h"
 #include "yb/docdb/doc_write_batch_cache.h"
@@ -20,6 +24,8 @@
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/subdocument.h"
 
+#include "yb/util/flag_tags.h"
+#include "yb/util/kv_util.h"
 #include "yb/util/stol_utils.h"
 #include "yb/util/redis_util.h"
 
@@ -30,6 +36,15 @@ DEFINE_bool(emulate_redis_responses,
     "and HDEL. If emulate_redis_responses is true, we read the required records to compute the "
     "response as specified by the official Redis API documentation. https://redis.io/commands");
 
+DEFINE_bool(redis_sorted_set_rank_index,
+    true,
+    "Maintain the rank index for sorted sets that are created or empty when this flag is set. "
+    "The index lets ZRANGE, ZREVRANGE, ZRANK, ZREVRANK and ZCOUNT find members by rank or score "
+    "without iterating over the members that precede them. The index counts members by score "
+    "only, so members that share a score with the requested rank or member are still iterated. "
+    "Sets that already have the index keep maintaining it regardless of this flag.");
+TAG_FLAG(redis_sorted_set_rank_index, advanced);
+
 namespace yb {
 namespace docdb {
 
@@ -484,6 +499,330 @@ void GetNormalizedBounds(int64 low_idx, int64 high_idx, int64 card, bool reverse
   }
 }
 
+// Rank index of a sorted set.
+//
+// Scores are encoded to kSortedSetRankKeySize bytes that sort in the same order as scores of the
+// forward mapping. For each proper prefix of an encoded score the index stores the number of
+// members whose encoded score starts with this prefix followed by a particular byte, i.e.
+// kSSRank -> prefix -> next byte -> number of members.
+// So the number of members below a score, or the score of the member at a given rank, is found by
+// reading at most kSortedSetRankKeySize nodes of at most 256 entries, regardless of the set size.
+// Counts that drop to zero are deleted, so the root node is empty when the set is empty or when
+// the set was created without the index.
+class SortedSetRankIndex {
+ public:
+  SortedSetRankIndex(IntentAwareIterator* iterator, const RedisKeyValuePB& kv,
+                     DeadlineInfo* deadline_info = nullptr)
+      : iterator_(iterator),
+        encoded_key_(DocKey::EncodedFromRedisKey(kv.hash_code(), kv.key())),
+        deadline_info_(deadline_info) {
+    PrimitiveValue(ValueType::kSSRank).AppendToKey(&encoded_key_);
+  }
+
+  // Returns true if the index is maintained for this set.
+  Result<bool> Exists() {
+    const Node* root = VERIFY_RESULT(ReadNode(std::string()));
+    return !root->empty();
+  }
+
+  // Returns the number of members in the set.
+  Result<int64_t> Size() {
+    const Node* root = VERIFY_RESULT(ReadNode(std::string()));
+    int64_t result = 0;
+    for (const auto& entry : *root) {
+      result += entry.second;
+    }
+    return result;
+  }
+
+  // Returns the number of members with score less than the given score, or less than or equal to
+  // it when inclusive is true.
+  Result<int64_t> CountLess(double score, bool inclusive) {
+    const std::string key = EncodeScore(score);
+    std::string prefix;
+    int64_t result = 0;
+    for (size_t i = 0; i != key.size(); ++i) {
+      const Node* node = VERIFY_RESULT(ReadNode(prefix));
+      const auto byte = static_cast<uint8_t>(key[i]);
+      auto it = node->begin();
+      for (; it != node->end() && it->first < byte; ++it) {
+        result += it->second;
+      }
+      if (it == node->end() || it->first != byte) {
+        return result;
+      }
+      prefix.push_back(key[i]);
+      if (inclusive && prefix.size() == key.size()) {
+        result += it->second;
+      }
+    }
+    return result;
+  }
+
+  // Returns the score of the member at the given rank, and the number of members with the same
+  // score that precede this member.
+  Result<std::pair<double, int64_t>> ScoreAt(int64_t rank) {
+    std::string prefix;
+    int64_t left = rank;
+    while (prefix.size() != kSortedSetRankKeySize) {
+      const Node* node = VERIFY_RESULT(ReadNode(prefix));
+      auto it = node->begin();
+      for (; it != node->end() && it->second <= left; ++it) {
+        left -= it->second;
+      }
+      if (it == node->end()) {
+        return STATUS_FORMAT(Corruption, "Rank $0 not found in sorted set rank index", rank);
+      }
+      prefix.push_back(static_cast<char>(it->first));
+    }
+    return std::make_pair(util::DecodeDoubleFromKey(prefix), left);
+  }
+
+  // Adds delta to the number of members with the given score. Changes are written by
+  // AppendChanges.
+  void Update(double score, int64_t delta) {
+    const std::string key = EncodeScore(score);
+    for (size_t i = 0; i != key.size(); ++i) {
+      deltas_[key.substr(0, i)][static_cast<uint8_t>(key[i])] += delta;
+    }
+  }
+
+  bool has_changes() const {
+    return !deltas_.empty();
+  }
+
+  // Adds updated counts to the sorted set document.
+  CHECKED_STATUS AppendChanges(SubDocument* kv_entries) {
+    SubDocument rank_entries;
+    for (const auto& node_deltas : deltas_) {
+      const Node* node = VERIFY_RESULT(ReadNode(node_deltas.first));
+      SubDocument node_entries;
+      for (const auto& delta : node_deltas.second) {
+        if (delta.second == 0) {
+          continue;
+        }
+        auto it = node->find(delta.first);
+        int64_t count = (it != node->end() ? it->second : 0) + delta.second;
+        if (count < 0) {
+          return STATUS_FORMAT(
+              Corruption, "Negative count $0 in sorted set rank index", count);
+        }
+        node_entries.SetChild(
+            PrimitiveValue::Int32(delta.first),
+            count == 0 ? SubDocument(ValueType::kTombstone) : SubDocument(PrimitiveValue(count)));
+      }
+      if (node_entries.object_num_keys() > 0) {
+        rank_entries.SetChild(PrimitiveValue(node_deltas.first), std::move(node_entries));
+      }
+    }
+    if (rank_entries.object_num_keys() > 0) {
+      kv_entries->SetChild(PrimitiveValue(ValueType::kSSRank), std::move(rank_entries));
+    }
+    return Status::OK();
+  }
+
+ private:
+  static constexpr size_t kSortedSetRankKeySize = sizeof(double);
+
+  // Children of a node: next byte of the encoded score -> number of members.
+  typedef std::map<uint8_t, int64_t> Node;
+
+  static std::string EncodeScore(double score) {
+    std::string result;
+    util::AppendDoubleToKey(score, &result);
+    return result;
+  }
+
+  Result<const Node*> ReadNode(const std::string& prefix) {
+    auto it = nodes_.find(prefix);
+    if (it != nodes_.end()) {
+      return &it->second;
+    }
+
+    KeyBytes encoded_node_key = encoded_key_;
+    PrimitiveValue(prefix).AppendToKey(&encoded_node_key);
+    SubDocument subdoc;
+    bool subdoc_found = false;
+    GetSubDocumentData data = { encoded_node_key, &subdoc, &subdoc_found };
+    data.deadline_info = deadline_info_;
+    RETURN_NOT_OK(GetSubDocument(
+        iterator_, data, /* projection */ nullptr, SeekFwdSuffices::kFalse));
+
+    Node node;
+    if (subdoc_found && IsObjectType(subdoc.value_type())) {
+      for (const auto& child : subdoc.object_container()) {
+        node.emplace(static_cast<uint8_t>(child.first.GetInt32()), child.second.GetInt64());
+      }
+    }
+    return &nodes_.emplace(prefix, std::move(node)).first->second;
+  }
+
+  IntentAwareIterator* iterator_;
+  KeyBytes encoded_key_;
+  DeadlineInfo* deadline_info_;
+
+  // Nodes read so far, by prefix.
+  std::unordered_map<std::string, Node> nodes_;
+
+  // Changes of counts by prefix and next byte.
+  std::map<std::string, std::map<uint8_t, int64_t>> deltas_;
+};
+
+// Returns the number of members of the sorted set with scores within the given bounds.
+Result<int64_t> CountSortedSetMembers(
+    IntentAwareIterator* iterator, const RedisKeyValuePB& kv,
+    const RedisSubKeyBoundPB& lower_bound, const RedisSubKeyBoundPB& upper_bound,
+    DeadlineInfo* deadline_info) {
+  if ((lower_bound.has_infinity_type() &&
+       lower_bound.infinity_type() == RedisSubKeyBoundPB::POSITIVE) ||
+      (upper_bound.has_infinity_type() &&
+       upper_bound.infinity_type() == RedisSubKeyBoundPB::NEGATIVE)) {
+    return 0;
+  }
+
+  SortedSetRankIndex rank_index(iterator, kv, deadline_info);
+  if (VERIFY_RESULT(rank_index.Exists())) {
+    int64_t high = upper_bound.has_infinity_type()
+        ? VERIFY_RESULT(rank_index.Size())
+        : VERIFY_RESULT(rank_index.CountLess(
+              upper_bound.subkey_bound().double_subkey(), !upper_bound.is_exclusive()));
+    int64_t low = lower_bound.has_infinity_type()
+        ? 0
+        : VERIFY_RESULT(rank_index.CountLess(
+              lower_bound.subkey_bound().double_subkey(), lower_bound.is_exclusive()));
+    return std::max<int64_t>(high - low, 0);
+  }
+
+  // No rank index, count members of the forward mapping.
+  auto encoded_doc_key = DocKey::EncodedFromRedisKey(kv.hash_code(), kv.key());
+  PrimitiveValue(ValueType::kSSForward).AppendToKey(&encoded_doc_key);
+
+  KeyBytes low_sub_key_bound;
+  SliceKeyBound low_subkey;
+  if (!lower_bound.has_infinity_type()) {
+    low_sub_key_bound = encoded_doc_key;
+    PrimitiveValue::Double(lower_bound.subkey_bound().double_subkey()).AppendToKey(
+        &low_sub_key_bound);
+    low_subkey = SliceKeyBound(low_sub_key_bound, LowerBound(lower_bound.is_exclusive()));
+  }
+  KeyBytes high_sub_key_bound;
+  SliceKeyBound high_subkey;
+  if (!upper_bound.has_infinity_type()) {
+    high_sub_key_bound = encoded_doc_key;
+    PrimitiveValue::Double(upper_bound.subkey_bound().double_subkey()).AppendToKey(
+        &high_sub_key_bound);
+    high_subkey = SliceKeyBound(high_sub_key_bound, UpperBound(upper_bound.is_exclusive()));
+  }
+
+  SubDocument doc;
+  bool doc_found = false;
+  GetSubDocumentData data = { encoded_doc_key, &doc, &doc_found };
+  data.deadline_info = deadline_info;
+  data.low_subkey = &low_subkey;
+  data.high_subkey = &high_subkey;
+  data.count_only = true;
+  RETURN_NOT_OK(GetSubDocument(iterator, data, /* projection */ nullptr, SeekFwdSuffices::kFalse));
+  return data.record_count;
+}
+
+// Returns the rank of the member in the sorted set, or none if the set does not contain it.
+Result<boost::optional<int64_t>> GetSortedSetRank(
+    IntentAwareIterator* iterator, const RedisKeyValuePB& kv, const std::string& member,
+    DeadlineInfo* deadline_info) {
+  const auto doc_key = DocKey::FromRedisKey(kv.hash_code(), kv.key());
+  auto encoded_key_reverse = SubDocKey(
+      doc_key, PrimitiveValue(ValueType::kSSReverse), PrimitiveValue(member)).EncodeWithoutHt();
+  SubDocument subdoc_reverse;
+  bool subdoc_reverse_found = false;
+  GetSubDocumentData reverse_data = { encoded_key_reverse, &subdoc_reverse,
+                                      &subdoc_reverse_found };
+  reverse_data.deadline_info = deadline_info;
+  RETURN_NOT_OK(GetSubDocument(
+      iterator, reverse_data, /* projection */ nullptr, SeekFwdSuffices::kFalse));
+  if (!subdoc_reverse_found) {
+    return boost::optional<int64_t>();
+  }
+  const double score = subdoc_reverse.GetDouble();
+
+  // Members with lower scores.
+  RedisSubKeyBoundPB lower_bound;
+  lower_bound.set_infinity_type(RedisSubKeyBoundPB::NEGATIVE);
+  RedisSubKeyBoundPB upper_bound;
+  upper_bound.mutable_subkey_bound()->set_double_subkey(score);
+  upper_bound.set_is_exclusive(true);
+  int64_t rank = VERIFY_RESULT(CountSortedSetMembers(
+      iterator, kv, lower_bound, upper_bound, deadline_info));
+
+  // Members with the same score that precede the given one.
+  auto encoded_key_forward = SubDocKey(
+      doc_key, PrimitiveValue(ValueType::kSSForward),
+      PrimitiveValue::Double(score)).EncodeWithoutHt();
+  KeyBytes high_sub_key_bound = encoded_key_forward;
+  PrimitiveValue(member).AppendToKey(&high_sub_key_bound);
+  SliceKeyBound high_subkey(high_sub_key_bound, UpperBound(/* exclusive */ true));
+  SubDocument subdoc_forward;
+  bool subdoc_forward_found = false;
+  GetSubDocumentData forward_data = { encoded_key_forward, &subdoc_forward,
+                                      &subdoc_forward_found };
+  forward_data.deadline_info = deadline_info;
+  forward_data.high_subkey = &high_subkey;
+  forward_data.count_only = true;
+  RETURN_NOT_OK(GetSubDocument(
+      iterator, forward_data, /* projection */ nullptr, SeekFwdSuffices::kFalse));
+  return boost::optional<int64_t>(rank + forward_data.record_count);
+}
+
+// Populates the response with members of the sorted set with ranks in [low_rank, high_rank],
+// using the rank index to find the scores of the boundary members.
+CHECKED_STATUS PopulateSortedSetRangeByRank(
+    IntentAwareIterator* iterator, const RedisKeyValuePB& kv, SortedSetRankIndex* rank_index,
+    int64_t low_rank, int64_t high_rank, DeadlineInfo* deadline_info, RedisResponsePB* response,
+    bool add_keys, bool reverse) {
+  const auto low = VERIFY_RESULT(rank_index->ScoreAt(low_rank));
+  const auto high = VERIFY_RESULT(rank_index->ScoreAt(high_rank));
+
+  auto encoded_doc_key = DocKey::EncodedFromRedisKey(kv.hash_code(), kv.key());
+  PrimitiveValue(ValueType::kSSForward).AppendToKey(&encoded_doc_key);
+  KeyBytes low_sub_key_bound = encoded_doc_key;
+  PrimitiveValue::Double(low.first).AppendToKey(&low_sub_key_bound);
+  SliceKeyBound low_subkey(low_sub_key_bound, LowerBound(/* exclusive */ false));
+  KeyBytes high_sub_key_bound = encoded_doc_key;
+  PrimitiveValue::Double(high.first).AppendToKey(&high_sub_key_bound);
+  SliceKeyBound high_subkey(high_sub_key_bound, UpperBound(/* exclusive */ false));
+
+  SubDocument doc;
+  bool doc_found = false;
+  GetSubDocumentData data = { encoded_doc_key, &doc, &doc_found };
+  data.deadline_info = deadline_info;
+  data.low_subkey = &low_subkey;
+  data.high_subkey = &high_subkey;
+  RETURN_NOT_OK(GetSubDocument(iterator, data, /* projection */ nullptr, SeekFwdSuffices::kFalse));
+
+  response->set_allocated_array_response(new RedisArrayPB());
+  if (!doc_found) {
+    response->set_code(RedisResponsePB::NIL);
+    return Status::OK();
+  }
+  if (!VerifyTypeAndSetCode(ValueType::kObject, doc.value_type(), response)) {
+    return Status::OK();
+  }
+
+  // Members with the boundary scores are sorted by value, drop the ones out of the rank range.
+  // Trim the last score first, so it also works when both boundaries have the same score.
+  auto& scores = doc.object_container();
+  if (!scores.empty()) {
+    auto& last = scores.rbegin()->second.object_container();
+    last.erase(std::next(last.begin(), std::min<size_t>(high.second + 1, last.size())),
+               last.end());
+    auto& first = scores.begin()->second.object_container();
+    first.erase(first.begin(),
+                std::next(first.begin(), std::min<size_t>(low.second, first.size())));
+  }
+
+  return PopulateResponseFrom(
+      scores, AddResponseValuesSortedSets, response, add_keys, /* add_values */ true, reverse);
+}
+
 } // anonymous namespace
 
 void RedisWriteOperation::InitializeIterator(const DocOperationApplyData& data) {
@@ -611,9 +950,21 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
         // The top level mapping.
         SubDocument kv_entries;
 
+        SortedSetRankIndex rank_index(iterator_.get(), kv);
+
+        // Only the last occurrence of a member is applied, otherwise earlier ones would leave
+        // stale entries in the forward mapping.
+        std::unordered_map<std::string, int> last_occurrence;
+        for (int i = 0; i < kv.subkey_size(); i++) {
+          last_occurrence[kv.value(i)] = i;
+        }
+
         int new_elements_added = 0;
         int return_value = 0;
         for (int i = 0; i < kv.subkey_size(); i++) {
+          if (last_occurrence[kv.value(i)] != i) {
+            continue;
+          }
           // Check whether the value is already in the document, if so delete it.
           SubDocKey key_reverse = SubDocKey(DocKey::FromRedisKey(kv.hash_code(), kv.key()),
                                             PrimitiveValue(ValueType::kSSReverse),
@@ -628,6 +979,13 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
               get_data, redis_query_id(), boost::none /* txn_op_context */, data.deadline,
               data.read_time));
 
+          // If the incr option is specified, we need insert the existing score + new score
+          // instead of just the new score.
+          double score_to_add = request_.set_request().sorted_set_options().incr() &&
+                                subdoc_reverse_found ?
+              kv.subkey(i).double_subkey() + subdoc_reverse.GetDouble() :
+              kv.subkey(i).double_subkey();
+
           // Flag indicating whether we should add the given entry to the sorted set.
           bool should_add_entry = true;
           // Flag indicating whether we shoould remove an entry from the sorted set.
@@ -661,7 +1019,7 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
                 // should_remove_existing_entry to true, and if the CH flag is on (return both
                 // elements changed and elements added), increment return_value.
                 double score_to_remove = subdoc_reverse.GetDouble();
-                if (score_to_remove != kv.subkey(i).double_subkey()) {
+                if (score_to_remove != score_to_add) {
                   should_remove_existing_entry = true;
                   if (request_.set_request().sorted_set_options().ch()) {
                     return_value++;
@@ -687,12 +1045,6 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
           }
 
           if (should_add_entry) {
-            // If the incr option is specified, we need insert the existing score + new score
-            // instead of just the new score.
-            double score_to_add = request_.set_request().sorted_set_options().incr() ?
-                kv.subkey(i).double_subkey() + subdoc_reverse.GetDouble() :
-                kv.subkey(i).double_subkey();
-
             // Add the forward mapping to the entries.
             SubDocument *forward_entry =
                 kv_entries_forward.GetOrAddChild(PrimitiveValue::Double(score_to_add)).first;
@@ -702,6 +1054,23 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
             // Add the reverse mapping to the entries.
             kv_entries_reverse.SetChild(PrimitiveValue(kv.value(i)),
                                         SubDocument(PrimitiveValue::Double(score_to_add)));
+
+            if (subdoc_reverse_found) {
+              rank_index.Update(subdoc_reverse.GetDouble(), -1);
+            }
+            rank_index.Update(score_to_add, 1);
+          }
+        }
+
+        if (rank_index.has_changes()) {
+          bool has_rank_index = VERIFY_RESULT(rank_index.Exists());
+          if (!has_rank_index && FLAGS_redis_sorted_set_rank_index) {
+            // The index could only be started for a set without members.
+            has_rank_index = data_type == REDIS_TYPE_NONE ||
+                             VERIFY_RESULT(GetCardinality(iterator_.get(), kv)) == 0;
+          }
+          if (has_rank_index) {
+            RETURN_NOT_OK(rank_index.AppendChanges(&kv_entries));
           }
         }
 
@@ -942,8 +1311,15 @@ Status RedisWriteOperation::ApplyDel(const DocOperationApplyData& data) {
       SubDocument values_card;
       SubDocument values_forward;
       SubDocument values_reverse;
+      SortedSetRankIndex rank_index(iterator_.get(), kv);
+      std::unordered_set<std::string> removed_members;
       num_keys = kv.subkey_size();
       for (int i = 0; i < kv.subkey_size(); i++) {
+        if (!removed_members.insert(kv.subkey(i).string_subkey()).second) {
+          // The same member was already removed by this command.
+          num_keys--;
+          continue;
+        }
         // Check whether the value is already in the document.
         SubDocument doc_reverse;
         bool doc_reverse_found = false;
@@ -970,6 +1346,7 @@ Status RedisWriteOperation::ApplyDel(const DocOperationApplyData& data) {
                                SubDocument(ValueType::kTombstone));
           values_forward.SetChild(PrimitiveValue::Double(doc_reverse.GetDouble()),
                           SubDocument(doc_forward));
+          rank_index.Update(doc_reverse.GetDouble(), -1);
         } else {
           // If the key is absent, it doesn't contribute to the count of keys being deleted.
           num_keys--;
@@ -982,6 +1359,9 @@ Status RedisWriteOperation::ApplyDel(const DocOperationApplyData& data) {
       values.SetChild(PrimitiveValue(ValueType::kCounter), SubDocument(values_card));
       values.SetChild(PrimitiveValue(ValueType::kSSForward), SubDocument(values_forward));
       values.SetChild(PrimitiveValue(ValueType::kSSReverse), SubDocument(values_reverse));
+      if (rank_index.has_changes() && VERIFY_RESULT(rank_index.Exists())) {
+        RETURN_NOT_OK(rank_index.AppendChanges(&values));
+      }
 
       break;
     }
@@ -1549,12 +1929,20 @@ Status RedisReadOperation::ExecuteCollectionGetRange() {
                                            true));
         return Status::OK();
       }
+      bool add_keys = request_.get_collection_range_request().with_scores();
+
+      SortedSetRankIndex rank_index(
+          iterator_.get(), request_.key_value(), deadline_info_.get_ptr());
+      if (VERIFY_RESULT(rank_index.Exists())) {
+        return PopulateSortedSetRangeByRank(
+            iterator_.get(), request_.key_value(), &rank_index, low_idx_normalized,
+            high_idx_normalized, deadline_info_.get_ptr(), &response_, add_keys, reverse);
+      }
+
       auto encoded_doc_key = DocKey::EncodedFromRedisKey(
           request_.key_value().hash_code(), request_.key_value().key());
       PrimitiveValue(ValueType::kSSForward).AppendToKey(&encoded_doc_key);
 
-      bool add_keys = request_.get_collection_range_request().with_scores();
-
       IndexBound low_bound = IndexBound(low_idx_normalized, true /* is_lower */);
       IndexBound high_bound = IndexBound(high_idx_normalized, false /* is_lower */);
 
@@ -1570,6 +1958,28 @@ Status RedisReadOperation::ExecuteCollectionGetRange() {
           &response_, add_keys, /* add_values */ true, reverse));
       break;
     }
+    case RedisCollectionGetRangeRequestPB::ZCOUNT: {
+      if(!request_.has_subkey_range() || !request_.subkey_range().has_lower_bound() ||
+          !request_.subkey_range().has_upper_bound()) {
+        return STATUS(InvalidArgument, "Need to specify the subkey range");
+      }
+
+      RedisDataType type = VERIFY_RESULT(GetValueType());
+      if (!VerifyTypeAndSetCode(RedisDataType::REDIS_TYPE_SORTEDSET, type, &response_,
+                                VerifySuccessIfMissing::kTrue)) {
+        return Status::OK();
+      }
+
+      int64_t count = 0;
+      if (type != REDIS_TYPE_NONE) {
+        count = VERIFY_RESULT(CountSortedSetMembers(
+            iterator_.get(), key_value, request_.subkey_range().lower_bound(),
+            request_.subkey_range().upper_bound(), deadline_info_.get_ptr()));
+      }
+      response_.set_code(RedisResponsePB::OK);
+      response_.set_int_response(count);
+      break;
+    }
     case RedisCollectionGetRangeRequestPB::UNKNOWN:
       return STATUS(InvalidCommand, "Unknown Collection Get Range Request not supported");
   }
@@ -1690,7 +2100,9 @@ Status RedisReadOperation::ExecuteGet(const RedisGetRequestPB& get_request) {
       expected_type = REDIS_TYPE_HASH; break;
     case RedisGetRequestPB::SISMEMBER:
       expected_type = REDIS_TYPE_SET; break;
-    case RedisGetRequestPB::ZSCORE:
+    case RedisGetRequestPB::ZSCORE: FALLTHROUGH_INTENDED;
+    case RedisGetRequestPB::ZRANK: FALLTHROUGH_INTENDED;
+    case RedisGetRequestPB::ZREVRANK:
       expected_type = REDIS_TYPE_SORTEDSET; break;
     default:
       expected_type = REDIS_TYPE_NONE;
@@ -1744,6 +2156,28 @@ Status RedisReadOperation::ExecuteGet(const RedisGetRequestPB& get_request) {
       }
       return Status::OK();
     }
+    case RedisGetRequestPB::ZRANK: FALLTHROUGH_INTENDED;
+    case RedisGetRequestPB::ZREVRANK: {
+      RedisDataType type = VERIFY_RESULT(GetValueType());
+      // If wrong type, we set the error code in the response.
+      if (!VerifyTypeAndSetCode(expected_type, type, &response_, VerifySuccessIfMissing::kTrue)) {
+        return Status::OK();
+      }
+      auto rank = VERIFY_RESULT(GetSortedSetRank(
+          iterator_.get(), request_.key_value(), request_.key_value().subkey(0).string_subkey(),
+          deadline_info_.get_ptr()));
+      if (!rank) {
+        response_.set_code(RedisResponsePB::NIL);
+        return Status::OK();
+      }
+      if (request_type == RedisGetRequestPB::ZREVRANK) {
+        int64_t card = VERIFY_RESULT(GetCardinality(iterator_.get(), request_.key_value()));
+        *rank = card - 1 - *rank;
+      }
+      response_.set_code(RedisResponsePB::OK);
+      response_.set_int_response(*rank);
+      return Status::OK();
+    }
     case RedisGetRequestPB::HEXISTS: FALLTHROUGH_INTENDED;
     case RedisGetRequestPB::SISMEMBER: {
       RedisDataType type = VERIFY_RESULT(GetValueType());
@@ -18,6 +18,8 @@
 #include <stack>
 #include <thread>
 
+#include <gflags/gflags.h>
+
 #include "yb/docdb/shared_lock_manager.h"
 
 #include "yb/rpc/thread_pool.h"
@@ -28,6 +30,11 @@
 
 using namespace std::literals;
 
+DEFINE_bool(shared_lock_manager_benchmark, false,
+            "Run the SharedLockManager lock/unlock throughput benchmark.");
+DEFINE_int32(shared_lock_manager_benchmark_time_ms, 2000,
+             "Time to run each thread/overlap combination of the throughput benchmark.");
+
 using std::string;
 using std::vector;
 using std::stack;
@@ -184,5 +191,61 @@ TEST_F(SharedLockManagerTest, LockConflicts) {
   tp.Shutdown();
 }
 
+// Measures lock/unlock throughput depending on number of threads and ratio of keys that are
+// shared between threads. Takes a while, so only runs with --shared_lock_manager_benchmark.
+TEST_F(SharedLockManagerTest, LockUnlockThroughput) {
+  if (!FLAGS_shared_lock_manager_benchmark) {
+    LOG(INFO) << "Skipping benchmark, use --shared_lock_manager_benchmark to run it";
+    return;
+  }
+
+  const auto kTestTime = FLAGS_shared_lock_manager_benchmark_time_ms * 1ms;
+  const size_t kKeysPerThread = 1000;
+  const size_t kSharedKeys = 16;
+
+  for (size_t num_threads : {1, 2, 4, 8, 16, 32}) {
+    for (int overlap_percent : {0, 10, 50, 100}) {
+      std::atomic<bool> stop_requested{false};
+      std::atomic<size_t> total_ops{0};
+      std::vector<std::thread> threads;
+      while (threads.size() != num_threads) {
+        size_t thread_idx = threads.size();
+        threads.emplace_back([this, &stop_requested, &total_ops, thread_idx, overlap_percent] {
+          std::vector<RefCntPrefix> own_keys;
+          for (size_t i = 0; i != kKeysPerThread; ++i) {
+            own_keys.emplace_back(Format("key_$0_$1", thread_idx, i));
+          }
+          std::vector<RefCntPrefix> shared_keys;
+          for (size_t i = 0; i != kSharedKeys; ++i) {
+            shared_keys.emplace_back(Format("shared_$0", i));
+          }
+          size_t ops = 0;
+          while (!stop_requested.load(std::memory_order_acquire)) {
+            const auto& key = RandomUniformInt(0, 99) < overlap_percent
+                ? RandomElement(shared_keys) : own_keys[ops % kKeysPerThread];
+            LockBatch lb(&lm_,
+                         {{key, IntentTypeSet({IntentType::kStrongWrite,
+                                               IntentType::kStrongRead})}},
+                         CoarseTimePoint::max());
+            ++ops;
+          }
+          total_ops.fetch_add(ops, std::memory_order_acq_rel);
+        });
+      }
+
+      std::this_thread::sleep_for(kTestTime);
+      stop_requested.store(true, std::memory_order_release);
+      for (auto& thread : threads) {
+        thread.join();
+      }
+
+      auto ops_per_sec = total_ops.load(std::memory_order_acquire) * 1000 /
+          std::chrono::duration_cast<std::chrono::milliseconds>(kTestTime).count();
+      LOG(INFO) << "Threads: " << num_threads << ", overlap: " << overlap_percent
+                << "%, lock/unlock per second: " << ops_per_sec;
+    }
+  }
+}
+
 } // namespace docdb
 } // namespace yb
@@ -70,6 +70,8 @@ namespace docdb {
     ((kSSReverse, '\'')) /* ASCII code 39 */ \
     ((kRedisSet, '(')) /* ASCII code 40 */ \
     ((kRedisList, ')')) /* ASCII code 41*/ \
+    /* Rank index for sorted sets, counts members by prefixes of encoded scores. */ \
+    ((kSSRank, '*')) /* ASCII code 42 */ \
     /* This is the redis timeseries type. */ \
     ((kRedisTS, '+')) /* ASCII code 43 */ \
     ((kRedisSortedSet, ',')) /* ASCII code 44 */ \
@@ -0,0 +1,89 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gflags/gflags.h>
+
+#include "yb/common/partition.h"
+#include "yb/integration-tests/mini_cluster.h"
+#include "yb/integration-tests/yb_table_test_base.h"
+#include "yb/master/catalog_manager.h"
+#include "yb/master/master.h"
+#include "yb/master/mini_master.h"
+#include "yb/tserver/mini_tablet_server.h"
+#include "yb/util/format.h"
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+DECLARE_int32(tablet_split_check_interval_ms);
+DECLARE_int64(tablet_split_size_threshold_bytes);
+
+namespace yb {
+namespace integration_tests {
+
+class TabletSplitITest : public YBTableTestBase {
+ protected:
+  void SetUp() override {
+    // The heartbeat data provider reads the check interval when the tablet server starts.
+    FLAGS_tablet_split_check_interval_ms = 100;
+    YBTableTestBase::SetUp();
+  }
+
+  bool use_external_mini_cluster() override { return false; }
+
+  int num_tablets() override { return 1; }
+  int num_tablet_servers() override { return 1; }
+
+  std::vector<master::TabletSplitCandidatePB> GetSplitCandidates() {
+    std::vector<master::TabletSplitCandidatePB> candidates;
+    mini_cluster()->leader_mini_master()->master()->catalog_manager()->GetTabletSplitCandidates(
+        &candidates);
+    return candidates;
+  }
+};
+
+// Test that a tablet reaching the split size threshold is reported to the master as a split
+// candidate, with a split key inside of its partition.
+TEST_F(TabletSplitITest, ReportSplitCandidate) {
+  constexpr int kNumRows = 1000;
+
+  for (int i = 0; i < kNumRows; ++i) {
+    PutKeyValue(Format("key_$0", i), Format("value_$0", i));
+  }
+
+  // Nothing is reported before the data is flushed.
+  FLAGS_tablet_split_size_threshold_bytes = 1;
+  SleepFor(1s);
+  ASSERT_TRUE(GetSplitCandidates().empty());
+
+  ASSERT_OK(mini_cluster()->mini_tablet_server(0)->FlushTablets());
+
+  std::vector<master::TabletSplitCandidatePB> candidates;
+  ASSERT_OK(WaitFor([this, &candidates] {
+    candidates = GetSplitCandidates();
+    return !candidates.empty();
+  }, 30s, "Tablet reported as split candidate"));
+
+  ASSERT_EQ(candidates.size(), 1U);
+  const auto& candidate = candidates.front();
+  LOG(INFO) << "Split candidate: " << candidate.ShortDebugString();
+  ASSERT_GT(candidate.sst_files_size(), 0U);
+  // Keys have hash codes spread evenly, so the split point should be close to the middle.
+  const auto split_hash_code =
+      PartitionSchema::DecodeMultiColumnHashValue(candidate.split_partition_key());
+  ASSERT_GT(split_hash_code, PartitionSchema::kMaxPartitionKey / 4);
+  ASSERT_LT(split_hash_code, PartitionSchema::kMaxPartitionKey / 4 * 3);
+}
+
+}  // namespace integration_tests
+}  // namespace yb
@@ -182,6 +182,26 @@ uint32_t TabletInfo::reported_schema_version() const {
   return reported_schema_version_;
 }
 
+bool TabletInfo::SetSplitCandidate(
+    const TabletSplitCandidatePB& candidate, MonoTime reported_after) {
+  std::lock_guard<simple_spinlock> l(lock_);
+  const bool was_candidate =
+      split_candidate_time_.Initialized() && split_candidate_time_ > reported_after;
+  split_candidate_ = candidate;
+  split_candidate_time_ = MonoTime::Now();
+  return was_candidate;
+}
+
+bool TabletInfo::GetSplitCandidate(
+    MonoTime reported_after, TabletSplitCandidatePB* candidate) const {
+  std::lock_guard<simple_spinlock> l(lock_);
+  if (!split_candidate_time_.Initialized() || split_candidate_time_ <= reported_after) {
+    return false;
+  }
+  *candidate = split_candidate_;
+  return true;
+}
+
 bool TabletInfo::colocated() const {
   auto l = LockForRead();
   return l->data().pb.colocated();
@@ -211,6 +211,13 @@ class TabletInfo : public RefCountedThreadSafe<TabletInfo>,
 
   bool colocated() const;
 
+  // Stores the split candidate reported by the tablet leader. Returns whether a candidate was
+  // already reported after the given time.
+  bool SetSplitCandidate(const TabletSplitCandidatePB& candidate, MonoTime reported_after);
+
+  // Fills the last split candidate, if it was reported after the given time.
+  bool GetSplitCandidate(MonoTime reported_after, TabletSplitCandidatePB* candidate) const;
+
   // No synchronization needed.
   std::string ToString() const override;
 
@@ -254,6 +261,10 @@ class TabletInfo : public RefCountedThreadSafe<TabletInfo>,
 
   LeaderStepDownFailureTimes leader_stepdown_failure_times_;
 
+  // Last split candidate reported by the tablet leader (in-memory only), and when it was reported.
+  TabletSplitCandidatePB split_candidate_;
+  MonoTime split_candidate_time_;
+
   DISALLOW_COPY_AND_ASSIGN(TabletInfo);
 };
 
@@ -14,6 +14,8 @@
 #ifndef YB_MASTER_CATALOG_MANAGER_TEST_BASE_H
 #define YB_MASTER_CATALOG_MANAGER_TEST_BASE_H
 
+#include <limits>
+
 #include <gtest/gtest.h>
 
 #include "yb/gutil/strings/substitute.h"
@@ -184,6 +186,9 @@ class TestLoadBalancerBase {
     gflags::SetCommandLineOption("leader_balance_threshold", "0");
     PrepareTestState(ts_descs_multi_az);
     TestLeaderBlacklist();
+
+    PrepareTestState(ts_descs_multi_az);
+    TestSkewedTabletLoad();
   }
 
  protected:
@@ -548,6 +553,51 @@ class TestLoadBalancerBase {
     ASSERT_EQ(0, cb_->get_total_over_replication());
   }
 
+  void TestSkewedTabletLoad() {
+    LOG(INFO) << "Testing with skewed tablet sizes and write rates";
+    gflags::SetCommandLineOption("load_balancer_use_tablet_metrics", "true");
+    PlacementInfoPB* cluster_placement = replication_info_.mutable_live_replicas();
+    cluster_placement->set_num_replicas(kNumReplicas);
+
+    // Add an empty fourth TS, as in TestNoPlacement.
+    ts_descs_.push_back(SetupTS("3333", "a"));
+
+    // The first tablet has 8 times as much data as each of the others and takes all the writes.
+    const std::vector<uint64_t> skewed_sizes = {800, 100, 100, 100};
+    const std::vector<double> skewed_writes = {1000, 0, 0, 0};
+    ReportTabletLoads(skewed_sizes, skewed_writes);
+    ResetState();
+    ASSERT_OK(AnalyzeTablets());
+    ASSERT_NEAR(131.0 / 44, cb_->state_->GetTabletWeight(tablets_[0]->tablet_id()), 1e-9);
+    for (int i = 1; i < tablets_.size(); ++i) {
+      ASSERT_NEAR(15.0 / 44, cb_->state_->GetTabletWeight(tablets_[i]->tablet_id()), 1e-9);
+    }
+
+    // Each of the first three TSs has a load of 4 and ts3 is empty. The first tablet weighs about
+    // 3, so moving it would only shift the imbalance to ts3, and the next runs could move it back.
+    // The lighter tablets are moved to ts3 instead, and the balancer settles.
+    const double initial_spread = GetWeightedLoadSpread();
+    ASSERT_NEAR(4.0, initial_spread, 1e-9);
+    int num_moves = 0;
+    RunLoadBalancerUntilSettled(skewed_sizes, skewed_writes, &num_moves);
+    ASSERT_GT(num_moves, 0);
+    ASSERT_LT(GetWeightedLoadSpread(), initial_spread);
+    const auto& ts3_meta = cb_->state_->per_ts_meta_[ts_descs_[3]->permanent_uuid()];
+    ASSERT_EQ(3, ts3_meta.running_tablets.size());
+    ASSERT_EQ(0, ts3_meta.running_tablets.count(tablets_[0]->tablet_id()));
+
+    // Once the tablets are the same, the replicas are spread evenly.
+    RunLoadBalancerUntilSettled({100, 100, 100, 100}, {0, 0, 0, 0}, &num_moves);
+    for (const auto& ts_desc : ts_descs_) {
+      ASSERT_EQ(3, cb_->state_->GetLoad(ts_desc->permanent_uuid()));
+    }
+
+    for (const auto& ts_desc : ts_descs_) {
+      ts_desc->ClearMetrics();
+    }
+    gflags::SetCommandLineOption("load_balancer_use_tablet_metrics", "false");
+  }
+
   void TestWithMissingTabletServers() {
     LOG(INFO) << "Testing with missing tablet servers";
     SetupClusterConfig({"a"}, &replication_info_);
@@ -950,6 +1000,83 @@ class TestLoadBalancerBase {
     tablet->SetReplicaLocations(replicas);
   }
 
+  // Reports the SST file size of each tablet from all of its replicas, and its write ops/sec from
+  // its leader, as the tablet servers do in their heartbeats.
+  void ReportTabletLoads(const std::vector<uint64_t>& sst_file_sizes,
+                         const std::vector<double>& write_ops_per_sec) {
+    for (const auto& ts_desc : ts_descs_) {
+      TServerMetricsPB metrics;
+      for (int i = 0; i < tablets_.size(); ++i) {
+        TabletInfo::ReplicaMap replicas;
+        tablets_[i]->GetReplicaLocations(&replicas);
+        auto it = replicas.find(ts_desc->permanent_uuid());
+        if (it == replicas.end()) {
+          continue;
+        }
+        auto* tablet_load = metrics.add_tablet_loads();
+        tablet_load->set_tablet_id(tablets_[i]->tablet_id());
+        tablet_load->set_sst_file_size(sst_file_sizes[i]);
+        if (it->second.role == consensus::RaftPeerPB::LEADER) {
+          tablet_load->set_write_ops_per_sec(write_ops_per_sec[i]);
+        }
+      }
+      ts_desc->UpdateMetrics(metrics);
+    }
+  }
+
+  // Returns the difference between the highest and the lowest weighted load of the TSs.
+  double GetWeightedLoadSpread() {
+    double max_load = 0;
+    double min_load = std::numeric_limits<double>::max();
+    for (const auto& ts_desc : ts_descs_) {
+      const double load = cb_->state_->GetWeightedLoad(ts_desc->permanent_uuid());
+      max_load = std::max(max_load, load);
+      min_load = std::min(min_load, load);
+    }
+    return max_load - min_load;
+  }
+
+  // Runs the load balancer on the current table until a run does not move anything, completing
+  // the moves of each run in the tablet map before the next one. Adds the number of moves to
+  // num_moves.
+  void RunLoadBalancerUntilSettled(const std::vector<uint64_t>& sst_file_sizes,
+                                   const std::vector<double>& write_ops_per_sec,
+                                   int* num_moves) {
+    const int kMaxRuns = 20;
+    auto find_ts = [this](const TabletServerId& uuid) {
+      for (const auto& ts_desc : ts_descs_) {
+        if (ts_desc->permanent_uuid() == uuid) {
+          return ts_desc;
+        }
+      }
+      return std::shared_ptr<TSDescriptor>();
+    };
+    for (int run = 0;; ++run) {
+      ASSERT_LT(run, kMaxRuns) << "Load balancer did not settle";
+      ReportTabletLoads(sst_file_sizes, write_ops_per_sec);
+      ResetState();
+      ASSERT_OK(AnalyzeTablets());
+
+      int run_moves = 0;
+      string tablet_id, from_ts, to_ts;
+      if (ASSERT_RESULT(HandleAddReplicas(&tablet_id, &from_ts, &to_ts))) {
+        ASSERT_FALSE(from_ts.empty());
+        auto tablet = tablet_map_[tablet_id];
+        AddRunningReplica(tablet.get(), find_ts(to_ts));
+        RemoveReplica(tablet.get(), find_ts(from_ts));
+        ++run_moves;
+      }
+      if (ASSERT_RESULT(HandleLeaderMoves(&tablet_id, &from_ts, &to_ts))) {
+        MoveTabletLeader(tablet_map_[tablet_id].get(), find_ts(to_ts));
+        ++run_moves;
+      }
+      if (run_moves == 0) {
+        break;
+      }
+      *num_moves += run_moves;
+    }
+  }
+
   // Clear the tablets_added_ field from the state, used for testing.
   void ClearTabletsAddedForTest() {
     cb_->state_->tablets_added_.clear();
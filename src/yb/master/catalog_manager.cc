@@ -257,6 +257,11 @@ DEFINE_bool(
     "This cuts down test logs significantly.");
 TAG_FLAG(hide_pg_catalog_table_creation_logs, hidden);
 
+DEFINE_int32(tablet_split_candidate_expiration_ms, 60000,
+    "Time (in milliseconds) for which master keeps a tablet split candidate after the tablet "
+    "leader last reported it.");
+TAG_FLAG(tablet_split_candidate_expiration_ms, advanced);
+
 DEFINE_test_flag(int32, simulate_slow_table_create_secs, 0,
     "Simulates a slow table creation by sleeping after the table has been added to memory.");
 
@@ -3914,6 +3919,64 @@ bool ShouldTransitionTabletToRunning(const ReportedTabletPB& report) {
 }
 }  // anonymous namespace
 
+void CatalogManager::ProcessTabletSplitCandidates(
+    TSDescriptor* ts_desc,
+    const google::protobuf::RepeatedPtrField<TabletSplitCandidatePB>& candidates) {
+  for (const auto& candidate : candidates) {
+    scoped_refptr<TabletInfo> tablet;
+    {
+      SharedLock<LockType> l(lock_);
+      tablet = FindPtrOrNull(*tablet_map_, candidate.tablet_id());
+    }
+    if (!tablet || !tablet->table()) {
+      VLOG(1) << "Ignoring split candidate from unknown tablet " << candidate.tablet_id();
+      continue;
+    }
+    auto leader = tablet->GetLeader();
+    if (!leader.ok() || *leader != ts_desc) {
+      VLOG(1) << "Ignoring split candidate " << candidate.tablet_id() << " reported by "
+              << ts_desc->permanent_uuid() << ", which is not its leader";
+      continue;
+    }
+    {
+      auto l = tablet->LockForRead();
+      const auto& partition = l->data().pb.partition();
+      const auto& split_key = candidate.split_partition_key();
+      if (!l->data().is_running() ||
+          split_key <= partition.partition_key_start() ||
+          (!partition.partition_key_end().empty() && split_key >= partition.partition_key_end())) {
+        LOG(WARNING) << "Ignoring invalid split candidate: " << candidate.ShortDebugString();
+        continue;
+      }
+    }
+    if (!tablet->SetSplitCandidate(candidate, SplitCandidateExpirationTime())) {
+      LOG(INFO) << "Tablet " << candidate.tablet_id() << " of table "
+                << tablet->table()->ToString() << " became a split candidate: "
+                << candidate.ShortDebugString();
+    }
+  }
+}
+
+MonoTime CatalogManager::SplitCandidateExpirationTime() const {
+  return MonoTime::Now() - MonoDelta::FromMilliseconds(FLAGS_tablet_split_candidate_expiration_ms);
+}
+
+void CatalogManager::GetTabletSplitCandidates(std::vector<TabletSplitCandidatePB>* candidates) {
+  const auto reported_after = SplitCandidateExpirationTime();
+  TabletInfos tablets;
+  {
+    SharedLock<LockType> l(lock_);
+    AppendValuesFromMap(*tablet_map_, &tablets);
+  }
+  for (const auto& tablet : tablets) {
+    TabletSplitCandidatePB candidate;
+    if (tablet->GetSplitCandidate(reported_after, &candidate) &&
+        tablet->LockForRead()->data().is_running()) {
+      candidates->push_back(std::move(candidate));
+    }
+  }
+}
+
 Status CatalogManager::HandleReportedTablet(TSDescriptor* ts_desc,
                                             const ReportedTabletPB& report,
                                             ReportedTabletUpdatesPB *report_updates,
@@ -5255,7 +5318,7 @@ Status CatalogManager::StartRemoteBootstrap(const StartRemoteBootstrapRequestPB&
             << " (" << bootstrap_peer_addr.ToString() << ").";
 
   auto rb_client = std::make_unique<tserver::RemoteBootstrapClient>(
-      tablet_id, master_->fs_manager());
+      tablet_id, master_->fs_manager(), master_->metric_entity());
 
   // Download and persist the remote superblock in TABLET_DATA_COPYING state.
   if (replacing_tablet) {
@@ -294,6 +294,16 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
                                      TabletReportUpdatesPB *report_update,
                                      rpc::RpcContext* rpc);
 
+  // Handle the split candidates reported by the given tablet server. Candidates are only accepted
+  // from the leader of the tablet and with a split key inside of the tablet partition.
+  void ProcessTabletSplitCandidates(
+      TSDescriptor* ts_desc,
+      const google::protobuf::RepeatedPtrField<TabletSplitCandidatePB>& candidates);
+
+  // Fills the split candidates of running tablets that their leaders reported within the last
+  // tablet_split_candidate_expiration_ms.
+  void GetTabletSplitCandidates(std::vector<TabletSplitCandidatePB>* candidates);
+
   // Create a new Namespace with the specified attributes.
   //
   // The RPC context is provided for logging/tracing purposes,
@@ -1178,6 +1188,9 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   virtual bool CDCStreamExistsUnlocked(const CDCStreamId& id);
   void RemoveFromNamespaceMaps(const NamespaceInfo& ns, rpc::RpcContext* rpc);
 
+  // Split candidates reported before the returned time are expired.
+  MonoTime SplitCandidateExpirationTime() const;
+
   // Should be bumped up when tablet locations are changed.
   std::atomic<uintptr_t> tablet_locations_version_{0};
 
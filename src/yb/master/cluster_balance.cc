@@ -69,6 +69,31 @@ DEFINE_int32(load_balancer_num_idle_runs,
              5,
              "Number of idle runs of load balancer to deem it idle.");
 
+DEFINE_bool(load_balancer_use_tablet_metrics, false,
+            "Whether to weigh each tablet replica by the SST file size, ops/sec and write ops/sec "
+            "of its tablet relative to the other tablets of the table, as reported in "
+            "heartbeats, instead of counting all replicas and leaders the same.");
+TAG_FLAG(load_balancer_use_tablet_metrics, runtime);
+TAG_FLAG(load_balancer_use_tablet_metrics, advanced);
+
+DEFINE_double(load_balancer_sst_size_weight, 1.0,
+              "Weight of the SST file size in the load of a tablet replica, when "
+              "load_balancer_use_tablet_metrics is set.");
+TAG_FLAG(load_balancer_sst_size_weight, runtime);
+TAG_FLAG(load_balancer_sst_size_weight, advanced);
+
+DEFINE_double(load_balancer_iops_weight, 1.0,
+              "Weight of the read and write ops/sec in the load of a tablet replica, when "
+              "load_balancer_use_tablet_metrics is set.");
+TAG_FLAG(load_balancer_iops_weight, runtime);
+TAG_FLAG(load_balancer_iops_weight, advanced);
+
+DEFINE_double(load_balancer_leader_write_rate_weight, 1.0,
+              "Weight of the write ops/sec served by the leader in the load of a tablet replica, "
+              "when load_balancer_use_tablet_metrics is set.");
+TAG_FLAG(load_balancer_leader_write_rate_weight, runtime);
+TAG_FLAG(load_balancer_leader_write_rate_weight, advanced);
+
 DEFINE_test_flag(bool, load_balancer_handle_under_replicated_tablets_only, false,
                  "Limit the functionality of the load balancer during tests so tests can make "
                  "progress")
@@ -343,6 +368,77 @@ void ClusterLoadBalancer::ResetState() {
   state_ = make_unique<enterprise::ClusterLoadState>();
 }
 
+void ClusterLoadBalancer::UpdateTabletWeights() {
+  // Add up the load reported by the replicas of each tablet. All replicas have the same SST files,
+  // while reads and writes are spread across them. Writes are only counted by the leader.
+  struct TabletUsage {
+    double sst_file_size = 0;
+    double iops = 0;
+    double write_ops = 0;
+  };
+  std::unordered_map<TabletId, TabletUsage> usages;
+  for (const auto& ts_meta : state_->per_ts_meta_) {
+    for (const auto& tablet_id : ts_meta.second.running_tablets) {
+      TSDescriptor::TabletLoad load;
+      if (!ts_meta.second.descriptor->GetTabletLoad(tablet_id, &load)) {
+        continue;
+      }
+      auto& usage = usages[tablet_id];
+      usage.sst_file_size = std::max(usage.sst_file_size, static_cast<double>(load.sst_file_size));
+      usage.iops += load.read_ops_per_sec + load.write_ops_per_sec;
+      usage.write_ops += load.write_ops_per_sec;
+    }
+  }
+  if (usages.empty()) {
+    return;
+  }
+
+  struct Metric {
+    double weight;
+    double TabletUsage::*value;
+    double average;
+  };
+  vector<Metric> metrics;
+  double total_weight = 1;
+  const auto num_tablets = state_->per_tablet_meta_.size();
+  for (const auto& metric : {Metric{FLAGS_load_balancer_sst_size_weight,
+                                    &TabletUsage::sst_file_size, 0},
+                             Metric{FLAGS_load_balancer_iops_weight, &TabletUsage::iops, 0},
+                             Metric{FLAGS_load_balancer_leader_write_rate_weight,
+                                    &TabletUsage::write_ops, 0}}) {
+    if (metric.weight <= 0) {
+      continue;
+    }
+    double total = 0;
+    for (const auto& usage : usages) {
+      total += usage.second.*metric.value;
+    }
+    // Metrics that are zero everywhere are left out.
+    if (total > 0) {
+      metrics.push_back(Metric{metric.weight, metric.value, total / num_tablets});
+      total_weight += metric.weight;
+    }
+  }
+  if (metrics.empty()) {
+    return;
+  }
+
+  // The weight of a tablet is the weighted average of its metrics, each relative to the average
+  // tablet of the table. Each replica also counts for one, as it does without metrics, so that
+  // tablets with no data or traffic yet are still spread across the TSs. The average weight is 1,
+  // so the load variance thresholds keep their meaning.
+  for (const auto& tablet_meta : state_->per_tablet_meta_) {
+    const auto usage_it = usages.find(tablet_meta.first);
+    double weighted_sum = 1;
+    if (usage_it != usages.end()) {
+      for (const auto& metric : metrics) {
+        weighted_sum += metric.weight * (usage_it->second.*metric.value) / metric.average;
+      }
+    }
+    state_->tablet_weights_[tablet_meta.first] = weighted_sum / total_weight;
+  }
+}
+
 Status ClusterLoadBalancer::AnalyzeTablets(const TableId& table_uuid) {
   // Set the blacklist so we can also mark the tablet servers as we add them up.
   state_->SetBlacklist(GetServerBlacklist());
@@ -390,6 +486,10 @@ Status ClusterLoadBalancer::AnalyzeTablets(const TableId& table_uuid) {
     }
   }
 
+  if (FLAGS_load_balancer_use_tablet_metrics) {
+    UpdateTabletWeights();
+  }
+
   // After updating the tablets and tablet servers, adjust the configured threshold if it is too
   // low for the given configuration.
   state_->AdjustLeaderBalanceThreshold();
@@ -540,7 +640,11 @@ void ClusterLoadBalancer::DumpSortedLoad() const {
   for (int left = 0; left <= last_pos; ++left) {
     const TabletServerId& uuid = state_->sorted_load_[left];
     int load = state_->GetLoad(uuid);
-    out << uuid << ":" << load << " ";
+    out << uuid << ":" << load;
+    if (!state_->tablet_weights_.empty()) {
+      out << "(" << state_->GetWeightedLoad(uuid) << ")";
+    }
+    out << " ";
   }
   VLOG(1) << out.str();
 }
@@ -576,7 +680,8 @@ Result<bool> ClusterLoadBalancer::GetLoadToMove(
     for (int right = last_pos; right >= 0; --right) {
       const TabletServerId& low_load_uuid = state_->sorted_load_[left];
       const TabletServerId& high_load_uuid = state_->sorted_load_[right];
-      int load_variance = state_->GetLoad(high_load_uuid) - state_->GetLoad(low_load_uuid);
+      double load_variance =
+          state_->GetWeightedLoad(high_load_uuid) - state_->GetWeightedLoad(low_load_uuid);
 
       // Check for state change or end conditions.
       if (left == right || load_variance < state_->options_->kMinLoadVarianceToBalance) {
@@ -590,7 +695,8 @@ Result<bool> ClusterLoadBalancer::GetLoadToMove(
       }
 
       // If we don't find a tablet_id to move between these two TSs, advance the state.
-      if (VERIFY_RESULT(GetTabletToMove(high_load_uuid, low_load_uuid, moving_tablet_id))) {
+      if (VERIFY_RESULT(GetTabletToMove(
+              high_load_uuid, low_load_uuid, load_variance, moving_tablet_id))) {
         // If we got this far, we have the candidate we want, so fill in the output params and
         // return. The tablet_id is filled in from GetTabletToMove.
         *from_ts = high_load_uuid;
@@ -628,7 +734,8 @@ Result<bool> ClusterLoadBalancer::ShouldSkipLeaderAsVictim(const TabletId& table
 }
 
 Result<bool> ClusterLoadBalancer::GetTabletToMove(
-    const TabletServerId& from_ts, const TabletServerId& to_ts, TabletId* moving_tablet_id) {
+    const TabletServerId& from_ts, const TabletServerId& to_ts, double load_variance,
+    TabletId* moving_tablet_id) {
   const auto& from_ts_meta = state_->per_ts_meta_[from_ts];
   set<TabletId> non_over_replicated_tablets;
   set<TabletId> all_tablets;
@@ -663,6 +770,11 @@ Result<bool> ClusterLoadBalancer::GetTabletToMove(
     if (!placement_info.placement_blocks().empty() && !same_placement) {
       continue;
     }
+    // Skip this tablet if it weighs more than half of the load difference between the two TSs:
+    // to_ts would end up more loaded than from_ts, and the next runs could move it back.
+    if (2 * state_->GetTabletWeight(tablet_id) > load_variance) {
+      continue;
+    }
     // Skip this tablet if we are trying to move away from the leader, as we would like to avoid
     // extra leader stepdowns. If table is in RF > 1 universe only, we skip leader as victim here.
     if (state_->per_tablet_meta_[tablet_id].leader_uuid == from_ts &&
@@ -746,8 +858,8 @@ Result<bool> ClusterLoadBalancer::GetLeaderToMove(
       const TabletServerId& high_load_uuid = state_->sorted_leader_load_[right];
       auto high_leader_blacklisted = (state_->leader_blacklisted_servers_.find(high_load_uuid) !=
           state_->leader_blacklisted_servers_.end());
-      int load_variance =
-          state_->GetLeaderLoad(high_load_uuid) - state_->GetLeaderLoad(low_load_uuid);
+      double load_variance = state_->GetWeightedLeaderLoad(high_load_uuid) -
+                             state_->GetWeightedLeaderLoad(low_load_uuid);
 
       // Check for state change or end conditions.
       if (left == right || (load_variance < state_->options_->kMinLeaderLoadVarianceToBalance &&
@@ -770,6 +882,10 @@ Result<bool> ClusterLoadBalancer::GetLeaderToMove(
       std::set_intersection(leaders.begin(), leaders.end(), peers.begin(), peers.end(), itr);
 
       for (const auto& tablet_id : intersection) {
+        // As in GetTabletToMove, do not make the lower loaded TS the more loaded one.
+        if (!high_leader_blacklisted && 2 * state_->GetTabletWeight(tablet_id) > load_variance) {
+          continue;
+        }
         *moving_tablet_id = tablet_id;
         *from_ts = high_load_uuid;
         *to_ts = low_load_uuid;
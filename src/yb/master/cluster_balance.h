@@ -152,6 +152,10 @@ class ClusterLoadBalancer {
   // Recreates the ClusterLoadState object.
   virtual void ResetState();
 
+  // Weighs each tablet of the table being balanced by the SST file size, ops/sec and write ops/sec
+  // its replicas report in their heartbeats, relative to the other tablets of the table.
+  void UpdateTabletWeights();
+
   // Goes over the tablet_map_ and the set of live TSDescriptors to compute the load distribution
   // across the tablets for the given table. Returns an OK status if the method succeeded or an
   // error if there are transient errors in updating the internal state.
@@ -214,8 +218,11 @@ class ClusterLoadBalancer {
   Result<bool> GetLoadToMove(
       TabletId* moving_tablet_id, TabletServerId* from_ts, TabletServerId* to_ts);
 
+  // Picks a tablet that can be moved from from_ts to to_ts, and that weighs at most half of the
+  // given difference of load between them.
   Result<bool> GetTabletToMove(
-      const TabletServerId& from_ts, const TabletServerId& to_ts, TabletId* moving_tablet_id);
+      const TabletServerId& from_ts, const TabletServerId& to_ts, double load_variance,
+      TabletId* moving_tablet_id);
 
   // Go through sorted_leader_load_ and figure out which leader to rebalance and from which TS
   // that is serving it to which other TS.
@@ -192,8 +192,8 @@ class ClusterLoadState {
 
   // Comparators used for sorting by load.
   bool CompareByUuid(const TabletServerId& a, const TabletServerId& b) {
-    int load_a = GetLoad(a);
-    int load_b = GetLoad(b);
+    double load_a = GetWeightedLoad(a);
+    double load_b = GetWeightedLoad(b);
     if (load_a == load_b) {
       return a < b;
     } else {
@@ -234,7 +234,7 @@ class ClusterLoadState {
       }
 
       // Secondary criteria: tserver leader load.
-      return state_->GetLeaderLoad(a) < state_->GetLeaderLoad(b);
+      return state_->GetWeightedLeaderLoad(a) < state_->GetWeightedLeaderLoad(b);
     }
     ClusterLoadState* state_;
   };
@@ -250,6 +250,41 @@ class ClusterLoadState {
     return per_ts_meta_.at(ts_uuid).leaders.size();
   }
 
+  // Get the weight of each replica of a certain tablet, see tablet_weights_.
+  double GetTabletWeight(const TabletId& tablet_id) const {
+    auto it = tablet_weights_.find(tablet_id);
+    return it == tablet_weights_.end() ? 1.0 : it->second;
+  }
+
+  // Get the load for a certain TS, with each replica counted by its weight. This is what the
+  // balancer equalizes.
+  double GetWeightedLoad(const TabletServerId& ts_uuid) const {
+    if (tablet_weights_.empty()) {
+      return GetLoad(ts_uuid);
+    }
+    const auto& ts_meta = per_ts_meta_.at(ts_uuid);
+    double load = 0;
+    for (const auto& tablet_id : ts_meta.running_tablets) {
+      load += GetTabletWeight(tablet_id);
+    }
+    for (const auto& tablet_id : ts_meta.starting_tablets) {
+      load += GetTabletWeight(tablet_id);
+    }
+    return load;
+  }
+
+  // Get the leader load for a certain TS, with each leader counted by the weight of its tablet.
+  double GetWeightedLeaderLoad(const TabletServerId& ts_uuid) const {
+    if (tablet_weights_.empty()) {
+      return GetLeaderLoad(ts_uuid);
+    }
+    double load = 0;
+    for (const auto& tablet_id : per_ts_meta_.at(ts_uuid).leaders) {
+      load += GetTabletWeight(tablet_id);
+    }
+    return load;
+  }
+
   void SetBlacklist(const BlacklistPB& blacklist) { blacklist_ = blacklist; }
   void SetLeaderBlacklist(const BlacklistPB& leader_blacklist) {
     leader_blacklist_ = leader_blacklist;
@@ -665,6 +700,11 @@ class ClusterLoadState {
   // Map from tablet server ids to the metadata we store for each.
   unordered_map<TabletServerId, CBTabletServerMetadata> per_ts_meta_;
 
+  // Map from tablet ids to the weight of each of their replicas, relative to the average tablet of
+  // the table, as computed from the heartbeat metrics by the load balancer. Unless
+  // load_balancer_use_tablet_metrics is set, the map is empty and every replica counts for one.
+  unordered_map<TabletId, double> tablet_weights_;
+
   // Map from table id to placement information for this table. This will be used for both
   // determining over-replication, by checking num_replicas, but also for az awareness, by keeping
   // track of the placement block policies between cluster and table level.
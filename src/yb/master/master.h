@@ -153,6 +153,8 @@ class Master : public server::RpcAndWebServerBase {
  protected:
   virtual CHECKED_STATUS RegisterServices();
 
+  bool UseRpcCompression() const override { return true; }
+
   void DisplayGeneralInfoIcons(std::stringstream* output);
 
  private:
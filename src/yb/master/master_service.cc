@@ -65,6 +65,8 @@ DEFINE_test_flag(int32, master_inject_latency_on_transactional_tablet_lookups_ms
 DEFINE_double(master_slow_get_registration_probability, 0,
               "Probability of injecting delay in GetMasterRegistration.");
 
+DECLARE_bool(load_balancer_use_tablet_metrics);
+
 using namespace std::literals;
 
 namespace yb {
@@ -192,6 +194,11 @@ void MasterServiceImpl::TSHeartbeat(const TSHeartbeatRequestPB* req,
     }
   }
 
+  if (req->tablet_split_candidates_size() > 0) {
+    server_->catalog_manager()->ProcessTabletSplitCandidates(
+        ts_desc.get(), req->tablet_split_candidates());
+  }
+
   if (!ts_desc->has_tablet_report()) {
     resp->set_needs_full_tablet_report(true);
   }
@@ -207,6 +214,8 @@ void MasterServiceImpl::TSHeartbeat(const TSHeartbeatRequestPB* req,
   uint64_t version = server_->catalog_manager()->GetYsqlCatalogVersion();
   resp->set_ysql_catalog_version(version);
 
+  resp->set_report_tablet_loads(FLAGS_load_balancer_use_tablet_metrics);
+
   rpc.RespondSuccess();
 }
 
@@ -257,6 +257,13 @@ void TSDescriptor::UpdateMetrics(const TServerMetricsPB& metrics) {
   ts_metrics_.read_ops_per_sec = metrics.read_ops_per_sec();
   ts_metrics_.write_ops_per_sec = metrics.write_ops_per_sec();
   ts_metrics_.uptime_seconds = metrics.uptime_seconds();
+  ts_metrics_.tablet_loads.clear();
+  for (const auto& tablet_load_pb : metrics.tablet_loads()) {
+    auto& tablet_load = ts_metrics_.tablet_loads[tablet_load_pb.tablet_id()];
+    tablet_load.sst_file_size = tablet_load_pb.sst_file_size();
+    tablet_load.read_ops_per_sec = tablet_load_pb.read_ops_per_sec();
+    tablet_load.write_ops_per_sec = tablet_load_pb.write_ops_per_sec();
+  }
 }
 
 bool TSDescriptor::HasTabletDeletePending() const {
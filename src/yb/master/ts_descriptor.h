@@ -37,6 +37,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include "yb/gutil/gscoped_ptr.h"
 
@@ -238,6 +239,30 @@ class TSDescriptor {
     return ts_metrics_.uptime_seconds;
   }
 
+  // Resources used by one of the tablet replicas hosted by this tablet server, as reported in its
+  // last heartbeat with metrics.
+  struct TabletLoad {
+    uint64_t sst_file_size = 0;
+    double read_ops_per_sec = 0;
+    double write_ops_per_sec = 0;
+  };
+
+  void set_tablet_load(const std::string& tablet_id, const TabletLoad& load) {
+    std::lock_guard<decltype(lock_)> l(lock_);
+    ts_metrics_.tablet_loads[tablet_id] = load;
+  }
+
+  // Returns false if the load of the given tablet was not reported by this tablet server.
+  bool GetTabletLoad(const std::string& tablet_id, TabletLoad* load) const {
+    SharedLock<decltype(lock_)> l(lock_);
+    auto it = ts_metrics_.tablet_loads.find(tablet_id);
+    if (it == ts_metrics_.tablet_loads.end()) {
+      return false;
+    }
+    *load = it->second;
+    return true;
+  }
+
   void UpdateMetrics(const TServerMetricsPB& metrics);
 
   void ClearMetrics() {
@@ -303,6 +328,8 @@ class TSDescriptor {
 
     uint64_t uptime_seconds = 0;
 
+    std::unordered_map<std::string, TabletLoad> tablet_loads;
+
     void ClearMetrics() {
       total_memory_usage = 0;
       total_sst_file_size = 0;
@@ -311,6 +338,7 @@ class TSDescriptor {
       read_ops_per_sec = 0;
       write_ops_per_sec = 0;
       uptime_seconds = 0;
+      tablet_loads.clear();
     }
   };
 
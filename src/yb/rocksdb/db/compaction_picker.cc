@@ -60,6 +60,14 @@ uint64_t TotalCompensatedFileSize(const std::vector<FileMetaData*>& files) {
   return sum;
 }
 
+uint64_t TotalInputsSize(const std::vector<CompactionInputFiles>& inputs) {
+  uint64_t sum = 0;
+  for (const auto& input : inputs) {
+    sum += TotalFileSize(input.files);
+  }
+  return sum;
+}
+
 // Universal compaction is not supported in ROCKSDB_LITE
 #ifndef ROCKSDB_LITE
 
@@ -155,6 +163,20 @@ CompressionType GetCompressionType(const ImmutableCFOptions& ioptions,
   }
 }
 
+// Determine compression type of universal compaction output, based on its estimated size.
+// Large outputs are compressed with large_output_compression if it is configured, otherwise
+// the compression type is determined by GetCompressionType.
+CompressionType GetUniversalCompressionType(const ImmutableCFOptions& ioptions,
+                                            int level, uint64_t estimated_output_size,
+                                            const bool enable_compression) {
+  const auto& options = ioptions.compaction_options_universal;
+  if (enable_compression && options.large_output_compression_threshold > 0 &&
+      estimated_output_size >= options.large_output_compression_threshold) {
+    return options.large_output_compression;
+  }
+  return GetCompressionType(ioptions, level, 1, enable_compression);
+}
+
 CompactionPicker::CompactionPicker(const ImmutableCFOptions& ioptions,
                                    const InternalKeyComparator* icmp)
     : ioptions_(ioptions), icmp_(icmp) {}
@@ -511,11 +533,13 @@ std::unique_ptr<Compaction> CompactionPicker::CompactRange(
         return nullptr;
       }
     }
+    // All files are compacted together, so output size is estimated by total size of inputs.
+    const auto compression = GetUniversalCompressionType(
+        ioptions_, output_level, TotalInputsSize(inputs));
     auto c = std::make_unique<Compaction>(
         vstorage, mutable_cf_options, std::move(inputs), output_level,
         mutable_cf_options.MaxFileSizeForLevel(output_level),
-        /* max_grandparent_overlap_bytes */ LLONG_MAX, output_path_id,
-        GetCompressionType(ioptions_, output_level, 1),
+        /* max_grandparent_overlap_bytes */ LLONG_MAX, output_path_id, compression,
         /* grandparents */ std::vector<FileMetaData*>(), /* is manual */ true);
     if (start_level == 0) {
       level0_compactions_in_progress_.insert(c.get());
@@ -611,13 +635,16 @@ std::unique_ptr<Compaction> CompactionPicker::CompactRange(
 
   std::vector<FileMetaData*> grandparents;
   GetGrandparents(vstorage, inputs, output_level_inputs, &grandparents);
+  const auto compression =
+      ioptions_.compaction_style == kCompactionStyleUniversal
+          ? GetUniversalCompressionType(
+                ioptions_, output_level, TotalInputsSize(compaction_inputs))
+          : GetCompressionType(ioptions_, output_level, vstorage->base_level());
   auto compaction = std::make_unique<Compaction>(
       vstorage, mutable_cf_options, std::move(compaction_inputs), output_level,
       mutable_cf_options.MaxFileSizeForLevel(output_level),
       mutable_cf_options.MaxGrandParentOverlapBytes(input_level),
-      output_path_id,
-      GetCompressionType(ioptions_, output_level, vstorage->base_level()),
-      std::move(grandparents), /* is manual compaction */ true);
+      output_path_id, compression, std::move(grandparents), /* is manual compaction */ true);
 
   TEST_SYNC_POINT_CALLBACK("CompactionPicker::CompactRange:Return", compaction.get());
   if (input_level == 0) {
@@ -1671,8 +1698,12 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalRe
   }
 
   uint64_t estimated_total_size = 0;
+  uint64_t estimated_output_size = 0;
   for (unsigned int i = 0; i < first_index_after; i++) {
     estimated_total_size += sorted_runs[i].size;
+    if (i >= start_index) {
+      estimated_output_size += sorted_runs[i].size;
+    }
   }
   uint32_t path_id = GetPathId(ioptions_, estimated_total_size);
   int start_level = sorted_runs[start_index].level;
@@ -1715,7 +1746,8 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalRe
   return std::make_unique<Compaction>(
       vstorage, mutable_cf_options, std::move(inputs), output_level,
       mutable_cf_options.MaxFileSizeForLevel(output_level), LLONG_MAX, path_id,
-      GetCompressionType(ioptions_, start_level, 1, enable_compression),
+      GetUniversalCompressionType(
+          ioptions_, start_level, estimated_output_size, enable_compression),
       /* grandparents */ std::vector<FileMetaData*>(), /* is manual */ false, score,
       false /* deletion_compaction */, compaction_reason);
 }
@@ -1837,7 +1869,8 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalSi
       vstorage->num_levels() - 1,
       mutable_cf_options.MaxFileSizeForLevel(vstorage->num_levels() - 1),
       /* max_grandparent_overlap_bytes */ LLONG_MAX, path_id,
-      GetCompressionType(ioptions_, vstorage->num_levels() - 1, 1),
+      GetUniversalCompressionType(
+          ioptions_, vstorage->num_levels() - 1, estimated_total_size),
       /* grandparents */ std::vector<FileMetaData*>(), /* is manual */ false, score,
       false /* deletion_compaction */,
       CompactionReason::kUniversalSizeAmplification);
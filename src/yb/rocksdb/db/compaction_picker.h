@@ -373,6 +373,10 @@ CompressionType GetCompressionType(const ImmutableCFOptions& ioptions,
                                    int level, int base_level,
                                    const bool enable_compression = true);
 
+CompressionType GetUniversalCompressionType(const ImmutableCFOptions& ioptions,
+                                            int level, uint64_t estimated_output_size,
+                                            const bool enable_compression = true);
+
 }  // namespace rocksdb
 
 #endif // YB_ROCKSDB_DB_COMPACTION_PICKER_H
@@ -876,6 +876,91 @@ TEST_P(DBTestUniversalCompactionWithParam, UniversalCompactionCompressRatio2) {
   ASSERT_LT(TotalSize(), 120000U * 12 * 0.8 + 120000 * 2);
 }
 
+TEST_P(DBTestUniversalCompactionWithParam, UniversalCompactionLargeOutputCompression) {
+  if (!Snappy_Supported()) {
+    return;
+  }
+  Options options;
+  options.compaction_style = kCompactionStyleUniversal;
+  options.write_buffer_size = 100 << 10;     // 100KB
+  options.target_file_size_base = 32 << 10;  // 32KB
+  options.level0_file_num_compaction_trigger = 2;
+  options.num_levels = num_levels_;
+  options.compaction_options_universal.large_output_compression_threshold = 300 << 10;  // 300KB
+  options.compaction_options_universal.large_output_compression = kSnappyCompression;
+  options = CurrentOptions(options);
+  options.compression = kNoCompression;
+  DestroyAndReopen(options);
+
+  Random rnd(301);
+  int key_idx = 0;
+
+  // The first compaction (2) is smaller than threshold, so it is not compressed.
+  for (int num = 0; num < 2; num++) {
+    // Write 110KB (11 values, each 10K)
+    for (int i = 0; i < 11; i++) {
+      ASSERT_OK(Put(Key(key_idx), CompressibleString(&rnd, 10000)));
+      key_idx++;
+    }
+    dbfull()->TEST_WaitForFlushMemTable();
+    dbfull()->TEST_WaitForCompact();
+  }
+  ASSERT_GT(TotalSize(), 110000U * 2 * 0.9);
+
+  // The second compaction (4) reaches threshold and is compressed.
+  for (int num = 0; num < 2; num++) {
+    // Write 110KB (11 values, each 10K)
+    for (int i = 0; i < 11; i++) {
+      ASSERT_OK(Put(Key(key_idx), CompressibleString(&rnd, 10000)));
+      key_idx++;
+    }
+    dbfull()->TEST_WaitForFlushMemTable();
+    dbfull()->TEST_WaitForCompact();
+  }
+  ASSERT_LT(TotalSize(), 110000U * 4 * 0.9);
+}
+
+TEST_P(DBTestUniversalCompactionWithParam, ManualCompactionLargeOutputCompression) {
+  if (!Snappy_Supported()) {
+    return;
+  }
+  Options options;
+  options.compaction_style = kCompactionStyleUniversal;
+  options.write_buffer_size = 100 << 10;     // 100KB
+  options.num_levels = num_levels_;
+  options.disable_auto_compactions = true;
+  options.compaction_options_universal.large_output_compression_threshold = 300 << 10;  // 300KB
+  options.compaction_options_universal.large_output_compression = kSnappyCompression;
+  options = CurrentOptions(options);
+  options.compression = kNoCompression;
+  DestroyAndReopen(options);
+
+  Random rnd(301);
+  int key_idx = 0;
+  auto write_files = [this, &rnd, &key_idx](int num_files) {
+    for (int num = 0; num < num_files; num++) {
+      // Write 110KB (11 values, each 10K)
+      for (int i = 0; i < 11; i++) {
+        ASSERT_OK(Put(Key(key_idx), CompressibleString(&rnd, 10000)));
+        key_idx++;
+      }
+      ASSERT_OK(Flush());
+    }
+  };
+  CompactRangeOptions compact_options;
+  compact_options.exclusive_manual_compaction = exclusive_manual_compaction_;
+
+  // Output of manual compaction is smaller than threshold, so it is not compressed.
+  write_files(2);
+  ASSERT_OK(db_->CompactRange(compact_options, nullptr, nullptr));
+  ASSERT_GT(TotalSize(), 110000U * 2 * 0.9);
+
+  // Output of full manual compaction reaches threshold and is compressed.
+  write_files(2);
+  ASSERT_OK(db_->CompactRange(compact_options, nullptr, nullptr));
+  ASSERT_LT(TotalSize(), 110000U * 4 * 0.9);
+}
+
 // Test that checks trivial move in universal compaction
 TEST_P(DBTestUniversalCompactionWithParam, UniversalCompactionTrivialMoveTest1) {
   int32_t trivial_move = 0;
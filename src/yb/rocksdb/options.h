@@ -93,7 +93,9 @@ enum CompressionType : char {
   kBZip2Compression = 0x3,
   kLZ4Compression = 0x4,
   kLZ4HCCompression = 0x5,
-  // zstd format is not finalized yet so it's subject to changes.
+  // Blocks are compressed with a plain zstd frame, same as kZSTDNotFinalCompression.
+  kZSTD = 0x7,
+  // Pre-finalized zstd type id, still readable and writable for compatibility with existing files.
   kZSTDNotFinalCompression = 0x40,
 };
 
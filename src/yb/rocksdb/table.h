@@ -120,6 +120,8 @@ struct BlockBasedTableOptions {
 
   // If non-NULL use the specified cache for compressed blocks.
   // If NULL, rocksdb will not use a compressed block cache.
+  // The cache is only filled on read, with blocks missing from block_cache. Blocks written by
+  // flushes and compactions are not inserted, so they don't evict the blocks being read.
   std::shared_ptr<Cache> block_cache_compressed = nullptr;
 
   // Approximate size of user data packed per block, in bytes. Note that the
@@ -61,7 +61,6 @@
 #include "yb/rocksdb/util/stop_watch.h"
 #include "yb/rocksdb/util/xxhash.h"
 
-#include "yb/util/mem_tracker.h"
 #include "yb/util/string_util.h"
 
 #include "yb/gutil/macros.h"
@@ -161,6 +160,7 @@ Slice CompressBlock(const Slice& raw,
         return *compressed_output;
       }
       break;     // fall back to no compression.
+    case kZSTD:
     case kZSTDNotFinalCompression:
       if (ZSTD_Compress(compression_options, raw.cdata(), raw.size(),
                         compressed_output) &&
@@ -237,7 +237,7 @@ class BlockBasedTableBuilder::BlockBasedTablePropertiesCollector
 // Originally following data was stored in BlockBasedTableBuilder::Rep and related to a single SST
 // file. Since SST file is now split into two types of files - data file and metadata file,
 // all file-related data was moved into dedicated structure for each file.
-struct BlockBasedTableBuilder::FileWriterWithOffsetAndCachePrefix {
+struct BlockBasedTableBuilder::FileWriterWithOffset {
   // Pointer to file writer. BlockBasedTableBuilder constructor accepts raw pointers to
   // WritableFileWriter and it is responsibility of client code to delete writer instance after
   // usage.
@@ -245,16 +245,6 @@ struct BlockBasedTableBuilder::FileWriterWithOffsetAndCachePrefix {
 
   // Current offset.
   uint64_t offset = 0;
-
-  // BlockBasedTableBuilder uses compressed block cache passed to BlockBasedTableBuilder constructor
-  // inside BlockBasedTableOptions instance. If that cache is set in options (off by default)
-  // all data written to files is also put into compressed block cache to reduce number of file
-  // read requests later during read operations.
-  // File blocks are referred in cache by keys, which are composed from following data (see
-  // BlockBasedTableBuilder::InsertBlockInCache):
-  // - cache key prefix (unique for each file), generated by GenerateCachePrefix
-  // - block offset within a file.
-  block_based_table::CacheKeyPrefixBuffer compressed_cache_key_prefix;
 };
 
 struct BlockBasedTableBuilder::Rep {
@@ -270,8 +260,8 @@ struct BlockBasedTableBuilder::Rep {
   // value) for handling both cases. At the level of BlockBasedTableBuilder implementation both
   // writers (inside BlockBasedTableBuilder::Rep) are not null and refer to
   // the same file or separate files.
-  std::shared_ptr<FileWriterWithOffsetAndCachePrefix> metadata_writer;
-  std::shared_ptr<FileWriterWithOffsetAndCachePrefix> data_writer;
+  std::shared_ptr<FileWriterWithOffset> metadata_writer;
+  std::shared_ptr<FileWriterWithOffset> data_writer;
   Status status;
 
   FilterType filter_type;
@@ -301,8 +291,6 @@ struct BlockBasedTableBuilder::Rep {
 
   std::vector<std::unique_ptr<IntTblPropCollector>> table_properties_collectors;
 
-  yb::MemTrackerPtr mem_tracker;
-
   Rep(const ImmutableCFOptions& _ioptions,
       const BlockBasedTableOptions& table_opt,
       const InternalKeyComparatorPtr& icomparator,
@@ -371,15 +359,10 @@ BlockBasedTableBuilder::Rep::Rep(
       flush_block_policy(
           table_options.flush_block_policy_factory->NewFlushBlockPolicy(
               table_options, data_block_builder)) {
-  if (_ioptions.mem_tracker) {
-    mem_tracker = yb::MemTracker::FindOrCreateTracker(
-        "BlockBasedTableBuilder", _ioptions.mem_tracker);
-  }
-
-  metadata_writer = std::make_shared<FileWriterWithOffsetAndCachePrefix>();
+  metadata_writer = std::make_shared<FileWriterWithOffset>();
   metadata_writer->writer = metadata_file;
   if (data_file != nullptr) {
-    data_writer = std::make_shared<FileWriterWithOffsetAndCachePrefix>();
+    data_writer = std::make_shared<FileWriterWithOffset>();
     data_writer->writer = data_file;
   } else {
     data_writer = metadata_writer;
@@ -423,16 +406,6 @@ BlockBasedTableBuilder::BlockBasedTableBuilder(
   if (rep_->filter_block_builder != nullptr) {
     rep_->filter_block_builder->StartBlock(0);
   }
-  if (table_options.block_cache_compressed.get() != nullptr) {
-    GenerateCachePrefix(
-        table_options.block_cache_compressed.get(), metadata_file->writable_file(),
-        &rep_->metadata_writer->compressed_cache_key_prefix);
-    if (rep_->is_split_sst()) {
-      GenerateCachePrefix(
-          table_options.block_cache_compressed.get(), data_file->writable_file(),
-          &rep_->metadata_writer->compressed_cache_key_prefix);
-    }
-  }
 }
 
 BlockBasedTableBuilder::~BlockBasedTableBuilder() {
@@ -563,7 +536,7 @@ void BlockBasedTableBuilder::FlushFilterBlock(const Slice& next_block_first_key)
 
 size_t BlockBasedTableBuilder::WriteBlock(BlockBuilder* block,
                                           BlockHandle* handle,
-                                          FileWriterWithOffsetAndCachePrefix* writer_info) {
+                                          FileWriterWithOffset* writer_info) {
   size_t block_size = WriteBlock(block->Finish(), handle, writer_info);
   block->Reset();
   return block_size;
@@ -571,7 +544,7 @@ size_t BlockBasedTableBuilder::WriteBlock(BlockBuilder* block,
 
 size_t BlockBasedTableBuilder::WriteBlock(const Slice& raw_block_contents,
                                           BlockHandle* handle,
-                                          FileWriterWithOffsetAndCachePrefix* writer_info) {
+                                          FileWriterWithOffset* writer_info) {
   // File format contains a sequence of blocks where each block has:
   //    block_data: uint8[n]
   //    type: uint8
@@ -598,7 +571,7 @@ size_t BlockBasedTableBuilder::WriteBlock(const Slice& raw_block_contents,
 size_t BlockBasedTableBuilder::WriteRawBlock(const Slice& block_contents,
                                              CompressionType type,
                                              BlockHandle* handle,
-                                             FileWriterWithOffsetAndCachePrefix* writer_info) {
+                                             FileWriterWithOffset* writer_info) {
   Rep* r = rep_;
   StopWatch sw(r->ioptions.env, r->ioptions.statistics, WRITE_RAW_BLOCK_MICROS);
   const auto start_offset = writer_info->offset;
@@ -636,9 +609,6 @@ size_t BlockBasedTableBuilder::WriteRawBlock(const Slice& block_contents,
     }
 
     r->status = writer_info->writer->Append(Slice(trailer, kBlockTrailerSize));
-    if (r->status.ok()) {
-      r->status = InsertBlockInCache(block_contents, type, handle, writer_info);
-    }
     if (r->status.ok()) {
       writer_info->offset += block_contents.size() + kBlockTrailerSize;
     }
@@ -650,51 +620,6 @@ Status BlockBasedTableBuilder::status() const {
   return rep_->status;
 }
 
-static void DeleteCachedBlock(const Slice& key, void* value) {
-  Block* block = reinterpret_cast<Block*>(value);
-  delete block;
-}
-
-//
-// Make a copy of the block contents and insert into compressed block cache
-//
-Status BlockBasedTableBuilder::InsertBlockInCache(const Slice& block_contents,
-                                                  const CompressionType type,
-                                                  const BlockHandle* handle,
-                                                  FileWriterWithOffsetAndCachePrefix* writer_info) {
-  Rep* r = rep_;
-  Cache* block_cache_compressed = r->table_options.block_cache_compressed.get();
-
-  if (type != kNoCompression && block_cache_compressed != nullptr) {
-
-    size_t size = block_contents.size();
-
-    std::unique_ptr<char[]> ubuf(new char[size + 1]);
-    memcpy(ubuf.get(), block_contents.data(), size);
-    ubuf[size] = type;
-
-    BlockContents results(std::move(ubuf), size, true, type, r->mem_tracker);
-
-    Block* block = new Block(std::move(results));
-
-    // make cache key by appending the file offset to the cache prefix id
-    char* end = EncodeVarint64(
-                  writer_info->compressed_cache_key_prefix.data +
-                  writer_info->compressed_cache_key_prefix.size,
-                  handle->offset());
-    Slice key(writer_info->compressed_cache_key_prefix.data,
-        static_cast<size_t> (end - writer_info->compressed_cache_key_prefix.data));
-
-    // Insert into compressed block cache.
-    block_cache_compressed->Insert(key, kDefaultQueryId, block, block->usable_size(),
-                                   &DeleteCachedBlock);
-
-    // Invalidate OS cache.
-    writer_info->writer->InvalidateCache(static_cast<size_t>(writer_info->offset), size);
-  }
-  return Status::OK();
-}
-
 Status BlockBasedTableBuilder::Finish() {
   Rep* r = rep_;
   Slice end_slice;
@@ -103,22 +103,18 @@ class BlockBasedTableBuilder : public TableBuilder {
   TableProperties GetTableProperties() const override;
 
  private:
-  struct FileWriterWithOffsetAndCachePrefix;
+  struct FileWriterWithOffset;
 
   bool ok() const { return status().ok(); }
   // Call block's Finish() method and then write the finalize block contents to
   // file. Returns number of bytes written to file.
   size_t WriteBlock(BlockBuilder* block, BlockHandle* handle,
-      FileWriterWithOffsetAndCachePrefix* writer_info);
+      FileWriterWithOffset* writer_info);
   // Directly write block content to the file. Returns number of bytes written to file.
   size_t WriteBlock(const Slice& block_contents, BlockHandle* handle,
-      FileWriterWithOffsetAndCachePrefix* writer_info);
+      FileWriterWithOffset* writer_info);
   size_t WriteRawBlock(const Slice& data, CompressionType, BlockHandle* handle,
-      FileWriterWithOffsetAndCachePrefix* writer_info);
-  Status InsertBlockInCache(const Slice& block_contents,
-                            const CompressionType type,
-                            const BlockHandle* handle,
-                            FileWriterWithOffsetAndCachePrefix* writer_info);
+      FileWriterWithOffset* writer_info);
 
   struct Rep;
   class BlockBasedTablePropertiesCollectorFactory;
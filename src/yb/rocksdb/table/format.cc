@@ -496,6 +496,7 @@ Status UncompressBlockContents(const char* data, size_t n,
       *contents =
           BlockContents(std::move(ubuf), decompress_size, true, kNoCompression, mem_tracker);
       break;
+    case kZSTD:
     case kZSTDNotFinalCompression:
       ubuf =
           std::unique_ptr<char[]>(ZSTD_Uncompress(data, n, &decompress_size));
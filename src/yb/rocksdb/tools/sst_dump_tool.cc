@@ -212,6 +212,7 @@ int SstFileReader::ShowAllCompressionSizes(size_t block_size) {
       std::make_pair(CompressionType::kLZ4Compression, "kLZ4Compression"));
   compress_type.insert(
       std::make_pair(CompressionType::kLZ4HCCompression, "kLZ4HCCompression"));
+  compress_type.insert(std::make_pair(CompressionType::kZSTD, "kZSTD"));
   compress_type.insert(std::make_pair(CompressionType::kZSTDNotFinalCompression,
                                       "kZSTDNotFinalCompression"));
 
@@ -219,8 +220,9 @@ int SstFileReader::ShowAllCompressionSizes(size_t block_size) {
 
   for (CompressionType i = CompressionType::kNoCompression;
        i <= CompressionType::kZSTDNotFinalCompression;
-       i = (i == kLZ4HCCompression) ? kZSTDNotFinalCompression
-                                    : CompressionType(i + 1)) {
+       i = (i == kLZ4HCCompression) ? kZSTD
+           : (i == kZSTD) ? kZSTDNotFinalCompression
+                          : CompressionType(i + 1)) {
     CompressionOptions compress_opt;
     TableBuilderOptions tb_opts(imoptions,
                                 ikc,
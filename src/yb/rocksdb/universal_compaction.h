@@ -31,6 +31,8 @@ using yb::operator"" _MB;
 
 namespace rocksdb {
 
+enum CompressionType : char;
+
 //
 // Algorithm used to make a compaction request stop picking new files
 // into a single compaction run
@@ -87,6 +89,20 @@ class CompactionOptionsUniversal {
   // Default: -1
   int compression_size_percent;
 
+  // If this option is positive, output of a compaction whose estimated size is at least this
+  // number of bytes is compressed with large_output_compression instead of the compression type
+  // specified for the column family. So small, frequently rewritten runs could use a fast codec,
+  // while large and rarely rewritten runs use a codec with better ratio.
+  // Runs are tiered by size only, there is no tier by age of the data: with a single level, the
+  // size of a run is what tells how rarely it is rewritten.
+  // Has no effect when the output would not be compressed at all, see compression_size_percent.
+  // Default: 0
+  uint64_t large_output_compression_threshold = 0;
+
+  // Compression type of large compaction outputs, see large_output_compression_threshold.
+  // Default: kNoCompression
+  CompressionType large_output_compression = static_cast<CompressionType>(0);
+
   // The algorithm used to stop picking files into a single compaction run
   // Default: kCompactionStopStyleTotalSize
   CompactionStopStyle stop_style;
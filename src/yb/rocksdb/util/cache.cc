@@ -26,6 +26,9 @@
 #include <stdlib.h>
 #include <gflags/gflags.h>
 
+#include <algorithm>
+#include <vector>
+
 #include "yb/util/metrics.h"
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/statistics.h"
@@ -42,6 +45,12 @@
 DEFINE_double(cache_single_touch_ratio, 0.2,
               "fraction of the cache dedicated to single-touch items");
 
+// When enabled, a new item is admitted to the full single-touch cache only if it was looked up
+// more frequently than the item it would evict, so one-time scans do not flush the working set.
+DEFINE_bool(cache_tiny_lfu_admission, false,
+            "Admit new items into the single-touch cache based on their estimated access "
+            "frequency. Takes effect when cache capacity is set.");
+
 namespace rocksdb {
 
 Cache::~Cache() {
@@ -354,6 +363,78 @@ void LRUSubCache::LRU_Append(LRUHandle *e) {
   lru_usage_ += e->charge;
 }
 
+// Approximate counter of lookups per key hash (count-min sketch with 4-bit like counters).
+// Counters are halved after the number of increments reaches 10x the sketch width, so estimates
+// reflect recent history.
+class FrequencySketch {
+ public:
+  bool empty() const {
+    return table_.empty();
+  }
+
+  void Clear() {
+    table_.clear();
+    width_mask_ = 0;
+    additions_ = 0;
+    sample_size_ = 0;
+  }
+
+  // Reallocates the sketch for the expected number of distinct keys, dropping collected counts.
+  void Resize(size_t expected_entries) {
+    size_t width = kMinWidth;
+    while (width < expected_entries) {
+      width *= 2;
+    }
+    table_.assign(kDepth * width, 0);
+    width_mask_ = width - 1;
+    additions_ = 0;
+    sample_size_ = 10 * width;
+  }
+
+  void Increment(uint32_t hash) {
+    for (size_t row = 0; row != kDepth; ++row) {
+      auto& counter = table_[Index(hash, row)];
+      if (counter < kMaxCount) {
+        ++counter;
+      }
+    }
+    if (++additions_ >= sample_size_) {
+      for (auto& counter : table_) {
+        counter >>= 1;
+      }
+      additions_ /= 2;
+    }
+  }
+
+  uint8_t Estimate(uint32_t hash) const {
+    uint8_t result = kMaxCount;
+    for (size_t row = 0; row != kDepth; ++row) {
+      result = std::min(result, table_[Index(hash, row)]);
+    }
+    return result;
+  }
+
+ private:
+  static constexpr size_t kDepth = 4;
+  static constexpr size_t kMinWidth = 1024;
+  static constexpr uint8_t kMaxCount = 15;
+
+  size_t Index(uint32_t hash, size_t row) const {
+    static const uint64_t kSeeds[kDepth] = {
+        0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL,
+        0xcbf29ce484222325ULL };
+    uint64_t h = (hash + 1ULL) * kSeeds[row];
+    h += h >> 32;
+    return row * (width_mask_ + 1) + (h & width_mask_);
+  }
+
+  // kDepth rows of counters, each row has width_mask_ + 1 counters.
+  std::vector<uint8_t> table_;
+  size_t width_mask_ = 0;
+  size_t additions_ = 0;
+  size_t sample_size_ = 0;
+};
+
 class LRUHandleDeleter {
  public:
   explicit LRUHandleDeleter(yb::CacheMetrics* metrics) : metrics_(metrics) {}
@@ -449,6 +530,11 @@ class LRUCache {
   // Decrements the usage on the appropriate subcache.
   void DecrementUsage(const SubCacheType subcache_type, const size_t charge);
 
+  // Returns true if the new entry should be added to the sub cache. When the sub cache is full,
+  // the entry is admitted only if it was looked up more frequently than the entry that would be
+  // evicted for it.
+  bool Admit(const LRUHandle& e, LRUSubCache* sub_cache);
+
   // Whether to reject insertion if cache reaches its full capacity.
   bool strict_capacity_limit_;
 
@@ -459,6 +545,9 @@ class LRUCache {
 
   HandleTable table_;
 
+  // Lookup frequencies used for admission, empty if admission is disabled.
+  FrequencySketch sketch_;
+
   shared_ptr<yb::CacheMetrics> metrics_;
 };
 
@@ -486,6 +575,15 @@ void LRUCache::DecrementUsage(const SubCacheType subcache_type, const size_t cha
   GetSubCache(subcache_type)->DecrementUsage(charge);
 }
 
+bool LRUCache::Admit(const LRUHandle& e, LRUSubCache* sub_cache) {
+  if (sketch_.empty() || sub_cache->Usage() + e.charge <= sub_cache->Capacity() ||
+      sub_cache->IsLRUEmpty()) {
+    return true;
+  }
+  const LRUHandle* victim = sub_cache->LRU_Head().next;
+  return sketch_.Estimate(e.hash) > sketch_.Estimate(victim->hash);
+}
+
 // Call deleter and free
 
 void LRUCache::ApplyToAllCacheEntries(void (*callback)(void*, size_t),
@@ -535,6 +633,12 @@ void LRUCache::SetCapacity(size_t capacity) {
     single_touch_sub_cache_.SetCapacity(
       static_cast<size_t>(round(FLAGS_cache_single_touch_ratio * capacity)));
     multi_touch_sub_cache_.SetCapacity(capacity - single_touch_sub_cache_.Capacity());
+    if (FLAGS_cache_tiny_lfu_admission) {
+      // Size the sketch assuming 4KB per entry, smaller entries just share counters.
+      sketch_.Resize(capacity / 4096);
+    } else {
+      sketch_.Clear();
+    }
     EvictFromLRU(0, &last_reference_list, SINGLE_TOUCH);
     EvictFromLRU(0, &last_reference_list, MULTI_TOUCH);
   }
@@ -548,6 +652,9 @@ void LRUCache::SetStrictCapacityLimit(bool strict_capacity_limit) {
 Cache::Handle* LRUCache::Lookup(const Slice& key, uint32_t hash, const QueryId query_id,
                                 Statistics* statistics)  {
   MutexLock l(&mutex_);
+  if (!sketch_.empty()) {
+    sketch_.Increment(hash);
+  }
   LRUHandle* e = table_.Lookup(key, hash);
   if (e != nullptr) {
     assert(e->in_cache);
@@ -703,10 +810,27 @@ Status LRUCache::Insert(const Slice& key, uint32_t hash, const QueryId query_id,
     } else {
       subcache_type = table_.GetSubCacheTypeCandidate(e);
     }
-    EvictFromLRU(charge, &last_reference_list, subcache_type);
     LRUSubCache* sub_cache = GetSubCache(subcache_type);
-    // If the cache no longer has any more space in the given pool.
-    if (strict_capacity_limit_ &&
+    const bool admitted = subcache_type != SINGLE_TOUCH || Admit(*e, sub_cache);
+    if (admitted) {
+      EvictFromLRU(charge, &last_reference_list, subcache_type);
+    }
+    if (!admitted) {
+      // The entry is not added to the cache, but is still returned to the caller if requested.
+      e->in_cache = false;
+      if (handle == nullptr) {
+        e->refs = 0;
+        last_reference_list.Add(e);
+      } else {
+        e->refs = 1;
+        sub_cache->IncrementUsage(e->charge);
+        *handle = reinterpret_cast<Cache::Handle*>(e);
+      }
+      if (metrics_ != nullptr) {
+        metrics_->admission_rejects->Increment();
+      }
+      s = Status::OK();
+    } else if (strict_capacity_limit_ &&
         sub_cache->Usage() - sub_cache->LRU_Usage() + charge > sub_cache->Capacity()) {
       if (handle == nullptr) {
         last_reference_list.Add(e);
@@ -739,7 +863,7 @@ Status LRUCache::Insert(const Slice& key, uint32_t hash, const QueryId query_id,
       }
       s = Status::OK();
     }
-    if (statistics != nullptr) {
+    if (statistics != nullptr && admitted) {
       if (s.ok()) {
         RecordTick(statistics, BLOCK_CACHE_ADD);
         RecordTick(statistics, BLOCK_CACHE_BYTES_WRITE, charge);
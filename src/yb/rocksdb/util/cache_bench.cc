@@ -34,6 +34,10 @@ int main() {
 #include <stdio.h>
 #include <gflags/gflags.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
 #include "yb/rocksdb/db.h"
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/env.h"
@@ -60,15 +64,70 @@ DEFINE_int32(lookup_percent, 50,
              "Ratio of lookup to total workload (expressed as a percentage)");
 DEFINE_int32(erase_percent, 10,
              "Ratio of erase to total workload (expressed as a percentage)");
+DEFINE_int32(scan_percent, 0,
+             "Ratio of scans to total workload (expressed as a percentage). Scan looks up "
+             "scan_length consecutive keys within the same query, inserting missing ones.");
+DEFINE_int32(scan_length, 1000, "Number of keys looked up by a single scan.");
+DEFINE_double(zipf_theta, 0,
+              "Skew of key distribution of inserts, lookups and erases, 0 - uniform "
+              "distribution, otherwise should be less than 1 (e.g. 0.99).");
 
 namespace rocksdb {
 
 class CacheBench;
 namespace {
 void deleter(const Slice& key, void* value) {
-    delete reinterpret_cast<char *>(value);
+    delete[] reinterpret_cast<char *>(value);
 }
 
+// Generates keys in [0, num_items) with zipfian distribution, key 0 being the most popular.
+// Algorithm from "Quickly Generating Billion-Record Synthetic Databases", Gray et al.
+class ZipfianGenerator {
+ public:
+  ZipfianGenerator(uint64_t num_items, double theta)
+      : num_items_(num_items), theta_(theta), alpha_(1.0 / (1.0 - theta)),
+        zetan_(Zeta(num_items, theta)),
+        eta_((1.0 - std::pow(2.0 / num_items, 1.0 - theta)) / (1.0 - Zeta(2, theta) / zetan_)) {
+  }
+
+  uint64_t Next(Random* rnd) const {
+    const double u = static_cast<double>(rnd->Next()) / Random::kMaxNext;
+    const double uz = u * zetan_;
+    if (uz < 1.0) {
+      return 0;
+    }
+    if (uz < 1.0 + std::pow(0.5, theta_)) {
+      return 1;
+    }
+    return std::min<uint64_t>(
+        num_items_ - 1,
+        static_cast<uint64_t>(num_items_ * std::pow(eta_ * u - eta_ + 1.0, alpha_)));
+  }
+
+ private:
+  // Sum of 1 / i^theta for i in [1, n]. The tail after the first million items is approximated
+  // with an integral, so the generator could be created for a large key space quickly.
+  static double Zeta(uint64_t n, double theta) {
+    constexpr uint64_t kExactItems = 1000000;
+    double result = 0;
+    const uint64_t exact_items = std::min(n, kExactItems);
+    for (uint64_t i = 1; i <= exact_items; i++) {
+      result += 1.0 / std::pow(i, theta);
+    }
+    if (n > exact_items) {
+      result += (std::pow(n + 0.5, 1.0 - theta) - std::pow(exact_items + 0.5, 1.0 - theta)) /
+                (1.0 - theta);
+    }
+    return result;
+  }
+
+  const uint64_t num_items_;
+  const double theta_;
+  const double alpha_;
+  const double zetan_;
+  const double eta_;
+};
+
 // State shared by all concurrent executions of the same benchmark.
 class SharedState {
  public:
@@ -146,7 +205,11 @@ class CacheBench {
  public:
   CacheBench() :
       cache_(NewLRUCache(FLAGS_cache_size, FLAGS_num_shard_bits)),
-      num_threads_(FLAGS_threads) {}
+      num_threads_(FLAGS_threads) {
+    if (FLAGS_zipf_theta > 0) {
+      zipfian_.reset(new ZipfianGenerator(FLAGS_max_key, FLAGS_zipf_theta));
+    }
+  }
 
   ~CacheBench() {}
 
@@ -157,7 +220,7 @@ class CacheBench {
       // Cast uint64* to be char*, data would be copied to cache
       Slice key(reinterpret_cast<char*>(&rand_key), 8);
       // do insert
-      cache_->Insert(key, new char[10], 1, &deleter);
+      cache_->Insert(key, kDefaultQueryId, new char[10], 1, &deleter);
     }
   }
 
@@ -194,6 +257,11 @@ class CacheBench {
       uint32_t qps = static_cast<uint32_t>(
           static_cast<double>(FLAGS_threads * FLAGS_ops_per_thread) / elapsed);
       fprintf(stdout, "Complete in %.3f s; QPS = %u\n", elapsed, qps);
+      const uint64_t lookups = lookups_.load();
+      const uint64_t scan_lookups = scan_lookups_.load();
+      fprintf(stdout, "Point lookup hit ratio = %.4f; scan lookup hit ratio = %.4f\n",
+              lookups ? static_cast<double>(hits_.load()) / lookups : 0.0,
+              scan_lookups ? static_cast<double>(scan_hits_.load()) / scan_lookups : 0.0);
     }
     return true;
   }
@@ -201,6 +269,11 @@ class CacheBench {
  private:
   std::shared_ptr<Cache> cache_;
   uint32_t num_threads_;
+  std::unique_ptr<ZipfianGenerator> zipfian_;
+  std::atomic<uint64_t> lookups_{0};
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> scan_lookups_{0};
+  std::atomic<uint64_t> scan_hits_{0};
 
   static void ThreadBody(void* v) {
     ThreadState* thread = reinterpret_cast<ThreadState*>(v);
@@ -227,28 +300,60 @@ class CacheBench {
     }
   }
 
+  uint64_t NextKey(ThreadState* thread) {
+    return zipfian_ ? zipfian_->Next(&thread->rnd) : thread->rnd.Next() % FLAGS_max_key;
+  }
+
+  // Looks up the key, inserting it if missing. Returns true if the key was found.
+  bool LookupOrInsert(const Slice& key, QueryId query_id) {
+    auto handle = cache_->Lookup(key, query_id);
+    if (handle) {
+      cache_->Release(handle);
+      return true;
+    }
+    cache_->Insert(key, query_id, new char[10], 1, &deleter);
+    return false;
+  }
+
+  void Scan(ThreadState* thread, QueryId query_id) {
+    uint64_t start_key = thread->rnd.Next() % FLAGS_max_key;
+    uint64_t hits = 0;
+    for (int i = 0; i < FLAGS_scan_length; i++) {
+      uint64_t scan_key = (start_key + i) % FLAGS_max_key;
+      Slice key(reinterpret_cast<char*>(&scan_key), 8);
+      hits += LookupOrInsert(key, query_id);
+    }
+    scan_lookups_ += FLAGS_scan_length;
+    scan_hits_ += hits;
+  }
+
   void OperateCache(ThreadState* thread) {
+    uint64_t lookups = 0;
+    uint64_t hits = 0;
     for (uint64_t i = 0; i < FLAGS_ops_per_thread; i++) {
-      uint64_t rand_key = thread->rnd.Next() % FLAGS_max_key;
+      // Every operation is executed as a separate query.
+      const QueryId query_id = (static_cast<QueryId>(thread->tid) << 40) + i + 1;
+      uint64_t rand_key = NextKey(thread);
       // Cast uint64* to be char*, data would be copied to cache
       Slice key(reinterpret_cast<char*>(&rand_key), 8);
       int32_t prob_op = thread->rnd.Uniform(100);
-      if (prob_op >= 0 && prob_op < FLAGS_insert_percent) {
+      if (prob_op < FLAGS_insert_percent) {
         // do insert
-        cache_->Insert(key, new char[10], 1, &deleter);
-      } else if (prob_op -= FLAGS_insert_percent &&
-                 prob_op < FLAGS_lookup_percent) {
-        // do lookup
-        auto handle = cache_->Lookup(key);
-        if (handle) {
-          cache_->Release(handle);
-        }
-      } else if (prob_op -= FLAGS_lookup_percent &&
-                 prob_op < FLAGS_erase_percent) {
+        cache_->Insert(key, query_id, new char[10], 1, &deleter);
+      } else if ((prob_op -= FLAGS_insert_percent) < FLAGS_lookup_percent) {
+        // do lookup, inserting missing key as block based table does
+        ++lookups;
+        hits += LookupOrInsert(key, query_id);
+      } else if ((prob_op -= FLAGS_lookup_percent) < FLAGS_erase_percent) {
         // do erase
         cache_->Erase(key);
+      } else if ((prob_op -= FLAGS_erase_percent) < FLAGS_scan_percent) {
+        // do scan
+        Scan(thread, query_id);
       }
     }
+    lookups_ += lookups;
+    hits_ += hits;
   }
 
   void PrintEnv() const {
@@ -261,6 +366,9 @@ class CacheBench {
     printf("Insert percentage   : %d%%\n", FLAGS_insert_percent);
     printf("Lookup percentage   : %d%%\n", FLAGS_lookup_percent);
     printf("Erase percentage    : %d%%\n", FLAGS_erase_percent);
+    printf("Scan percentage     : %d%%\n", FLAGS_scan_percent);
+    printf("Scan length         : %d\n", FLAGS_scan_length);
+    printf("Zipf theta          : %.3f\n", FLAGS_zipf_theta);
     printf("----------------------------\n");
   }
 };
@@ -274,6 +382,11 @@ int main(int argc, char** argv) {
     exit(1);
   }
 
+  if (FLAGS_zipf_theta < 0 || FLAGS_zipf_theta >= 1) {
+    fprintf(stderr, "zipf_theta should be in [0, 1)\n");
+    exit(1);
+  }
+
   rocksdb::CacheBench bench;
   if (FLAGS_populate_cache) {
     bench.PopulateCache();
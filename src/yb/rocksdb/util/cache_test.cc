@@ -33,6 +33,7 @@
 #include "yb/rocksdb/util/testharness.h"
 
 DECLARE_double(cache_single_touch_ratio);
+DECLARE_bool(cache_tiny_lfu_admission);
 
 namespace rocksdb {
 
@@ -463,6 +464,56 @@ TEST_F(CacheTest, EvictionPolicyMultiTouch) {
   ASSERT_LT(kCacheSize * FLAGS_cache_single_touch_ratio, cache_->GetUsage());
 }
 
+TEST_F(CacheTest, FrequencyAdmission) {
+  FLAGS_cache_single_touch_ratio = 1;
+  FLAGS_cache_tiny_lfu_admission = true;
+  const int kCapacity = 100;
+  auto cache = NewLRUCache(kCapacity, 0);
+
+  // Fill the cache with entries that are looked up twice.
+  for (int i = 0; i < kCapacity; i++) {
+    ASSERT_EQ(-1, Lookup(cache, i));
+    ASSERT_OK(Insert(cache, i, i + 1));
+    ASSERT_EQ(i + 1, Lookup(cache, i));
+  }
+
+  // Scan of entries that are looked up once should not evict anything.
+  for (int i = kCapacity; i < 3 * kCapacity; i++) {
+    ASSERT_EQ(-1, Lookup(cache, i));
+    ASSERT_OK(Insert(cache, i, i + 1));
+    ASSERT_EQ(-1, Lookup(cache, i));
+  }
+  for (int i = 0; i < kCapacity; i++) {
+    ASSERT_EQ(i + 1, Lookup(cache, i));
+  }
+  ASSERT_EQ(kCapacity, cache->GetUsage());
+
+  // Rejected entry is still returned to the caller.
+  Cache::Handle* handle = nullptr;
+  ASSERT_OK(cache->Insert(EncodeKey(3 * kCapacity), kTestQueryId, EncodeValue(1), 1,
+                          &CacheTest::Deleter, &handle));
+  ASSERT_NE(nullptr, handle);
+  ASSERT_EQ(1, DecodeValue(cache->Value(handle)));
+  cache->Release(handle);
+  ASSERT_EQ(kCapacity, cache->GetUsage());
+
+  // Entry that is looked up more frequently than the least recently used one replaces it.
+  const int kHotKey = 4 * kCapacity;
+  for (int i = 0; i < 5; i++) {
+    ASSERT_EQ(-1, Lookup(cache, kHotKey));
+  }
+  ASSERT_OK(Insert(cache, kHotKey, kHotKey + 1));
+  ASSERT_EQ(kHotKey + 1, Lookup(cache, kHotKey));
+  ASSERT_EQ(-1, Lookup(cache, 0));
+  for (int i = 1; i < kCapacity; i++) {
+    ASSERT_EQ(i + 1, Lookup(cache, i));
+  }
+
+  // Returning the flags back.
+  FLAGS_cache_tiny_lfu_admission = false;
+  FLAGS_cache_single_touch_ratio = 0.2;
+}
+
 TEST_F(CacheTest, HeavyEntries) {
   // Add a bunch of light and heavy entries and then count the combined
   // size of items still in the cache, which must be approximately the
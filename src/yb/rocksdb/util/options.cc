@@ -523,6 +523,12 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
   RHEADER(log,
       "Options.compaction_options_universal.compression_size_percent: %d",
       compaction_options_universal.compression_size_percent);
+  RHEADER(log, "Options.compaction_options_universal."
+          "large_output_compression_threshold: %" PRIu64,
+          compaction_options_universal.large_output_compression_threshold);
+  RHEADER(log, "Options.compaction_options_universal.large_output_compression: %s",
+          CompressionTypeToString(
+              compaction_options_universal.large_output_compression).c_str());
   RHEADER(log,
       "Options.compaction_options_fifo.max_table_files_size: %" PRIu64,
       compaction_options_fifo.max_table_files_size);
@@ -0,0 +1,820 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rpc/compressed_stream.h"
+
+#include <algorithm>
+
+#include <lz4.h>
+#include <snappy.h>
+#include <zlib.h>
+
+#include "yb/gutil/casts.h"
+#include "yb/gutil/endian.h"
+#include "yb/gutil/macros.h"
+
+#include "yb/rpc/circular_read_buffer.h"
+#include "yb/rpc/outbound_data.h"
+#include "yb/rpc/rpc_metrics.h"
+#include "yb/rpc/rpc_util.h"
+
+#include "yb/util/enums.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+#include "yb/util/memory/memory.h"
+#include "yb/util/size_literals.h"
+#include "yb/util/stopwatch.h"
+#include "yb/util/string_util.h"
+
+using namespace yb::size_literals;
+
+DEFINE_string(rpc_compression_algorithm, "none",
+              "Algorithm used to compress data sent over outbound RPC connections: none, snappy, "
+              "lz4 or zlib. Peers should accept compressed connections.");
+TAG_FLAG(rpc_compression_algorithm, advanced);
+
+DEFINE_int32(rpc_compression_threshold_bytes, 4_KB,
+             "Outbound RPC data blocks smaller than this size are sent uncompressed.");
+TAG_FLAG(rpc_compression_threshold_bytes, advanced);
+
+DECLARE_int32(rpc_max_message_size);
+
+namespace {
+
+// Names of compression algorithms, in the order of CompressionAlgorithm values.
+const char* const kCompressionAlgorithmNames[] = { "none", "snappy", "lz4", "zlib" };
+
+// Returns index of the algorithm with specified name in kCompressionAlgorithmNames, or -1 if the
+// name is unknown.
+int CompressionAlgorithmIndex(const std::string& name) {
+  auto it = std::find(
+      std::begin(kCompressionAlgorithmNames), std::end(kCompressionAlgorithmNames), name);
+  return it != std::end(kCompressionAlgorithmNames)
+      ? static_cast<int>(it - std::begin(kCompressionAlgorithmNames)) : -1;
+}
+
+bool ValidateCompressionAlgorithm(const char* flagname, const std::string& value) {
+  if (CompressionAlgorithmIndex(value) < 0) {
+    LOG(ERROR) << "Unknown RPC compression algorithm " << value << " for " << flagname;
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+__attribute__((unused))
+DEFINE_validator(rpc_compression_algorithm, &ValidateCompressionAlgorithm);
+
+namespace yb {
+namespace rpc {
+
+namespace {
+
+YB_DEFINE_ENUM(CompressionAlgorithm, (kNone)(kSnappy)(kLz4)(kZlib));
+YB_DEFINE_ENUM(CompressionState, (kInitial)(kEnabled)(kDisabled));
+
+static_assert(arraysize(kCompressionAlgorithmNames) == kCompressionAlgorithmMapSize,
+              "Names should be specified for all compression algorithms");
+
+// Outbound connection starts with 'Y', 'B', 'C' followed by byte with compression algorithm.
+const char kHandshakeBytes[] = "YBC";
+const size_t kHandshakePrefixSize = sizeof(kHandshakeBytes) - 1;
+const size_t kHandshakeSize = kHandshakePrefixSize + 1;
+
+// Frame starts with kind byte and 32 bit payload size, compressed frame is followed by
+// 32 bit size of uncompressed data.
+const uint8_t kRawFrame = 0;
+const uint8_t kCompressedFrame = 1;
+const size_t kRawFrameHeaderSize = 1 + sizeof(uint32_t);
+const size_t kCompressedFrameHeaderSize = kRawFrameHeaderSize + sizeof(uint32_t);
+
+// Data blocks sent before the connection is established are queued by the compressed stream.
+// Their handles are indexes in this queue with the highest bit set, so they don't clash with
+// handles of the lower stream.
+const size_t kPendingHandleFlag = static_cast<size_t>(1) << (sizeof(size_t) * 8 - 1);
+
+class Compressor {
+ public:
+  virtual size_t MaxCompressedLength(size_t input_size) const = 0;
+
+  // Returns size of compressed data, or 0 if compression failed.
+  virtual size_t Compress(Slice input, char* out, size_t out_size) const = 0;
+
+  virtual CHECKED_STATUS Decompress(Slice input, char* out, size_t out_size) const = 0;
+
+  virtual ~Compressor() {}
+};
+
+class SnappyCompressor : public Compressor {
+ public:
+  size_t MaxCompressedLength(size_t input_size) const override {
+    return snappy::MaxCompressedLength(input_size);
+  }
+
+  size_t Compress(Slice input, char* out, size_t out_size) const override {
+    size_t result = 0;
+    snappy::RawCompress(input.cdata(), input.size(), out, &result);
+    return result;
+  }
+
+  CHECKED_STATUS Decompress(Slice input, char* out, size_t out_size) const override {
+    size_t uncompressed_size = 0;
+    if (!snappy::GetUncompressedLength(input.cdata(), input.size(), &uncompressed_size) ||
+        uncompressed_size != out_size ||
+        !snappy::RawUncompress(input.cdata(), input.size(), out)) {
+      return STATUS(Corruption, "Failed to decompress snappy frame");
+    }
+    return Status::OK();
+  }
+};
+
+class Lz4Compressor : public Compressor {
+ public:
+  size_t MaxCompressedLength(size_t input_size) const override {
+    return LZ4_compressBound(input_size);
+  }
+
+  size_t Compress(Slice input, char* out, size_t out_size) const override {
+    return std::max(LZ4_compress_default(input.cdata(), out, input.size(), out_size), 0);
+  }
+
+  CHECKED_STATUS Decompress(Slice input, char* out, size_t out_size) const override {
+    auto result = LZ4_decompress_safe(input.cdata(), out, input.size(), out_size);
+    if (result < 0 || static_cast<size_t>(result) != out_size) {
+      return STATUS_FORMAT(Corruption, "Failed to decompress LZ4 frame: $0", result);
+    }
+    return Status::OK();
+  }
+};
+
+class ZlibCompressor : public Compressor {
+ public:
+  size_t MaxCompressedLength(size_t input_size) const override {
+    return compressBound(input_size);
+  }
+
+  size_t Compress(Slice input, char* out, size_t out_size) const override {
+    uLongf result = out_size;
+    if (compress2(pointer_cast<Bytef*>(out), &result, input.data(), input.size(),
+                  Z_BEST_SPEED) != Z_OK) {
+      return 0;
+    }
+    return result;
+  }
+
+  CHECKED_STATUS Decompress(Slice input, char* out, size_t out_size) const override {
+    uLongf result = out_size;
+    auto status = uncompress(pointer_cast<Bytef*>(out), &result, input.data(), input.size());
+    if (status != Z_OK || result != out_size) {
+      return STATUS_FORMAT(Corruption, "Failed to decompress zlib frame: $0", status);
+    }
+    return Status::OK();
+  }
+};
+
+const Compressor* GetCompressor(CompressionAlgorithm algorithm) {
+  static const SnappyCompressor snappy_compressor;
+  static const Lz4Compressor lz4_compressor;
+  static const ZlibCompressor zlib_compressor;
+  switch (algorithm) {
+    case CompressionAlgorithm::kNone:
+      return nullptr;
+    case CompressionAlgorithm::kSnappy:
+      return &snappy_compressor;
+    case CompressionAlgorithm::kLz4:
+      return &lz4_compressor;
+    case CompressionAlgorithm::kZlib:
+      return &zlib_compressor;
+  }
+  FATAL_INVALID_ENUM_VALUE(CompressionAlgorithm, algorithm);
+}
+
+CompressionAlgorithm AlgorithmFromFlag() {
+  // The flag validator rejects unknown names.
+  auto index = CompressionAlgorithmIndex(FLAGS_rpc_compression_algorithm);
+  return index > 0 ? static_cast<CompressionAlgorithm>(index) : CompressionAlgorithm::kNone;
+}
+
+void IncrementCounterBy(const scoped_refptr<Counter>& counter, int64_t value) {
+  if (counter) {
+    counter->IncrementBy(value);
+  }
+}
+
+// Wraps data sent by the upper layer, Transferred and IsFinished are forwarded to the original
+// data, so cancellation of calls works the same way as for the lower stream.
+class CompressedOutboundData : public OutboundData {
+ public:
+  CompressedOutboundData(
+      boost::container::small_vector_base<RefCntBuffer>* buffers, OutboundDataPtr lower_data)
+      : buffers_(std::make_move_iterator(buffers->begin()),
+                 std::make_move_iterator(buffers->end())),
+        lower_data_(std::move(lower_data)) {}
+
+  void Transferred(const Status& status, Connection* conn) override {
+    if (lower_data_) {
+      lower_data_->Transferred(status, conn);
+    }
+  }
+
+  bool DumpPB(const DumpRunningRpcsRequestPB& req, RpcCallInProgressPB* resp) override {
+    return lower_data_ && lower_data_->DumpPB(req, resp);
+  }
+
+  bool IsFinished() const override {
+    return lower_data_ && lower_data_->IsFinished();
+  }
+
+  bool IsHeartbeat() const override {
+    return lower_data_ && lower_data_->IsHeartbeat();
+  }
+
+  void Serialize(boost::container::small_vector_base<RefCntBuffer>* output) override {
+    for (auto& buffer : buffers_) {
+      output->push_back(std::move(buffer));
+    }
+    buffers_.clear();
+  }
+
+  std::string ToString() const override {
+    return Format("Compressed[$0]", lower_data_);
+  }
+
+  size_t ObjectSize() const override { return sizeof(*this); }
+
+  size_t DynamicMemoryUsage() const override {
+    return DynamicMemoryUsageOf(buffers_, lower_data_);
+  }
+
+ private:
+  boost::container::small_vector<RefCntBuffer, 4> buffers_;
+  OutboundDataPtr lower_data_;
+};
+
+class CompressedStream : public Stream, public StreamContext {
+ public:
+  CompressedStream(std::unique_ptr<Stream> lower_stream, size_t receive_buffer_size,
+                   const StreamCreateData& data)
+      : lower_stream_(std::move(lower_stream)), metrics_(data.rpc_metrics),
+        compressed_read_buffer_(receive_buffer_size, data.mem_tracker) {
+  }
+
+  CompressedStream(const CompressedStream&) = delete;
+  void operator=(const CompressedStream&) = delete;
+
+  size_t GetPendingWriteBytes() override {
+    return lower_stream_->GetPendingWriteBytes();
+  }
+
+ private:
+  CHECKED_STATUS Start(bool connect, ev::loop_ref* loop, StreamContext* context) override;
+  void Close() override;
+  void Shutdown(const Status& status) override;
+  size_t Send(OutboundDataPtr data) override;
+  CHECKED_STATUS TryWrite() override;
+  void ParseReceived() override;
+  void Cancelled(size_t handle) override;
+
+  bool Idle(std::string* reason_not_idle) override;
+  bool IsConnected() override;
+  void DumpPB(const DumpRunningRpcsRequestPB& req, RpcConnectionPB* resp) override;
+
+  const Endpoint& Remote() override;
+  const Endpoint& Local() override;
+
+  const Protocol* GetProtocol() override {
+    return CompressedStreamProtocol();
+  }
+
+  // Implementation StreamContext
+  void UpdateLastActivity() override;
+  void UpdateLastRead() override;
+  void UpdateLastWrite() override;
+  void Transferred(const OutboundDataPtr& data, const Status& status) override;
+  void Destroy(const Status& status) override;
+  Result<ProcessDataResult> ProcessReceived(
+      const IoVecs& data, ReadBufferFull read_buffer_full) override;
+  void Connected() override;
+
+  std::shared_ptr<void> KeepAlive() override {
+    return context_->KeepAlive();
+  }
+
+  StreamReadBuffer& ReadBuffer() override {
+    return compressed_read_buffer_;
+  }
+
+  void Established(CompressionState state, CompressionAlgorithm algorithm);
+  OutboundDataPtr MakeFrame(OutboundDataPtr data);
+  Result<size_t> ProcessFrames(const IoVecs& data);
+
+  // Returns true if the decompressed frame was fully delivered to the upper layer.
+  Result<bool> DecompressFrame();
+
+  // Passes data to the upper layer. Returns number of passed bytes, that is less than the size of
+  // data when the read buffer of the upper layer is full.
+  Result<size_t> Deliver(Slice data);
+  Result<size_t> Deliver(const IoVecs& data, size_t begin, size_t end);
+
+  // Passes decompressed data left from the previous calls to the upper layer. Returns true if
+  // nothing is left.
+  Result<bool> DeliverUndelivered();
+
+  std::string ToString() override;
+
+  std::unique_ptr<Stream> lower_stream_;
+  RpcMetrics* metrics_;
+  StreamContext* context_ = nullptr;
+  CompressionState state_ = CompressionState::kInitial;
+  const Compressor* compressor_ = nullptr;
+  // Data sent before the connection was established, and handles of the lower stream for this
+  // data after it was sent.
+  std::vector<OutboundDataPtr> pending_data_;
+  std::vector<size_t> pending_data_handles_;
+
+  // Buffer for compression output, reused between frames.
+  std::string compress_buffer_;
+
+  // Header and state of the frame that is being received.
+  char frame_header_[kCompressedFrameHeaderSize];
+  uint8_t frame_kind_ = kRawFrame;
+  size_t frame_bytes_left_ = 0;
+  RefCntBuffer compressed_frame_;
+  size_t compressed_frame_pos_ = 0;
+  size_t uncompressed_frame_size_ = 0;
+
+  size_t decompressed_bytes_to_skip_ = 0;
+
+  // Decompressed frame that did not fit into the read buffer of the upper layer. Nothing is
+  // consumed from the lower stream until it is delivered, as the upper layer calls ParseReceived
+  // when it has room for more data.
+  RefCntBuffer undelivered_;
+  size_t undelivered_pos_ = 0;
+
+  CircularReadBuffer compressed_read_buffer_;
+};
+
+Status CompressedStream::Start(bool connect, ev::loop_ref* loop, StreamContext* context) {
+  context_ = context;
+  RETURN_NOT_OK(lower_stream_->Start(connect, loop, this));
+  if (!connect) {
+    // Wait for the peer to tell whether it uses compression.
+    return Status::OK();
+  }
+
+  auto algorithm = AlgorithmFromFlag();
+  if (algorithm == CompressionAlgorithm::kNone) {
+    Established(CompressionState::kDisabled, algorithm);
+    return Status::OK();
+  }
+
+  boost::container::small_vector<RefCntBuffer, 1> handshake;
+  handshake.emplace_back(kHandshakeSize);
+  memcpy(handshake.back().data(), kHandshakeBytes, kHandshakePrefixSize);
+  handshake.back().data()[kHandshakePrefixSize] = static_cast<char>(algorithm);
+  lower_stream_->Send(std::make_shared<CompressedOutboundData>(&handshake, nullptr));
+  Established(CompressionState::kEnabled, algorithm);
+  return Status::OK();
+}
+
+void CompressedStream::Close() {
+  lower_stream_->Close();
+}
+
+void CompressedStream::Shutdown(const Status& status) {
+  for (auto& data : pending_data_) {
+    if (data) {
+      context_->Transferred(data, status);
+    }
+  }
+  pending_data_.clear();
+
+  lower_stream_->Shutdown(status);
+}
+
+size_t CompressedStream::Send(OutboundDataPtr data) {
+  switch (state_) {
+    case CompressionState::kInitial:
+      pending_data_.push_back(std::move(data));
+      return kPendingHandleFlag | (pending_data_.size() - 1);
+    case CompressionState::kEnabled:
+      return lower_stream_->Send(MakeFrame(std::move(data)));
+    case CompressionState::kDisabled:
+      return lower_stream_->Send(std::move(data));
+  }
+
+  return std::numeric_limits<size_t>::max();
+}
+
+OutboundDataPtr CompressedStream::MakeFrame(OutboundDataPtr data) {
+  boost::container::small_vector<RefCntBuffer, 4> buffers;
+  data->Serialize(&buffers);
+  size_t size = 0;
+  for (const auto& buffer : buffers) {
+    size += buffer.size();
+  }
+
+  if (compressor_ && size >= FLAGS_rpc_compression_threshold_bytes) {
+    RefCntBuffer joined;
+    Slice input;
+    if (buffers.size() == 1) {
+      input = buffers.front().as_slice();
+    } else {
+      joined = RefCntBuffer(size);
+      auto* out = joined.data();
+      for (const auto& buffer : buffers) {
+        memcpy(out, buffer.data(), buffer.size());
+        out += buffer.size();
+      }
+      input = joined.as_slice();
+    }
+
+    Stopwatch stopwatch;
+    stopwatch.start();
+    auto max_size = compressor_->MaxCompressedLength(size);
+    compress_buffer_.resize(kCompressedFrameHeaderSize + max_size);
+    auto* frame = &compress_buffer_[0];
+    auto compressed_size = compressor_->Compress(
+        input, frame + kCompressedFrameHeaderSize, max_size);
+    stopwatch.stop();
+    if (metrics_) {
+      auto elapsed = stopwatch.elapsed();
+      IncrementCounterBy(metrics_->compression_input_bytes, size);
+      IncrementCounterBy(metrics_->compression_output_bytes,
+                         compressed_size ? compressed_size : size);
+      IncrementCounterBy(metrics_->compression_cpu_time_us,
+                         (elapsed.user + elapsed.system) / 1000);
+    }
+
+    // Send incompressible data as is, so receiver does not waste time on decompression.
+    if (compressed_size != 0 && compressed_size < size) {
+      frame[0] = kCompressedFrame;
+      NetworkByteOrder::Store32(frame + 1, static_cast<uint32_t>(compressed_size));
+      NetworkByteOrder::Store32(frame + kRawFrameHeaderSize, static_cast<uint32_t>(size));
+      buffers.clear();
+      buffers.emplace_back(frame, kCompressedFrameHeaderSize + compressed_size);
+      return std::make_shared<CompressedOutboundData>(&buffers, std::move(data));
+    }
+  }
+
+  RefCntBuffer header(kRawFrameHeaderSize);
+  header.data()[0] = kRawFrame;
+  NetworkByteOrder::Store32(header.data() + 1, static_cast<uint32_t>(size));
+  buffers.insert(buffers.begin(), std::move(header));
+  return std::make_shared<CompressedOutboundData>(&buffers, std::move(data));
+}
+
+Status CompressedStream::TryWrite() {
+  return lower_stream_->TryWrite();
+}
+
+void CompressedStream::ParseReceived() {
+  auto delivered = DeliverUndelivered();
+  if (!delivered.ok()) {
+    context_->Destroy(delivered.status());
+    return;
+  }
+  if (*delivered) {
+    lower_stream_->ParseReceived();
+  }
+}
+
+void CompressedStream::Cancelled(size_t handle) {
+  if (handle & kPendingHandleFlag) {
+    handle &= ~kPendingHandleFlag;
+    if (state_ == CompressionState::kInitial) {
+      // Not sent yet, so could be just dropped.
+      auto& data = pending_data_[handle];
+      if (data) {
+        context_->Transferred(data, STATUS(Aborted, "Cancelled before connection established"));
+        data.reset();
+      }
+      return;
+    }
+    handle = pending_data_handles_[handle];
+    if (handle == std::numeric_limits<size_t>::max()) {
+      return;
+    }
+  }
+  // Each block of the upper layer is sent as exactly one block of the lower stream, so other
+  // handles are the same.
+  lower_stream_->Cancelled(handle);
+}
+
+bool CompressedStream::Idle(std::string* reason) {
+  if (undelivered_) {
+    if (reason) {
+      AppendWithSeparator("undelivered decompressed data", reason);
+    }
+    return false;
+  }
+  return lower_stream_->Idle(reason);
+}
+
+bool CompressedStream::IsConnected() {
+  return lower_stream_->IsConnected();
+}
+
+void CompressedStream::DumpPB(const DumpRunningRpcsRequestPB& req, RpcConnectionPB* resp) {
+  lower_stream_->DumpPB(req, resp);
+}
+
+const Endpoint& CompressedStream::Remote() {
+  return lower_stream_->Remote();
+}
+
+const Endpoint& CompressedStream::Local() {
+  return lower_stream_->Local();
+}
+
+std::string CompressedStream::ToString() {
+  return Format("COMPRESSED $0 $1", state_, lower_stream_->ToString());
+}
+
+void CompressedStream::UpdateLastActivity() {
+  context_->UpdateLastActivity();
+}
+
+void CompressedStream::UpdateLastRead() {
+  context_->UpdateLastRead();
+}
+
+void CompressedStream::UpdateLastWrite() {
+  context_->UpdateLastWrite();
+}
+
+void CompressedStream::Transferred(const OutboundDataPtr& data, const Status& status) {
+  context_->Transferred(data, status);
+}
+
+void CompressedStream::Destroy(const Status& status) {
+  context_->Destroy(status);
+}
+
+void CompressedStream::Connected() {
+  context_->Connected();
+}
+
+void CompressedStream::Established(CompressionState state, CompressionAlgorithm algorithm) {
+  VLOG_WITH_PREFIX(4) << "Established with state: " << state << ", algorithm: " << algorithm;
+
+  state_ = state;
+  compressor_ = GetCompressor(algorithm);
+  ResetLogPrefix();
+  pending_data_handles_.reserve(pending_data_.size());
+  for (auto& data : pending_data_) {
+    pending_data_handles_.push_back(
+        data ? Send(std::move(data)) : std::numeric_limits<size_t>::max());
+  }
+  pending_data_.clear();
+}
+
+Result<ProcessDataResult> CompressedStream::ProcessReceived(
+    const IoVecs& data, ReadBufferFull read_buffer_full) {
+  switch (state_) {
+    case CompressionState::kInitial: {
+      if (IoVecsFullSize(data) < kHandshakeSize) {
+        return ProcessDataResult{0, Slice()};
+      }
+      char header[kHandshakeSize];
+      IoVecsToBuffer(data, 0, kHandshakeSize, header);
+      if (memcmp(header, kHandshakeBytes, kHandshakePrefixSize) != 0) {
+        Established(CompressionState::kDisabled, CompressionAlgorithm::kNone);
+        return ProcessReceived(data, read_buffer_full);
+      }
+      auto algorithm = static_cast<uint8_t>(header[kHandshakePrefixSize]);
+      if (algorithm >= kCompressionAlgorithmMapSize ||
+          algorithm == to_underlying(CompressionAlgorithm::kNone)) {
+        return STATUS_FORMAT(NetworkError, "Unsupported compression algorithm: $0",
+                             static_cast<int>(algorithm));
+      }
+      Established(CompressionState::kEnabled, static_cast<CompressionAlgorithm>(algorithm));
+
+      // We assume that handshake is fully contained in the first block, as it is the first thing
+      // sent by the peer.
+      if (data[0].iov_len < kHandshakeSize) {
+        return STATUS(NetworkError, "Compressed stream handshake is split between blocks");
+      }
+      IoVecs data_copy(data);
+      data_copy[0].iov_len -= kHandshakeSize;
+      data_copy[0].iov_base = static_cast<char*>(data_copy[0].iov_base) + kHandshakeSize;
+      return ProcessDataResult{ VERIFY_RESULT(ProcessFrames(data_copy)) + kHandshakeSize, Slice() };
+    }
+
+    case CompressionState::kDisabled:
+      return context_->ProcessReceived(data, read_buffer_full);
+
+    case CompressionState::kEnabled:
+      return ProcessDataResult{ VERIFY_RESULT(ProcessFrames(data)), Slice() };
+  }
+
+  return STATUS_FORMAT(IllegalState, "Unexpected state: $0", to_underlying(state_));
+}
+
+Result<size_t> CompressedStream::ProcessFrames(const IoVecs& data) {
+  if (!VERIFY_RESULT(DeliverUndelivered())) {
+    return 0;
+  }
+
+  const auto full_size = IoVecsFullSize(data);
+  size_t consumed = 0;
+  while (consumed < full_size) {
+    if (frame_bytes_left_ == 0) {
+      size_t header_size = kRawFrameHeaderSize;
+      IoVecsToBuffer(data, consumed, consumed + 1, frame_header_);
+      frame_kind_ = static_cast<uint8_t>(frame_header_[0]);
+      if (frame_kind_ == kCompressedFrame) {
+        header_size = kCompressedFrameHeaderSize;
+      } else if (frame_kind_ != kRawFrame) {
+        return STATUS_FORMAT(NetworkError, "Unknown compressed stream frame kind: $0",
+                             static_cast<int>(frame_kind_));
+      }
+      if (full_size - consumed < header_size) {
+        break;
+      }
+      IoVecsToBuffer(data, consumed, consumed + header_size, frame_header_);
+      consumed += header_size;
+      frame_bytes_left_ = NetworkByteOrder::Load32(frame_header_ + 1);
+      if (frame_bytes_left_ > FLAGS_rpc_max_message_size) {
+        return STATUS_FORMAT(NetworkError, "Too big compressed stream frame: $0",
+                             frame_bytes_left_);
+      }
+      if (frame_kind_ == kCompressedFrame) {
+        uncompressed_frame_size_ = NetworkByteOrder::Load32(frame_header_ + kRawFrameHeaderSize);
+        if (uncompressed_frame_size_ > FLAGS_rpc_max_message_size) {
+          return STATUS_FORMAT(NetworkError, "Too big uncompressed frame: $0",
+                               uncompressed_frame_size_);
+        }
+        compressed_frame_ = RefCntBuffer(frame_bytes_left_);
+        compressed_frame_pos_ = 0;
+      }
+      continue;
+    }
+
+    auto end = consumed + std::min(frame_bytes_left_, full_size - consumed);
+    if (frame_kind_ == kRawFrame) {
+      auto delivered = VERIFY_RESULT(Deliver(data, consumed, end));
+      frame_bytes_left_ -= delivered;
+      consumed += delivered;
+      if (consumed != end) {
+        // Read buffer of the upper layer is full, keep the rest in the lower stream.
+        break;
+      }
+      continue;
+    }
+
+    IoVecsToBuffer(data, consumed, end, compressed_frame_.data() + compressed_frame_pos_);
+    compressed_frame_pos_ += end - consumed;
+    frame_bytes_left_ -= end - consumed;
+    consumed = end;
+    if (frame_bytes_left_ == 0 && !VERIFY_RESULT(DecompressFrame())) {
+      break;
+    }
+  }
+
+  return consumed;
+}
+
+Result<bool> CompressedStream::DecompressFrame() {
+  RefCntBuffer decompressed(uncompressed_frame_size_);
+  Stopwatch stopwatch;
+  stopwatch.start();
+  auto status = compressor_->Decompress(
+      compressed_frame_.as_slice(), decompressed.data(), decompressed.size());
+  stopwatch.stop();
+  if (metrics_) {
+    auto elapsed = stopwatch.elapsed();
+    IncrementCounterBy(metrics_->decompression_cpu_time_us,
+                       (elapsed.user + elapsed.system) / 1000);
+  }
+  compressed_frame_.Reset();
+  RETURN_NOT_OK(status);
+  undelivered_ = std::move(decompressed);
+  undelivered_pos_ = 0;
+  return DeliverUndelivered();
+}
+
+Result<bool> CompressedStream::DeliverUndelivered() {
+  if (!undelivered_) {
+    return true;
+  }
+  undelivered_pos_ += VERIFY_RESULT(Deliver(
+      Slice(undelivered_.data() + undelivered_pos_, undelivered_.end())));
+  if (undelivered_pos_ != undelivered_.size()) {
+    return false;
+  }
+  undelivered_.Reset();
+  undelivered_pos_ = 0;
+  return true;
+}
+
+Result<size_t> CompressedStream::Deliver(const IoVecs& data, size_t begin, size_t end) {
+  size_t result = 0;
+  for (const auto& iov : data) {
+    if (begin >= end) {
+      break;
+    }
+    if (begin >= iov.iov_len) {
+      begin -= iov.iov_len;
+      end -= iov.iov_len;
+      continue;
+    }
+    auto len = std::min(iov.iov_len, end) - begin;
+    auto delivered = VERIFY_RESULT(Deliver(
+        Slice(static_cast<const char*>(iov.iov_base) + begin, len)));
+    result += delivered;
+    if (delivered != len) {
+      break;
+    }
+    begin = 0;
+    end -= iov.iov_len;
+  }
+  return result;
+}
+
+Result<size_t> CompressedStream::Deliver(Slice data) {
+  auto& read_buffer = context_->ReadBuffer();
+  const auto size = data.size();
+  while (!data.empty()) {
+    if (decompressed_bytes_to_skip_ > 0) {
+      auto len = std::min(decompressed_bytes_to_skip_, data.size());
+      data.remove_prefix(len);
+      decompressed_bytes_to_skip_ -= len;
+      continue;
+    }
+    auto out = read_buffer.PrepareAppend();
+    if (!out.ok()) {
+      if (out.status().IsBusy()) {
+        // Same as TcpStream, wait until the upper layer processes received data.
+        VLOG_WITH_PREFIX(3) << "Read buffer is full, undelivered: " << data.size();
+        break;
+      }
+      return out.status();
+    }
+    size_t appended = 0;
+    for (const auto& iov : *out) {
+      auto len = std::min(iov.iov_len, data.size());
+      memcpy(iov.iov_base, data.data(), len);
+      data.remove_prefix(len);
+      appended += len;
+      if (data.empty()) {
+        break;
+      }
+    }
+    read_buffer.DataAppended(appended);
+    if (read_buffer.ReadyToRead()) {
+      auto temp = VERIFY_RESULT(context_->ProcessReceived(
+          read_buffer.AppendedVecs(), ReadBufferFull(read_buffer.Full())));
+      read_buffer.Consume(temp.consumed, temp.buffer);
+      DCHECK_EQ(decompressed_bytes_to_skip_, 0);
+      decompressed_bytes_to_skip_ = temp.bytes_to_skip;
+    }
+  }
+  return size - data.size();
+}
+
+} // namespace
+
+const Protocol* CompressedStreamProtocol() {
+  static Protocol result("tcpc");
+  return &result;
+}
+
+StreamFactoryPtr CompressedStreamFactory(StreamFactoryPtr lower_layer_factory) {
+  class CompressedStreamFactory : public StreamFactory {
+   public:
+    explicit CompressedStreamFactory(StreamFactoryPtr lower_layer_factory)
+        : lower_layer_factory_(std::move(lower_layer_factory)) {
+    }
+
+   private:
+    std::unique_ptr<Stream> Create(const StreamCreateData& data) override {
+      auto receive_buffer_size = data.socket->GetReceiveBufferSize();
+      if (!receive_buffer_size.ok()) {
+        LOG(WARNING) << "Compressed stream failure: " << receive_buffer_size.status();
+        receive_buffer_size = 256_KB;
+      }
+      auto lower_stream = lower_layer_factory_->Create(data);
+      return std::make_unique<CompressedStream>(
+          std::move(lower_stream), *receive_buffer_size, data);
+    }
+
+    StreamFactoryPtr lower_layer_factory_;
+  };
+
+  return std::make_shared<CompressedStreamFactory>(std::move(lower_layer_factory));
+}
+
+} // namespace rpc
+} // namespace yb
@@ -0,0 +1,35 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_RPC_COMPRESSED_STREAM_H
+#define YB_RPC_COMPRESSED_STREAM_H
+
+#include "yb/rpc/stream.h"
+
+namespace yb {
+namespace rpc {
+
+// Stream layer that compresses outbound data blocks of at least rpc_compression_threshold_bytes.
+//
+// Outbound connection starts with a header that specifies compression algorithm, after it each
+// data block is sent as a separate frame, that is compressed when it makes it smaller.
+// Inbound side uses the algorithm chosen by the peer for its own frames. Inbound connection
+// without such header is served as regular connection of the lower layer, so it is safe to
+// accept compressed connections before peers start to use them.
+const Protocol* CompressedStreamProtocol();
+StreamFactoryPtr CompressedStreamFactory(StreamFactoryPtr lower_layer_factory);
+
+} // namespace rpc
+} // namespace yb
+
+#endif // YB_RPC_COMPRESSED_STREAM_H
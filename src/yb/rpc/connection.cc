@@ -458,6 +458,10 @@ StreamReadBuffer& Connection::ReadBuffer() {
   return context_->ReadBuffer();
 }
 
+std::shared_ptr<void> Connection::KeepAlive() {
+  return shared_from_this();
+}
+
 const Endpoint& Connection::remote() const {
   return stream_->Remote();
 }
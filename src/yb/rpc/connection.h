@@ -204,6 +204,7 @@ class Connection final : public StreamContext, public std::enable_shared_from_th
       const IoVecs& data, ReadBufferFull read_buffer_full) override;
   void Connected() override;
   StreamReadBuffer& ReadBuffer() override;
+  std::shared_ptr<void> KeepAlive() override;
 
   std::string LogPrefix() const;
 
@@ -15,6 +15,8 @@
 
 #include "yb/rpc/local_call.h"
 
+#include <google/protobuf/io/coded_stream.h>
+
 #include "yb/rpc/rpc_controller.h"
 #include "yb/util/memory/memory.h"
 
@@ -34,7 +36,22 @@ LocalOutboundCall::LocalOutboundCall(
 
 Status LocalOutboundCall::SetRequestParam(
     const google::protobuf::Message& req, const MemTrackerPtr& mem_tracker) {
-  req_ = &req;
+  auto request_fields = TakeRequestFields();
+  if (request_fields.empty()) {
+    req_ = &req;
+    return Status::OK();
+  }
+
+  // The request is not serialized for local calls, so serialized fields are merged into a copy.
+  owned_req_.reset(req.New());
+  owned_req_->CopyFrom(req);
+  for (const auto& fields : request_fields) {
+    google::protobuf::io::CodedInputStream input(fields.udata(), fields.size());
+    if (!owned_req_->MergePartialFromCodedStream(&input)) {
+      return STATUS(InvalidArgument, "Failed to merge serialized request fields");
+    }
+  }
+  req_ = owned_req_.get();
   return Status::OK();
 }
 
@@ -49,6 +49,9 @@ class LocalOutboundCall : public OutboundCall {
 
   const google::protobuf::Message* req_ = nullptr;
 
+  // Copy of the request with merged serialized fields, if there were any.
+  std::unique_ptr<google::protobuf::Message> owned_req_;
+
   std::shared_ptr<LocalYBInboundCall> inbound_call_;
 };
 
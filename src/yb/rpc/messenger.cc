@@ -52,6 +52,7 @@
 #include "yb/gutil/strings/substitute.h"
 
 #include "yb/rpc/acceptor.h"
+#include "yb/rpc/compressed_stream.h"
 #include "yb/rpc/connection.h"
 #include "yb/rpc/constants.h"
 #include "yb/rpc/proxy.h"
@@ -60,6 +61,7 @@
 #include "yb/rpc/rpc_service.h"
 #include "yb/rpc/rpc_util.h"
 #include "yb/rpc/tcp_stream.h"
+#include "yb/rpc/uring_stream.h"
 #include "yb/rpc/yb_rpc.h"
 
 #include "yb/util/errno.h"
@@ -158,6 +160,32 @@ MessengerBuilder &MessengerBuilder::AddStreamFactory(
   return *this;
 }
 
+MessengerBuilder &MessengerBuilder::UseIoUring() {
+  if (!UringStream::IsSupported()) {
+    LOG(WARNING) << name_ << ": io_uring is not supported, using libev based TCP streams";
+    return *this;
+  }
+  stream_factories_[TcpStream::StaticProtocol()] = UringStream::Factory();
+  return *this;
+}
+
+StreamFactoryPtr MessengerBuilder::stream_factory(const Protocol* protocol) const {
+  auto it = stream_factories_.find(protocol);
+  return it != stream_factories_.end() ? it->second : nullptr;
+}
+
+MessengerBuilder &MessengerBuilder::UseCompression() {
+  auto it = stream_factories_.find(listen_protocol_);
+  if (it == stream_factories_.end()) {
+    LOG(DFATAL) << name_ << ": No stream factory for listen protocol "
+                << listen_protocol_->ToString();
+    return *this;
+  }
+  AddStreamFactory(CompressedStreamProtocol(), CompressedStreamFactory(it->second));
+  listen_protocol_ = CompressedStreamProtocol();
+  return *this;
+}
+
 MessengerBuilder &MessengerBuilder::UseDefaultConnectionContextFactory(
     const std::shared_ptr<MemTracker>& parent_mem_tracker) {
   if (parent_mem_tracker) {
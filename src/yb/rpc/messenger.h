@@ -104,6 +104,21 @@ class MessengerBuilder {
 
   MessengerBuilder &AddStreamFactory(const Protocol* protocol, StreamFactoryPtr factory);
 
+  // Transfers data of plain TCP connections using io_uring instead of libev driven readv/writev,
+  // when io_uring is supported by the running kernel.
+  // Should be called before streams layered over TCP, e.g. secure ones, are set up, since they
+  // pick the TCP stream factory when they are added.
+  MessengerBuilder &UseIoUring();
+
+  // Returns factory of streams for the given protocol, or nullptr if there is no such factory.
+  StreamFactoryPtr stream_factory(const Protocol* protocol) const;
+
+  // Wraps streams of the listen protocol with compressed stream and makes it the listen protocol.
+  // Inbound connections are accepted with and without compression, outbound connections are
+  // compressed according to rpc_compression_algorithm.
+  // Should be called after the stream factory of the listen protocol is set up.
+  MessengerBuilder &UseCompression();
+
   MessengerBuilder &SetListenProtocol(const Protocol* protocol) {
     listen_protocol_ = protocol;
     return *this;
@@ -250,6 +250,15 @@ void OutboundCall::NotifyTransferred(const Status& status, Connection* conn) {
 void OutboundCall::Serialize(boost::container::small_vector_base<RefCntBuffer>* output) {
   output->push_back(std::move(buffer_));
   buffer_consumption_ = ScopedTrackedConsumption();
+  for (auto& fields : request_fields_) {
+    output->push_back(std::move(fields));
+  }
+  request_fields_.clear();
+}
+
+std::vector<RefCntBuffer> OutboundCall::TakeRequestFields() {
+  std::lock_guard<simple_spinlock> l(controller_->lock_);
+  return std::move(controller_->request_fields_);
 }
 
 Status OutboundCall::SetRequestParam(
@@ -257,10 +266,16 @@ Status OutboundCall::SetRequestParam(
   using serialization::SerializeHeader;
   using serialization::SerializeMessage;
 
+  request_fields_ = TakeRequestFields();
+  size_t fields_size = 0;
+  for (const auto& fields : request_fields_) {
+    fields_size += fields.size();
+  }
+
   size_t message_size = 0;
   auto status = SerializeMessage(message,
                                  /* param_buf */ nullptr,
-                                 /* additional_size */ 0,
+                                 fields_size,
                                  /* use_cached_size */ false,
                                  /* offset */ 0,
                                  &message_size);
@@ -271,7 +286,8 @@ Status OutboundCall::SetRequestParam(
 
   RequestHeader header;
   InitHeader(&header);
-  status = SerializeHeader(header, message_size, &buffer_, message_size, &header_size);
+  status = SerializeHeader(
+      header, message_size + fields_size, &buffer_, message_size, &header_size);
   remote_method_pool_->Release(header.release_remote_method());
   if (!status.ok()) {
     return status;
@@ -283,7 +299,7 @@ Status OutboundCall::SetRequestParam(
 
   return SerializeMessage(message,
                           &buffer_,
-                          /* additional_size */ 0,
+                          fields_size,
                           /* use_cached_size */ true,
                           header_size);
 }
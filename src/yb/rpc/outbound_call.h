@@ -330,6 +330,10 @@ class OutboundCall : public RpcCall {
   // Can be used only while callback_ object is alive.
   google::protobuf::Message* response_;
 
+ protected:
+  // Moves the serialized request fields added to the controller into the result.
+  std::vector<RefCntBuffer> TakeRequestFields();
+
  private:
   friend class RpcController;
 
@@ -383,6 +387,9 @@ class OutboundCall : public RpcCall {
   // Consumption of buffer_.
   ScopedTrackedConsumption buffer_consumption_;
 
+  // Serialized fields of the request, sent after buffer_.
+  std::vector<RefCntBuffer> request_fields_;
+
   // Once a response has been received for this call, contains that response.
   CallResponse call_response_;
 
@@ -569,7 +569,7 @@ Status Reactor::FindOrStartConnection(const ConnectionId &conn_id,
   auto stream = VERIFY_RESULT(CreateStream(
       messenger_->stream_factories_, conn_id.protocol(),
       {conn_id.remote(), hostname, &sock,
-       messenger_->connection_context_factory_->buffer_tracker()}));
+       messenger_->connection_context_factory_->buffer_tracker(), &messenger()->rpc_metrics()}));
 
   // Register the new connection in our map.
   auto connection = std::make_shared<Connection>(
@@ -866,7 +866,7 @@ void Reactor::RegisterInboundSocket(
 
   auto stream = CreateStream(
       messenger_->stream_factories_, messenger_->listen_protocol_,
-      {remote, std::string(), socket, mem_tracker});
+      {remote, std::string(), socket, mem_tracker, &messenger()->rpc_metrics()});
   if (!stream.ok()) {
     LOG_WITH_PREFIX(DFATAL) << "Failed to create stream for " << remote << ": " << stream.status();
     return;
@@ -30,6 +30,7 @@
 // under the License.
 //
 
+#include <fstream>
 #include <string>
 #include <thread>
 
@@ -37,6 +38,7 @@
 
 #include "yb/rpc/rpc-test-base.h"
 #include "yb/rpc/rtest.proxy.h"
+#include "yb/rpc/uring_stream.h"
 #include "yb/util/countdown_latch.h"
 #include "yb/util/test_util.h"
 
@@ -48,6 +50,20 @@ using std::shared_ptr;
 namespace yb {
 namespace rpc {
 
+// Number of read and write family system calls made by this process, readv/writev included.
+uint64_t NumReadWriteSyscalls() {
+  std::ifstream input("/proc/self/io");
+  std::string key;
+  uint64_t value;
+  uint64_t result = 0;
+  while (input >> key >> value) {
+    if (key == "syscr:" || key == "syscw:") {
+      result += value;
+    }
+  }
+  return result;
+}
+
 class RpcBench : public RpcTestBase {
  public:
   RpcBench() {}
@@ -55,7 +71,10 @@ class RpcBench : public RpcTestBase {
  protected:
   friend class ClientThread;
 
+  void DoBenchmarkCalls(bool use_io_uring);
+
   HostPort server_hostport_;
+  MessengerOptions client_options_ = kDefaultClientMessengerOptions;
   std::atomic<bool> should_run_{true};
 };
 
@@ -76,7 +95,8 @@ class ClientThread {
 
   void Run() {
     CDSAttacher attacher;
-    auto client_messenger = CreateAutoShutdownMessengerHolder(bench_->CreateMessenger("Client"));
+    auto client_messenger = CreateAutoShutdownMessengerHolder(
+        bench_->CreateMessenger("Client", bench_->client_options_));
     ProxyCache proxy_cache(client_messenger.get());
 
     rpc_test::CalculatorServiceProxy p(&proxy_cache, HostPort(bench_->server_hostport_));
@@ -100,20 +120,25 @@ class ClientThread {
 };
 
 
-// Test making successful RPC calls.
-TEST_F(RpcBench, BenchmarkCalls) {
+void RpcBench::DoBenchmarkCalls(bool use_io_uring) {
   TestServerOptions options;
   options.n_worker_threads = 1;
+  options.messenger_options.use_io_uring = use_io_uring;
+  client_options_.use_io_uring = use_io_uring;
 
   // Set up server.
-  StartTestServerWithGeneratedCode(&server_hostport_);
+  StartTestServerWithGeneratedCode(&server_hostport_, options);
 
   // Set up client.
   LOG(INFO) << "Connecting to " << server_hostport_;
-  MessengerOptions client_options = kDefaultClientMessengerOptions;
+  MessengerOptions client_options = client_options_;
   client_options.n_reactors = 2;
   auto client_messenger = CreateAutoShutdownMessengerHolder("Client", client_options);
 
+  auto read_write_syscalls_before = NumReadWriteSyscalls();
+  auto uring_submit_calls_before = UringStream::NumSubmitCalls();
+  auto uring_ops_before = UringStream::NumSubmittedOps();
+
   Stopwatch sw(Stopwatch::ALL_THREADS);
   sw.start();
 
@@ -147,6 +172,29 @@ TEST_F(RpcBench, BenchmarkCalls) {
   LOG(INFO) << "Reqs/sec:         " << reqs_per_second;
   LOG(INFO) << "User CPU per req: " << user_cpu_micros_per_req << "us";
   LOG(INFO) << "Sys CPU per req:  " << sys_cpu_micros_per_req << "us";
+
+  auto read_write_syscalls = NumReadWriteSyscalls() - read_write_syscalls_before;
+  auto uring_submit_calls = UringStream::NumSubmitCalls() - uring_submit_calls_before;
+  auto uring_ops = UringStream::NumSubmittedOps() - uring_ops_before;
+  LOG(INFO) << "Read/write syscalls per req: "
+            << static_cast<double>(read_write_syscalls) / total_reqs;
+  LOG(INFO) << "io_uring_enter calls per req: "
+            << static_cast<double>(uring_submit_calls) / total_reqs
+            << ", ops per req: " << static_cast<double>(uring_ops) / total_reqs;
+}
+
+// Test making successful RPC calls.
+TEST_F(RpcBench, BenchmarkCalls) {
+  DoBenchmarkCalls(false /* use_io_uring */);
+}
+
+// Same as BenchmarkCalls, but connections transfer data using io_uring.
+TEST_F(RpcBench, BenchmarkCallsIoUring) {
+  if (!UringStream::IsSupported()) {
+    LOG(INFO) << "io_uring is not supported, skipping test";
+    return;
+  }
+  DoBenchmarkCalls(true /* use_io_uring */);
 }
 
 } // namespace rpc
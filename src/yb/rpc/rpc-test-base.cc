@@ -76,6 +76,9 @@ MessengerBuilder CreateMessengerBuilder(const std::string& name,
   if (options.num_connections_to_server >= 0) {
     bld.set_num_connections_to_server(options.num_connections_to_server);
   }
+  if (options.use_io_uring) {
+    bld.UseIoUring();
+  }
   static constexpr std::chrono::milliseconds kMinCoarseTimeGranularity(1);
   static constexpr std::chrono::milliseconds kMaxCoarseTimeGranularity(100);
   auto coarse_time_granularity = std::max(std::min(options.keep_alive_timeout / 10,
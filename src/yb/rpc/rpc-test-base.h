@@ -131,6 +131,7 @@ struct MessengerOptions {
   size_t n_reactors;
   std::chrono::milliseconds keep_alive_timeout;
   int num_connections_to_server = -1;
+  bool use_io_uring = false;
 };
 
 extern const MessengerOptions kDefaultClientMessengerOptions;
@@ -50,20 +50,25 @@
 #include "yb/gutil/strings/human_readable.h"
 #include "yb/gutil/strings/join.h"
 
+#include "yb/rpc/compressed_stream.h"
 #include "yb/rpc/secure_stream.h"
 #include "yb/rpc/serialization.h"
 #include "yb/rpc/tcp_stream.h"
+#include "yb/rpc/uring_stream.h"
 #include "yb/rpc/yb_rpc.h"
 
 #include "yb/util/countdown_latch.h"
 #include "yb/util/env.h"
 #include "yb/util/logging_test_util.h"
+#include "yb/util/random_util.h"
 #include "yb/util/test_util.h"
 
 #include "yb/util/memory/memory_usage_test_util.h"
 
 METRIC_DECLARE_histogram(handler_latency_yb_rpc_test_CalculatorService_Sleep);
 METRIC_DECLARE_histogram(rpc_incoming_queue_time);
+METRIC_DECLARE_counter(rpc_compression_input_bytes);
+METRIC_DECLARE_counter(rpc_compression_output_bytes);
 
 DEFINE_int32(rpc_test_connection_keepalive_num_iterations, 1,
   "Number of iterations in TestRpc.TestConnectionKeepalive");
@@ -74,6 +79,7 @@ DECLARE_bool(enable_rpc_keepalive);
 DECLARE_int64(memory_limit_hard_bytes);
 DECLARE_bool(TEST_pause_calculator_echo_request);
 DECLARE_bool(binary_call_parser_reject_on_mem_tracker_hard_limit);
+DECLARE_string(rpc_compression_algorithm);
 
 using namespace std::chrono_literals;
 using std::string;
@@ -1033,8 +1039,8 @@ class TestRpcSecure : public RpcTestBase {
     builder.SetListenProtocol(SecureStreamProtocol());
     builder.AddStreamFactory(
         SecureStreamProtocol(),
-        SecureStreamFactory(TcpStream::Factory(), MemTracker::GetRootTracker(),
-                            secure_context_.get()));
+        SecureStreamFactory(builder.stream_factory(TcpStream::StaticProtocol()),
+                            MemTracker::GetRootTracker(), secure_context_.get()));
     return EXPECT_RESULT(builder.Build());
   }
 
@@ -1063,6 +1069,61 @@ TEST_F(TestRpcSecure, TLS) {
   ASSERT_EQ(30, resp.result());
 }
 
+// Compression is layered over encryption, so compressed data is sent over TLS.
+TEST_F(TestRpcSecure, TLSWithCompression) {
+  FLAGS_rpc_compression_algorithm = "lz4";
+  auto create_messenger = [this](const std::string& name, const MessengerOptions& options) {
+    auto builder = CreateMessengerBuilder(name, options);
+    builder.SetListenProtocol(SecureStreamProtocol());
+    builder.AddStreamFactory(
+        SecureStreamProtocol(),
+        SecureStreamFactory(builder.stream_factory(TcpStream::StaticProtocol()),
+                            MemTracker::GetRootTracker(), secure_context_.get()));
+    builder.UseCompression();
+    return EXPECT_RESULT(builder.Build());
+  };
+
+  HostPort server_hostport;
+  StartTestServerWithGeneratedCode(
+      create_messenger("TestServer", kDefaultServerMessengerOptions), &server_hostport);
+  auto input_bytes = METRIC_rpc_compression_input_bytes.Instantiate(metric_entity());
+  auto output_bytes = METRIC_rpc_compression_output_bytes.Instantiate(metric_entity());
+
+  auto compressed_client = rpc::CreateAutoShutdownMessengerHolder(
+      create_messenger("CompressedClient", kDefaultClientMessengerOptions));
+  // Clients that only use TLS are still accepted.
+  auto secure_client = rpc::CreateAutoShutdownMessengerHolder(CreateSecureMessenger("Client"));
+
+  for (auto protocol : {CompressedStreamProtocol(), SecureStreamProtocol()}) {
+    auto* client_messenger = protocol == CompressedStreamProtocol() ? compressed_client.get()
+                                                                    : secure_client.get();
+    ProxyCache proxy_cache(client_messenger);
+    rpc_test::CalculatorServiceProxy p(&proxy_cache, server_hostport, protocol);
+    auto input_bytes_before = input_bytes->value();
+    auto output_bytes_before = output_bytes->value();
+
+    RpcController controller;
+    controller.set_timeout(30s);
+    rpc_test::EchoRequestPB req;
+    req.set_data(std::string(512_KB, 'x') + RandomHumanReadableString(512_KB));
+    rpc_test::EchoResponsePB resp;
+    ASSERT_OK(p.Echo(req, &resp, &controller));
+    ASSERT_EQ(req.data(), resp.data());
+
+    auto input_delta = input_bytes->value() - input_bytes_before;
+    auto output_delta = output_bytes->value() - output_bytes_before;
+    LOG(INFO) << protocol->ToString() << ": compressed " << input_delta << " bytes to "
+              << output_delta;
+    if (protocol == CompressedStreamProtocol()) {
+      // Request and response.
+      ASSERT_GE(input_delta, 2_MB);
+      ASSERT_LT(output_delta, input_delta);
+    } else {
+      ASSERT_EQ(input_delta, 0);
+    }
+  }
+}
+
 TEST_F(TestRpcSecure, CantAllocateReadBuffer) {
   // Set up server.
   TestServerOptions options = SetupServerForTestCantAllocateReadBuffer();
@@ -1076,5 +1137,260 @@ TEST_F(TestRpcSecure, CantAllocateReadBuffer) {
   TestCantAllocateReadBuffer(client_messenger.get(), server_addr);
 }
 
+class TestRpcCompression : public RpcTestBase {
+ protected:
+  std::unique_ptr<Messenger> CreateCompressedMessenger(
+      const std::string& name, const MessengerOptions& options = kDefaultClientMessengerOptions) {
+    auto builder = CreateMessengerBuilder(name, options);
+    builder.UseCompression();
+    return EXPECT_RESULT(builder.Build());
+  }
+
+  void TestEcho(Messenger* client_messenger, const HostPort& server_hostport,
+                const Protocol* protocol) {
+    ProxyCache proxy_cache(client_messenger);
+    rpc_test::CalculatorServiceProxy p(&proxy_cache, server_hostport, protocol);
+
+    // Small payload is sent uncompressed, big one is compressed in both directions.
+    const size_t kSizes[] = {10, 1_MB};
+    for (auto size : kSizes) {
+      RpcController controller;
+      controller.set_timeout(5s);
+      rpc_test::EchoRequestPB req;
+      req.set_data(std::string(size / 2, 'x') + RandomHumanReadableString(size / 2));
+      rpc_test::EchoResponsePB resp;
+      ASSERT_OK(p.Echo(req, &resp, &controller));
+      ASSERT_EQ(req.data(), resp.data());
+    }
+  }
+};
+
+TEST_F(TestRpcCompression, Algorithms) {
+  HostPort server_hostport;
+  StartTestServerWithGeneratedCode(
+      CreateCompressedMessenger("TestServer", kDefaultServerMessengerOptions), &server_hostport);
+  auto input_bytes = METRIC_rpc_compression_input_bytes.Instantiate(metric_entity());
+  auto output_bytes = METRIC_rpc_compression_output_bytes.Instantiate(metric_entity());
+
+  for (const auto* algorithm : {"none", "snappy", "lz4", "zlib"}) {
+    FLAGS_rpc_compression_algorithm = algorithm;
+    auto input_bytes_before = input_bytes->value();
+    auto output_bytes_before = output_bytes->value();
+
+    auto client_messenger = rpc::CreateAutoShutdownMessengerHolder(
+        CreateCompressedMessenger(Format("Client-$0", algorithm)));
+    ASSERT_NO_FATALS(TestEcho(
+        client_messenger.get(), server_hostport, CompressedStreamProtocol()));
+
+    auto input_delta = input_bytes->value() - input_bytes_before;
+    auto output_delta = output_bytes->value() - output_bytes_before;
+    LOG(INFO) << algorithm << ": compressed " << input_delta << " bytes to " << output_delta;
+    if (FLAGS_rpc_compression_algorithm == "none") {
+      ASSERT_EQ(input_delta, 0);
+    } else {
+      // Request and response of the big call.
+      ASSERT_GE(input_delta, 2_MB);
+      ASSERT_LT(output_delta, input_delta);
+    }
+  }
+}
+
+TEST_F(TestRpcCompression, UncompressedClient) {
+  FLAGS_rpc_compression_algorithm = "lz4";
+  HostPort server_hostport;
+  StartTestServerWithGeneratedCode(
+      CreateCompressedMessenger("TestServer", kDefaultServerMessengerOptions), &server_hostport);
+
+  auto client_messenger = CreateAutoShutdownMessengerHolder("Client");
+  ASSERT_NO_FATALS(TestEcho(
+      client_messenger.get(), server_hostport, TcpStream::StaticProtocol()));
+}
+
+namespace {
+
+bool IoUringSupported() {
+  if (!UringStream::IsSupported()) {
+    LOG(INFO) << "io_uring is not supported, skipping test";
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+TEST_F(TestRpcSecure, TLSOverIoUring) {
+  if (!IoUringSupported()) {
+    return;
+  }
+  MessengerOptions client_options = kDefaultClientMessengerOptions;
+  client_options.use_io_uring = true;
+  MessengerOptions server_options = kDefaultServerMessengerOptions;
+  server_options.use_io_uring = true;
+  auto client_messenger = rpc::CreateAutoShutdownMessengerHolder(
+      CreateSecureMessenger("Client", client_options));
+  ProxyCache proxy_cache(client_messenger.get());
+
+  HostPort server_hostport;
+  StartTestServerWithGeneratedCode(
+      CreateSecureMessenger("TestServer", server_options), &server_hostport);
+
+  rpc_test::CalculatorServiceProxy p(&proxy_cache, server_hostport, SecureStreamProtocol());
+  for (size_t size : {10_KB, 4_MB}) {
+    RpcController controller;
+    controller.set_timeout(30s);
+    rpc_test::EchoRequestPB req;
+    req.set_data(RandomHumanReadableString(size));
+    rpc_test::EchoResponsePB resp;
+    ASSERT_OK(p.Echo(req, &resp, &controller));
+    ASSERT_EQ(req.data(), resp.data());
+  }
+}
+
+class TestRpcIoUring : public RpcTestBase {
+ protected:
+  void TestEcho(Messenger* client_messenger, const HostPort& server_hostport) {
+    ProxyCache proxy_cache(client_messenger);
+    rpc_test::CalculatorServiceProxy p(&proxy_cache, server_hostport);
+
+    // Big payloads span several read buffers and could not be written by one operation.
+    const size_t kSizes[] = {10, 64_KB, 8_MB};
+    for (auto size : kSizes) {
+      RpcController controller;
+      controller.set_timeout(30s);
+      rpc_test::EchoRequestPB req;
+      req.set_data(RandomHumanReadableString(size));
+      rpc_test::EchoResponsePB resp;
+      ASSERT_OK(p.Echo(req, &resp, &controller));
+      ASSERT_EQ(req.data(), resp.data());
+    }
+
+    // Concurrent calls share the connection, so their frames follow each other in the stream.
+    constexpr size_t kNumCalls = 20;
+    std::vector<rpc_test::EchoRequestPB> requests(kNumCalls);
+    std::vector<rpc_test::EchoResponsePB> responses(kNumCalls);
+    std::vector<RpcController> controllers(kNumCalls);
+    CountDownLatch latch(kNumCalls);
+    for (size_t i = 0; i != kNumCalls; ++i) {
+      requests[i].set_data(RandomHumanReadableString(256_KB + i * 1_KB));
+      controllers[i].set_timeout(30s);
+      p.EchoAsync(requests[i], &responses[i], &controllers[i], [&latch] { latch.CountDown(); });
+    }
+    latch.Wait();
+    for (size_t i = 0; i != kNumCalls; ++i) {
+      ASSERT_OK(controllers[i].status());
+      ASSERT_EQ(requests[i].data(), responses[i].data());
+    }
+  }
+
+  MessengerOptions IoUringOptions(const MessengerOptions& options) {
+    auto result = options;
+    result.use_io_uring = true;
+    return result;
+  }
+};
+
+TEST_F(TestRpcIoUring, LargeCalls) {
+  if (!IoUringSupported()) {
+    return;
+  }
+  TestServerOptions options;
+  options.messenger_options = IoUringOptions(kDefaultServerMessengerOptions);
+  HostPort server_hostport;
+  StartTestServerWithGeneratedCode(&server_hostport, options);
+
+  auto client_messenger = CreateAutoShutdownMessengerHolder(
+      "Client", IoUringOptions(kDefaultClientMessengerOptions));
+  ASSERT_NO_FATALS(TestEcho(client_messenger.get(), server_hostport));
+}
+
+// io_uring streams use the same wire format, so they talk to libev based ones.
+TEST_F(TestRpcIoUring, PlainServer) {
+  if (!IoUringSupported()) {
+    return;
+  }
+  HostPort server_hostport;
+  StartTestServerWithGeneratedCode(&server_hostport);
+
+  auto client_messenger = CreateAutoShutdownMessengerHolder(
+      "Client", IoUringOptions(kDefaultClientMessengerOptions));
+  ASSERT_NO_FATALS(TestEcho(client_messenger.get(), server_hostport));
+}
+
+TEST_F(TestRpcIoUring, Errors) {
+  if (!IoUringSupported()) {
+    return;
+  }
+  auto client_messenger = CreateAutoShutdownMessengerHolder(
+      "Client", IoUringOptions(kDefaultClientMessengerOptions));
+
+  // Connect to the address nobody listens on.
+  {
+    Proxy p(client_messenger.get(), HostPort());
+    for (int i = 0; i < 3; i++) {
+      Status s = DoTestSyncCall(&p, CalculatorServiceMethods::AddMethod());
+      ASSERT_TRUE(s.IsRemoteError()) << "unexpected status: " << s.ToString();
+    }
+  }
+
+  // Error response of the server.
+  TestServerOptions options;
+  options.messenger_options = IoUringOptions(kDefaultServerMessengerOptions);
+  HostPort server_hostport;
+  StartTestServer(&server_hostport, options);
+  Proxy p(client_messenger.get(), server_hostport);
+  static RemoteMethod method(
+      rpc_test::CalculatorServiceIf::static_service_name(), "ThisMethodDoesNotExist");
+  Status s = DoTestSyncCall(&p, &method);
+  ASSERT_TRUE(s.IsRemoteError()) << "unexpected status: " << s.ToString();
+  ASSERT_STR_CONTAINS(s.ToString(), "bad method");
+
+  // The connection is still usable after the error.
+  ASSERT_OK(DoTestSyncCall(&p, CalculatorServiceMethods::AddMethod()));
+}
+
+TEST_F(TestRpcIoUring, ConnectionClosed) {
+  if (!IoUringSupported()) {
+    return;
+  }
+  HostPort server_hostport;
+  Socket listen_sock;
+  ASSERT_OK(StartFakeServer(&listen_sock, &server_hostport));
+
+  auto client_messenger = CreateAutoShutdownMessengerHolder(
+      "Client", IoUringOptions(kDefaultClientMessengerOptions));
+  Proxy p(client_messenger.get(), server_hostport);
+
+  rpc_test::AddRequestPB req;
+  req.set_x(1);
+  req.set_y(2);
+  rpc_test::AddResponsePB resp;
+  constexpr int kNumCalls = 5;
+  std::vector<RpcController> controllers(kNumCalls);
+  CountDownLatch latch(kNumCalls);
+  for (auto& controller : controllers) {
+    p.AsyncRequest(CalculatorServiceMethods::AddMethod(), req, &resp, &controller, [&latch]() {
+      latch.CountDown();
+    });
+  }
+
+  Socket server_sock;
+  Endpoint remote;
+  ASSERT_OK(listen_sock.Accept(&server_sock, &remote, 0));
+  for (const auto& controller : controllers) {
+    ASSERT_FALSE(controller.finished());
+  }
+
+  // Closing the connection fails the calls that are queued or wait for responses.
+  ASSERT_OK(listen_sock.Close());
+  ASSERT_OK(server_sock.Close());
+  latch.Wait();
+
+  for (const auto& controller : controllers) {
+    ASSERT_TRUE(controller.finished());
+    Status s = controller.status();
+    ASSERT_TRUE(s.IsNetworkError()) << "Unexpected status: " << s.ToString();
+  }
+}
+
 } // namespace rpc
 } // namespace yb
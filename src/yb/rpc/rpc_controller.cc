@@ -69,6 +69,7 @@ void RpcController::Swap(RpcController* other) {
   std::swap(timeout_, other->timeout_);
   std::swap(allow_local_calls_in_curr_thread_, other->allow_local_calls_in_curr_thread_);
   std::swap(call_, other->call_);
+  request_fields_.swap(other->request_fields_);
   std::swap(invoke_callback_mode_, other->invoke_callback_mode_);
 }
 
@@ -78,6 +79,7 @@ void RpcController::Reset() {
     CHECK(finished());
   }
   call_.reset();
+  request_fields_.clear();
 }
 
 bool RpcController::finished() const {
@@ -101,6 +103,12 @@ const ErrorStatusPB* RpcController::error_response() const {
   return nullptr;
 }
 
+void RpcController::AddRequestFields(RefCntBuffer fields) {
+  std::lock_guard<simple_spinlock> l(lock_);
+  DCHECK(!call_ || call_->state() == RpcCallState::READY);
+  request_fields_.push_back(std::move(fields));
+}
+
 Result<Slice> RpcController::GetSidecar(int idx) const {
   return call_->GetSidecar(idx);
 }
@@ -40,6 +40,7 @@
 #include "yb/rpc/rpc_fwd.h"
 #include "yb/util/locks.h"
 #include "yb/util/monotime.h"
+#include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/status.h"
 
 namespace yb {
@@ -146,6 +147,11 @@ class RpcController {
   // Return the configured timeout.
   MonoDelta timeout() const;
 
+  // Adds already serialized protobuf fields, that are sent after the request message of the next
+  // call as if they were part of it. So large parts of requests, shared by several calls, could be
+  // serialized once. Fields are consumed when the call is started.
+  void AddRequestFields(RefCntBuffer fields);
+
   // Returns the slice pointing to the i-th sidecar upon success.
   //
   // Should only be called if the call's finished, but the controller has not
@@ -164,6 +170,7 @@ class RpcController {
 
   // Once the call is sent, it is tracked here.
   OutboundCallPtr call_;
+  std::vector<RefCntBuffer> request_fields_;
   bool allow_local_calls_in_curr_thread_ = false;
   InvokeCallbackMode invoke_callback_mode_ = InvokeCallbackMode::kThreadPool;
 
@@ -43,6 +43,27 @@ METRIC_DEFINE_counter(server, rpc_outbound_calls_created,
                       yb::MetricUnit::kRequests,
                       "Number of created RPC outbound calls.");
 
+METRIC_DEFINE_counter(server, rpc_compression_input_bytes,
+                      "Bytes passed to RPC compression.",
+                      yb::MetricUnit::kBytes,
+                      "Size of outbound RPC data blocks passed to compression.");
+
+METRIC_DEFINE_counter(server, rpc_compression_output_bytes,
+                      "Bytes produced by RPC compression.",
+                      yb::MetricUnit::kBytes,
+                      "Size of outbound RPC data blocks after compression, blocks that could not "
+                      "be compressed are accounted with their original size.");
+
+METRIC_DEFINE_counter(server, rpc_compression_cpu_time_us,
+                      "CPU time spent on RPC compression.",
+                      yb::MetricUnit::kMicroseconds,
+                      "CPU time spent by reactor threads on compression of outbound RPC data.");
+
+METRIC_DEFINE_counter(server, rpc_decompression_cpu_time_us,
+                      "CPU time spent on RPC decompression.",
+                      yb::MetricUnit::kMicroseconds,
+                      "CPU time spent by reactor threads on decompression of inbound RPC data.");
+
 namespace yb {
 namespace rpc {
 
@@ -54,6 +75,10 @@ RpcMetrics::RpcMetrics(const scoped_refptr<MetricEntity>& metric_entity) {
     inbound_calls_created = METRIC_rpc_inbound_calls_created.Instantiate(metric_entity);
     outbound_calls_alive = METRIC_rpc_outbound_calls_alive.Instantiate(metric_entity, 0);
     outbound_calls_created = METRIC_rpc_outbound_calls_created.Instantiate(metric_entity);
+    compression_input_bytes = METRIC_rpc_compression_input_bytes.Instantiate(metric_entity);
+    compression_output_bytes = METRIC_rpc_compression_output_bytes.Instantiate(metric_entity);
+    compression_cpu_time_us = METRIC_rpc_compression_cpu_time_us.Instantiate(metric_entity);
+    decompression_cpu_time_us = METRIC_rpc_decompression_cpu_time_us.Instantiate(metric_entity);
   }
 }
 
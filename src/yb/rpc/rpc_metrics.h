@@ -28,6 +28,10 @@ struct RpcMetrics {
   scoped_refptr<Counter> inbound_calls_created;
   scoped_refptr<AtomicGauge<int64_t>> outbound_calls_alive;
   scoped_refptr<Counter> outbound_calls_created;
+  scoped_refptr<Counter> compression_input_bytes;
+  scoped_refptr<Counter> compression_output_bytes;
+  scoped_refptr<Counter> compression_cpu_time_us;
+  scoped_refptr<Counter> decompression_cpu_time_us;
 };
 
 } // namespace rpc
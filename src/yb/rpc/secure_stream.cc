@@ -341,6 +341,10 @@ class SecureStream : public Stream, public StreamContext {
       const IoVecs& data, ReadBufferFull read_buffer_full) override;
   void Connected() override;
 
+  std::shared_ptr<void> KeepAlive() override {
+    return context_->KeepAlive();
+  }
+
   StreamReadBuffer& ReadBuffer() override {
     return encrypted_read_buffer_;
   }
@@ -92,6 +92,10 @@ class StreamContext {
       const IoVecs& data, ReadBufferFull read_buffer_full) = 0;
   virtual StreamReadBuffer& ReadBuffer() = 0;
 
+  // Returns object that keeps this context and its read buffer alive. Used by streams that
+  // complete shutdown asynchronously, after the kernel released their buffers.
+  virtual std::shared_ptr<void> KeepAlive() = 0;
+
  protected:
   ~StreamContext() {}
 };
@@ -150,6 +154,7 @@ struct StreamCreateData {
   const std::string& remote_hostname;
   Socket* socket;
   std::shared_ptr<MemTracker> mem_tracker;
+  RpcMetrics* rpc_metrics = nullptr;
 };
 
 class StreamFactory {
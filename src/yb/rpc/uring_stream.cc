@@ -0,0 +1,912 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rpc/uring_stream.h"
+
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+// Sockets are switched to blocking mode, so kernel should poll them instead of blocking io-wq
+// workers on reads, that requires IORING_FEAT_FAST_POLL.
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && \
+    defined(IORING_FEAT_FAST_POLL)
+#define YB_HAVE_IO_URING 1
+#endif
+#endif
+#endif
+
+#include "yb/rpc/outbound_data.h"
+#include "yb/rpc/rpc_util.h"
+
+#include "yb/util/errno.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+#include "yb/util/string_util.h"
+
+DEFINE_int32(rpc_io_uring_queue_depth, 4096,
+             "Number of submission queue entries of the io_uring used by each reactor. Each "
+             "connection has at most two operations in flight.");
+TAG_FLAG(rpc_io_uring_queue_depth, advanced);
+
+DEFINE_bool(rpc_io_uring_sqpoll, false,
+            "Let a kernel thread poll io_uring submission queues of reactors, so submitting "
+            "operations does not require a system call.");
+TAG_FLAG(rpc_io_uring_sqpoll, advanced);
+
+namespace yb {
+namespace rpc {
+
+namespace {
+
+const size_t kMaxIov = 16;
+
+std::atomic<uint64_t> num_submit_calls{0};
+std::atomic<uint64_t> num_submitted_ops{0};
+
+} // namespace
+
+#if defined(YB_HAVE_IO_URING)
+
+namespace {
+
+int IoUringSetup(unsigned entries, io_uring_params* params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int IoUringEnter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+  return static_cast<int>(
+      syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+bool HasFastPoll(const io_uring_params& params) {
+  return (params.features & IORING_FEAT_FAST_POLL) != 0;
+}
+
+template <class T>
+T* RingField(void* ring, uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+
+} // namespace
+
+// io_uring instance shared by all streams of a reactor. Used only from the reactor thread.
+class IoUring : public std::enable_shared_from_this<IoUring> {
+ public:
+  static Result<std::shared_ptr<IoUring>> ForCurrentThread(ev::loop_ref* loop) {
+    static thread_local ThreadRing thread_ring;
+    auto result = thread_ring.ring.lock();
+    if (result) {
+      return result;
+    }
+    result = std::make_shared<IoUring>(loop);
+    RETURN_NOT_OK(result->Init());
+    thread_ring.ring = result;
+    return result;
+  }
+
+  explicit IoUring(ev::loop_ref* loop) : loop_(*loop) {}
+
+  IoUring(const IoUring&) = delete;
+  void operator=(const IoUring&) = delete;
+
+  ~IoUring() {
+    LOG_IF(DFATAL, !completed_.empty()) << "Destroying io_uring with unprocessed completions";
+    if (fd_ >= 0) {
+      io_.stop();
+      prepare_.stop();
+    }
+    if (sqes_) {
+      munmap(sqes_, sqes_size_);
+    }
+    if (cq_ring_ && cq_ring_ != sq_ring_) {
+      munmap(cq_ring_, cq_ring_size_);
+    }
+    if (sq_ring_) {
+      munmap(sq_ring_, sq_ring_size_);
+    }
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+
+  CHECKED_STATUS Init() {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    if (FLAGS_rpc_io_uring_sqpoll) {
+      params.flags |= IORING_SETUP_SQPOLL;
+    }
+    fd_ = IoUringSetup(FLAGS_rpc_io_uring_queue_depth, &params);
+    if (fd_ < 0 && FLAGS_rpc_io_uring_sqpoll) {
+      // SQPOLL requires privileges on older kernels.
+      LOG(WARNING) << "Failed to setup io_uring with SQPOLL, falling back to regular submission: "
+                   << ErrnoToString(errno);
+      memset(&params, 0, sizeof(params));
+      fd_ = IoUringSetup(FLAGS_rpc_io_uring_queue_depth, &params);
+    }
+    if (fd_ < 0) {
+      return STATUS(RuntimeError, "io_uring_setup failed", Errno(errno));
+    }
+    if (!HasFastPoll(params)) {
+      return STATUS(NotSupported, "io_uring does not support fast poll");
+    }
+    sqpoll_ = (params.flags & IORING_SETUP_SQPOLL) != 0;
+
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = false;
+#ifdef IORING_FEAT_SINGLE_MMAP
+    single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+#endif
+    if (single_mmap) {
+      sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+    }
+    sq_ring_ = VERIFY_RESULT(Map(sq_ring_size_, IORING_OFF_SQ_RING));
+    cq_ring_ = single_mmap ? sq_ring_ : VERIFY_RESULT(Map(cq_ring_size_, IORING_OFF_CQ_RING));
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = static_cast<io_uring_sqe*>(VERIFY_RESULT(Map(sqes_size_, IORING_OFF_SQES)));
+
+    sq_head_ = RingField<unsigned>(sq_ring_, params.sq_off.head);
+    sq_tail_ = RingField<unsigned>(sq_ring_, params.sq_off.tail);
+    sq_flags_ = RingField<unsigned>(sq_ring_, params.sq_off.flags);
+    sq_array_ = RingField<unsigned>(sq_ring_, params.sq_off.array);
+    sq_mask_ = *RingField<unsigned>(sq_ring_, params.sq_off.ring_mask);
+    sq_entries_ = params.sq_entries;
+    sq_tail_local_ = *sq_tail_;
+    cq_head_ = RingField<unsigned>(cq_ring_, params.cq_off.head);
+    cq_tail_ = RingField<unsigned>(cq_ring_, params.cq_off.tail);
+    cq_mask_ = *RingField<unsigned>(cq_ring_, params.cq_off.ring_mask);
+    cqes_ = RingField<io_uring_cqe>(cq_ring_, params.cq_off.cqes);
+
+    // Ring file descriptor is readable while there are completions to reap.
+    io_.set(loop_);
+    io_.set<IoUring, &IoUring::IoHandler>(this);
+    io_.start(fd_, ev::READ);
+    // Operations queued during loop iteration are submitted by one call before loop blocks.
+    prepare_.set(loop_);
+    prepare_.set<IoUring, &IoUring::PrepareHandler>(this);
+    prepare_.start();
+
+    LOG(INFO) << "Started io_uring, entries: " << params.sq_entries << ", sqpoll: " << sqpoll_;
+    return Status::OK();
+  }
+
+  CHECKED_STATUS QueueVectored(
+      uint8_t opcode, int fd, const iovec* iov, size_t len, UringStream::Op* op) {
+    auto* sqe = NextSqe();
+    if (!sqe) {
+      return STATUS(Busy, "io_uring submission queue is full");
+    }
+    sqe->opcode = opcode;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(iov);
+    sqe->len = static_cast<uint32_t>(len);
+    sqe->user_data = reinterpret_cast<uint64_t>(op);
+    return Status::OK();
+  }
+
+  // Asks kernel to cancel operation, completion of cancelled operation is still delivered.
+  void QueueCancel(UringStream::Op* op) {
+#ifdef IORING_OP_ASYNC_CANCEL
+    auto* sqe = NextSqe();
+    if (!sqe) {
+      return;
+    }
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = reinterpret_cast<uint64_t>(op);
+    sqe->user_data = 0;
+#endif
+  }
+
+  // Stream that is shutting down waits for completion of its operations, keeping its owner alive.
+  void StartClosing(UringStream* stream, std::shared_ptr<void> keep_alive) {
+    closing_.emplace(stream, std::move(keep_alive));
+  }
+
+  // Invoked when all operations of the closing stream are completed. The owner of the stream is
+  // released after processing of current completions, since the stream is still in use.
+  void Closed(UringStream* stream) {
+    auto it = closing_.find(stream);
+    if (it == closing_.end()) {
+      return;
+    }
+    released_.push_back(std::move(it->second));
+    closing_.erase(it);
+  }
+
+ private:
+  struct Completion {
+    UringStream::Op* op;
+    int result;
+  };
+
+  // Reactor thread could exit while some streams are still closing, so wait for them at thread
+  // exit. Waiting is fine at this point, since the reactor does not process events anymore.
+  struct ThreadRing {
+    std::weak_ptr<IoUring> ring;
+
+    ~ThreadRing() {
+      auto locked = ring.lock();
+      if (locked) {
+        locked->WaitClosingStreams();
+      }
+    }
+  };
+
+  void WaitClosingStreams() {
+    ProcessCompletions();
+    while (!closing_.empty()) {
+      Flush();
+      if (IoUringEnter(fd_, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+        LOG(DFATAL) << "Wait for io_uring completions failed: " << ErrnoToString(errno);
+        return;
+      }
+      ProcessCompletions();
+    }
+  }
+
+  Result<void*> Map(size_t size, uint64_t offset) {
+    auto* result = mmap(
+        nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, offset);
+    if (result == MAP_FAILED) {
+      return STATUS(RuntimeError, "Failed to map io_uring", Errno(errno));
+    }
+    return result;
+  }
+
+  io_uring_sqe* NextSqe() {
+    if (sq_tail_local_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_) {
+      Flush();
+      if (sq_tail_local_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_) {
+        return nullptr;
+      }
+    }
+    auto index = sq_tail_local_ & sq_mask_;
+    auto* sqe = &sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sq_array_[index] = index;
+    ++sq_tail_local_;
+    ++to_submit_;
+    return sqe;
+  }
+
+  void Flush() {
+    if (to_submit_ == 0) {
+      return;
+    }
+    __atomic_store_n(sq_tail_, sq_tail_local_, __ATOMIC_RELEASE);
+    num_submitted_ops.fetch_add(to_submit_, std::memory_order_relaxed);
+    if (sqpoll_) {
+      to_submit_ = 0;
+      if (__atomic_load_n(sq_flags_, __ATOMIC_ACQUIRE) & IORING_SQ_NEED_WAKEUP) {
+        num_submit_calls.fetch_add(1, std::memory_order_relaxed);
+        IoUringEnter(fd_, 0, 0, IORING_ENTER_SQ_WAKEUP);
+      }
+      return;
+    }
+    while (to_submit_ != 0) {
+      num_submit_calls.fetch_add(1, std::memory_order_relaxed);
+      int submitted = IoUringEnter(fd_, to_submit_, 0, 0);
+      if (submitted < 0) {
+        if (errno == EINTR || errno == EAGAIN) {
+          continue;
+        }
+        if (errno == EBUSY) {
+          // Completion queue is overflown, make some room and retry.
+          HarvestCompletions();
+          continue;
+        }
+        LOG(DFATAL) << "io_uring_enter failed: " << ErrnoToString(errno);
+        return;
+      }
+      to_submit_ -= submitted;
+    }
+  }
+
+  // Moves completions from the completion queue to completed_.
+  void HarvestCompletions() {
+    auto head = *cq_head_;
+    auto tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head) {
+      const auto& cqe = cqes_[head & cq_mask_];
+      // Cancel requests are submitted with zero user data, we don't need their completions.
+      if (cqe.user_data != 0) {
+        completed_.push_back(
+            Completion{reinterpret_cast<UringStream::Op*>(cqe.user_data), cqe.res});
+      }
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  }
+
+  void ProcessCompletions() {
+    // Stream could release the last reference to the ring during shutdown.
+    auto self = shared_from_this();
+    HarvestCompletions();
+    while (!completed_.empty()) {
+      auto completion = completed_.front();
+      completed_.pop_front();
+      completion.op->stream->OpCompleted(completion.op, completion.result);
+    }
+    // Could destroy streams, so should be done after all completions were dispatched.
+    decltype(released_) released;
+    released.swap(released_);
+  }
+
+  void IoHandler(ev::io& watcher, int revents) { // NOLINT
+    ProcessCompletions();
+  }
+
+  void PrepareHandler(ev::prepare& watcher, int revents) { // NOLINT
+    auto self = shared_from_this();
+    ProcessCompletions();
+    Flush();
+  }
+
+  ev::loop_ref loop_;
+  int fd_ = -1;
+  bool sqpoll_ = false;
+
+  void* sq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  void* cq_ring_ = nullptr;
+  size_t cq_ring_size_ = 0;
+  io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  unsigned* sq_head_ = nullptr;
+  unsigned* sq_tail_ = nullptr;
+  unsigned* sq_flags_ = nullptr;
+  unsigned* sq_array_ = nullptr;
+  unsigned sq_mask_ = 0;
+  unsigned sq_entries_ = 0;
+  // Tail including queued but not yet published entries.
+  unsigned sq_tail_local_ = 0;
+  unsigned to_submit_ = 0;
+
+  unsigned* cq_head_ = nullptr;
+  unsigned* cq_tail_ = nullptr;
+  unsigned cq_mask_ = 0;
+  io_uring_cqe* cqes_ = nullptr;
+
+  // Completions reaped from the ring, but not yet dispatched to streams.
+  std::deque<Completion> completed_;
+
+  // Streams that are shutting down with operations in flight, mapped to their owners.
+  std::unordered_map<UringStream*, std::shared_ptr<void>> closing_;
+  std::vector<std::shared_ptr<void>> released_;
+
+  ev::io io_;
+  ev::prepare prepare_;
+};
+
+#else
+
+class IoUring {
+ public:
+  static Result<std::shared_ptr<IoUring>> ForCurrentThread(ev::loop_ref* loop) {
+    return STATUS(NotSupported, "io_uring is not supported");
+  }
+
+  CHECKED_STATUS QueueVectored(
+      uint8_t opcode, int fd, const iovec* iov, size_t len, UringStream::Op* op) {
+    return STATUS(NotSupported, "io_uring is not supported");
+  }
+
+  void QueueCancel(UringStream::Op* op) {}
+
+  void StartClosing(UringStream* stream, std::shared_ptr<void> keep_alive) {}
+
+  void Closed(UringStream* stream) {}
+};
+
+#define IORING_OP_READV 0
+#define IORING_OP_WRITEV 0
+
+#endif
+
+UringStream::UringStream(const StreamCreateData& data)
+    : socket_(std::move(*data.socket)),
+      remote_(data.remote) {
+  if (data.mem_tracker) {
+    mem_tracker_ = MemTracker::FindOrCreateTracker("Sending", data.mem_tracker);
+  }
+}
+
+UringStream::~UringStream() {
+  CHECK(sending_.empty()) << ToString();
+  // Kernel could still write to buffers of operations in flight, so stream should be shut down
+  // in the reactor thread before destruction.
+  CHECK(!is_registered_) << ToString();
+  CHECK(!HasOpsInFlight()) << ToString();
+}
+
+bool UringStream::IsSupported() {
+#if defined(YB_HAVE_IO_URING)
+  static const bool result = [] {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int fd = IoUringSetup(1, &params);
+    if (fd < 0) {
+      LOG(INFO) << "io_uring is not available: " << ErrnoToString(errno);
+      return false;
+    }
+    close(fd);
+    if (!HasFastPoll(params)) {
+      LOG(INFO) << "io_uring is not used, since kernel does not support fast poll";
+      return false;
+    }
+    return true;
+  }();
+  return result;
+#else
+  return false;
+#endif
+}
+
+uint64_t UringStream::NumSubmitCalls() {
+  return num_submit_calls.load(std::memory_order_relaxed);
+}
+
+uint64_t UringStream::NumSubmittedOps() {
+  return num_submitted_ops.load(std::memory_order_relaxed);
+}
+
+Status UringStream::Start(bool connect, ev::loop_ref* loop, StreamContext* context) {
+  context_ = context;
+  connected_ = !connect;
+
+  RETURN_NOT_OK(socket_.SetNoDelay(true));
+
+  ring_ = VERIFY_RESULT(IoUring::ForCurrentThread(loop));
+
+  if (connect) {
+    auto status = socket_.Connect(remote_);
+    if (!status.ok() && !Socket::IsTemporarySocketError(status)) {
+      LOG_WITH_PREFIX(WARNING) << "Connect failed: " << status;
+      return status;
+    }
+  }
+
+  RETURN_NOT_OK(socket_.GetSocketAddress(&local_));
+  log_prefix_.clear();
+  is_registered_ = true;
+
+  if (!connected_) {
+    // Connection establishment is rare, so just wait for it using libev.
+    connect_io_.set(*loop);
+    connect_io_.set<UringStream, &UringStream::ConnectHandler>(this);
+    connect_io_.start(socket_.GetFd(), ev::WRITE);
+    return Status::OK();
+  }
+
+  return Connected();
+}
+
+Status UringStream::Connected() {
+  // io_uring does not wait for readiness of non blocking sockets, but fails with EAGAIN instead.
+  // Blocking socket makes kernel poll it on our behalf, so each operation is submitted once.
+  // IoUring::Init requires IORING_FEAT_FAST_POLL, so such operation does not block io-wq worker.
+  RETURN_NOT_OK(socket_.SetNonBlocking(false));
+  context_->Connected();
+  return StartRead();
+}
+
+void UringStream::ConnectHandler(ev::io& watcher, int revents) { // NOLINT
+  connect_io_.stop();
+  if (revents & ev::ERROR) {
+    context_->Destroy(STATUS(NetworkError, ToString() + ": Connect handler encountered an error"));
+    return;
+  }
+
+  connected_ = true;
+  auto status = Connected();
+  if (status.ok()) {
+    status = DoWrite();
+  }
+  if (!status.ok()) {
+    context_->Destroy(status);
+  }
+}
+
+void UringStream::Close() {
+  if (socket_.GetFd() >= 0) {
+    auto status = socket_.Shutdown(true, true);
+    LOG_IF(INFO, !status.ok()) << "Failed to shutdown socket: " << status;
+  }
+}
+
+void UringStream::Shutdown(const Status& status) {
+  if (closing_) {
+    return;
+  }
+  closing_ = true;
+  connect_io_.stop();
+
+  ClearSending(status);
+
+  if (ring_ && HasOpsInFlight()) {
+    // Make socket operations in flight complete, the rest of shutdown is done on their completion,
+    // since kernel could still access buffers of those operations.
+    if (socket_.GetFd() >= 0) {
+      ::shutdown(socket_.GetFd(), SHUT_RDWR);
+    }
+    if (read_in_flight_) {
+      ring_->QueueCancel(&read_op_);
+    }
+    if (write_in_flight_) {
+      ring_->QueueCancel(&write_op_);
+    }
+    ring_->StartClosing(this, context_->KeepAlive());
+    shutdown_status_ = status;
+    return;
+  }
+
+  FinishShutdown(status);
+}
+
+void UringStream::FinishShutdown(const Status& status) {
+  sending_.clear();
+  queued_bytes_to_send_ = 0;
+
+  if (!ReadBuffer().Empty()) {
+    LOG_WITH_PREFIX(WARNING) << "Shutting down with pending inbound data ("
+                             << ReadBuffer().ToString() << ", status = " << status << ")";
+  }
+
+  is_registered_ = false;
+
+  ReadBuffer().Reset();
+
+  WARN_NOT_OK(socket_.Close(), "Error closing socket");
+
+  if (ring_) {
+    auto ring = std::move(ring_);
+    ring->Closed(this);
+  }
+}
+
+void UringStream::OpCompleted(Op* op, int result) {
+  const bool read = op == &read_op_;
+  if (read) {
+    read_in_flight_ = false;
+  } else {
+    write_in_flight_ = false;
+  }
+  if (closing_) {
+    if (!HasOpsInFlight() && is_registered_) {
+      FinishShutdown(shutdown_status_);
+    }
+    return;
+  }
+
+  auto status = read ? ReadCompleted(result) : WriteCompleted(result);
+  if (!status.ok()) {
+    VLOG_WITH_PREFIX(3) << (read ? "Read" : "Write") << " failed: " << status;
+    context_->Destroy(status);
+  }
+}
+
+Status UringStream::StartRead() {
+  if (read_in_flight_ || closing_ || !connected_) {
+    return Status::OK();
+  }
+
+  if (inbound_bytes_to_skip_ > 0) {
+    auto global_skip_buffer = GetGlobalSkipBuffer();
+    read_iov_.clear();
+    read_iov_.push_back(iovec{
+        global_skip_buffer.mutable_data(),
+        std::min(global_skip_buffer.size(), inbound_bytes_to_skip_)});
+  } else {
+    auto iov = ReadBuffer().PrepareAppend();
+    if (!iov.ok()) {
+      VLOG_WITH_PREFIX(3) << "ReadBuffer().PrepareAppend() error: " << iov.status();
+      if (iov.status().IsBusy()) {
+        read_buffer_full_ = true;
+        return Status::OK();
+      }
+      return iov.status();
+    }
+    read_buffer_full_ = false;
+    read_iov_ = std::move(*iov);
+  }
+
+  RETURN_NOT_OK(ring_->QueueVectored(
+      IORING_OP_READV, socket_.GetFd(), read_iov_.data(), read_iov_.size(), &read_op_));
+  read_in_flight_ = true;
+  return Status::OK();
+}
+
+Status UringStream::ReadCompleted(int result) {
+  if (result < 0) {
+    if (result == -EAGAIN || result == -EINTR || result == -ECANCELED) {
+      // Read was cancelled by ParseReceived, so process data that could be left in the buffer.
+      if (result == -ECANCELED && inbound_bytes_to_skip_ == 0) {
+        RETURN_NOT_OK(TryProcessReceived());
+      }
+      return StartRead();
+    }
+    YB_LOG_WITH_PREFIX_EVERY_N(INFO, 50) << " Recv failed: " << ErrnoToString(-result);
+    return STATUS(NetworkError, "readv error", Errno(-result));
+  }
+  if (result == 0) {
+    VLOG_WITH_PREFIX(1) << "Shut down by remote end.";
+    return STATUS(NetworkError, "readv got EOF from remote", Slice(), Errno(ESHUTDOWN));
+  }
+
+  context_->UpdateLastRead();
+  if (inbound_bytes_to_skip_ > 0) {
+    VLOG_WITH_PREFIX(3) << "inbound_bytes_to_skip_: " << inbound_bytes_to_skip_;
+    inbound_bytes_to_skip_ -= result;
+  } else {
+    ReadBuffer().DataAppended(result);
+    RETURN_NOT_OK(TryProcessReceived());
+  }
+  return StartRead();
+}
+
+void UringStream::ParseReceived() {
+  if (read_in_flight_) {
+    // Kernel could append to the read buffer, so it could not be consumed now. Cancel the read,
+    // received data will be processed on its completion.
+    ring_->QueueCancel(&read_op_);
+    return;
+  }
+  auto result = TryProcessReceived();
+  if (result.ok() && read_buffer_full_) {
+    read_buffer_full_ = false;
+    result = StartRead();
+  }
+  if (!result.ok()) {
+    context_->Destroy(result.status());
+  }
+}
+
+Result<bool> UringStream::TryProcessReceived() {
+  auto& read_buffer = ReadBuffer();
+  if (!read_buffer.ReadyToRead()) {
+    return false;
+  }
+
+  auto result = VERIFY_RESULT(context_->ProcessReceived(
+      read_buffer.AppendedVecs(), ReadBufferFull(read_buffer.Full())));
+  DVLOG_WITH_PREFIX(5) << "context_->ProcessReceived result: " << AsString(result);
+
+  read_buffer.Consume(result.consumed, result.buffer);
+  LOG_IF(DFATAL, inbound_bytes_to_skip_ != 0)
+      << "Expected inbound_bytes_to_skip_ to be 0 instead of " << inbound_bytes_to_skip_;
+  inbound_bytes_to_skip_ = result.bytes_to_skip;
+  return true;
+}
+
+Status UringStream::TryWrite() {
+  return DoWrite();
+}
+
+UringStream::FillIovResult UringStream::FillIov(iovec* out) {
+  int index = 0;
+  size_t offset = send_position_;
+  size_t blocks = 0;
+  bool only_heartbeats = true;
+  for (auto& data : sending_) {
+    ++blocks;
+    const auto wrapped_data = data.data;
+    if (wrapped_data && !wrapped_data->IsHeartbeat()) {
+      only_heartbeats = false;
+    }
+    if (data.skipped || (offset == 0 && wrapped_data && wrapped_data->IsFinished())) {
+      queued_bytes_to_send_ -= data.bytes_size();
+      data.ClearBytes();
+      data.skipped = true;
+      continue;
+    }
+    for (const auto& bytes : data.bytes) {
+      if (offset >= bytes.size()) {
+        offset -= bytes.size();
+        continue;
+      }
+
+      out[index].iov_base = bytes.data() + offset;
+      out[index].iov_len = bytes.size() - offset;
+      offset = 0;
+      if (++index == kMaxIov) {
+        return FillIovResult{index, only_heartbeats, blocks};
+      }
+    }
+  }
+
+  return FillIovResult{index, only_heartbeats, blocks};
+}
+
+Status UringStream::DoWrite() {
+  if (!connected_ || write_in_flight_ || closing_ || !is_registered_) {
+    return Status::OK();
+  }
+
+  while (!sending_.empty()) {
+    auto fill_result = FillIov(write_iov_);
+
+    if (!fill_result.only_heartbeats) {
+      context_->UpdateLastActivity();
+    }
+
+    if (fill_result.len != 0) {
+      RETURN_NOT_OK(ring_->QueueVectored(
+          IORING_OP_WRITEV, socket_.GetFd(), write_iov_, fill_result.len, &write_op_));
+      write_in_flight_ = true;
+      write_blocks_in_flight_ = fill_result.blocks;
+      return Status::OK();
+    }
+
+    // Nothing to send, so drop skipped and empty blocks.
+    RETURN_NOT_OK(WriteCompleted(0));
+  }
+
+  return Status::OK();
+}
+
+Status UringStream::WriteCompleted(int result) {
+  if (result < 0) {
+    if (result == -EAGAIN || result == -EINTR) {
+      VLOG_WITH_PREFIX(3) << "Send temporary failed: " << ErrnoToString(-result);
+      return DoWrite();
+    }
+    YB_LOG_WITH_PREFIX_EVERY_N(WARNING, 50) << "Send failed: " << ErrnoToString(-result);
+    return STATUS(NetworkError, "writev error", Errno(-result));
+  }
+
+  if (result > 0) {
+    context_->UpdateLastWrite();
+  }
+
+  send_position_ += result;
+  while (!sending_.empty()) {
+    auto& front = sending_.front();
+    size_t full_size = front.bytes_size();
+    if (front.skipped) {
+      PopSending();
+      continue;
+    }
+    if (send_position_ < full_size) {
+      break;
+    }
+    auto data = front.data;
+    send_position_ -= full_size;
+    PopSending();
+    if (data) {
+      context_->Transferred(data, Status::OK());
+    }
+  }
+
+  // Called from DoWrite when there was nothing to send.
+  if (result == 0) {
+    return Status::OK();
+  }
+  return DoWrite();
+}
+
+void UringStream::PopSending() {
+  queued_bytes_to_send_ -= sending_.front().bytes_size();
+  sending_.pop_front();
+  ++data_blocks_sent_;
+}
+
+bool UringStream::Idle(std::string* reason_not_idle) {
+  bool result = true;
+  if (HasOpsInFlight()) {
+    if (reason_not_idle) {
+      AppendWithSeparator("operations in flight", reason_not_idle);
+    }
+    result = false;
+  }
+
+  if (!ReadBuffer().Empty()) {
+    if (reason_not_idle) {
+      AppendWithSeparator("read buffer not empty", reason_not_idle);
+    }
+    result = false;
+  }
+
+  if (!sending_.empty()) {
+    if (reason_not_idle) {
+      AppendWithSeparator("still sending", reason_not_idle);
+    }
+    result = false;
+  }
+
+  return result;
+}
+
+void UringStream::ClearSending(const Status& status) {
+  // Bytes of the blocks could be used by the write in flight, so they are released by
+  // FinishShutdown.
+  for (auto& data : sending_) {
+    if (data.data) {
+      context_->Transferred(data.data, status);
+      data.data = nullptr;
+    }
+  }
+}
+
+size_t UringStream::Send(OutboundDataPtr data) {
+  // Same as in TcpStream, handle is absolute index of data block since stream start.
+  size_t result = data_blocks_sent_ + sending_.size();
+
+  sending_.emplace_back(std::move(data), mem_tracker_);
+  queued_bytes_to_send_ += sending_.back().bytes_size();
+  DVLOG_WITH_PREFIX(4) << "Queued data, sending_.size(): " << sending_.size()
+                       << ", queued_bytes_to_send_: " << queued_bytes_to_send_;
+
+  return result;
+}
+
+void UringStream::Cancelled(size_t handle) {
+  if (handle < data_blocks_sent_) {
+    return;
+  }
+  handle -= data_blocks_sent_;
+  LOG_IF_WITH_PREFIX(DFATAL, !sending_[handle].data->IsFinished())
+      << "Cancelling not finished data: " << sending_[handle].data->ToString();
+  auto& entry = sending_[handle];
+  if ((handle == 0 && send_position_ > 0) ||
+      (write_in_flight_ && handle < write_blocks_in_flight_)) {
+    // Transfer already started, cannot drop it.
+    return;
+  }
+
+  queued_bytes_to_send_ -= entry.bytes_size();
+  entry.ClearBytes();
+}
+
+void UringStream::DumpPB(const DumpRunningRpcsRequestPB& req, RpcConnectionPB* resp) {
+  auto call_in_flight = resp->add_calls_in_flight();
+  uint64_t sending_bytes = 0;
+  for (auto& entry : sending_) {
+    auto entry_bytes_size = entry.bytes_size();
+    sending_bytes += entry_bytes_size;
+    if (!entry.data) {
+      continue;
+    }
+    if (entry.data->DumpPB(req, call_in_flight)) {
+      call_in_flight->set_sending_bytes(entry_bytes_size);
+      call_in_flight = resp->add_calls_in_flight();
+    }
+  }
+  resp->set_sending_bytes(sending_bytes);
+  resp->mutable_calls_in_flight()->DeleteSubrange(resp->calls_in_flight_size() - 1, 1);
+}
+
+StreamFactoryPtr UringStream::Factory() {
+  class UringStreamFactory : public StreamFactory {
+   private:
+    std::unique_ptr<Stream> Create(const StreamCreateData& data) override {
+      return std::make_unique<UringStream>(data);
+    }
+  };
+
+  return std::make_shared<UringStreamFactory>();
+}
+
+} // namespace rpc
+} // namespace yb
@@ -0,0 +1,155 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_RPC_URING_STREAM_H
+#define YB_RPC_URING_STREAM_H
+
+#include <ev++.h>
+
+#include "yb/rpc/stream.h"
+#include "yb/rpc/tcp_stream.h"
+
+#include "yb/util/net/socket.h"
+
+namespace yb {
+namespace rpc {
+
+class IoUring;
+
+// TCP stream that transfers data using io_uring instead of readv/writev calls on readiness
+// notifications from libev.
+//
+// All streams of a reactor share one ring. Reads and writes are queued to the ring and submitted
+// by a single io_uring_enter call once per reactor loop iteration, completions are reaped when the
+// ring file descriptor becomes readable. Each stream keeps at most one read and one write in
+// flight, so the same buffers as in TcpStream are used.
+//
+// On the wire it is the same as TcpStream, so it is registered for TcpStream::StaticProtocol() and
+// could be used as a lower layer of SecureStream.
+class UringStream : public Stream {
+ public:
+  explicit UringStream(const StreamCreateData& data);
+  ~UringStream();
+
+  size_t GetPendingWriteBytes() override {
+    return queued_bytes_to_send_ - send_position_;
+  }
+
+  // Whether io_uring is available in this build and on the running kernel.
+  static bool IsSupported();
+
+  static StreamFactoryPtr Factory();
+
+  // Number of io_uring_enter calls and submitted read/write operations in this process.
+  static uint64_t NumSubmitCalls();
+  static uint64_t NumSubmittedOps();
+
+ private:
+  friend class IoUring;
+
+  struct Op {
+    UringStream* stream;
+  };
+
+  struct FillIovResult {
+    int len;
+    bool only_heartbeats;
+    // Number of entries of sending_ referenced by filled iovs.
+    size_t blocks;
+  };
+
+  CHECKED_STATUS Start(bool connect, ev::loop_ref* loop, StreamContext* context) override;
+  void Close() override;
+  void Shutdown(const Status& status) override;
+  size_t Send(OutboundDataPtr data) override;
+  CHECKED_STATUS TryWrite() override;
+  void Cancelled(size_t handle) override;
+
+  bool Idle(std::string* reason_not_idle) override;
+  bool IsConnected() override { return connected_; }
+  void DumpPB(const DumpRunningRpcsRequestPB& req, RpcConnectionPB* resp) override;
+
+  const Endpoint& Remote() override { return remote_; }
+  const Endpoint& Local() override { return local_; }
+
+  const Protocol* GetProtocol() override {
+    return TcpStream::StaticProtocol();
+  }
+
+  void ParseReceived() override;
+
+  // Invoked by the ring when operation of this stream is completed, result has the same meaning
+  // as the res field of io_uring_cqe.
+  void OpCompleted(Op* op, int result);
+
+  bool HasOpsInFlight() const {
+    return read_in_flight_ || write_in_flight_;
+  }
+
+  // Switches connected socket to blocking mode and starts reading from it.
+  CHECKED_STATUS Connected();
+  CHECKED_STATUS StartRead();
+  CHECKED_STATUS ReadCompleted(int result);
+  CHECKED_STATUS DoWrite();
+  CHECKED_STATUS WriteCompleted(int result);
+  Result<bool> TryProcessReceived();
+
+  FillIovResult FillIov(iovec* out);
+  void PopSending();
+  void ClearSending(const Status& status);
+  void FinishShutdown(const Status& status);
+
+  void ConnectHandler(ev::io& watcher, int revents); // NOLINT
+
+  StreamReadBuffer& ReadBuffer() {
+    return context_->ReadBuffer();
+  }
+
+  Socket socket_;
+  Endpoint local_;
+  const Endpoint remote_;
+
+  StreamContext* context_ = nullptr;
+  std::shared_ptr<IoUring> ring_;
+
+  // Waits for the outbound connection to be established.
+  ev::io connect_io_;
+
+  bool is_registered_ = false;
+  bool connected_ = false;
+  bool closing_ = false;
+  bool read_buffer_full_ = false;
+  // Status passed to Shutdown, when it is completed after operations in flight.
+  Status shutdown_status_;
+
+  Op read_op_{this};
+  Op write_op_{this};
+  bool read_in_flight_ = false;
+  bool write_in_flight_ = false;
+  // Buffers passed to the in flight operations, should stay intact until they are completed.
+  IoVecs read_iov_;
+  iovec write_iov_[16];
+  size_t write_blocks_in_flight_ = 0;
+
+  std::deque<TcpStreamSendingData> sending_;
+  size_t data_blocks_sent_ = 0;
+  size_t send_position_ = 0;
+  size_t queued_bytes_to_send_ = 0;
+  size_t inbound_bytes_to_skip_ = 0;
+  MemTrackerPtr mem_tracker_;
+};
+
+} // namespace rpc
+} // namespace yb
+
+#endif // YB_RPC_URING_STREAM_H
@@ -80,6 +80,11 @@ DEFINE_int32(num_reactor_threads, -1,
              "Number of libev reactor threads to start. If -1, the value is automatically set.");
 TAG_FLAG(num_reactor_threads, advanced);
 
+DEFINE_bool(rpc_use_io_uring, false,
+            "Use io_uring instead of libev driven readv/writev for TCP RPC connections, "
+            "when it is supported by the kernel. Encrypted connections use it as well.");
+TAG_FLAG(rpc_use_io_uring, advanced);
+
 DECLARE_bool(use_hybrid_clock);
 
 DEFINE_int32(generic_svc_num_threads, 10,
@@ -234,6 +239,9 @@ Status RpcServerBase::SetupMessengerBuilder(rpc::MessengerBuilder* builder) {
   builder->set_num_reactors(FLAGS_num_reactor_threads);
   builder->set_metric_entity(metric_entity());
   builder->set_connection_keepalive_time(options_.rpc_opts.connection_keepalive_time_ms * 1ms);
+  if (FLAGS_rpc_use_io_uring) {
+    builder->UseIoUring();
+  }
 
   return Status::OK();
 }
@@ -258,6 +266,11 @@ Status RpcServerBase::Init() {
   rpc::MessengerBuilder builder(name_);
   builder.UseDefaultConnectionContextFactory(mem_tracker());
   RETURN_NOT_OK(SetupMessengerBuilder(&builder));
+  // Compression wraps the final listen protocol, so it should be applied after subclasses have set
+  // up their streams, e.g. the encrypted ones.
+  if (UseRpcCompression()) {
+    builder.UseCompression();
+  }
   messenger_ = VERIFY_RESULT(builder.Build());
   proxy_cache_ = std::make_unique<rpc::ProxyCache>(messenger_.get());
 
@@ -123,6 +123,10 @@ class RpcServerBase {
   void SetConnectionContextFactory(rpc::ConnectionContextFactoryPtr connection_context_factory);
   virtual CHECKED_STATUS SetupMessengerBuilder(rpc::MessengerBuilder* builder);
 
+  // Whether the messenger of this server should use compressed streams. Only servers serving the
+  // internal RPC protocol support it, clients of CQL and Redis servers do not expect it.
+  virtual bool UseRpcCompression() const { return false; }
+
   const std::string name_;
   std::shared_ptr<MemTracker> mem_tracker_;
   gscoped_ptr<MetricRegistry> metric_registry_;
@@ -17,6 +17,8 @@
 
 #include "yb/common/pgsql_error.h"
 
+#include "yb/tablet/transaction_status_resolver.h"
+
 #include "yb/util/flag_tags.h"
 #include "yb/util/yb_pg_errcodes.h"
 
@@ -180,6 +182,23 @@ boost::optional<TransactionStatus> RunningTransaction::GetStatusAt(
 
 void RunningTransaction::SendStatusRequest(
     int64_t serial_no, const RunningTransactionPtr& shared_self) {
+  auto* resolver = context_.participant_context_.transaction_status_resolver();
+  if (resolver) {
+    context_.resolver_lookups_.fetch_add(1, std::memory_order_acq_rel);
+    RunningTransactionPtr self = shared_self;
+    resolver->RequestStatus(
+        metadata_.status_tablet, metadata_.transaction_id,
+        [this, serial_no, self](Result<TransactionStatusResult> result) mutable {
+          StatusReceived(result, serial_no, self);
+          // Participant shutdown could complete as soon as the counter is decremented, so the
+          // transaction should be released before that.
+          auto& resolver_lookups = context_.resolver_lookups_;
+          self.reset();
+          resolver_lookups.fetch_sub(1, std::memory_order_acq_rel);
+        });
+    return;
+  }
+
   tserver::GetTransactionStatusRequestPB req;
   req.set_tablet_id(metadata_.status_tablet);
   req.add_transaction_id()->assign(
@@ -191,76 +210,79 @@ void RunningTransaction::SendStatusRequest(
           nullptr /* tablet */,
           context_.participant_context_.client_future().get(),
           &req,
-          std::bind(&RunningTransaction::StatusReceived, this, _1, _2, serial_no, shared_self)),
+          [this, serial_no, shared_self](
+              const Status& status, const tserver::GetTransactionStatusResponsePB& response) {
+            if (response.has_propagated_hybrid_time()) {
+              context_.participant_context_.UpdateClock(
+                  HybridTime(response.propagated_hybrid_time()));
+            }
+            context_.rpcs_.Unregister(&get_status_handle_);
+            StatusReceived(MakeStatusResult(status, response), serial_no, shared_self);
+          }),
       &get_status_handle_);
 }
 
-void RunningTransaction::StatusReceived(
+Result<TransactionStatusResult> RunningTransaction::MakeStatusResult(
     const Status& status,
-    const tserver::GetTransactionStatusResponsePB& response,
+    const tserver::GetTransactionStatusResponsePB& response) {
+  if (!status.ok()) {
+    return status;
+  }
+  if (response.status().size() != 1 || response.status_hybrid_time().size() != 1) {
+    LOG(DFATAL) << "Wrong number of status entries, exactly one entry expected: "
+                << response.ShortDebugString();
+    return STATUS_FORMAT(
+        IllegalState, "Wrong number of status entries: $0", response.status().size());
+  }
+  return TransactionStatusResult{response.status(0), HybridTime(response.status_hybrid_time(0))};
+}
+
+void RunningTransaction::StatusReceived(
+    const Result<TransactionStatusResult>& result,
     int64_t serial_no,
     const RunningTransactionPtr& shared_self) {
   auto delay_usec = FLAGS_transaction_delay_status_reply_usec_in_tests;
   if (delay_usec > 0) {
     context_.delayer().Delay(
         MonoTime::Now() + MonoDelta::FromMicroseconds(delay_usec),
-        std::bind(&RunningTransaction::DoStatusReceived, this, status, response,
-                  serial_no, shared_self));
+        std::bind(&RunningTransaction::DoStatusReceived, this, result, serial_no, shared_self));
   } else {
-    DoStatusReceived(status, response, serial_no, shared_self);
+    DoStatusReceived(result, serial_no, shared_self);
   }
 }
 
-void RunningTransaction::DoStatusReceived(const Status& status,
-                                          const tserver::GetTransactionStatusResponsePB& response,
+void RunningTransaction::DoStatusReceived(const Result<TransactionStatusResult>& result,
                                           int64_t serial_no,
                                           const RunningTransactionPtr& shared_self) {
-  if (response.has_propagated_hybrid_time()) {
-    context_.participant_context_.UpdateClock(HybridTime(response.propagated_hybrid_time()));
-  }
-
-  context_.rpcs_.Unregister(&get_status_handle_);
   decltype(status_waiters_) status_waiters;
   HybridTime time_of_status;
   TransactionStatus transaction_status;
-  const bool ok = status.ok();
   int64_t new_request_id = -1;
   {
     MinRunningNotifier min_running_notifier(&context_.applier_);
     std::unique_lock<std::mutex> lock(context_.mutex_);
-    if (!ok) {
+    if (!result.ok()) {
       status_waiters_.swap(status_waiters);
       lock.unlock();
       for (const auto& waiter : status_waiters) {
-        waiter.callback(status);
+        waiter.callback(result.status());
       }
       return;
     }
 
-    if (response.status_hybrid_time().size() == 1) {
-      time_of_status = HybridTime(response.status_hybrid_time()[0]);
-    } else {
-      LOG(DFATAL) << "Wrong number of status hybrid time entries, exactly one entry expected: "
-                  << response.ShortDebugString();
-      time_of_status = HybridTime::kMin;
-    }
+    time_of_status = result->status_time;
 
     // Check for local_commit_time_ is not required for correctness, but useful for optimization.
     // So we could avoid unnecessary actions.
     if (local_commit_time_.is_valid()) {
       last_known_status_hybrid_time_ = local_commit_time_;
       last_known_status_ = TransactionStatus::COMMITTED;
-    } else if (response.status().size() == 1) {
-      if (last_known_status_hybrid_time_ <= time_of_status) {
-        last_known_status_hybrid_time_ = time_of_status;
-        last_known_status_ = response.status(0);
-        if (response.status(0) == TransactionStatus::ABORTED) {
-          context_.EnqueueRemoveUnlocked(id(), &min_running_notifier);
-        }
+    } else if (last_known_status_hybrid_time_ <= time_of_status) {
+      last_known_status_hybrid_time_ = time_of_status;
+      last_known_status_ = result->status;
+      if (result->status == TransactionStatus::ABORTED) {
+        context_.EnqueueRemoveUnlocked(id(), &min_running_notifier);
       }
-    } else {
-      LOG(DFATAL) << "Wrong number of status entries, exactly one entry expected: "
-                  << response.ShortDebugString();
     }
 
     time_of_status = last_known_status_hybrid_time_;
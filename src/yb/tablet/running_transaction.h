@@ -89,16 +89,18 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
 
   void SendStatusRequest(int64_t serial_no, const RunningTransactionPtr& shared_self);
 
-  void StatusReceived(const Status& status,
-                      const tserver::GetTransactionStatusResponsePB& response,
+  void StatusReceived(const Result<TransactionStatusResult>& result,
                       int64_t serial_no,
                       const RunningTransactionPtr& shared_self);
 
-  void DoStatusReceived(const Status& status,
-                        const tserver::GetTransactionStatusResponsePB& response,
+  void DoStatusReceived(const Result<TransactionStatusResult>& result,
                         int64_t serial_no,
                         const RunningTransactionPtr& shared_self);
 
+  static Result<TransactionStatusResult> MakeStatusResult(
+      const Status& status,
+      const tserver::GetTransactionStatusResponsePB& response);
+
   // Extracts status waiters from status_waiters_ that could be notified at this point.
   // Extracted waiters also removed from status_waiters_.
   std::vector<StatusRequest> ExtractFinishedStatusWaitersUnlocked(
@@ -14,6 +14,8 @@
 #ifndef YB_TABLET_RUNNING_TRANSACTION_CONTEXT_H
 #define YB_TABLET_RUNNING_TRANSACTION_CONTEXT_H
 
+#include <atomic>
+
 #include "yb/rpc/rpc.h"
 
 #include "yb/tablet/transaction_participant.h"
@@ -80,6 +82,10 @@ class RunningTransactionContext {
   int64_t request_serial_ = 0;
   std::mutex mutex_;
 
+  // Number of status lookups sent through the transaction status resolver whose callbacks are not
+  // finished yet.
+  std::atomic<size_t> resolver_lookups_{0};
+
   // Used only in tests.
   Delayer delayer_;
 };
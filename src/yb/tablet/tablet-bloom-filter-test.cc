@@ -0,0 +1,133 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//
+
+#include "yb/common/ql_protocol_util.h"
+#include "yb/common/ql_value.h"
+
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/doc_ql_scanspec.h"
+#include "yb/docdb/doc_rowwise_iterator.h"
+
+#include "yb/rocksdb/statistics.h"
+
+#include "yb/tablet/tablet-test-util.h"
+#include "yb/tablet/tablet.h"
+#include "yb/tablet/local_tablet_writer.h"
+
+DECLARE_bool(rocksdb_disable_compactions);
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+constexpr int kNumFiles = 5;
+constexpr int kRowsPerFile = 10;
+constexpr int kRangeRowsPerPrefix = 4;
+// Bloom filters could have false positives, so allow one file per read to be checked in vain.
+constexpr uint64_t kMinSkippedFiles = kNumFiles - 2;
+
+Schema RangeKeyedSchema() {
+  TableProperties table_properties;
+  table_properties.SetBloomFilterRangeComponents(1);
+  return Schema({ ColumnSchema("r1", INT32, false, false),
+                  ColumnSchema("r2", INT32, false, false),
+                  ColumnSchema("v", INT32) },
+                2, table_properties);
+}
+
+} // namespace
+
+class TabletBloomFilterTest : public YBTabletTest {
+ public:
+  TabletBloomFilterTest() : YBTabletTest(RangeKeyedSchema()) {}
+
+  void SetUp() override {
+    // Keep one SST file per flush, so every file holds a disjoint range of r1.
+    FLAGS_rocksdb_disable_compactions = true;
+    YBTabletTest::SetUp();
+  }
+
+ protected:
+  void FillTablet() {
+    LocalTabletWriter writer(tablet().get());
+    for (int file = 0; file != kNumFiles; ++file) {
+      for (int r1 = file * kRowsPerFile; r1 != (file + 1) * kRowsPerFile; ++r1) {
+        for (int r2 = 0; r2 != kRangeRowsPerPrefix; ++r2) {
+          QLWriteRequestPB req;
+          req.set_type(QLWriteRequestPB::QL_STMT_INSERT);
+          QLAddInt32RangeValue(&req, r1);
+          QLAddInt32RangeValue(&req, r2);
+          QLAddInt32ColumnValue(&req, kFirstColumnId + 2, r1 * 100 + r2);
+          ASSERT_OK(writer.Write(&req));
+        }
+      }
+      ASSERT_OK(tablet()->Flush(FlushMode::kSync));
+    }
+    ASSERT_EQ(static_cast<uint64_t>(kNumFiles), tablet()->GetCurrentVersionNumSSTFiles());
+  }
+
+  // Reads all rows that have the given value of the first range column.
+  Result<std::vector<std::pair<int, int>>> ReadPrefix(int r1) {
+    docdb::DocRowwiseIterator iter(
+        schema_, schema_, boost::none /* txn_op_context */, tablet()->doc_db(),
+        CoarseTimePoint::max() /* deadline */,
+        ReadHybridTime::SingleTime(tablet()->SafeTime()));
+    docdb::DocQLScanSpec spec(
+        schema_, docdb::DocKey({ docdb::PrimitiveValue::Int32(r1) }), rocksdb::kDefaultQueryId);
+    RETURN_NOT_OK(iter.Init(spec));
+
+    std::vector<std::pair<int, int>> result;
+    QLTableRow row;
+    QLValue value;
+    while (VERIFY_RESULT(iter.HasNext())) {
+      RETURN_NOT_OK(iter.NextRow(&row));
+      RETURN_NOT_OK(row.GetValue(schema_.column_id(1), &value));
+      const int r2 = value.int32_value();
+      RETURN_NOT_OK(row.GetValue(schema_.column_id(2), &value));
+      result.emplace_back(r2, value.int32_value());
+    }
+    return result;
+  }
+};
+
+TEST_F(TabletBloomFilterTest, RangePrefixReadSkipsFiles) {
+  ASSERT_NO_FATALS(FillTablet());
+  const auto& statistics = tablet()->rocksdb_statistics();
+
+  for (int r1 : { 0, kRowsPerFile * 2 + 3, kNumFiles * kRowsPerFile - 1 }) {
+    const auto useful_before = statistics->getTickerCount(rocksdb::BLOOM_FILTER_USEFUL);
+    auto rows = ASSERT_RESULT(ReadPrefix(r1));
+    const auto useful = statistics->getTickerCount(rocksdb::BLOOM_FILTER_USEFUL) - useful_before;
+
+    ASSERT_EQ(kRangeRowsPerPrefix, static_cast<int>(rows.size())) << "r1: " << r1;
+    for (int r2 = 0; r2 != kRangeRowsPerPrefix; ++r2) {
+      ASSERT_EQ(r2, rows[r2].first);
+      ASSERT_EQ(r1 * 100 + r2, rows[r2].second);
+    }
+    // Only the file that holds r1 has to be read, the others are rejected by the bloom filter.
+    ASSERT_GE(useful, kMinSkippedFiles) << "r1: " << r1;
+    ASSERT_LE(useful, kMinSkippedFiles + 1) << "r1: " << r1;
+  }
+
+  // A prefix that is absent from all files does not have to read any of them.
+  const auto useful_before = statistics->getTickerCount(rocksdb::BLOOM_FILTER_USEFUL);
+  ASSERT_TRUE(ASSERT_RESULT(ReadPrefix(kNumFiles * kRowsPerFile)).empty());
+  ASSERT_GE(statistics->getTickerCount(rocksdb::BLOOM_FILTER_USEFUL) - useful_before,
+            kMinSkippedFiles + 1);
+}
+
+} // namespace tablet
+} // namespace yb
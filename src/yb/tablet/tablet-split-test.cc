@@ -183,6 +183,40 @@ TEST_F(TabletSplitTest,  v) {
   ASSERT_TRUE(source_docdb_dump.empty()) << boost::algorithm::join(source_docdb_dump, "\n");
 }
 
+TEST_F(TabletSplitTest, SplitHashCode) {
+  constexpr auto kNumRows = 5000;
+  constexpr auto kRowsPerFlush = kNumRows / 5;
+
+  ASSERT_NOK(tablet()->GetSplitHashCode());
+
+  const auto value_format = RandomHumanReadableString(256) + "_$0";
+  std::vector<docdb::DocKeyHash> hash_codes;
+  {
+    LocalTabletWriter::Batch batch;
+    for (auto i = 1; i <= kNumRows; ++i) {
+      hash_codes.push_back(InsertRow(i, Format(value_format, i), &batch));
+      if (i % kRowsPerFlush == 0) {
+        ASSERT_OK(writer_->WriteBatch(&batch));
+        batch.Clear();
+        ASSERT_OK(tablet()->Flush(FlushMode::kSync));
+      }
+    }
+  }
+
+  const auto split_hash_code = ASSERT_RESULT(tablet()->GetSplitHashCode());
+  LOG(INFO) << "Split hash code: " << split_hash_code;
+
+  // Rows have hash codes spread evenly, so each side of the split should get about half of them.
+  size_t rows_before = 0;
+  for (auto hash_code : hash_codes) {
+    if (hash_code < split_hash_code) {
+      ++rows_before;
+    }
+  }
+  ASSERT_GT(rows_before, kNumRows * 2 / 5);
+  ASSERT_LT(rows_before, kNumRows * 3 / 5);
+}
+
 // TODO: Need to test with distributed transactions both pending and committed
 // (but not yet applied) during split.
 // Split tablets should not return unexpected data for not yet applied, but committed transactions
@@ -77,6 +77,7 @@
 #include "yb/docdb/conflict_resolution.h"
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/cql_operation.h"
+#include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
 #include "yb/docdb/docdb.h"
 #include "yb/docdb/docdb.pb.h"
@@ -103,6 +104,7 @@
 #include "yb/tablet/tablet_snapshots.h"
 #include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_retention_policy.h"
+#include "yb/tablet/tablet_row_cache.h"
 #include "yb/tablet/transaction_coordinator.h"
 #include "yb/tablet/transaction_participant.h"
 #include "yb/tablet/operations/change_metadata_operation.h"
@@ -177,6 +179,11 @@ DEFINE_int32(backfill_index_rate_rows_per_sec, 0, "Rate of at which the "
 TAG_FLAG(backfill_index_rate_rows_per_sec, advanced);
 TAG_FLAG(backfill_index_rate_rows_per_sec, runtime);
 
+DEFINE_int64(tablet_row_cache_size_bytes, 0,
+             "Max amount of memory used by the per-tablet cache of decoded YCQL rows, that serves "
+             "point reads of hot keys of non-transactional tables. 0 disables the cache.");
+TAG_FLAG(tablet_row_cache_size_bytes, advanced);
+
 DEFINE_test_flag(int32, TEST_slowdown_backfill_by_ms, 0,
                  "If set > 0, slows down the backfill process by this amount.");
 
@@ -440,6 +447,12 @@ Tablet::Tablet(
         metrics_->expired_transactions.get());
   }
 
+  if (FLAGS_tablet_row_cache_size_bytes > 0 && table_type_ == TableType::YQL_TABLE_TYPE &&
+      !metadata->schema().table_properties().is_transactional()) {
+    row_cache_ = std::make_unique<TabletRowCache>(
+        FLAGS_tablet_row_cache_size_bytes, mem_tracker_, metrics_.get());
+  }
+
   snapshots_ = std::make_unique<TabletSnapshots>(this);
 }
 
@@ -570,6 +583,11 @@ Status Tablet::OpenKeyValueTablet() {
   docdb::InitRocksDBOptions(
       &rocksdb_options, LogPrefix(docdb::StorageDbType::kRegular), rocksdb_statistics_,
       tablet_options_);
+  // Intents could be looked up by prefixes of range keys, so only the regular DB indexes range
+  // components.
+  auto intents_table_factory = rocksdb_options.table_factory;
+  docdb::SetBloomFilterRangeComponents(
+      &rocksdb_options, docdb::BloomFilterRangeComponents(metadata_->schema()));
   rocksdb_options.mem_tracker = MemTracker::FindOrCreateTracker(kRegularDB, mem_tracker_);
   rocksdb_options.block_based_table_mem_tracker =
       MemTracker::FindOrCreateTracker(
@@ -619,6 +637,7 @@ Status Tablet::OpenKeyValueTablet() {
   if (transaction_participant_) {
     LOG_WITH_PREFIX(INFO) << "Opening intents DB at: " << db_dir + kIntentsDBSuffix;
     docdb::SetLogPrefix(&rocksdb_options, LogPrefix(docdb::StorageDbType::kIntents));
+    rocksdb_options.table_factory = intents_table_factory;
 
     rocksdb_options.mem_table_flush_filter_factory = MakeMemTableFlushFilterFactory([this] {
       return std::bind(&Tablet::IntentsDbFlushFilter, this, _1);
@@ -646,6 +665,11 @@ Status Tablet::OpenKeyValueTablet() {
   }
 
   ql_storage_.reset(new docdb::QLRocksDBStorage(doc_db()));
+  if (row_cache_) {
+    // Rows cached before RocksDB was replaced, i.e. by truncate or snapshot restore, are stale.
+    row_cache_->Clear(clock_->Now());
+    ql_storage_ = std::make_unique<RowCachingQLStorage>(std::move(ql_storage_), row_cache_.get());
+  }
   if (transaction_participant_) {
     transaction_participant_->SetDB(intents_db_.get(), &key_bounds_, &pending_op_counter_);
   }
@@ -1009,11 +1033,37 @@ Status Tablet::ApplyKeyValueRowOperations(int64_t batch_idx,
   } else {
     PrepareNonTransactionWriteBatch(put_batch, hybrid_time, &write_batch);
     WriteToRocksDB(frontiers, &write_batch, StorageDbType::kRegular);
+    if (row_cache_) {
+      // Write could have external hybrid time, so reads that did not see it are rejected basing on
+      // the current time.
+      row_cache_->Invalidate(put_batch, clock_->Now(), key_schema_.num_range_key_columns());
+    }
   }
 
   return Status::OK();
 }
 
+void Tablet::ApplyNonTransactionalWriteBatches(
+    const std::vector<std::pair<const docdb::KeyValueWriteBatchPB*, HybridTime>>& batches,
+    const rocksdb::UserFrontiers* frontiers) {
+  rocksdb::WriteBatch write_batch;
+  for (const auto& batch_and_time : batches) {
+    const auto& put_batch = *batch_and_time.first;
+    DCHECK(!put_batch.has_transaction());
+    if (metrics_) {
+      metrics_->rows_inserted->IncrementBy(put_batch.write_pairs().size());
+    }
+    PrepareNonTransactionWriteBatch(put_batch, batch_and_time.second, &write_batch);
+  }
+  WriteToRocksDB(frontiers, &write_batch, StorageDbType::kRegular);
+  if (row_cache_) {
+    const auto now = clock_->Now();
+    for (const auto& batch_and_time : batches) {
+      row_cache_->Invalidate(*batch_and_time.first, now, key_schema_.num_range_key_columns());
+    }
+  }
+}
+
 void Tablet::WriteToRocksDB(
     const rocksdb::UserFrontiers* frontiers,
     rocksdb::WriteBatch* write_batch,
@@ -1458,7 +1508,11 @@ CHECKED_STATUS Tablet::CreatePagingStateForRead(const PgsqlReadRequestPB& pgsql_
       (!pgsql_read_request.has_limit() || row_count < pgsql_read_request.limit() ||
        pgsql_read_request.return_paging_state())) {
     const string& next_partition_key = metadata_->partition().partition_key_end();
-    if (!next_partition_key.empty()) {
+    // Check we did not reach the max partition key of the scanned hash code range.
+    if (!next_partition_key.empty() &&
+        (!pgsql_read_request.has_max_hash_code() ||
+         PartitionSchema::DecodeMultiColumnHashValue(next_partition_key) <=
+             pgsql_read_request.max_hash_code())) {
       response->mutable_paging_state()->set_next_partition_key(next_partition_key);
     }
   }
@@ -1767,6 +1821,9 @@ Status Tablet::AlterSchema(ChangeMetadataOperationState *operation_state) {
 
   metadata_->SetSchema(*operation_state->schema(), operation_state->index_map(), deleted_cols,
                        operation_state->schema_version());
+  if (row_cache_) {
+    row_cache_->Clear(clock_->Now());
+  }
   if (operation_state->has_new_table_name()) {
     metadata_->SetTableName(operation_state->new_table_name());
     if (metric_entity_) {
@@ -2647,6 +2704,108 @@ Status Tablet::CreateSubtablet(
   return snapshots_->CreateCheckpoint(metadata->rocksdb_dir());
 }
 
+namespace {
+
+// Returns the hash code the given SST file boundary key starts with, if any.
+boost::optional<docdb::DocKeyHash> DecodeBoundaryHash(const std::string& key) {
+  docdb::DocKeyDecoder decoder(key);
+  if (!decoder.DecodeCotableId().ok() || !decoder.DecodePgtableId().ok()) {
+    return boost::none;
+  }
+  uint16_t hash = 0;
+  auto has_hash = decoder.DecodeHashCode(&hash);
+  if (!has_hash.ok() || !*has_hash) {
+    return boost::none;
+  }
+  return hash;
+}
+
+} // namespace
+
+Result<docdb::DocKeyHash> Tablet::GetSplitHashCode() const {
+  if (!metadata_->partition_schema().IsHashPartitioning()) {
+    return STATUS(NotSupported, "Only tablets of hash partitioned tables could be split");
+  }
+
+  std::vector<rocksdb::LiveFileMetaData> files;
+  {
+    ScopedPendingOperation scoped_operation(&pending_op_counter_);
+    RETURN_NOT_OK(scoped_operation);
+    std::lock_guard<rw_spinlock> lock(component_lock_);
+    if (!regular_db_) {
+      return STATUS(IllegalState, "Regular DB is not open");
+    }
+    regular_db_->GetLiveFilesMetaData(&files);
+  }
+
+  const auto& partition = metadata_->partition();
+  const uint32_t partition_start = partition.partition_key_start().empty() ? 0 :
+      PartitionSchema::DecodeMultiColumnHashValue(partition.partition_key_start());
+  const uint32_t partition_end = partition.partition_key_end().empty() ?
+      PartitionSchema::kMaxPartitionKey + 1 :
+      PartitionSchema::DecodeMultiColumnHashValue(partition.partition_key_end());
+
+  // The data of each file is assumed to be spread evenly over the hash codes between its smallest
+  // and largest keys. Files of a subtablet could also cover hash codes outside of its partition,
+  // only the part inside of the partition is counted.
+  struct HashRange {
+    uint32_t first;
+    uint32_t last;
+    double size;
+  };
+  std::vector<HashRange> ranges;
+  double total_size = 0;
+  for (const auto& file : files) {
+    auto smallest = DecodeBoundaryHash(file.smallest.key);
+    auto largest = DecodeBoundaryHash(file.largest.key);
+    if (!smallest || !largest || *smallest > *largest) {
+      continue;
+    }
+    HashRange range = { std::max<uint32_t>(*smallest, partition_start),
+                        std::min<uint32_t>(*largest, partition_end - 1), 0 };
+    if (range.first > range.last) {
+      continue;
+    }
+    range.size = static_cast<double>(file.total_size) * (range.last - range.first + 1) /
+                 (*largest - *smallest + 1);
+    ranges.push_back(range);
+    total_size += range.size;
+  }
+
+  // Returns the estimated size of the data with hash codes below the given one.
+  auto size_before = [&ranges](uint32_t hash) {
+    double result = 0;
+    for (const auto& range : ranges) {
+      if (hash > range.last) {
+        result += range.size;
+      } else if (hash > range.first) {
+        result += range.size * (hash - range.first) / (range.last - range.first + 1);
+      }
+    }
+    return result;
+  };
+
+  // Find the smallest hash code with at least half of the data before it.
+  uint32_t left = partition_start + 1;
+  uint32_t right = partition_end;
+  while (left < right) {
+    const uint32_t middle = left + (right - left) / 2;
+    if (size_before(middle) * 2 >= total_size) {
+      right = middle;
+    } else {
+      left = middle + 1;
+    }
+  }
+  left = std::min(left, partition_end - 1);
+  const double before = size_before(left);
+  if (left <= partition_start || before <= 0 || before >= total_size) {
+    return STATUS_FORMAT(
+        IllegalState, "Data of tablet $0 could not be split by hash code in [$1, $2)",
+        tablet_id(), partition_start, partition_end);
+  }
+  return static_cast<docdb::DocKeyHash>(left);
+}
+
 Result<int64_t> Tablet::CountIntents() {
   ScopedPendingOperation pending_op(&pending_op_counter_);
   RETURN_NOT_OK(pending_op);
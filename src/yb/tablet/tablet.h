@@ -285,6 +285,12 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
       const rocksdb::UserFrontiers* frontiers,
       HybridTime hybrid_time);
 
+  // Apply non transactional write batches of consecutive operations using single RocksDB write
+  // batch. Used during bootstrap, frontiers should cover op ids and hybrid times of all batches.
+  void ApplyNonTransactionalWriteBatches(
+      const std::vector<std::pair<const docdb::KeyValueWriteBatchPB*, HybridTime>>& batches,
+      const rocksdb::UserFrontiers* frontiers);
+
   void WriteToRocksDB(
       const rocksdb::UserFrontiers* frontiers,
       rocksdb::WriteBatch* write_batch,
@@ -525,6 +531,11 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
     return regular_db_.get();
   }
 
+  // Row cache is present only when enabled by tablet_row_cache_size_bytes for YCQL tables.
+  TabletRowCache* TEST_row_cache() const {
+    return row_cache_.get();
+  }
+
   rocksdb::DB* TEST_intents_db() const {
     return intents_db_.get();
   }
@@ -546,6 +557,11 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
       const TabletId& tablet_id, const Partition& partition,
       const docdb::KeyBounds& key_bounds);
 
+  // Returns the hash code at which this tablet should be split to get two tablets of about the
+  // same size. It is estimated from the key ranges and sizes of the SST files of the regular DB,
+  // without reading any data. Only supported for hash partitioned tables.
+  Result<docdb::DocKeyHash> GetSplitHashCode() const;
+
   // Scans the intent db. Potentially takes a long time. Used for testing/debugging.
   Result<int64_t> CountIntents();
 
@@ -704,6 +720,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   std::unique_ptr<common::YQLStorageIf> ql_storage_;
 
+  // Cache of decoded YCQL rows, see TabletRowCache. Null when disabled.
+  std::unique_ptr<TabletRowCache> row_cache_;
+
   // This is for docdb fine-grained locking.
   docdb::SharedLockManager shared_lock_manager_;
 
@@ -30,6 +30,7 @@
 // under the License.
 //
 
+#include <map>
 #include <vector>
 
 #include "yb/consensus/consensus_meta.h"
@@ -43,6 +44,7 @@
 #include "yb/tablet/tablet_bootstrap_if.h"
 #include "yb/tablet/tablet-test-util.h"
 #include "yb/tablet/tablet_metadata.h"
+#include "yb/util/format.h"
 #include "yb/util/tostring.h"
 #include "yb/tablet/tablet_options.h"
 
@@ -50,6 +52,9 @@ using std::shared_ptr;
 using std::string;
 using std::vector;
 
+DECLARE_int32(tablet_bootstrap_read_ahead_segments);
+DECLARE_int32(tablet_bootstrap_max_write_batch_ops);
+
 namespace yb {
 
 namespace log {
@@ -174,6 +179,49 @@ class BootstrapTest : public LogTestBase {
       VLOG(1) << result;
     }
   }
+
+  // Writes log of num_segments segments, each of them contains ops_per_segment committed write
+  // operations with distinct keys, then bootstraps tablet from it and checks replayed rows.
+  void TestReplayBenchmark(int num_segments, int ops_per_segment) {
+    BuildLog();
+    for (int segment = 0; segment != num_segments; ++segment) {
+      if (segment != 0) {
+        ASSERT_OK(RollLog());
+      }
+      for (int i = 0; i != ops_per_segment; ++i) {
+        const auto op_id = MakeOpId(1, current_index_);
+        AppendReplicateBatch(op_id, op_id,
+                             {TupleForAppend(static_cast<int>(current_index_), i, "benchmark")},
+                             i + 1 == ops_per_segment /* sync */);
+        ++current_index_;
+      }
+    }
+
+    TabletPtr tablet;
+    ConsensusBootstrapInfo boot_info;
+    auto start = MonoTime::Now();
+    ASSERT_OK(BootstrapTestTablet(&tablet, &boot_info));
+    auto elapsed = MonoTime::Now().GetDeltaSince(start);
+    LOG(INFO) << "Bootstrap of " << num_segments * ops_per_segment << " operations in "
+              << num_segments << " segments, read ahead segments: "
+              << FLAGS_tablet_bootstrap_read_ahead_segments << ", max write batch ops: "
+              << FLAGS_tablet_bootstrap_max_write_batch_ops << ", took: " << elapsed;
+
+    vector<string> results;
+    IterateTabletRows(tablet.get(), &results);
+    ASSERT_EQ(num_segments * ops_per_segment, results.size());
+  }
+
+  // Replay is still checked in quick test mode, but with amount of data that is not enough to
+  // measure its performance.
+  void TestReplayBenchmark() {
+    if (AllowSlowTests()) {
+      TestReplayBenchmark(10 /* num_segments */, 1000 /* ops_per_segment */);
+    } else {
+      LOG(INFO) << "Running replay benchmark with reduced amount of data in quick test mode";
+      TestReplayBenchmark(3 /* num_segments */, 50 /* ops_per_segment */);
+    }
+  }
 };
 
 // Tests a normal bootstrap scenario.
@@ -365,5 +413,59 @@ TEST_F(BootstrapTest, TestBootstrapHighOpIdIndex) {
   ASSERT_OPID_EQ(last_opid, boot_info.last_committed_id);
 }
 
+// Tests that writes and updates of the same keys spread over segments, which are read ahead in
+// parallel, are replayed in log order.
+TEST_F(BootstrapTest, ReplayUpdatesAcrossSegments) {
+  constexpr int kNumSegments = 8;
+  constexpr int kOpsPerSegment = 7;
+  constexpr int kNumKeys = 5;
+  FLAGS_tablet_bootstrap_read_ahead_segments = kNumSegments;
+
+  BuildLog();
+  std::map<int, std::string> expected;
+  for (int segment = 0; segment != kNumSegments; ++segment) {
+    if (segment != 0) {
+      ASSERT_OK(RollLog());
+    }
+    for (int i = 0; i != kOpsPerSegment; ++i) {
+      const auto op_id = MakeOpId(1, current_index_);
+      const int key = static_cast<int>(current_index_ % kNumKeys);
+      const int value = static_cast<int>(current_index_);
+      const auto text = Format("segment $0 op $1", segment, i);
+      AppendReplicateBatch(op_id, op_id, {TupleForAppend(key, value, text)},
+                           i + 1 == kOpsPerSegment /* sync */);
+      expected[key] = Format(
+          "{ int32_value: $0 int32_value: $1 string_value: \"$2\" }", key, value, text);
+      ++current_index_;
+    }
+  }
+
+  TabletPtr tablet;
+  ConsensusBootstrapInfo boot_info;
+  ASSERT_OK(BootstrapTestTablet(&tablet, &boot_info));
+  ASSERT_EQ(current_index_ - 1, boot_info.last_committed_id.index());
+
+  // Every key has the value of its latest write.
+  vector<string> results;
+  IterateTabletRows(tablet.get(), &results);
+  std::sort(results.begin(), results.end());
+  vector<string> expected_rows;
+  for (const auto& key_and_row : expected) {
+    expected_rows.push_back(key_and_row.second);
+  }
+  std::sort(expected_rows.begin(), expected_rows.end());
+  ASSERT_EQ(expected_rows, results);
+}
+
+TEST_F(BootstrapTest, ReplayBenchmark) {
+  TestReplayBenchmark();
+}
+
+TEST_F(BootstrapTest, ReplayBenchmarkSequential) {
+  FLAGS_tablet_bootstrap_read_ahead_segments = 0;
+  FLAGS_tablet_bootstrap_max_write_batch_ops = 1;
+  TestReplayBenchmark();
+}
+
 } // namespace tablet
 } // namespace yb
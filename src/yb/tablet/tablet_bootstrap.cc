@@ -31,6 +31,9 @@
 //
 #include "yb/tablet/tablet_bootstrap.h"
 
+#include <deque>
+#include <future>
+
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/log_reader.h"
@@ -51,6 +54,7 @@
 #include "yb/util/logging.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/stopwatch.h"
+#include "yb/util/threadpool.h"
 #include "yb/util/env_util.h"
 #include "yb/consensus/log_index.h"
 #include "yb/docdb/consensus_frontier.h"
@@ -83,6 +87,17 @@ DEFINE_bool(skip_flushed_entries, true,
 
 DECLARE_int32(retryable_request_timeout_secs);
 
+DEFINE_int32(tablet_bootstrap_read_ahead_segments, 2,
+             "Number of log segments that are read and decoded in background, while previous "
+             "segments are replayed during tablet bootstrap. 0 to read segments synchronously.");
+TAG_FLAG(tablet_bootstrap_read_ahead_segments, advanced);
+
+DEFINE_int32(tablet_bootstrap_max_write_batch_ops, 64,
+             "Maximum number of consecutive non transactional write operations that are applied "
+             "to RocksDB using single write batch during tablet bootstrap. 1 to apply each "
+             "operation separately.");
+TAG_FLAG(tablet_bootstrap_max_write_batch_ops, advanced);
+
 DEFINE_uint64(transaction_status_tablet_log_segment_size_bytes, 4_MB,
               "The segment size for transaction status tablet log roll-overs, in bytes.");
 
@@ -746,6 +761,13 @@ Status TabletBootstrap::HandleEntryPair(
   ReplicateMsg* replicate = replicate_entry->mutable_replicate();
   const auto op_type = replicate_entry->replicate().op_type();
 
+  // Batched writes should be applied before any other operation, so operations are applied in
+  // the same order as they are present in the log.
+  if (op_type != consensus::WRITE_OP ||
+      replicate->write_request().write_batch().has_transaction()) {
+    ApplyPendingWrites();
+  }
+
   int64_t flushed_index;
   if (op_type == consensus::UPDATE_TRANSACTION_OP) {
     if (replicate->transaction_state().status() == TransactionStatus::APPLYING) {
@@ -889,13 +911,38 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
       }
   }
 
+  // Segments are read and decoded in background, up to tablet_bootstrap_read_ahead_segments
+  // segments ahead of the segment being replayed.
+  const size_t read_ahead_segments = std::max(FLAGS_tablet_bootstrap_read_ahead_segments, 0);
+  // Declared before read_ahead, so it is shut down after pending reads are abandoned, and waits
+  // for the running ones on early return.
+  std::unique_ptr<ThreadPool> read_pool;
+  if (read_ahead_segments) {
+    RETURN_NOT_OK(ThreadPoolBuilder("bootstrap-read")
+                      .set_max_threads(static_cast<int>(read_ahead_segments))
+                      .Build(&read_pool));
+  }
+  std::deque<std::future<log::ReadEntriesResult>> read_ahead;
+  auto read_ahead_iter = iter;
+
   int segment_count = 0;
   yb::OpId last_committed_op_id;
   RestartSafeCoarseTimePoint last_entry_time;
   for (; iter != segments.end(); ++iter) {
     const scoped_refptr<ReadableLogSegment>& segment = *iter;
 
-    auto read_result = segment->ReadEntries();
+    while (read_ahead_iter != segments.end() && read_ahead.size() <= read_ahead_segments) {
+      auto read_task = std::make_shared<std::packaged_task<log::ReadEntriesResult()>>(
+          [segment = *read_ahead_iter] { return segment->ReadEntries(); });
+      read_ahead.push_back(read_task->get_future());
+      if (!read_pool || !read_pool->SubmitFunc([read_task] { (*read_task)(); }).ok()) {
+        // Read ahead is disabled or the pool is not available, read the segment in place.
+        (*read_task)();
+      }
+      ++read_ahead_iter;
+    }
+    auto read_result = read_ahead.front().get();
+    read_ahead.pop_front();
     last_committed_op_id = std::max(last_committed_op_id, read_result.committed_op_id);
     for (int entry_idx = 0; entry_idx < read_result.entries.size(); ++entry_idx) {
       Status s = HandleEntry(
@@ -964,6 +1011,8 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
     }
   }
 
+  ApplyPendingWrites();
+
   LOG_WITH_PREFIX(INFO) << "Dumping replay state to log at the end of " << __FUNCTION__;
   DumpReplayStateToLog(state);
 
@@ -1001,6 +1050,26 @@ void TabletBootstrap::PlayWriteRequest(ReplicateMsg* replicate_msg) {
 
   DCHECK(write->has_write_batch());
 
+  if (FLAGS_tablet_bootstrap_max_write_batch_ops > 1 && !write->write_batch().has_transaction()) {
+    HybridTime hybrid_time(replicate_msg->hybrid_time());
+    tablet_->mvcc_manager()->AddPending(&hybrid_time);
+
+    pending_writes_.emplace_back();
+    auto& pending_write = pending_writes_.back();
+    pending_write.op_id = yb::OpId::FromPB(replicate_msg->id());
+    pending_write.hybrid_time = hybrid_time;
+    pending_write.write_hybrid_time = write->has_external_hybrid_time()
+        ? HybridTime(write->external_hybrid_time()) : hybrid_time;
+    // Replicate message is not used after it is played, so its write batch could be moved.
+    pending_write.write_batch.Swap(write->mutable_write_batch());
+
+    if (pending_writes_.size() >=
+            static_cast<size_t>(FLAGS_tablet_bootstrap_max_write_batch_ops)) {
+      ApplyPendingWrites();
+    }
+    return;
+  }
+
   WriteOperationState operation_state(nullptr, write, nullptr);
   operation_state.mutable_op_id()->CopyFrom(replicate_msg->id());
   HybridTime hybrid_time(replicate_msg->hybrid_time());
@@ -1018,6 +1087,30 @@ void TabletBootstrap::PlayWriteRequest(ReplicateMsg* replicate_msg) {
   tablet_->mvcc_manager()->Replicated(hybrid_time);
 }
 
+void TabletBootstrap::ApplyPendingWrites() {
+  if (pending_writes_.empty()) {
+    return;
+  }
+
+  docdb::ConsensusFrontiers frontiers;
+  frontiers.Smallest().set_op_id(pending_writes_.front().op_id);
+  frontiers.Smallest().set_hybrid_time(pending_writes_.front().hybrid_time);
+  frontiers.Largest().set_op_id(pending_writes_.back().op_id);
+  frontiers.Largest().set_hybrid_time(pending_writes_.back().hybrid_time);
+
+  std::vector<std::pair<const docdb::KeyValueWriteBatchPB*, HybridTime>> batches;
+  batches.reserve(pending_writes_.size());
+  for (const auto& pending_write : pending_writes_) {
+    batches.emplace_back(&pending_write.write_batch, pending_write.write_hybrid_time);
+  }
+  tablet_->ApplyNonTransactionalWriteBatches(batches, &frontiers);
+
+  for (const auto& pending_write : pending_writes_) {
+    tablet_->mvcc_manager()->Replicated(pending_write.hybrid_time);
+  }
+  pending_writes_.clear();
+}
+
 Status TabletBootstrap::PlayChangeMetadataRequest(ReplicateMsg* replicate_msg) {
   ChangeMetadataRequestPB* request = replicate_msg->mutable_change_metadata_request();
 
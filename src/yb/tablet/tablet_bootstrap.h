@@ -36,6 +36,8 @@
 #include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/consensus/log_reader.h"
+#include "yb/docdb/docdb.pb.h"
+#include "yb/util/opid.h"
 #include "yb/util/threadpool.h"
 
 namespace yb {
@@ -111,6 +113,9 @@ class TabletBootstrap {
 
   void PlayWriteRequest(consensus::ReplicateMsg* replicate_msg);
 
+  // Applies write operations collected in pending_writes_ using single RocksDB write batch.
+  void ApplyPendingWrites();
+
   CHECKED_STATUS PlayUpdateTransactionRequest(
       consensus::ReplicateMsg* replicate_msg, AlreadyApplied already_applied);
 
@@ -196,6 +201,18 @@ class TabletBootstrap {
 
   HybridTime rocksdb_last_entry_hybrid_time_ = HybridTime::kMin;
 
+  // Non transactional write operation that was replayed, but not applied to RocksDB yet.
+  struct PendingWrite {
+    yb::OpId op_id;
+    HybridTime hybrid_time;
+    // Hybrid time used for written values, differs from hybrid_time for external writes.
+    HybridTime write_hybrid_time;
+    docdb::KeyValueWriteBatchPB write_batch;
+  };
+
+  // Consecutive write operations, that are applied to RocksDB using single write batch.
+  std::vector<PendingWrite> pending_writes_;
+
   bool skip_wal_rewrite_;
 
   DISALLOW_COPY_AND_ASSIGN(TabletBootstrap);
@@ -36,12 +36,14 @@ class TabletPeer;
 typedef std::shared_ptr<TabletPeer> TabletPeerPtr;
 
 class SnapshotOperationState;
+class TabletRowCache;
 class TabletSnapshots;
 class TabletStatusPB;
 class TabletStatusListener;
 class TransactionIntentApplier;
 class TransactionParticipant;
 class TransactionParticipantContext;
+class TransactionStatusResolver;
 class UpdateTxnOperationState;
 class WriteOperationState;
 
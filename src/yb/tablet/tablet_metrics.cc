@@ -134,6 +134,16 @@ METRIC_DEFINE_counter(tablet, restart_read_requests,
   yb::MetricUnit::kRequests,
   "Number of read requests that require restart.");
 
+METRIC_DEFINE_counter(tablet, ql_row_cache_hits,
+  "YCQL Row Cache Hits",
+  yb::MetricUnit::kRequests,
+  "Number of YCQL point reads served from the tablet row cache.");
+
+METRIC_DEFINE_counter(tablet, ql_row_cache_misses,
+  "YCQL Row Cache Misses",
+  yb::MetricUnit::kRequests,
+  "Number of cacheable YCQL point reads that were not found in the tablet row cache.");
+
 using strings::Substitute;
 
 namespace yb {
@@ -152,6 +162,8 @@ TabletMetrics::TabletMetrics(const scoped_refptr<MetricEntity>& entity)
     MINIT(transaction_conflicts),
     MINIT(expired_transactions),
     MINIT(restart_read_requests),
+    MINIT(ql_row_cache_hits),
+    MINIT(ql_row_cache_misses),
     MINIT(rows_inserted) {
 }
 #undef MINIT
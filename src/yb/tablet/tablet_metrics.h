@@ -66,6 +66,8 @@ struct TabletMetrics {
   scoped_refptr<Counter> transaction_conflicts;
   scoped_refptr<Counter> expired_transactions;
   scoped_refptr<Counter> restart_read_requests;
+  scoped_refptr<Counter> ql_row_cache_hits;
+  scoped_refptr<Counter> ql_row_cache_misses;
 
   scoped_refptr<Counter> rows_inserted;
 };
@@ -34,6 +34,8 @@ YB_STRONGLY_TYPED_BOOL(IsDropTable);
 
 struct TabletOptions {
   std::shared_ptr<rocksdb::Cache> block_cache;
+  // Cache of compressed data blocks, consulted on block_cache misses. Could be null.
+  std::shared_ptr<rocksdb::Cache> block_cache_compressed;
   std::shared_ptr<rocksdb::MemoryMonitor> memory_monitor;
   std::vector<std::shared_ptr<rocksdb::EventListener>> listeners;
   yb::Env* env = Env::Default();
@@ -148,7 +148,8 @@ TabletPeer::TabletPeer(
     const scoped_refptr<server::Clock> &clock,
     const std::string& permanent_uuid,
     Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
-    MetricRegistry* metric_registry)
+    MetricRegistry* metric_registry,
+    TransactionStatusResolver* transaction_status_resolver)
   : meta_(meta),
     tablet_id_(meta->raft_group_id()),
     local_peer_pb_(local_peer_pb),
@@ -159,7 +160,8 @@ TabletPeer::TabletPeer(
     log_anchor_registry_(new LogAnchorRegistry()),
     mark_dirty_clbk_(std::move(mark_dirty_clbk)),
     permanent_uuid_(permanent_uuid),
-    metric_registry_(metric_registry) {}
+    metric_registry_(metric_registry),
+    transaction_status_resolver_(transaction_status_resolver) {}
 
 TabletPeer::~TabletPeer() {
   std::lock_guard<simple_spinlock> lock(lock_);
@@ -104,7 +104,8 @@ class TabletPeer : public consensus::ConsensusContext,
              const scoped_refptr<server::Clock> &clock,
              const std::string& permanent_uuid,
              Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
-             MetricRegistry* metric_registry);
+             MetricRegistry* metric_registry,
+             TransactionStatusResolver* transaction_status_resolver = nullptr);
 
   ~TabletPeer();
 
@@ -168,6 +169,10 @@ class TabletPeer : public consensus::ConsensusContext,
 
   HybridTime SafeTimeForTransactionParticipant() override;
 
+  TransactionStatusResolver* transaction_status_resolver() override {
+    return transaction_status_resolver_;
+  }
+
   void GetLastReplicatedData(RemoveIntentsData* data) override;
 
   void GetTabletStatusPB(TabletStatusPB* status_pb_out) const;
@@ -450,6 +455,9 @@ class TabletPeer : public consensus::ConsensusContext,
 
   std::shared_future<client::YBClient*> client_future_;
 
+  // Owned by the tablet manager and outlives this peer.
+  TransactionStatusResolver* const transaction_status_resolver_;
+
   DISALLOW_COPY_AND_ASSIGN(TabletPeer);
 };
 
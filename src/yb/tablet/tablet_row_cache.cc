@@ -0,0 +1,444 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/tablet_row_cache.h"
+
+#include <algorithm>
+
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/doc_ql_scanspec.h"
+#include "yb/docdb/primitive_value_util.h"
+
+#include "yb/gutil/casts.h"
+
+#include "yb/tablet/tablet_metrics.h"
+
+#include "yb/util/hash_util.h"
+#include "yb/util/metrics.h"
+
+namespace yb {
+namespace tablet {
+
+struct TabletRowCache::Entry {
+  std::vector<ColumnIdRep> column_ids;
+  QLTableRow row;
+  HybridTime read_ht;
+  int64_t bytes = 0;
+  std::list<std::string>::iterator lru_it;
+};
+
+struct TabletRowCache::Shard {
+  std::mutex mutex;
+  std::unordered_map<std::string, Entry> entries;
+  // Most recently used keys are in front.
+  std::list<std::string> lru;
+  // Max hybrid time of invalidations in this shard, rows read before it are not inserted.
+  HybridTime max_write_ht = HybridTime::kMin;
+};
+
+TabletRowCache::TabletRowCache(
+    int64_t capacity_bytes, const MemTrackerPtr& parent_mem_tracker, TabletMetrics* metrics)
+    : mem_tracker_(MemTracker::CreateTracker(capacity_bytes, "row_cache", parent_mem_tracker)),
+      metrics_(metrics),
+      shards_(new Shard[kNumShards]) {
+}
+
+TabletRowCache::~TabletRowCache() {
+  Clear(HybridTime::kMax);
+  mem_tracker_->UnregisterFromParent();
+}
+
+TabletRowCache::Shard& TabletRowCache::ShardFor(const Slice& doc_key) {
+  auto hash = HashUtil::MurmurHash2_64(doc_key.data(), static_cast<int>(doc_key.size()), 0);
+  return shards_[hash % kNumShards];
+}
+
+bool TabletRowCache::Lookup(
+    const Slice& doc_key, const std::vector<ColumnIdRep>& column_ids, HybridTime read_ht,
+    QLTableRow* table_row) {
+  auto& shard = ShardFor(doc_key);
+  bool found = false;
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.entries.find(doc_key.ToBuffer());
+    if (it != shard.entries.end() && it->second.read_ht <= read_ht &&
+        it->second.column_ids == column_ids) {
+      shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lru_it);
+      *table_row = it->second.row;
+      found = true;
+    }
+  }
+  if (metrics_) {
+    (found ? metrics_->ql_row_cache_hits : metrics_->ql_row_cache_misses)->Increment();
+  }
+  return found;
+}
+
+void TabletRowCache::Insert(
+    const Slice& doc_key, std::vector<ColumnIdRep> column_ids, HybridTime read_ht,
+    const QLTableRow& table_row) {
+  int64_t bytes = sizeof(Entry) + 2 * doc_key.size() + column_ids.size() * sizeof(ColumnIdRep) +
+                  table_row.ColumnCount() * (sizeof(ColumnIdRep) + sizeof(QLTableColumn));
+  for (auto id : column_ids) {
+    const auto* value = table_row.GetColumn(id);
+    if (value) {
+      bytes += value->SpaceUsedLong();
+    }
+  }
+
+  auto& shard = ShardFor(doc_key);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  if (shard.max_write_ht > read_ht) {
+    return;
+  }
+  auto key = doc_key.ToBuffer();
+  auto it = shard.entries.find(key);
+  if (it != shard.entries.end()) {
+    if (it->second.read_ht >= read_ht && it->second.column_ids == column_ids) {
+      return;
+    }
+    EraseUnlocked(&shard, it);
+  }
+  while (!mem_tracker_->TryConsume(bytes)) {
+    if (shard.lru.empty()) {
+      return;
+    }
+    EraseUnlocked(&shard, shard.entries.find(shard.lru.back()));
+  }
+  auto& entry = shard.entries[key];
+  entry.column_ids = std::move(column_ids);
+  entry.row = table_row;
+  entry.read_ht = read_ht;
+  entry.bytes = bytes;
+  shard.lru.push_front(std::move(key));
+  entry.lru_it = shard.lru.begin();
+}
+
+void TabletRowCache::EraseUnlocked(
+    Shard* shard, std::unordered_map<std::string, Entry>::iterator it) {
+  mem_tracker_->Release(it->second.bytes);
+  shard->lru.erase(it->second.lru_it);
+  shard->entries.erase(it);
+}
+
+void TabletRowCache::Invalidate(
+    const docdb::KeyValueWriteBatchPB& put_batch, HybridTime hybrid_time,
+    size_t num_range_key_columns) {
+  docdb::DocKey doc_key;
+  for (const auto& pair : put_batch.write_pairs()) {
+    auto size = doc_key.DecodeFrom(pair.key());
+    if (!size.ok() || doc_key.range_group().size() != num_range_key_columns) {
+      Clear(hybrid_time);
+      return;
+    }
+    InvalidateKey(Slice(pair.key().data(), *size), hybrid_time);
+  }
+}
+
+void TabletRowCache::InvalidateKey(const Slice& doc_key, HybridTime hybrid_time) {
+  auto& shard = ShardFor(doc_key);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  shard.max_write_ht.MakeAtLeast(hybrid_time);
+  auto it = shard.entries.find(doc_key.ToBuffer());
+  if (it != shard.entries.end()) {
+    EraseUnlocked(&shard, it);
+  }
+}
+
+void TabletRowCache::Clear(HybridTime hybrid_time) {
+  for (size_t i = 0; i != kNumShards; ++i) {
+    auto& shard = shards_[i];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.max_write_ht.MakeAtLeast(hybrid_time);
+    while (!shard.lru.empty()) {
+      EraseUnlocked(&shard, shard.entries.find(shard.lru.back()));
+    }
+  }
+}
+
+size_t TabletRowCache::TEST_num_entries() {
+  size_t result = 0;
+  for (size_t i = 0; i != kNumShards; ++i) {
+    std::lock_guard<std::mutex> lock(shards_[i].mutex);
+    result += shards_[i].entries.size();
+  }
+  return result;
+}
+
+namespace {
+
+// Returns sorted ids of the non-key columns in projection.
+std::vector<ColumnIdRep> NonKeyColumnIds(const Schema& schema, const Schema& projection) {
+  std::vector<ColumnIdRep> result;
+  for (size_t i = 0; i != projection.num_columns(); ++i) {
+    const auto id = projection.column_id(i);
+    if (!schema.is_key_column(id)) {
+      result.push_back(id.rep());
+    }
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+// Iterator over a single row, that is served from the cache when possible. Underlying iterator
+// is created only on cache miss.
+class RowCachingIterator : public common::YQLRowwiseIteratorIf {
+ public:
+  typedef std::function<Status(std::unique_ptr<common::YQLRowwiseIteratorIf>*)> IteratorFactory;
+
+  RowCachingIterator(
+      TabletRowCache* cache, std::string doc_key, const Schema& schema, const Schema& projection,
+      HybridTime read_ht, IteratorFactory iterator_factory)
+      : cache_(cache), doc_key_(std::move(doc_key)), schema_(schema), projection_(projection),
+        read_ht_(read_ht), iterator_factory_(std::move(iterator_factory)) {
+  }
+
+  Result<bool> HasNext() const override {
+    if (state_ == State::kInitial) {
+      column_ids_ = NonKeyColumnIds(schema_, projection_);
+      if (!column_ids_.empty() && cache_->Lookup(doc_key_, column_ids_, read_ht_, &cached_row_)) {
+        state_ = State::kHit;
+      } else {
+        RETURN_NOT_OK(CreateIterator());
+      }
+    }
+    if (state_ == State::kMiss) {
+      return iter_->HasNext();
+    }
+    return state_ == State::kHit;
+  }
+
+  void SkipRow() override {
+    if (state_ == State::kMiss) {
+      iter_->SkipRow();
+    } else {
+      state_ = State::kDone;
+    }
+  }
+
+  HybridTime RestartReadHt() override {
+    return state_ == State::kMiss ? iter_->RestartReadHt() : HybridTime::kInvalid;
+  }
+
+  std::string ToString() const override {
+    return Format("RowCachingIterator($0)", iter_ ? iter_->ToString() : "cached");
+  }
+
+  const Schema& schema() const override {
+    return iter_ ? iter_->schema() : projection_;
+  }
+
+  bool IsNextStaticColumn() const override {
+    return state_ == State::kMiss && iter_->IsNextStaticColumn();
+  }
+
+  CHECKED_STATUS GetNextReadSubDocKey(docdb::SubDocKey* sub_doc_key) const override {
+    // Cached row is the only row in the scan, so there is nothing to read after it.
+    return state_ == State::kMiss ? iter_->GetNextReadSubDocKey(sub_doc_key) : Status::OK();
+  }
+
+ private:
+  enum class State {
+    kInitial,
+    kHit,
+    kMiss,
+    kDone,
+  };
+
+  CHECKED_STATUS CreateIterator() const {
+    RETURN_NOT_OK(iterator_factory_(&iter_));
+    state_ = State::kMiss;
+    return Status::OK();
+  }
+
+  CHECKED_STATUS DoNextRow(const Schema& projection, QLTableRow* table_row) override {
+    if (state_ == State::kHit) {
+      if (NonKeyColumnIds(schema_, projection) == column_ids_) {
+        *table_row = std::move(cached_row_);
+        state_ = State::kDone;
+        return Status::OK();
+      }
+      // Row is read with different columns than requested, fall back to the regular read.
+      RETURN_NOT_OK(CreateIterator());
+      if (!VERIFY_RESULT(iter_->HasNext())) {
+        return STATUS(NotFound, "end of iter");
+      }
+    }
+    if (state_ != State::kMiss) {
+      return STATUS(NotFound, "end of iter");
+    }
+    RETURN_NOT_OK(iter_->NextRow(projection, table_row));
+    MaybeInsert(projection, *table_row);
+    return Status::OK();
+  }
+
+  void MaybeInsert(const Schema& projection, const QLTableRow& table_row) {
+    if (iter_->RestartReadHt().is_valid()) {
+      return;
+    }
+    auto column_ids = NonKeyColumnIds(schema_, projection);
+    if (column_ids.empty()) {
+      return;
+    }
+    // Row with missing or expiring columns could disappear without a write, so only rows with all
+    // requested columns present and without TTL are cached.
+    for (auto id : column_ids) {
+      int64_t ttl_seconds = 0;
+      if (!table_row.GetTTL(id, &ttl_seconds).ok() || ttl_seconds != -1) {
+        return;
+      }
+    }
+    cache_->Insert(doc_key_, std::move(column_ids), read_ht_, table_row);
+  }
+
+  TabletRowCache* const cache_;
+  const std::string doc_key_;
+  const Schema& schema_;
+  const Schema& projection_;
+  const HybridTime read_ht_;
+  const IteratorFactory iterator_factory_;
+
+  mutable State state_ = State::kInitial;
+  mutable std::vector<ColumnIdRep> column_ids_;
+  mutable QLTableRow cached_row_;
+  mutable std::unique_ptr<common::YQLRowwiseIteratorIf> iter_;
+};
+
+} // namespace
+
+RowCachingQLStorage::RowCachingQLStorage(
+    std::unique_ptr<common::YQLStorageIf> storage, TabletRowCache* cache)
+    : storage_(std::move(storage)), cache_(cache) {
+}
+
+Result<std::string> RowCachingQLStorage::CacheableDocKey(
+    const QLReadRequestPB& request, const Schema& schema,
+    const TransactionOperationContextOpt& txn_op_context,
+    const common::QLScanSpec& spec) const {
+  if (txn_op_context || schema.has_statics() ||
+      schema.table_properties().is_transactional() ||
+      schema.table_properties().HasDefaultTimeToLive() ||
+      request.has_paging_state() || request.distinct() || !request.has_hash_code() ||
+      schema.num_hash_key_columns() == 0 ||
+      static_cast<size_t>(request.hashed_column_values_size()) != schema.num_hash_key_columns()) {
+    return std::string();
+  }
+
+  // All range columns should be specified by EQ conditions.
+  std::vector<docdb::PrimitiveValue> range_components;
+  if (schema.num_range_key_columns() != 0) {
+    const auto& range_options = down_cast<const docdb::DocQLScanSpec&>(spec).range_options();
+    if (!range_options || range_options->size() != schema.num_range_key_columns()) {
+      return std::string();
+    }
+    for (const auto& options : *range_options) {
+      if (options.size() != 1) {
+        return std::string();
+      }
+      range_components.push_back(options.front());
+    }
+  }
+
+  std::vector<docdb::PrimitiveValue> hashed_components;
+  RETURN_NOT_OK(docdb::QLKeyColumnValuesToPrimitiveValues(
+      request.hashed_column_values(), schema, 0, schema.num_hash_key_columns(),
+      &hashed_components));
+  docdb::DocKey doc_key(
+      schema, request.hash_code(), std::move(hashed_components), std::move(range_components));
+  return doc_key.Encode().data();
+}
+
+Status RowCachingQLStorage::GetIterator(
+    const QLReadRequestPB& request,
+    const Schema& projection,
+    const Schema& schema,
+    const TransactionOperationContextOpt& txn_op_context,
+    CoarseTimePoint deadline,
+    const ReadHybridTime& read_time,
+    const common::QLScanSpec& spec,
+    std::unique_ptr<common::YQLRowwiseIteratorIf>* iter) const {
+  auto doc_key = VERIFY_RESULT(CacheableDocKey(request, schema, txn_op_context, spec));
+  if (doc_key.empty()) {
+    return storage_->GetIterator(
+        request, projection, schema, txn_op_context, deadline, read_time, spec, iter);
+  }
+  auto* storage = storage_.get();
+  // Request, schemas and spec outlive the iterator, see QLReadOperation::Execute.
+  *iter = std::make_unique<RowCachingIterator>(
+      cache_, std::move(doc_key), schema, projection, read_time.read,
+      [storage, &request, &projection, &schema, &txn_op_context, deadline, read_time, &spec](
+          std::unique_ptr<common::YQLRowwiseIteratorIf>* iter) {
+        return storage->GetIterator(
+            request, projection, schema, txn_op_context, deadline, read_time, spec, iter);
+      });
+  return Status::OK();
+}
+
+Status RowCachingQLStorage::BuildYQLScanSpec(
+    const QLReadRequestPB& request,
+    const ReadHybridTime& read_time,
+    const Schema& schema,
+    bool include_static_columns,
+    const Schema& static_projection,
+    std::unique_ptr<common::QLScanSpec>* spec,
+    std::unique_ptr<common::QLScanSpec>* static_row_spec) const {
+  return storage_->BuildYQLScanSpec(
+      request, read_time, schema, include_static_columns, static_projection, spec,
+      static_row_spec);
+}
+
+Status RowCachingQLStorage::CreateIterator(
+    const Schema& projection,
+    const Schema& schema,
+    const TransactionOperationContextOpt& txn_op_context,
+    CoarseTimePoint deadline,
+    const ReadHybridTime& read_time,
+    common::YQLRowwiseIteratorIf::UniPtr* iter) const {
+  return storage_->CreateIterator(projection, schema, txn_op_context, deadline, read_time, iter);
+}
+
+Status RowCachingQLStorage::InitIterator(
+    common::YQLRowwiseIteratorIf* doc_iter,
+    const PgsqlReadRequestPB& request,
+    const Schema& schema,
+    const QLValuePB& ybctid) const {
+  return storage_->InitIterator(doc_iter, request, schema, ybctid);
+}
+
+Status RowCachingQLStorage::GetIterator(
+    const PgsqlReadRequestPB& request,
+    const Schema& projection,
+    const Schema& schema,
+    const TransactionOperationContextOpt& txn_op_context,
+    CoarseTimePoint deadline,
+    const ReadHybridTime& read_time,
+    common::YQLRowwiseIteratorIf::UniPtr* iter) const {
+  return storage_->GetIterator(
+      request, projection, schema, txn_op_context, deadline, read_time, iter);
+}
+
+Status RowCachingQLStorage::GetIterator(
+    const PgsqlReadRequestPB& request,
+    const Schema& projection,
+    const Schema& schema,
+    const TransactionOperationContextOpt& txn_op_context,
+    CoarseTimePoint deadline,
+    const ReadHybridTime& read_time,
+    const QLValuePB& ybctid,
+    common::YQLRowwiseIteratorIf::UniPtr* iter) const {
+  return storage_->GetIterator(
+      request, projection, schema, txn_op_context, deadline, read_time, ybctid, iter);
+}
+
+} // namespace tablet
+} // namespace yb
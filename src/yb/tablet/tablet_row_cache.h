@@ -0,0 +1,158 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_TABLET_ROW_CACHE_H
+#define YB_TABLET_TABLET_ROW_CACHE_H
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "yb/common/hybrid_time.h"
+#include "yb/common/ql_expr.h"
+#include "yb/common/ql_storage_interface.h"
+
+#include "yb/docdb/docdb.pb.h"
+
+#include "yb/util/mem_tracker.h"
+
+namespace yb {
+namespace tablet {
+
+class TabletMetrics;
+
+// Cache of decoded YCQL rows of a single tablet, keyed by encoded DocKey.
+//
+// Entry remembers the hybrid time it was read at, and could be used by any read at the same or
+// later hybrid time, because every applied write of the row removes it from the cache.
+// Each shard also tracks the max hybrid time passed to invalidation, so a row read concurrently
+// with a write to the same shard is never inserted.
+//
+// Only rows that could not change without a write are cached, i.e. rows of non-transactional
+// tables without static columns and TTL.
+class TabletRowCache {
+ public:
+  TabletRowCache(int64_t capacity_bytes, const MemTrackerPtr& parent_mem_tracker,
+                 TabletMetrics* metrics);
+  ~TabletRowCache();
+
+  // Copies the cached row into table_row if it was read with the same non-key columns at or
+  // before read_ht. Returns false otherwise.
+  bool Lookup(const Slice& doc_key, const std::vector<ColumnIdRep>& column_ids,
+              HybridTime read_ht, QLTableRow* table_row);
+
+  // Caches the row read at read_ht, unless its shard was invalidated after read_ht.
+  void Insert(const Slice& doc_key, std::vector<ColumnIdRep> column_ids, HybridTime read_ht,
+              const QLTableRow& table_row);
+
+  // Removes rows written by the batch, should be invoked after the batch is applied to RocksDB.
+  // hybrid_time should not be less than read time of any read that could miss the batch.
+  // num_range_key_columns is used to detect writes that could affect several rows, i.e.
+  // tombstone of the whole hash key. Such writes drop all cached rows.
+  void Invalidate(const docdb::KeyValueWriteBatchPB& put_batch, HybridTime hybrid_time,
+                  size_t num_range_key_columns);
+
+  // Drops all cached rows and rejects rows read before hybrid_time.
+  void Clear(HybridTime hybrid_time);
+
+  size_t TEST_num_entries();
+
+ private:
+  struct Entry;
+  struct Shard;
+
+  Shard& ShardFor(const Slice& doc_key);
+  void InvalidateKey(const Slice& doc_key, HybridTime hybrid_time);
+  void EraseUnlocked(Shard* shard, std::unordered_map<std::string, Entry>::iterator it);
+
+  static constexpr size_t kNumShards = 16;
+
+  MemTrackerPtr mem_tracker_;
+  TabletMetrics* metrics_;
+  std::unique_ptr<Shard[]> shards_;
+};
+
+// YQLStorageIf that serves YCQL point reads of full primary keys from TabletRowCache and forwards
+// everything else to the underlying storage.
+class RowCachingQLStorage : public common::YQLStorageIf {
+ public:
+  RowCachingQLStorage(std::unique_ptr<common::YQLStorageIf> storage, TabletRowCache* cache);
+
+  CHECKED_STATUS GetIterator(
+      const QLReadRequestPB& request,
+      const Schema& projection,
+      const Schema& schema,
+      const TransactionOperationContextOpt& txn_op_context,
+      CoarseTimePoint deadline,
+      const ReadHybridTime& read_time,
+      const common::QLScanSpec& spec,
+      std::unique_ptr<common::YQLRowwiseIteratorIf>* iter) const override;
+
+  CHECKED_STATUS BuildYQLScanSpec(
+      const QLReadRequestPB& request,
+      const ReadHybridTime& read_time,
+      const Schema& schema,
+      bool include_static_columns,
+      const Schema& static_projection,
+      std::unique_ptr<common::QLScanSpec>* spec,
+      std::unique_ptr<common::QLScanSpec>* static_row_spec) const override;
+
+  CHECKED_STATUS CreateIterator(
+      const Schema& projection,
+      const Schema& schema,
+      const TransactionOperationContextOpt& txn_op_context,
+      CoarseTimePoint deadline,
+      const ReadHybridTime& read_time,
+      common::YQLRowwiseIteratorIf::UniPtr* iter) const override;
+
+  CHECKED_STATUS InitIterator(
+      common::YQLRowwiseIteratorIf* doc_iter,
+      const PgsqlReadRequestPB& request,
+      const Schema& schema,
+      const QLValuePB& ybctid) const override;
+
+  CHECKED_STATUS GetIterator(
+      const PgsqlReadRequestPB& request,
+      const Schema& projection,
+      const Schema& schema,
+      const TransactionOperationContextOpt& txn_op_context,
+      CoarseTimePoint deadline,
+      const ReadHybridTime& read_time,
+      common::YQLRowwiseIteratorIf::UniPtr* iter) const override;
+
+  CHECKED_STATUS GetIterator(
+      const PgsqlReadRequestPB& request,
+      const Schema& projection,
+      const Schema& schema,
+      const TransactionOperationContextOpt& txn_op_context,
+      CoarseTimePoint deadline,
+      const ReadHybridTime& read_time,
+      const QLValuePB& ybctid,
+      common::YQLRowwiseIteratorIf::UniPtr* iter) const override;
+
+ private:
+  // Returns encoded DocKey of the row read by request, or empty result when request could read
+  // several rows or rows that are not cached.
+  Result<std::string> CacheableDocKey(
+      const QLReadRequestPB& request, const Schema& schema,
+      const TransactionOperationContextOpt& txn_op_context,
+      const common::QLScanSpec& spec) const;
+
+  std::unique_ptr<common::YQLStorageIf> storage_;
+  TabletRowCache* cache_;
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_TABLET_ROW_CACHE_H
@@ -153,7 +153,8 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
     if (load_thread_.joinable()) {
       load_thread_.join();
     }
-    while (checking_status_.load(std::memory_order_acquire)) {
+    while (checking_status_.load(std::memory_order_acquire) ||
+           resolver_lookups_.load(std::memory_order_acquire) != 0) {
       std::this_thread::sleep_for(10ms);
     }
     shutdown_done_.store(true, std::memory_order_release);
@@ -120,6 +120,10 @@ class TransactionParticipantContext {
   // Returns hybrid time that lower than any future transaction apply record.
   virtual HybridTime SafeTimeForTransactionParticipant() = 0;
 
+  // Tablet server wide resolver used to request transaction statuses, nullptr when statuses
+  // should be requested directly.
+  virtual TransactionStatusResolver* transaction_status_resolver() { return nullptr; }
+
  protected:
   ~TransactionParticipantContext() {}
 };
@@ -0,0 +1,283 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <deque>
+
+#include <gtest/gtest.h>
+
+#include "yb/server/logical_clock.h"
+
+#include "yb/tablet/transaction_status_resolver.h"
+
+#include "yb/tserver/tserver_service.pb.h"
+
+#include "yb/util/test_util.h"
+
+DECLARE_uint64(max_transactions_in_status_request);
+DECLARE_int32(transaction_status_cache_size);
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+const TabletId kStatusTablet = "status_tablet";
+const TabletId kOtherStatusTablet = "other_status_tablet";
+
+typedef std::vector<Result<TransactionStatusResult>> StatusResults;
+
+// Resolver that keeps requests in memory instead of sending them, so tests could answer them.
+class TestTransactionStatusResolver : public TransactionStatusResolver {
+ public:
+  TestTransactionStatusResolver()
+      : TransactionStatusResolver(
+            std::shared_future<client::YBClient*>(),
+            server::ClockPtr(server::LogicalClock::CreateStartingAt(HybridTime::kInitial))) {
+  }
+
+  size_t num_in_flight() const {
+    return requests_.size();
+  }
+
+  const TabletId& InFlightTablet() const {
+    return requests_.front().req.tablet_id();
+  }
+
+  // Returns transaction ids of the oldest request in flight.
+  std::vector<TransactionId> InFlightIds() const {
+    std::vector<TransactionId> result;
+    for (const auto& id : requests_.front().req.transaction_id()) {
+      result.push_back(CHECK_RESULT(FullyDecodeTransactionId(id)));
+    }
+    return result;
+  }
+
+  // Answers the oldest request in flight with the given statuses.
+  void Respond(const std::vector<TransactionStatus>& statuses, HybridTime time) {
+    tserver::GetTransactionStatusResponsePB response;
+    for (auto status : statuses) {
+      response.add_status(status);
+      response.add_status_hybrid_time(time.ToUint64());
+    }
+    Complete(Status::OK(), response);
+  }
+
+  // Fails the oldest request in flight.
+  void Fail(const Status& status) {
+    Complete(status, tserver::GetTransactionStatusResponsePB());
+  }
+
+ protected:
+  bool SendRequest(
+      tserver::GetTransactionStatusRequestPB* req,
+      client::GetTransactionStatusCallback callback) override {
+    requests_.push_back(Request{*req, std::move(callback)});
+    return true;
+  }
+
+ private:
+  struct Request {
+    tserver::GetTransactionStatusRequestPB req;
+    client::GetTransactionStatusCallback callback;
+  };
+
+  void Complete(const Status& status, const tserver::GetTransactionStatusResponsePB& response) {
+    CHECK(!requests_.empty());
+    auto request = std::move(requests_.front());
+    requests_.pop_front();
+    request.callback(status, response);
+  }
+
+  std::deque<Request> requests_;
+};
+
+TransactionStatusCallback Collect(StatusResults* results) {
+  return [results](Result<TransactionStatusResult> result) {
+    results->push_back(std::move(result));
+  };
+}
+
+void CheckStatus(TransactionStatus expected, const StatusResults& results) {
+  for (const auto& result : results) {
+    ASSERT_OK(result);
+    ASSERT_EQ(expected, result->status);
+  }
+}
+
+} // namespace
+
+class TransactionStatusResolverTest : public YBTest {
+ protected:
+  TestTransactionStatusResolver resolver_;
+  const HybridTime time_ = HybridTime::FromMicros(1000);
+};
+
+TEST_F(TransactionStatusResolverTest, DeduplicateLookups) {
+  auto id1 = GenerateTransactionId();
+  auto id2 = GenerateTransactionId();
+  StatusResults first_results, second_results, third_results, repeated_results;
+
+  resolver_.RequestStatus(kStatusTablet, id1, Collect(&first_results));
+  ASSERT_EQ(1, resolver_.num_in_flight());
+
+  // Lookups requested while the RPC is in flight wait for it and share one entry per transaction.
+  // The lookup of id1 is not attached to the RPC in flight.
+  resolver_.RequestStatus(kStatusTablet, id2, Collect(&second_results));
+  resolver_.RequestStatus(kStatusTablet, id2, Collect(&third_results));
+  resolver_.RequestStatus(kStatusTablet, id1, Collect(&repeated_results));
+  ASSERT_EQ(1, resolver_.num_in_flight());
+  ASSERT_EQ(1, resolver_.num_rpcs());
+
+  resolver_.Respond({TransactionStatus::PENDING}, time_);
+  ASSERT_EQ(1, first_results.size());
+  ASSERT_NO_FATALS(CheckStatus(TransactionStatus::PENDING, first_results));
+  ASSERT_EQ(1, resolver_.num_in_flight());
+  ASSERT_EQ(std::vector<TransactionId>({id2, id1}), resolver_.InFlightIds());
+
+  resolver_.Respond({TransactionStatus::COMMITTED, TransactionStatus::PENDING}, time_);
+  ASSERT_EQ(0, resolver_.num_in_flight());
+  ASSERT_EQ(2, resolver_.num_rpcs());
+  ASSERT_EQ(1, second_results.size());
+  ASSERT_EQ(1, third_results.size());
+  ASSERT_EQ(1, repeated_results.size());
+  ASSERT_NO_FATALS(CheckStatus(TransactionStatus::COMMITTED, second_results));
+  ASSERT_NO_FATALS(CheckStatus(TransactionStatus::COMMITTED, third_results));
+  ASSERT_NO_FATALS(CheckStatus(TransactionStatus::PENDING, repeated_results));
+}
+
+TEST_F(TransactionStatusResolverTest, BatchLookups) {
+  FLAGS_max_transactions_in_status_request = 2;
+  std::vector<TransactionId> ids;
+  for (int i = 0; i != 6; ++i) {
+    ids.push_back(GenerateTransactionId());
+  }
+  StatusResults results, other_results;
+
+  for (const auto& id : ids) {
+    resolver_.RequestStatus(kStatusTablet, id, Collect(&results));
+  }
+  // Lookups of another status tablet are not blocked by the RPC in flight.
+  resolver_.RequestStatus(kOtherStatusTablet, ids[0], Collect(&other_results));
+  ASSERT_EQ(2, resolver_.num_in_flight());
+
+  ASSERT_EQ(kStatusTablet, resolver_.InFlightTablet());
+  ASSERT_EQ(std::vector<TransactionId>({ids[0]}), resolver_.InFlightIds());
+  resolver_.Respond({TransactionStatus::PENDING}, time_);
+
+  ASSERT_EQ(kOtherStatusTablet, resolver_.InFlightTablet());
+  resolver_.Respond({TransactionStatus::PENDING}, time_);
+  ASSERT_EQ(1, other_results.size());
+
+  // Queued lookups are sent in batches of max_transactions_in_status_request.
+  ASSERT_EQ(std::vector<TransactionId>({ids[1], ids[2]}), resolver_.InFlightIds());
+  // Node with old software version answers only the first transaction, the second one is requested
+  // again in the next batch.
+  resolver_.Respond({TransactionStatus::PENDING}, time_);
+  ASSERT_EQ(std::vector<TransactionId>({ids[2], ids[3]}), resolver_.InFlightIds());
+
+  // Failure is delivered to all lookups of the batch, the rest of the queue is still sent.
+  resolver_.Fail(STATUS(TimedOut, "Timed out"));
+  ASSERT_EQ(std::vector<TransactionId>({ids[4], ids[5]}), resolver_.InFlightIds());
+  resolver_.Respond({TransactionStatus::ABORTED, TransactionStatus::ABORTED}, time_);
+
+  ASSERT_EQ(0, resolver_.num_in_flight());
+  ASSERT_EQ(5, resolver_.num_rpcs());
+  ASSERT_EQ(ids.size(), results.size());
+  size_t num_failed = 0;
+  for (const auto& result : results) {
+    if (!result.ok()) {
+      ASSERT_TRUE(result.status().IsTimedOut()) << result.status();
+      ++num_failed;
+    }
+  }
+  ASSERT_EQ(2, num_failed);
+}
+
+TEST_F(TransactionStatusResolverTest, CacheFinalStatuses) {
+  FLAGS_transaction_status_cache_size = 1;
+  auto committed_id = GenerateTransactionId();
+  auto aborted_id = GenerateTransactionId();
+  auto pending_id = GenerateTransactionId();
+  StatusResults committed_results, aborted_results, pending_results;
+
+  resolver_.RequestStatus(kStatusTablet, committed_id, Collect(&committed_results));
+  resolver_.Respond({TransactionStatus::COMMITTED}, time_);
+  resolver_.RequestStatus(kStatusTablet, pending_id, Collect(&pending_results));
+  resolver_.Respond({TransactionStatus::PENDING}, time_);
+  ASSERT_EQ(2, resolver_.num_rpcs());
+
+  // Final status is answered from the cache, with the same status time.
+  resolver_.RequestStatus(kStatusTablet, committed_id, Collect(&committed_results));
+  ASSERT_EQ(0, resolver_.num_in_flight());
+  ASSERT_EQ(1, resolver_.num_cache_hits());
+  ASSERT_EQ(2, committed_results.size());
+  ASSERT_NO_FATALS(CheckStatus(TransactionStatus::COMMITTED, committed_results));
+  ASSERT_EQ(time_, committed_results.back()->status_time);
+
+  // PENDING could change, so it is not cached.
+  resolver_.RequestStatus(kStatusTablet, pending_id, Collect(&pending_results));
+  ASSERT_EQ(1, resolver_.num_in_flight());
+  resolver_.Respond({TransactionStatus::PENDING}, time_);
+  ASSERT_EQ(2, pending_results.size());
+
+  // The cache is bounded, the oldest status is evicted.
+  resolver_.RequestStatus(kStatusTablet, aborted_id, Collect(&aborted_results));
+  resolver_.Respond({TransactionStatus::ABORTED}, time_);
+  resolver_.RequestStatus(kStatusTablet, aborted_id, Collect(&aborted_results));
+  ASSERT_EQ(2, resolver_.num_cache_hits());
+  resolver_.RequestStatus(kStatusTablet, committed_id, Collect(&committed_results));
+  ASSERT_EQ(1, resolver_.num_in_flight());
+  ASSERT_EQ(2, resolver_.num_cache_hits());
+  resolver_.Respond({TransactionStatus::COMMITTED}, time_);
+  ASSERT_EQ(3, committed_results.size());
+  ASSERT_NO_FATALS(CheckStatus(TransactionStatus::ABORTED, aborted_results));
+  ASSERT_EQ(5, resolver_.num_rpcs());
+}
+
+TEST_F(TransactionStatusResolverTest, ShutdownWithLookupsInFlight) {
+  auto id1 = GenerateTransactionId();
+  auto id2 = GenerateTransactionId();
+  StatusResults in_flight_results, queued_results, late_results;
+  // Tracks that the resolver releases callbacks after invoking them.
+  auto token = std::make_shared<int>(0);
+  auto collect_with_token = [&token](StatusResults* results) -> TransactionStatusCallback {
+    return [token, results](Result<TransactionStatusResult> result) {
+      results->push_back(std::move(result));
+    };
+  };
+
+  resolver_.RequestStatus(kStatusTablet, id1, collect_with_token(&in_flight_results));
+  resolver_.RequestStatus(kStatusTablet, id2, collect_with_token(&queued_results));
+  ASSERT_EQ(1, resolver_.num_in_flight());
+
+  resolver_.Shutdown();
+
+  // New lookups fail right away.
+  resolver_.RequestStatus(kStatusTablet, id2, collect_with_token(&late_results));
+  ASSERT_EQ(1, late_results.size());
+  ASSERT_TRUE(late_results[0].status().IsAborted()) << late_results[0].status();
+
+  // Answer of the RPC in flight is still delivered, while queued lookups are failed instead of
+  // being sent.
+  resolver_.Respond({TransactionStatus::COMMITTED}, time_);
+  ASSERT_EQ(0, resolver_.num_in_flight());
+  ASSERT_EQ(1, resolver_.num_rpcs());
+  ASSERT_EQ(1, in_flight_results.size());
+  ASSERT_NO_FATALS(CheckStatus(TransactionStatus::COMMITTED, in_flight_results));
+  ASSERT_EQ(1, queued_results.size());
+  ASSERT_TRUE(queued_results[0].status().IsAborted()) << queued_results[0].status();
+  ASSERT_EQ(1, token.use_count());
+}
+
+} // namespace tablet
+} // namespace yb
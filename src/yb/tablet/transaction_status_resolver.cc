@@ -0,0 +1,293 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/transaction_status_resolver.h"
+
+#include <algorithm>
+
+#include "yb/client/transaction_rpc.h"
+
+#include "yb/common/wire_protocol.h"
+
+#include "yb/tserver/tserver_service.pb.h"
+
+#include "yb/util/flag_tags.h"
+
+DEFINE_int32(transaction_status_cache_size, 50000,
+             "Max number of final transaction statuses cached by the tablet server wide "
+             "transaction status resolver.");
+TAG_FLAG(transaction_status_cache_size, advanced);
+
+DECLARE_uint64(max_transactions_in_status_request);
+
+namespace yb {
+namespace tablet {
+
+TransactionStatusResolver::TransactionStatusResolver(
+    std::shared_future<client::YBClient*> client_future, server::ClockPtr clock)
+    : client_future_(std::move(client_future)), clock_(std::move(clock)) {
+}
+
+TransactionStatusResolver::~TransactionStatusResolver() {
+  Shutdown();
+}
+
+void TransactionStatusResolver::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closing_) {
+      return;
+    }
+    closing_ = true;
+  }
+  // Aborted RPCs fail the lookups queued after them.
+  rpcs_.Shutdown();
+}
+
+void TransactionStatusResolver::RequestStatus(
+    const TabletId& status_tablet, const TransactionId& id, TransactionStatusCallback callback) {
+  BatchPtr batch;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto& cache_index = cache_.get<1>();
+    auto it = cache_index.find(id);
+    if (it != cache_index.end()) {
+      cache_.relocate(cache_.begin(), cache_.project<0>(it));
+      auto result = it->result;
+      ++num_cache_hits_;
+      lock.unlock();
+      callback(result);
+      return;
+    }
+    if (closing_) {
+      lock.unlock();
+      callback(STATUS(Aborted, "Transaction status resolver is shutting down"));
+      return;
+    }
+
+    auto& queue = queues_[status_tablet];
+    auto index_it = queue.index.emplace(id, queue.lookups.size()).first;
+    if (index_it->second == queue.lookups.size()) {
+      queue.lookups.push_back(Lookup{id, {}});
+    }
+    queue.lookups[index_it->second].callbacks.push_back(std::move(callback));
+    if (queue.rpc_in_flight) {
+      return;
+    }
+    batch = ExtractBatchUnlocked(status_tablet, &queue);
+  }
+  SendBatch(batch);
+}
+
+TransactionStatusResolver::BatchPtr TransactionStatusResolver::ExtractBatchUnlocked(
+    const TabletId& status_tablet, StatusTabletQueue* queue) {
+  auto batch = std::make_shared<Batch>();
+  batch->status_tablet = status_tablet;
+  const size_t batch_size = std::min<size_t>(
+      std::max<uint64_t>(FLAGS_max_transactions_in_status_request, 1), queue->lookups.size());
+  batch->lookups.reserve(batch_size);
+  std::move(queue->lookups.begin(), queue->lookups.begin() + batch_size,
+            std::back_inserter(batch->lookups));
+  queue->lookups.erase(queue->lookups.begin(), queue->lookups.begin() + batch_size);
+  queue->index.clear();
+  for (size_t i = 0; i != queue->lookups.size(); ++i) {
+    queue->index.emplace(queue->lookups[i].id, i);
+  }
+  queue->rpc_in_flight = true;
+  ++num_rpcs_;
+  return batch;
+}
+
+void TransactionStatusResolver::SendBatch(const BatchPtr& batch) {
+  tserver::GetTransactionStatusRequestPB req;
+  req.set_tablet_id(batch->status_tablet);
+  req.set_propagated_hybrid_time(clock_->Now().ToUint64());
+  for (const auto& lookup : batch->lookups) {
+    req.add_transaction_id()->assign(pointer_cast<const char*>(lookup.id.data), lookup.id.size());
+  }
+  VLOG(4) << "Requesting status of " << batch->lookups.size() << " transactions from "
+          << batch->status_tablet;
+
+  auto sent = SendRequest(
+      &req,
+      [this, batch](const Status& status, const tserver::GetTransactionStatusResponsePB& response) {
+        StatusReceived(batch, status, response);
+      });
+  if (!sent) {
+    StatusReceived(batch, STATUS(Aborted, "Transaction status resolver is shutting down"),
+                   tserver::GetTransactionStatusResponsePB());
+  }
+}
+
+bool TransactionStatusResolver::SendRequest(
+    tserver::GetTransactionStatusRequestPB* req,
+    client::GetTransactionStatusCallback callback) {
+  auto handle = rpcs_.Prepare();
+  if (handle == rpcs_.InvalidHandle()) {
+    return false;
+  }
+  *handle = client::GetTransactionStatus(
+      TransactionRpcDeadline(),
+      nullptr /* tablet */,
+      client_future_.get(),
+      req,
+      [this, handle, callback](
+          const Status& status, const tserver::GetTransactionStatusResponsePB& response) {
+        rpcs_.Unregister(handle);
+        callback(status, response);
+      });
+  (**handle).SendRpc();
+  return true;
+}
+
+void TransactionStatusResolver::StatusReceived(
+    const BatchPtr& batch, Status status,
+    const tserver::GetTransactionStatusResponsePB& response) {
+  if (response.has_propagated_hybrid_time()) {
+    clock_->Update(HybridTime(response.propagated_hybrid_time()));
+  }
+  if (status.ok() && response.has_error()) {
+    status = StatusFromPB(response.error().status());
+  }
+
+  // Node with old software version would always return 1 status, the rest of transactions are
+  // requested again.
+  size_t num_answered = 0;
+  if (status.ok()) {
+    num_answered = response.status().size();
+    if (num_answered == 0 || num_answered > batch->lookups.size() ||
+        response.status_hybrid_time().size() != num_answered) {
+      LOG(DFATAL) << "Bad response size, expected " << batch->lookups.size() << " entries: "
+                  << response.ShortDebugString();
+      status = STATUS_FORMAT(
+          IllegalState, "Bad number of transaction statuses: $0", response.status().size());
+      num_answered = 0;
+    }
+  }
+  if (!status.ok()) {
+    VLOG(2) << "Failed to request status of " << batch->lookups.size() << " transactions from "
+            << batch->status_tablet << ": " << status;
+  }
+
+  std::vector<std::pair<TransactionStatusCallback, Result<TransactionStatusResult>>> notifications;
+  BatchPtr next_batch;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i != num_answered; ++i) {
+      TransactionStatusResult result{
+          response.status(i), HybridTime(response.status_hybrid_time(i))};
+      if (result.status == TransactionStatus::COMMITTED ||
+          result.status == TransactionStatus::ABORTED) {
+        AddToCacheUnlocked(batch->lookups[i].id, result);
+      }
+      for (auto& callback : batch->lookups[i].callbacks) {
+        notifications.emplace_back(std::move(callback), result);
+      }
+    }
+
+    auto& queue = queues_[batch->status_tablet];
+    queue.rpc_in_flight = false;
+    if (status.ok()) {
+      // Unanswered lookups go to the head of the queue, merged with the newer ones.
+      std::vector<Lookup> lookups(
+          std::make_move_iterator(batch->lookups.begin() + num_answered),
+          std::make_move_iterator(batch->lookups.end()));
+      for (auto& lookup : queue.lookups) {
+        auto it = std::find_if(lookups.begin(), lookups.end(), [&lookup](const Lookup& old) {
+          return old.id == lookup.id;
+        });
+        if (it == lookups.end()) {
+          lookups.push_back(std::move(lookup));
+        } else {
+          std::move(lookup.callbacks.begin(), lookup.callbacks.end(),
+                    std::back_inserter(it->callbacks));
+        }
+      }
+      queue.lookups = std::move(lookups);
+      queue.index.clear();
+      for (size_t i = 0; i != queue.lookups.size(); ++i) {
+        queue.index.emplace(queue.lookups[i].id, i);
+      }
+    } else {
+      for (auto& lookup : batch->lookups) {
+        for (auto& callback : lookup.callbacks) {
+          notifications.emplace_back(std::move(callback), status);
+        }
+      }
+    }
+
+    if (closing_) {
+      std::vector<TransactionStatusCallback> callbacks;
+      FailQueuedUnlocked(batch->status_tablet, &callbacks);
+      for (auto& callback : callbacks) {
+        notifications.emplace_back(
+            std::move(callback), STATUS(Aborted, "Transaction status resolver is shutting down"));
+      }
+    } else if (queue.lookups.empty()) {
+      queues_.erase(batch->status_tablet);
+    } else {
+      next_batch = ExtractBatchUnlocked(batch->status_tablet, &queue);
+    }
+  }
+
+  if (next_batch) {
+    SendBatch(next_batch);
+  }
+  for (auto& notification : notifications) {
+    // Destroy the callback right after invoking it, since it could hold the last reference to the
+    // object waiting for this status.
+    auto callback = std::move(notification.first);
+    callback(std::move(notification.second));
+  }
+}
+
+void TransactionStatusResolver::FailQueuedUnlocked(
+    const TabletId& status_tablet, std::vector<TransactionStatusCallback>* callbacks) {
+  auto it = queues_.find(status_tablet);
+  if (it == queues_.end()) {
+    return;
+  }
+  for (auto& lookup : it->second.lookups) {
+    std::move(lookup.callbacks.begin(), lookup.callbacks.end(), std::back_inserter(*callbacks));
+  }
+  queues_.erase(it);
+}
+
+void TransactionStatusResolver::AddToCacheUnlocked(
+    const TransactionId& id, const TransactionStatusResult& result) {
+  auto capacity = FLAGS_transaction_status_cache_size;
+  if (capacity <= 0) {
+    return;
+  }
+  auto insert_result = cache_.push_front(CachedStatus{id, result});
+  if (!insert_result.second) {
+    cache_.relocate(cache_.begin(), insert_result.first);
+    return;
+  }
+  while (cache_.size() > static_cast<size_t>(capacity)) {
+    cache_.pop_back();
+  }
+}
+
+uint64_t TransactionStatusResolver::num_rpcs() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_rpcs_;
+}
+
+uint64_t TransactionStatusResolver::num_cache_hits() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_cache_hits_;
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,147 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_TRANSACTION_STATUS_RESOLVER_H
+#define YB_TABLET_TRANSACTION_STATUS_RESOLVER_H
+
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+
+#include "yb/client/client_fwd.h"
+#include "yb/client/transaction_rpc.h"
+
+#include "yb/common/entity_ids.h"
+#include "yb/common/transaction.h"
+
+#include "yb/rpc/rpc.h"
+
+#include "yb/server/clock.h"
+
+namespace yb {
+
+namespace tablet {
+
+// Resolves statuses of transactions for all tablets of the tablet server, so lookups of the same
+// transactions from different tablets and lookups of different transactions with the same status
+// tablet don't end up in separate RPCs.
+//
+// While a GetTransactionStatus RPC to a status tablet is in flight, new lookups for this tablet are
+// queued and sent in one RPC when it completes. Queued lookups of the same transaction share one
+// entry of this RPC. Final statuses, i.e. COMMITTED and ABORTED, are kept in a bounded LRU cache.
+class TransactionStatusResolver {
+ public:
+  TransactionStatusResolver(
+      std::shared_future<client::YBClient*> client_future, server::ClockPtr clock);
+
+  virtual ~TransactionStatusResolver();
+
+  TransactionStatusResolver(const TransactionStatusResolver&) = delete;
+  void operator=(const TransactionStatusResolver&) = delete;
+
+  // Invokes callback with status of the transaction, the status time has the same meaning as
+  // status_hybrid_time of GetTransactionStatusResponsePB. Callback could be invoked before this
+  // function returns.
+  void RequestStatus(
+      const TabletId& status_tablet, const TransactionId& id, TransactionStatusCallback callback);
+
+  // Fails all pending lookups and makes new ones fail.
+  void Shutdown();
+
+  // Number of GetTransactionStatus RPCs sent so far.
+  uint64_t num_rpcs() const;
+
+  // Number of lookups resolved from the cache.
+  uint64_t num_cache_hits() const;
+
+ protected:
+  // Sends the request to its status tablet and invokes callback with the response. Returns false
+  // without invoking callback when the resolver is shutting down. Overridden in tests.
+  virtual bool SendRequest(
+      tserver::GetTransactionStatusRequestPB* req,
+      client::GetTransactionStatusCallback callback);
+
+ private:
+  struct Lookup {
+    TransactionId id;
+    std::vector<TransactionStatusCallback> callbacks;
+  };
+
+  struct Batch {
+    TabletId status_tablet;
+    std::vector<Lookup> lookups;
+  };
+
+  typedef std::shared_ptr<Batch> BatchPtr;
+
+  struct StatusTabletQueue {
+    // Lookups waiting for the next RPC, in the order they were requested.
+    std::vector<Lookup> lookups;
+    // Index of the lookup of the transaction in lookups.
+    std::unordered_map<TransactionId, size_t, TransactionIdHash> index;
+    bool rpc_in_flight = false;
+  };
+
+  struct CachedStatus {
+    TransactionId id;
+    TransactionStatusResult result;
+  };
+
+  typedef boost::multi_index_container<CachedStatus,
+      boost::multi_index::indexed_by<
+          boost::multi_index::sequenced<>,
+          boost::multi_index::hashed_unique<
+              boost::multi_index::member<CachedStatus, TransactionId, &CachedStatus::id>,
+              TransactionIdHash>
+      >
+  > StatusCache;
+
+  // Moves up to max_transactions_in_status_request lookups from the queue to a new batch.
+  BatchPtr ExtractBatchUnlocked(const TabletId& status_tablet, StatusTabletQueue* queue);
+
+  void SendBatch(const BatchPtr& batch);
+
+  void StatusReceived(
+      const BatchPtr& batch, Status status,
+      const tserver::GetTransactionStatusResponsePB& response);
+
+  // Fails all queued lookups of the status tablet, used when the resolver is shutting down.
+  void FailQueuedUnlocked(
+      const TabletId& status_tablet, std::vector<TransactionStatusCallback>* callbacks);
+
+  void AddToCacheUnlocked(const TransactionId& id, const TransactionStatusResult& result);
+
+  const std::shared_future<client::YBClient*> client_future_;
+  const server::ClockPtr clock_;
+
+  mutable std::mutex mutex_;
+  bool closing_ = false;
+  std::unordered_map<TabletId, StatusTabletQueue> queues_;
+  StatusCache cache_;
+  uint64_t num_rpcs_ = 0;
+  uint64_t num_cache_hits_ = 0;
+
+  rpc::Rpcs rpcs_;
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_TRANSACTION_STATUS_RESOLVER_H
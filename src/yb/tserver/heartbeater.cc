@@ -443,6 +443,8 @@ Status Heartbeater::Thread::TryHeartbeat() {
     server_->SetYSQLCatalogVersion(last_hb_response_.ysql_catalog_version());
   }
 
+  server_->set_report_tablet_loads(last_hb_response_.report_tablet_loads());
+
   // Update the live tserver list.
   return server_->PopulateLiveTServers(last_hb_response_);
 }
@@ -80,7 +80,8 @@ class RemoteBootstrapClientTest : public RemoteBootstrapTest {
     messenger_ = ASSERT_RESULT(rpc::MessengerBuilder(CURRENT_TEST_NAME()).Build());
     proxy_cache_ = std::make_unique<rpc::ProxyCache>(messenger_.get());
 
-    client_ = std::make_unique<RemoteBootstrapClient>(GetTabletId(), fs_manager_.get());
+    client_ = std::make_unique<RemoteBootstrapClient>(
+        GetTabletId(), fs_manager_.get(), nullptr /* metric_entity */);
     ASSERT_OK(GetRaftConfigLeader(tablet_peer_->consensus()
         ->ConsensusState(consensus::CONSENSUS_CONFIG_COMMITTED), &leader_));
 
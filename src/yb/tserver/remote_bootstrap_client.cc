@@ -122,10 +122,12 @@ using tablet::RaftGroupReplicaSuperBlockPB;
 
 std::atomic<int32_t> remote_bootstrap_clients_started_{0};
 
-RemoteBootstrapClient::RemoteBootstrapClient(std::string tablet_id, FsManager* fs_manager)
+RemoteBootstrapClient::RemoteBootstrapClient(
+    std::string tablet_id, FsManager* fs_manager,
+    const scoped_refptr<MetricEntity>& metric_entity)
     : tablet_id_(std::move(tablet_id)),
       log_prefix_(Format("T $0 P $1: Remote bootstrap client: ", tablet_id_, fs_manager->uuid())),
-      downloader_(&log_prefix_, fs_manager) {
+      downloader_(&log_prefix_, fs_manager, metric_entity) {
   AddComponent<RemoteBootstrapSnapshotsComponent>();
 }
 
@@ -424,7 +426,9 @@ Status RemoteBootstrapClient::Finish() {
   // Replace tablet metadata superblock. This will set the tablet metadata state
   // to TABLET_DATA_READY, since we checked above that the response
   // superblock is in a valid state to bootstrap from.
-  LOG_WITH_PREFIX(INFO) << "Remote bootstrap complete. Replacing tablet superblock.";
+  downloader_.Finished();
+  LOG_WITH_PREFIX(INFO) << "Remote bootstrap complete, " << downloader_.ThroughputToString()
+                        << ". Replacing tablet superblock.";
   UpdateStatusMessage("Replacing tablet superblock");
   new_superblock_.set_tablet_data_state(tablet::TABLET_DATA_READY);
   RETURN_NOT_OK(meta_->ReplaceSuperBlock(new_superblock_));
@@ -645,16 +649,16 @@ Status RemoteBootstrapClient::DownloadRocksDBFiles() {
 
   RETURN_NOT_OK(CreateTabletDirectories(rocksdb_dir, meta_->fs_manager()));
 
-  DataIdPB data_id;
-  data_id.set_type(DataIdPB::ROCKSDB_FILE);
+  std::vector<RemoteBootstrapFileTask> tasks;
   for (auto const& file_pb : new_superblock_.kv_store().rocksdb_files()) {
-    auto start = MonoTime::Now();
-    RETURN_NOT_OK(downloader_.DownloadFile(file_pb, rocksdb_dir, &data_id));
-    auto elapsed = MonoTime::Now().GetDeltaSince(start);
-    LOG_WITH_PREFIX(INFO)
-        << "Downloaded file " << file_pb.name() << " of size " << file_pb.size_bytes()
-        << " in " << elapsed.ToSeconds() << " seconds";
-  }
+    RemoteBootstrapFileTask task;
+    task.file_pb = &file_pb;
+    task.dir = rocksdb_dir;
+    task.data_id.set_type(DataIdPB::ROCKSDB_FILE);
+    tasks.push_back(std::move(task));
+  }
+  RETURN_NOT_OK(downloader_.DownloadFiles(tasks));
+  LOG_WITH_PREFIX(INFO) << "Downloaded RocksDB files, " << downloader_.ThroughputToString();
 
   // To avoid adding new file type to remote bootstrap we move intents as subdir of regular DB.
   auto intents_tmp_dir = JoinPathSegments(rocksdb_dir, tablet::kIntentsSubdir);
@@ -95,7 +95,10 @@ class RemoteBootstrapClient {
 
   // Construct the remote bootstrap client.
   // 'fs_manager' and 'messenger' must remain valid until this object is destroyed.
-  RemoteBootstrapClient(std::string tablet_id, FsManager* fs_manager);
+  // Download statistics are exported to 'metric_entity', when it is not null.
+  RemoteBootstrapClient(
+      std::string tablet_id, FsManager* fs_manager,
+      const scoped_refptr<MetricEntity>& metric_entity);
 
   // Attempt to clean up resources on the remote end by sending an
   // EndRemoteBootstrapSession() RPC
@@ -144,6 +147,7 @@ class RemoteBootstrapClient {
 
  private:
   FRIEND_TEST(RemoteBootstrapRocksDBClientTest, TestBeginEndSession);
+  FRIEND_TEST(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFilesPipelined);
 
   template <class Component>
   void AddComponent() {
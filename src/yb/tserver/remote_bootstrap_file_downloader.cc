@@ -13,6 +13,9 @@
 
 #include "yb/tserver/remote_bootstrap_file_downloader.h"
 
+#include <deque>
+#include <unordered_set>
+
 #include "yb/common/wire_protocol.h"
 
 #include "yb/fs/fs_manager.h"
@@ -21,10 +24,15 @@
 
 #include "yb/tserver/remote_bootstrap.proxy.h"
 
+#include "yb/gutil/strings/human_readable.h"
+
+#include "yb/util/countdown_latch.h"
 #include "yb/util/crc.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
+#include "yb/util/scope_exit.h"
 #include "yb/util/size_literals.h"
+#include "yb/util/threadpool.h"
 #include "yb/util/net/rate_limiter.h"
 
 using namespace yb::size_literals;
@@ -45,10 +53,34 @@ DEFINE_int64(remote_bootstrap_rate_limit_bytes_per_sec, 256_MB,
              "the total limit will be 2 * remote_bootstrap_rate_limit_bytes_per_sec because a "
              "tserver or master can act both as a sender and receiver at the same time.");
 
+DEFINE_int32(remote_bootstrap_max_outstanding_chunks, 4,
+             "Maximum number of chunks of a single file that are requested at the same time "
+             "during remote bootstrap.");
+TAG_FLAG(remote_bootstrap_max_outstanding_chunks, advanced);
+
+DEFINE_int32(remote_bootstrap_max_parallel_files, 4,
+             "Maximum number of files that are downloaded at the same time by a single remote "
+             "bootstrap session.");
+TAG_FLAG(remote_bootstrap_max_parallel_files, advanced);
+
 DEFINE_int32(bytes_remote_bootstrap_durable_write_mb, 8,
              "Explicitly call fsync after downloading the specified amount of data in MB "
              "during a remote bootstrap session. If 0 fsync() is not called.");
 
+METRIC_DEFINE_counter(server, remote_bootstrap_bytes_downloaded,
+                      "Remote Bootstrap Bytes Downloaded", yb::MetricUnit::kBytes,
+                      "Number of bytes downloaded by remote bootstrap sessions of this server");
+
+METRIC_DEFINE_counter(server, remote_bootstrap_files_downloaded,
+                      "Remote Bootstrap Files Downloaded", yb::MetricUnit::kUnits,
+                      "Number of files downloaded by remote bootstrap sessions of this server");
+
+METRIC_DEFINE_histogram(server, remote_bootstrap_download_rate,
+                        "Remote Bootstrap Download Rate", yb::MetricUnit::kBytes,
+                        "Average download rate of finished remote bootstrap sessions of this "
+                        "server, in bytes per second",
+                        10_GB, 2);
+
 // RETURN_NOT_OK_PREPEND() with a remote-error unwinding step.
 #define RETURN_NOT_OK_UNWIND_PREPEND(status, controller, msg) \
   RETURN_NOT_OK_PREPEND(UnwindRemoteError(status, controller), msg)
@@ -73,13 +105,66 @@ CHECKED_STATUS ExtractRemoteError(
           " from remote service");
 }
 
+// Rate limiter shared by all remote bootstrap sessions for which this process is the receiver,
+// so remote_bootstrap_rate_limit_bytes_per_sec is respected by their total rate, independently
+// of the number of sessions, files and outstanding chunks.
+class ReceiveRateLimiter {
+ public:
+  ReceiveRateLimiter()
+      : rate_limiter_([] {
+          return static_cast<uint64_t>(FLAGS_remote_bootstrap_rate_limit_bytes_per_sec);
+        }) {
+    rate_limiter_.Init();
+  }
+
+  bool active() const {
+    return FLAGS_remote_bootstrap_rate_limit_bytes_per_sec > 0;
+  }
+
+  uint64_t GetMaxSizeForNextTransmission() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return rate_limiter_.GetMaxSizeForNextTransmission();
+  }
+
+  // Delays of concurrent receivers are accumulated by the rate limiter, so they are throttled
+  // together without sleeping under the mutex.
+  void UpdateDataSizeAndMaybeSleep(uint64_t data_size) {
+    MonoDelta sleep_time;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      sleep_time = rate_limiter_.UpdateDataSize(data_size);
+    }
+    SleepFor(sleep_time);
+  }
+
+ private:
+  std::mutex mutex_;
+  RateLimiter rate_limiter_;
+};
+
+ReceiveRateLimiter& SharedReceiveRateLimiter() {
+  static ReceiveRateLimiter result;
+  return result;
+}
+
 } // namespace
 
-extern std::atomic<int32_t> remote_bootstrap_clients_started_;
+struct RemoteBootstrapFileDownloader::ChunkFetch {
+  FetchDataRequestPB req;
+  FetchDataResponsePB resp;
+  rpc::RpcController controller;
+  CountDownLatch latch{1};
+};
 
 RemoteBootstrapFileDownloader::RemoteBootstrapFileDownloader(
-    const std::string* log_prefix, FsManager* fs_manager)
+    const std::string* log_prefix, FsManager* fs_manager,
+    const scoped_refptr<MetricEntity>& metric_entity)
     : log_prefix_(*log_prefix), fs_manager_(*fs_manager) {
+  if (metric_entity) {
+    bytes_downloaded_metric_ = METRIC_remote_bootstrap_bytes_downloaded.Instantiate(metric_entity);
+    files_downloaded_metric_ = METRIC_remote_bootstrap_files_downloaded.Instantiate(metric_entity);
+    download_rate_metric_ = METRIC_remote_bootstrap_download_rate.Instantiate(metric_entity);
+  }
 }
 
 void RemoteBootstrapFileDownloader::Start(
@@ -88,6 +173,31 @@ void RemoteBootstrapFileDownloader::Start(
   proxy_ = std::move(proxy);
   session_id_ = std::move(session_id);
   session_idle_timeout_ = session_idle_timeout;
+  start_time_ = MonoTime::Now();
+}
+
+uint64_t RemoteBootstrapFileDownloader::BytesPerSecond() const {
+  if (!start_time_.Initialized()) {
+    return 0;
+  }
+  auto elapsed_us = MonoTime::Now().GetDeltaSince(start_time_).ToMicroseconds();
+  if (elapsed_us <= 0) {
+    return 0;
+  }
+  return MonoTime::kMicrosecondsPerSecond * bytes_downloaded() / elapsed_us;
+}
+
+std::string RemoteBootstrapFileDownloader::ThroughputToString() const {
+  return Format("downloaded $0 in $1 files, $2/s",
+                HumanReadableNumBytes::ToString(bytes_downloaded()),
+                files_downloaded_.load(std::memory_order_acquire),
+                HumanReadableNumBytes::ToString(BytesPerSecond()));
+}
+
+void RemoteBootstrapFileDownloader::Finished() {
+  if (download_rate_metric_) {
+    download_rate_metric_->Increment(BytesPerSecond());
+  }
 }
 
 Env& RemoteBootstrapFileDownloader::env() const {
@@ -100,16 +210,23 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
   RETURN_NOT_OK(env().CreateDirs(DirName(file_path)));
 
   if (file_pb.inode() != 0) {
-    auto it = inode2file_.find(file_pb.inode());
-    if (it != inode2file_.end()) {
+    std::string linked_path;
+    {
+      std::lock_guard<std::mutex> lock(inode2file_mutex_);
+      auto it = inode2file_.find(file_pb.inode());
+      if (it != inode2file_.end()) {
+        linked_path = it->second;
+      }
+    }
+    if (!linked_path.empty()) {
       VLOG_WITH_PREFIX(2) << "File with the same inode already found: " << file_path
-                          << " => " << it->second;
-      auto link_status = env().LinkFile(it->second, file_path);
+                          << " => " << linked_path;
+      auto link_status = env().LinkFile(linked_path, file_path);
       if (link_status.ok()) {
         return Status::OK();
       }
       // TODO fallback to copy.
-      LOG_WITH_PREFIX(ERROR) << "Failed to link file: " << file_path << " => " << it->second
+      LOG_WITH_PREFIX(ERROR) << "Failed to link file: " << file_path << " => " << linked_path
                              << ": " << link_status;
     }
   }
@@ -124,14 +241,101 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
                         Format("Unable to download $0 file $1",
                                DataIdPB::IdType_Name(data_id->type()), file_path));
   VLOG_WITH_PREFIX(2) << "Downloaded file " << file_path;
+  files_downloaded_.fetch_add(1, std::memory_order_acq_rel);
+  IncrementCounter(files_downloaded_metric_);
 
   if (file_pb.inode() != 0) {
+    std::lock_guard<std::mutex> lock(inode2file_mutex_);
     inode2file_.emplace(file_pb.inode(), file_path);
   }
 
   return Status::OK();
 }
 
+Status RemoteBootstrapFileDownloader::DownloadFiles(
+    const std::vector<RemoteBootstrapFileTask>& tasks) {
+  // Files sharing inode with a previous file are postponed, so they could be linked after
+  // the first copy is downloaded.
+  std::vector<const RemoteBootstrapFileTask*> parallel_tasks;
+  std::vector<const RemoteBootstrapFileTask*> linked_tasks;
+  std::unordered_set<uint64_t> inodes;
+  for (const auto& task : tasks) {
+    auto inode = task.file_pb->inode();
+    if (inode != 0 && !inodes.insert(inode).second) {
+      linked_tasks.push_back(&task);
+    } else {
+      parallel_tasks.push_back(&task);
+    }
+  }
+
+  auto download = [this](const RemoteBootstrapFileTask& task) {
+    auto start = MonoTime::Now();
+    DataIdPB data_id = task.data_id;
+    RETURN_NOT_OK(DownloadFile(*task.file_pb, task.dir, &data_id));
+    LOG_WITH_PREFIX(INFO)
+        << "Downloaded file " << task.file_pb->name() << " of size "
+        << task.file_pb->size_bytes() << " in "
+        << MonoTime::Now().GetDeltaSince(start).ToSeconds() << " seconds";
+    return Status::OK();
+  };
+
+  auto max_threads = std::min<int>(
+      std::max(FLAGS_remote_bootstrap_max_parallel_files, 1), parallel_tasks.size());
+  if (max_threads <= 1) {
+    for (const auto* task : parallel_tasks) {
+      RETURN_NOT_OK(download(*task));
+    }
+  } else {
+    std::mutex status_mutex;
+    Status status;
+    std::unique_ptr<ThreadPool> pool;
+    RETURN_NOT_OK(ThreadPoolBuilder("rb-download")
+                      .set_min_threads(0)
+                      .set_max_threads(max_threads)
+                      .Build(&pool));
+    for (const auto* task : parallel_tasks) {
+      RETURN_NOT_OK(pool->SubmitFunc([task, &download, &status_mutex, &status] {
+        {
+          std::lock_guard<std::mutex> lock(status_mutex);
+          if (!status.ok()) {
+            return;
+          }
+        }
+        auto task_status = download(*task);
+        if (!task_status.ok()) {
+          std::lock_guard<std::mutex> lock(status_mutex);
+          if (status.ok()) {
+            status = std::move(task_status);
+          }
+        }
+      }));
+    }
+    pool->Wait();
+    RETURN_NOT_OK(status);
+  }
+
+  for (const auto* task : linked_tasks) {
+    RETURN_NOT_OK(download(*task));
+  }
+
+  return Status::OK();
+}
+
+std::unique_ptr<RemoteBootstrapFileDownloader::ChunkFetch>
+RemoteBootstrapFileDownloader::StartFetch(
+    const DataIdPB& data_id, uint64_t offset, int32_t max_length) {
+  auto result = std::make_unique<ChunkFetch>();
+  result->controller.set_timeout(session_idle_timeout_);
+  result->req.set_session_id(session_id_);
+  result->req.mutable_data_id()->CopyFrom(data_id);
+  result->req.set_offset(offset);
+  result->req.set_max_length(max_length);
+  auto* latch = &result->latch;
+  proxy_->FetchDataAsync(
+      result->req, &result->resp, &result->controller, [latch] { latch->CountDown(); });
+  return result;
+}
+
 template<class Appendable>
 Status RemoteBootstrapFileDownloader::DownloadFile(
     const DataIdPB& data_id, Appendable* appendable) {
@@ -140,79 +344,106 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
   // For periodic sync, indicates number of bytes which need to be sync'ed.
   size_t periodic_sync_unsynced_bytes = 0;
   uint64_t offset = 0;
-  int32_t max_length = std::min(FLAGS_remote_bootstrap_max_chunk_size,
-                                FLAGS_rpc_max_message_size - kBytesReservedForMessageHeaders);
-
-  std::unique_ptr<RateLimiter> rate_limiter;
-
-  if (FLAGS_remote_bootstrap_rate_limit_bytes_per_sec > 0) {
-    static auto rate_updater = []() {
-      auto remote_bootstrap_clients_started =
-          remote_bootstrap_clients_started_.load(std::memory_order_acquire);
-      if (remote_bootstrap_clients_started < 1) {
-        YB_LOG_EVERY_N(ERROR, 100) << "Invalid number of remote bootstrap sessions: "
-                                   << remote_bootstrap_clients_started;
-        return static_cast<uint64_t>(FLAGS_remote_bootstrap_rate_limit_bytes_per_sec);
-      }
-      return static_cast<uint64_t>(
-          FLAGS_remote_bootstrap_rate_limit_bytes_per_sec / remote_bootstrap_clients_started);
-    };
-
-    rate_limiter = std::make_unique<RateLimiter>(rate_updater);
-  } else {
-    // Inactive RateLimiter.
-    rate_limiter = std::make_unique<RateLimiter>();
-  }
-
-  rpc::RpcController controller;
-  controller.set_timeout(session_idle_timeout_);
-  FetchDataRequestPB req;
-
-  bool done = false;
-  while (!done) {
-    controller.Reset();
-    req.set_session_id(session_id_);
-    req.mutable_data_id()->CopyFrom(data_id);
-    req.set_offset(offset);
-    if (rate_limiter->active()) {
-      auto max_size = rate_limiter->GetMaxSizeForNextTransmission();
-      if (max_size > std::numeric_limits<decltype(max_length)>::max()) {
-        max_size = std::numeric_limits<decltype(max_length)>::max();
+  const int32_t max_length = std::min(FLAGS_remote_bootstrap_max_chunk_size,
+                                      FLAGS_rpc_max_message_size - kBytesReservedForMessageHeaders);
+  const size_t max_outstanding_chunks =
+      std::max(FLAGS_remote_bootstrap_max_outstanding_chunks, 1);
+
+  auto& rate_limiter = SharedReceiveRateLimiter();
+  auto next_chunk_length = [&rate_limiter, max_length]() {
+    if (!rate_limiter.active()) {
+      return max_length;
+    }
+    auto max_size = rate_limiter.GetMaxSizeForNextTransmission();
+    return static_cast<int32_t>(std::min<uint64_t>(max_length, std::max<uint64_t>(max_size, 1)));
+  };
+
+  // Chunks are ordered by offset. Outstanding RPCs should be finished before returning,
+  // since they reference data owned by ChunkFetch.
+  std::deque<std::unique_ptr<ChunkFetch>> fetches;
+  auto se = ScopeExit([&fetches] {
+    for (const auto& fetch : fetches) {
+      fetch->latch.Wait();
+    }
+  });
+
+  // Total length is unknown until the first chunk is received, so only one chunk is requested
+  // at the beginning.
+  uint64_t total_length = 0;
+  bool total_length_known = false;
+  uint64_t next_offset = 0;
+  for (;;) {
+    size_t max_fetches = total_length_known ? max_outstanding_chunks : 1;
+    while (fetches.size() < max_fetches && (!total_length_known || next_offset < total_length)) {
+      auto length = next_chunk_length();
+      if (total_length_known) {
+        length = std::min<uint64_t>(length, total_length - next_offset);
       }
-      max_length = std::min(max_length, decltype(max_length)(max_size));
+      fetches.push_back(StartFetch(data_id, next_offset, length));
+      next_offset += length;
+    }
+    if (fetches.empty()) {
+      return STATUS_FORMAT(
+          IllegalState, "Nothing to fetch for data item $0 at offset $1 of $2",
+          data_id, offset, total_length);
     }
-    req.set_max_length(max_length);
 
-    FetchDataResponsePB resp;
-    auto status = rate_limiter->SendOrReceiveData([this, &req, &resp, &controller]() {
-      return proxy_->FetchData(req, &resp, &controller);
-    }, [&resp]() { return resp.ByteSize(); });
-    RETURN_NOT_OK_UNWIND_PREPEND(status, controller, "Unable to fetch data from remote");
-    DCHECK_LE(resp.chunk().data().size(), max_length);
+    auto fetch = std::move(fetches.front());
+    fetches.pop_front();
+    fetch->latch.Wait();
+    RETURN_NOT_OK_UNWIND_PREPEND(
+        fetch->controller.status(), fetch->controller, "Unable to fetch data from remote");
+    const auto& chunk = fetch->resp.chunk();
+    DCHECK_LE(chunk.data().size(), fetch->req.max_length());
 
     // Sanity-check for corruption.
-    RETURN_NOT_OK_PREPEND(VerifyData(offset, resp.chunk()),
+    RETURN_NOT_OK_PREPEND(VerifyData(offset, chunk),
                           Format("Error validating data item $0", data_id));
 
     // Write the data.
-    RETURN_NOT_OK(appendable->Append(resp.chunk().data()));
+    RETURN_NOT_OK(appendable->Append(chunk.data()));
     VLOG_WITH_PREFIX(3)
-        << "resp size: " << resp.ByteSize() << ", chunk size: " << resp.chunk().data().size();
+        << "resp size: " << fetch->resp.ByteSize() << ", chunk size: " << chunk.data().size();
 
-    if (offset + resp.chunk().data().size() == resp.chunk().total_data_length()) {
-      done = true;
+    offset += chunk.data().size();
+    bytes_downloaded_.fetch_add(chunk.data().size(), std::memory_order_acq_rel);
+    if (bytes_downloaded_metric_) {
+      bytes_downloaded_metric_->IncrementBy(chunk.data().size());
+    }
+    if (rate_limiter.active()) {
+      rate_limiter.UpdateDataSizeAndMaybeSleep(fetch->resp.ByteSize());
     }
-    offset += resp.chunk().data().size();
     if (FLAGS_bytes_remote_bootstrap_durable_write_mb != 0) {
-      periodic_sync_unsynced_bytes += resp.chunk().data().size();
+      periodic_sync_unsynced_bytes += chunk.data().size();
       if (periodic_sync_unsynced_bytes > FLAGS_bytes_remote_bootstrap_durable_write_mb * 1_MB) {
         RETURN_NOT_OK(appendable->Sync());
         periodic_sync_unsynced_bytes = 0;
       }
     }
-  }
 
-  VLOG_WITH_PREFIX(2) << "Transmission rate: " << rate_limiter->GetRate();
+    if (offset == chunk.total_data_length()) {
+      break;
+    }
+    if (offset > chunk.total_data_length()) {
+      return STATUS_FORMAT(
+          IllegalState, "Received $0 bytes of data item $1, while its total length is $2",
+          offset, data_id, chunk.total_data_length());
+    }
+    total_length = chunk.total_data_length();
+    if (!total_length_known) {
+      total_length_known = true;
+      next_offset = offset;
+      continue;
+    }
+
+    // Sender could return less data than requested, for instance because of its own rate limit.
+    // Request the missing part before the chunks that are already in flight.
+    auto expected_offset = fetch->req.offset() + fetch->req.max_length();
+    if (offset < expected_offset && offset < total_length) {
+      fetches.push_front(StartFetch(
+          data_id, offset, std::min<uint64_t>(expected_offset, total_length) - offset));
+    }
+  }
 
   return Status::OK();
 }
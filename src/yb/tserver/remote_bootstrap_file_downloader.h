@@ -14,9 +14,12 @@
 #ifndef YB_TSERVER_REMOTE_BOOTSTRAP_FILE_DOWNLOADER_H
 #define YB_TSERVER_REMOTE_BOOTSTRAP_FILE_DOWNLOADER_H
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "yb/rpc/rpc_fwd.h"
 
@@ -24,6 +27,7 @@
 
 #include "yb/tserver/remote_bootstrap.pb.h"
 
+#include "yb/util/metrics.h"
 #include "yb/util/monotime.h"
 #include "yb/util/status.h"
 
@@ -37,9 +41,19 @@ namespace tserver {
 
 class RemoteBootstrapServiceProxy;
 
+// File that should be downloaded to specified directory using specified data id.
+struct RemoteBootstrapFileTask {
+  const tablet::FilePB* file_pb;
+  std::string dir;
+  DataIdPB data_id;
+};
+
 class RemoteBootstrapFileDownloader {
  public:
-  RemoteBootstrapFileDownloader(const std::string* log_prefix, FsManager* fs_manager);
+  // Download statistics are exported to metric_entity, when it is not null.
+  RemoteBootstrapFileDownloader(
+      const std::string* log_prefix, FsManager* fs_manager,
+      const scoped_refptr<MetricEntity>& metric_entity);
 
   void Start(
       std::shared_ptr<RemoteBootstrapServiceProxy> proxy, std::string session_id,
@@ -48,9 +62,16 @@ class RemoteBootstrapFileDownloader {
   CHECKED_STATUS DownloadFile(
       const tablet::FilePB& file_pb, const std::string& dir, DataIdPB* data_id);
 
+  // Download multiple files, up to remote_bootstrap_max_parallel_files of them at the same time.
+  // Files that share inode with other file are downloaded once and hard linked.
+  CHECKED_STATUS DownloadFiles(const std::vector<RemoteBootstrapFileTask>& tasks);
+
   // Download a single remote file. The block and WAL implementations delegate
   // to this method when downloading files.
   //
+  // Up to remote_bootstrap_max_outstanding_chunks chunks are requested at the same time, and
+  // appended in order of offset.
+  //
   // An Appendable is typically a WritableFile (WAL).
   //
   // Only used in one compilation unit, otherwise the implementation would
@@ -66,9 +87,28 @@ class RemoteBootstrapFileDownloader {
     return session_id_;
   }
 
+  uint64_t bytes_downloaded() const {
+    return bytes_downloaded_.load(std::memory_order_acquire);
+  }
+
+  // Average download rate of this session in bytes per second.
+  uint64_t BytesPerSecond() const;
+
+  // Human readable download statistics of this session.
+  std::string ThroughputToString() const;
+
+  // Records download rate of this session, should be invoked when all files were downloaded.
+  void Finished();
+
  private:
+  struct ChunkFetch;
+
   CHECKED_STATUS VerifyData(uint64_t offset, const DataChunkPB& resp);
 
+  // Starts fetch of chunk of specified size at specified offset.
+  std::unique_ptr<ChunkFetch> StartFetch(
+      const DataIdPB& data_id, uint64_t offset, int32_t max_length);
+
   const std::string& LogPrefix() const {
     return log_prefix_;
   }
@@ -81,6 +121,16 @@ class RemoteBootstrapFileDownloader {
   std::shared_ptr<RemoteBootstrapServiceProxy> proxy_;
   std::string session_id_;
   MonoDelta session_idle_timeout_ = MonoDelta::kZero;
+  MonoTime start_time_;
+
+  std::atomic<uint64_t> bytes_downloaded_{0};
+  std::atomic<size_t> files_downloaded_{0};
+
+  scoped_refptr<Counter> bytes_downloaded_metric_;
+  scoped_refptr<Counter> files_downloaded_metric_;
+  scoped_refptr<Histogram> download_rate_metric_;
+
+  std::mutex inode2file_mutex_;
   std::unordered_map<uint64_t, std::string> inode2file_;
 };
 
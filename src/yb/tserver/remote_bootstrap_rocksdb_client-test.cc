@@ -17,9 +17,16 @@
 
 #include "yb/tserver/remote_bootstrap_client-test.h"
 
+#include "yb/util/size_literals.h"
+
+using namespace yb::size_literals;
 
 using std::shared_ptr;
 
+DECLARE_int32(remote_bootstrap_max_chunk_size);
+DECLARE_int32(remote_bootstrap_max_outstanding_chunks);
+DECLARE_int32(remote_bootstrap_max_parallel_files);
+
 namespace yb {
 namespace tserver {
 
@@ -31,6 +38,9 @@ using tablet::TabletStatusListener;
 class RemoteBootstrapRocksDBClientTest : public RemoteBootstrapClientTest {
  public:
   RemoteBootstrapRocksDBClientTest() : RemoteBootstrapClientTest(YQL_TABLE_TYPE) {}
+
+ protected:
+  void TestDownloadRocksDBFiles();
 };
 
 // Basic begin / end remote bootstrap session.
@@ -40,8 +50,7 @@ TEST_F(RemoteBootstrapRocksDBClientTest, TestBeginEndSession) {
   ASSERT_OK(client_->Finish());
 }
 
-// Basic RocksDB files download unit test.
-TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
+void RemoteBootstrapRocksDBClientTest::TestDownloadRocksDBFiles() {
   TabletStatusListener listener(meta_);
   ASSERT_OK(client_->FetchAll(&listener));
   auto tablet_peer_checkpoint_dir =
@@ -81,5 +90,19 @@ TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
   }
 }
 
+// Basic RocksDB files download unit test.
+TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
+  TestDownloadRocksDBFiles();
+}
+
+// Download files in small chunks, with many outstanding chunks and files at the same time.
+TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFilesPipelined) {
+  FLAGS_remote_bootstrap_max_chunk_size = 1_KB;
+  FLAGS_remote_bootstrap_max_outstanding_chunks = 8;
+  FLAGS_remote_bootstrap_max_parallel_files = 3;
+  TestDownloadRocksDBFiles();
+  ASSERT_GT(client_->downloader_.bytes_downloaded(), 0);
+}
+
 } // namespace tserver
 } // namespace yb
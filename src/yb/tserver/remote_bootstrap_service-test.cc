@@ -31,6 +31,7 @@
 //
 
 #include <limits>
+#include <thread>
 
 #include <gflags/gflags.h>
 
@@ -51,12 +52,14 @@
 #include "yb/util/crc.h"
 #include "yb/util/env_util.h"
 #include "yb/util/monotime.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/stopwatch.h"
 #include "yb/util/test_util.h"
 
 #define ASSERT_REMOTE_ERROR(status, err, code, str) \
     ASSERT_NO_FATALS(AssertRemoteError(status, err, code, str))
 
+DECLARE_int64(remote_bootstrap_rate_limit_bytes_per_sec);
 DECLARE_uint64(remote_bootstrap_idle_timeout_ms);
 DECLARE_uint64(remote_bootstrap_timeout_poll_period_ms);
 
@@ -372,6 +375,67 @@ TEST_F(RemoteBootstrapServiceTest, TestFetchLog) {
   AssertDataEqual(slice.data(), slice.size(), resp.chunk());
 }
 
+// Chunks of one session are fetched in parallel, as the file downloader does, while the rate
+// limiter of the session is active.
+TEST_F(RemoteBootstrapServiceTest, TestParallelFetchData) {
+  FLAGS_remote_bootstrap_rate_limit_bytes_per_sec = 64_MB;
+
+  string session_id;
+  uint64_t segment_seqno;
+  ASSERT_OK(DoBeginValidRemoteBootstrapSession(&session_id, nullptr, nullptr, &segment_seqno));
+
+  log::SegmentSequence local_segments;
+  ASSERT_OK(tablet_peer_->log()->GetLogReader()->GetSegmentsSnapshot(&local_segments));
+  const scoped_refptr<ReadableLogSegment>& segment = local_segments[0];
+  faststring scratch;
+  int64_t size = ASSERT_RESULT(segment->readable_file_checkpoint()->Size());
+  scratch.resize(size);
+  Slice slice;
+  ASSERT_OK(ReadFully(segment->readable_file_checkpoint().get(), 0, size, &slice, scratch.data()));
+
+  DataIdPB data_id;
+  data_id.set_type(DataIdPB::LOG_SEGMENT);
+  data_id.set_wal_segment_seqno(segment_seqno);
+
+  constexpr int64_t kNumChunks = 16;
+  const int64_t chunk_size = std::max<int64_t>((size + kNumChunks - 1) / kNumChunks, 1);
+  std::vector<FetchDataResponsePB> responses(kNumChunks);
+  std::vector<Status> statuses(kNumChunks);
+  std::vector<std::thread> threads;
+  for (int64_t i = 0; i != kNumChunks; ++i) {
+    threads.emplace_back([this, i, chunk_size, &session_id, &data_id, &responses, &statuses] {
+      uint64_t offset = i * chunk_size;
+      int64_t max_length = chunk_size;
+      RpcController controller;
+      statuses[i] = DoFetchData(
+          session_id, data_id, &offset, &max_length, &responses[i], &controller);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (int64_t i = 0; i != kNumChunks; ++i) {
+    const int64_t offset = i * chunk_size;
+    if (offset >= size) {
+      continue;
+    }
+    ASSERT_OK(statuses[i]);
+    const auto& chunk = responses[i].chunk();
+    ASSERT_EQ(offset, chunk.offset());
+    ASSERT_EQ(size, chunk.total_data_length());
+    // Rate limiter could make the chunk shorter than requested.
+    const int64_t chunk_length = chunk.data().size();
+    ASSERT_GT(chunk_length, 0);
+    ASSERT_LE(chunk_length, std::min(chunk_size, size - offset));
+    ASSERT_NO_FATALS(AssertDataEqual(slice.data() + offset, chunk_length, chunk));
+  }
+
+  EndRemoteBootstrapSessionResponsePB resp;
+  RpcController controller;
+  ASSERT_OK(DoEndRemoteBootstrapSession(session_id, true, nullptr, &resp, &controller));
+}
+
 // Test that the remote bootstrap session timeout works properly.
 TEST_F(RemoteBootstrapServiceTest, TestSessionTimeout) {
   // This flag should be seen by the service due to TSO.
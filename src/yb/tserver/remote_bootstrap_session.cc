@@ -571,13 +571,28 @@ bool RemoteBootstrapSession::Succeeded() {
 }
 
 void RemoteBootstrapSession::EnsureRateLimiterIsInitialized() {
+  std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
   if (!rate_limiter_.IsInitialized()) {
-    InitRateLimiter();
+    InitRateLimiterUnlocked();
   }
 }
 
+int64_t RemoteBootstrapSession::GetMaxSizeForNextTransmission() {
+  std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
+  return rate_limiter_.GetMaxSizeForNextTransmission();
+}
+
+void RemoteBootstrapSession::UpdateDataSizeAndMaybeSleep(uint64_t data_size) {
+  MonoDelta sleep_time;
+  {
+    std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
+    sleep_time = rate_limiter_.UpdateDataSize(data_size);
+  }
+  SleepFor(sleep_time);
+}
+
 
-void RemoteBootstrapSession::InitRateLimiter() {
+void RemoteBootstrapSession::InitRateLimiterUnlocked() {
   if (FLAGS_remote_bootstrap_rate_limit_bytes_per_sec > 0 && nsessions_) {
     // Calling SetTargetRateUpdater will activate the rate limiter.
     rate_limiter_.SetTargetRateUpdater([this]() -> uint64_t {
@@ -128,11 +128,15 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
   // Change the peer's role to VOTER.
   CHECKED_STATUS ChangeRole();
 
-  void InitRateLimiter();
-
   void EnsureRateLimiterIsInitialized();
 
-  RateLimiter& rate_limiter() { return rate_limiter_; }
+  // Rate limiter accessors are thread safe, since chunks of the session could be fetched in
+  // parallel.
+  int64_t GetMaxSizeForNextTransmission();
+
+  // Sleeping while holding the rate limiter mutex is intended, it throttles all fetches of the
+  // session.
+  void UpdateDataSizeAndMaybeSleep(uint64_t data_size);
 
   static const std::string kCheckpointsDir;
 
@@ -184,6 +188,8 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
 
   RemoteBootstrapSource* Source(DataIdPB::IdType id_type) const;
 
+  void InitRateLimiterUnlocked() REQUIRES(rate_limiter_mutex_);
+
   std::shared_ptr<tablet::TabletPeer> tablet_peer_;
   const std::string session_id_;
   const std::string requestor_uuid_;
@@ -216,8 +222,10 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
   // Time when this session was initialized.
   MonoTime start_time_;
 
+  std::mutex rate_limiter_mutex_;
+
   // Used to limit the transmission rate.
-  RateLimiter rate_limiter_;
+  RateLimiter rate_limiter_ GUARDED_BY(rate_limiter_mutex_);
 
   // Pointer to the counter for of the number of sessions in RemoteBootstrapService. Used to
   // calculate the rate for the rate limiter.
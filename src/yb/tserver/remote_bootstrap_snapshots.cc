@@ -81,20 +81,22 @@ Status RemoteBootstrapSnapshotsComponent::Download() {
                         Format("Failed to create & sync top snapshots directory $0",
                                top_snapshots_dir));
 
-  DataIdPB data_id;
-  data_id.set_type(DataIdPB::SNAPSHOT_FILE);
+  std::vector<RemoteBootstrapFileTask> tasks;
   for (auto const& file_pb : kv_store.snapshot_files()) {
     const string snapshot_dir = JoinPathSegments(top_snapshots_dir, file_pb.snapshot_id());
 
     RETURN_NOT_OK_PREPEND(fs_manager().CreateDirIfMissingAndSync(snapshot_dir),
                           Format("Failed to create & sync snapshot directory $0", snapshot_dir));
 
-    const std::string file_path = JoinPathSegments(snapshot_dir, file_pb.file().name());
-    data_id.set_snapshot_id(file_pb.snapshot_id());
-    RETURN_NOT_OK(downloader_.DownloadFile(file_pb.file(), snapshot_dir, &data_id));
+    RemoteBootstrapFileTask task;
+    task.file_pb = &file_pb.file();
+    task.dir = snapshot_dir;
+    task.data_id.set_type(DataIdPB::SNAPSHOT_FILE);
+    task.data_id.set_snapshot_id(file_pb.snapshot_id());
+    tasks.push_back(std::move(task));
   }
 
-  return Status::OK();
+  return downloader_.DownloadFiles(tasks);
 }
 
 Status RemoteBootstrapSnapshotsSource::Init() {
@@ -173,6 +173,16 @@ class TabletServer : public server::RpcAndWebServerBase, public TabletServerIf {
 
   void SetYSQLCatalogVersion(uint64_t new_version);
 
+  // Whether loads of individual tablets should be reported to the master, as requested by the
+  // last heartbeat response.
+  void set_report_tablet_loads(bool value) {
+    report_tablet_loads_.store(value, std::memory_order_release);
+  }
+
+  bool report_tablet_loads() const {
+    return report_tablet_loads_.load(std::memory_order_acquire);
+  }
+
   uint64_t ysql_catalog_version() const override {
     std::lock_guard<simple_spinlock> l(lock_);
     return ysql_catalog_version_;
@@ -202,6 +212,8 @@ class TabletServer : public server::RpcAndWebServerBase, public TabletServerIf {
  protected:
   virtual CHECKED_STATUS RegisterServices();
 
+  bool UseRpcCompression() const override { return true; }
+
   friend class TabletServerTestBase;
 
   void DisplayRpcIcons(std::stringstream* output) override;
@@ -252,6 +264,8 @@ class TabletServer : public server::RpcAndWebServerBase, public TabletServerIf {
   // Latest known version from the YSQL catalog (as reported by last heartbeat response).
   uint64_t ysql_catalog_version_ = 0;
 
+  std::atomic<bool> report_tablet_loads_{false};
+
   // An instance to tablet server service. This pointer is no longer valid after RpcAndWebServerBase
   // is shut down.
   TabletServiceImpl* tablet_server_service_;
@@ -0,0 +1,105 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+
+#include "yb/tserver/tablet_split_heartbeat_data_provider.h"
+
+#include "yb/common/partition.h"
+#include "yb/master/master.pb.h"
+#include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_metrics.h"
+#include "yb/tablet/tablet_peer.h"
+#include "yb/tserver/tablet_server.h"
+#include "yb/tserver/ts_tablet_manager.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+
+DEFINE_int32(tablet_split_check_interval_ms, 10000,
+             "Interval (in milliseconds) at which tserver looks for tablets to split and reports "
+             "them in a heartbeat to master.");
+TAG_FLAG(tablet_split_check_interval_ms, advanced);
+
+DEFINE_int64(tablet_split_size_threshold_bytes, 0,
+             "A tablet led by this tserver is reported to master as a split candidate once the "
+             "size of its SST files reaches this value. 0 to disable.");
+TAG_FLAG(tablet_split_size_threshold_bytes, runtime);
+
+DEFINE_double(tablet_split_write_rate_threshold, 0,
+              "A tablet led by this tserver is reported to master as a split candidate once the "
+              "number of rows written to it per second reaches this value. 0 to disable.");
+TAG_FLAG(tablet_split_write_rate_threshold, runtime);
+
+namespace yb {
+namespace tserver {
+
+TabletSplitHeartbeatDataProvider::TabletSplitHeartbeatDataProvider(TabletServer* server) :
+  PeriodicalHeartbeatDataProvider(server,
+      MonoDelta::FromMilliseconds(FLAGS_tablet_split_check_interval_ms)) {}
+
+void TabletSplitHeartbeatDataProvider::DoAddData(master::TSHeartbeatRequestPB* req) {
+  const auto size_threshold = FLAGS_tablet_split_size_threshold_bytes;
+  const auto write_rate_threshold = FLAGS_tablet_split_write_rate_threshold;
+  if (size_threshold <= 0 && write_rate_threshold <= 0) {
+    prev_rows_written_.clear();
+    return;
+  }
+
+  const double elapsed_seconds = (CoarseMonoClock::Now() - prev_run_time()).ToSeconds();
+  std::unordered_map<TabletId, int64_t> rows_written;
+  for (const auto& tablet_peer : server().tablet_manager()->GetTabletPeers()) {
+    if (!tablet_peer || tablet_peer->state() != tablet::RUNNING ||
+        tablet_peer->LeaderStatus() != consensus::LeaderStatus::LEADER_AND_READY) {
+      continue;
+    }
+    auto tablet = tablet_peer->shared_tablet();
+    if (!tablet) {
+      continue;
+    }
+    const auto& tablet_id = tablet_peer->tablet_id();
+
+    const int64_t rows = tablet->metrics()->rows_inserted->value();
+    rows_written.emplace(tablet_id, rows);
+    double write_rate = 0;
+    auto it = prev_rows_written_.find(tablet_id);
+    if (it != prev_rows_written_.end() && elapsed_seconds > 0 && rows >= it->second) {
+      write_rate = (rows - it->second) / elapsed_seconds;
+    }
+    const uint64_t size = tablet->GetCurrentVersionSstFilesSize();
+
+    if ((size_threshold <= 0 || size < size_threshold) &&
+        (write_rate_threshold <= 0 || write_rate < write_rate_threshold)) {
+      continue;
+    }
+
+    auto split_hash_code = tablet->GetSplitHashCode();
+    if (!split_hash_code.ok()) {
+      VLOG_WITH_PREFIX(1) << "Not reporting tablet " << tablet_id << " for split: "
+                          << split_hash_code.status();
+      continue;
+    }
+    VLOG_WITH_PREFIX(1) << "Reporting tablet " << tablet_id << " for split at hash code "
+                        << *split_hash_code << ", SST files size: " << size
+                        << ", rows written per second: " << write_rate;
+    auto* candidate = req->add_tablet_split_candidates();
+    candidate->set_tablet_id(tablet_id);
+    candidate->set_split_partition_key(
+        PartitionSchema::EncodeMultiColumnHashValue(*split_hash_code));
+    candidate->set_sst_files_size(size);
+    candidate->set_rows_written_per_sec(write_rate);
+  }
+  prev_rows_written_.swap(rows_written);
+}
+
+} // namespace tserver
+} // namespace yb
@@ -0,0 +1,42 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+
+#ifndef YB_TSERVER_TABLET_SPLIT_HEARTBEAT_DATA_PROVIDER_H
+#define YB_TSERVER_TABLET_SPLIT_HEARTBEAT_DATA_PROVIDER_H
+
+#include <unordered_map>
+
+#include "yb/common/entity_ids.h"
+#include "yb/tserver/heartbeater.h"
+
+namespace yb {
+namespace tserver {
+
+// Reports the tablets led by this tablet server whose SST files size or write rate is above the
+// configured thresholds to the master as split candidates, with the hash code to split them at.
+class TabletSplitHeartbeatDataProvider : public PeriodicalHeartbeatDataProvider {
+ public:
+  explicit TabletSplitHeartbeatDataProvider(TabletServer* server);
+
+ private:
+  void DoAddData(master::TSHeartbeatRequestPB* req) override;
+
+  // Number of rows written to each tablet as of the previous run, to compute write rates.
+  std::unordered_map<TabletId, int64_t> prev_rows_written_;
+};
+
+} // namespace tserver
+} // namespace yb
+
+#endif // YB_TSERVER_TABLET_SPLIT_HEARTBEAT_DATA_PROVIDER_H
@@ -32,24 +32,31 @@
 
 #include "yb/tserver/ts_tablet_manager.h"
 
+#include <algorithm>
 #include <string>
 
 #include <gtest/gtest.h>
 #include <gflags/gflags.h>
 
 #include "yb/common/partition.h"
+#include "yb/common/ql_protocol_util.h"
 #include "yb/common/schema.h"
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/consensus.pb.h"
 #include "yb/consensus/metadata.pb.h"
 #include "yb/fs/fs_manager.h"
 #include "yb/master/master.pb.h"
+#include "yb/rocksdb/cache.h"
+#include "yb/rocksdb/statistics.h"
+#include "yb/tablet/local_tablet_writer.h"
+#include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tablet/tablet-test-util.h"
 #include "yb/tserver/mini_tablet_server.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/util/test_util.h"
 #include "yb/util/format.h"
+#include "yb/util/size_literals.h"
 
 #define ASSERT_REPORT_HAS_UPDATED_TABLET(report, tablet_id) \
   ASSERT_NO_FATALS(AssertReportHasUpdatedTablet(report, tablet_id))
@@ -58,6 +65,9 @@
   ASSERT_NO_FATALS(AssertMonotonicReportSeqno(report_seqno, tablet_report))
 
 DECLARE_bool(pretend_memory_exceeded_enforce_flush);
+DECLARE_int64(db_compressed_block_cache_size_bytes);
+
+using namespace yb::size_literals;
 
 namespace yb {
 namespace tserver {
@@ -298,6 +308,125 @@ TEST_F(TsTabletManagerTest, TestProperBackgroundFlushOnStartup) {
   }
 }
 
+static const int kNumRows = 1000;
+
+class TsTabletManagerCompressedBlockCacheTest : public TsTabletManagerTest {
+ public:
+  void SetUp() override {
+    FLAGS_db_compressed_block_cache_size_bytes = 16_MB;
+    TsTabletManagerTest::SetUp();
+
+    tablet_options_ = tablet_manager_->TEST_tablet_options();
+    ASSERT_NE(nullptr, tablet_options_->block_cache);
+    ASSERT_NE(nullptr, tablet_options_->block_cache_compressed);
+
+    const Schema schema({ ColumnSchema("key", INT32, false, true),
+                          ColumnSchema("value", STRING) }, 1);
+    std::shared_ptr<TabletPeer> peer;
+    ASSERT_OK(CreateNewTablet(kTabletId, schema, &peer));
+    tablet_ = peer->tablet();
+  }
+
+ protected:
+  // Values are mostly repeated characters, so blocks are compressed well enough to be stored
+  // compressed.
+  static std::string Value(const std::string& prefix, int key) {
+    return Format("$0_$1_", prefix, key) + std::string(256, 'a' + key % 26);
+  }
+
+  void WriteRows(const std::string& prefix) {
+    tablet::LocalTabletWriter writer(tablet_);
+    for (int i = 0; i != kNumRows; ++i) {
+      QLWriteRequestPB req;
+      req.set_type(QLWriteRequestPB::QL_STMT_INSERT);
+      QLAddInt32HashValue(&req, i);
+      QLAddStringColumnValue(&req, kFirstColumnId + 1, Value(prefix, i));
+      ASSERT_OK(writer.Write(&req));
+    }
+  }
+
+  void ReadAllRows(std::vector<std::string>* rows) {
+    rows->clear();
+    ASSERT_OK(tablet::DumpTablet(*tablet_, tablet_->SchemaRef(), rows));
+    ASSERT_EQ(kNumRows, static_cast<int>(rows->size()));
+  }
+
+  void EvictFromBlockCache() {
+    auto& block_cache = *tablet_options_->block_cache;
+    const auto capacity = block_cache.GetCapacity();
+    block_cache.SetCapacity(0);
+    block_cache.SetCapacity(capacity);
+  }
+
+  uint64_t Ticker(rocksdb::Tickers ticker) {
+    return tablet_->rocksdb_statistics()->getTickerCount(ticker);
+  }
+
+  // Reads all rows after evicting them from the block cache, and checks that every data block
+  // missing from the block cache is found in the compressed block cache.
+  void ReadThroughCompressedCache(std::vector<std::string>* rows) {
+    EvictFromBlockCache();
+    const auto compressed_hits_before = Ticker(rocksdb::BLOCK_CACHE_COMPRESSED_HIT);
+    const auto compressed_misses_before = Ticker(rocksdb::BLOCK_CACHE_COMPRESSED_MISS);
+    const auto data_misses_before = Ticker(rocksdb::BLOCK_CACHE_DATA_MISS);
+    ASSERT_NO_FATALS(ReadAllRows(rows));
+    const auto data_misses = Ticker(rocksdb::BLOCK_CACHE_DATA_MISS) - data_misses_before;
+    ASSERT_GT(data_misses, 0);
+    ASSERT_EQ(data_misses, Ticker(rocksdb::BLOCK_CACHE_COMPRESSED_HIT) - compressed_hits_before);
+    ASSERT_EQ(compressed_misses_before, Ticker(rocksdb::BLOCK_CACHE_COMPRESSED_MISS));
+  }
+
+  tablet::TabletOptions* tablet_options_ = nullptr;
+  tablet::Tablet* tablet_ = nullptr;
+};
+
+// Data blocks evicted from the block cache should be served from the compressed block cache,
+// without reading them from disk.
+TEST_F(TsTabletManagerCompressedBlockCacheTest, ServeEvictedBlocksFromCompressedCache) {
+  ASSERT_NO_FATALS(WriteRows("old"));
+  ASSERT_OK(tablet_->Flush(tablet::FlushMode::kSync));
+
+  // The first read brings data blocks from disk to both caches.
+  std::vector<std::string> rows;
+  ASSERT_NO_FATALS(ReadAllRows(&rows));
+  ASSERT_GT(Ticker(rocksdb::BLOCK_CACHE_COMPRESSED_ADD), 0);
+
+  std::vector<std::string> cached_rows;
+  ASSERT_NO_FATALS(ReadThroughCompressedCache(&cached_rows));
+  ASSERT_EQ(rows, cached_rows);
+}
+
+// Files written by flushes and compactions are not put into the compressed block cache. Reads of
+// the compacted data should get the blocks of the new file, with the latest values.
+TEST_F(TsTabletManagerCompressedBlockCacheTest, ReadCompactedDataThroughCompressedCache) {
+  ASSERT_NO_FATALS(WriteRows("old"));
+  ASSERT_OK(tablet_->Flush(tablet::FlushMode::kSync));
+  std::vector<std::string> rows;
+  ASSERT_NO_FATALS(ReadAllRows(&rows));
+  ASSERT_NO_FATALS(ReadThroughCompressedCache(&rows));
+
+  // Overwrite every row and flush, so the compaction has to merge both files.
+  ASSERT_NO_FATALS(WriteRows("new"));
+  ASSERT_OK(tablet_->Flush(tablet::FlushMode::kSync));
+  tablet_->ForceRocksDBCompactInTest();
+  ASSERT_EQ(1U, tablet_->GetCurrentVersionNumSSTFiles());
+  const auto compressed_adds_before = Ticker(rocksdb::BLOCK_CACHE_COMPRESSED_ADD);
+
+  // The first read of the compacted file misses the compressed block cache and fills it.
+  ASSERT_NO_FATALS(ReadAllRows(&rows));
+  ASSERT_GT(Ticker(rocksdb::BLOCK_CACHE_COMPRESSED_ADD), compressed_adds_before);
+
+  std::vector<std::string> cached_rows;
+  ASSERT_NO_FATALS(ReadThroughCompressedCache(&cached_rows));
+  ASSERT_EQ(rows, cached_rows);
+  for (int i = 0; i != kNumRows; ++i) {
+    const auto new_value = Value("new", i);
+    ASSERT_EQ(1, std::count_if(cached_rows.begin(), cached_rows.end(), [&](const auto& row) {
+      return row.find(new_value) != std::string::npos;
+    })) << "Value not found: " << new_value;
+  }
+}
+
 static void AssertMonotonicReportSeqno(int64_t* report_seqno,
                                        const TabletReportPB &report) {
   ASSERT_LT(*report_seqno, report.sequence_number());
@@ -76,6 +76,7 @@
 #include "yb/tablet/tablet_metadata.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tablet/tablet_options.h"
+#include "yb/tablet/transaction_status_resolver.h"
 
 #include "yb/tserver/heartbeater.h"
 #include "yb/tserver/remote_bootstrap_client.h"
@@ -186,6 +187,11 @@ DEFINE_int32(db_block_cache_size_percentage, 50,
              "Default percentage of total available memory to use as block cache size, if not "
              "asking for a raw number, through FLAGS_db_block_cache_size_bytes.");
 
+DEFINE_int64(db_compressed_block_cache_size_bytes, 0,
+             "Size of cross-tablet shared RocksDB cache of compressed data blocks (in bytes). "
+             "It is consulted on block cache misses before reading the block from disk, and its "
+             "memory is in addition to the block cache size. 0 disables compressed block cache.");
+
 DEFINE_int32(read_pool_max_threads, 128,
              "The maximum number of threads allowed for read_pool_. This pool is used "
              "to run multiple read operations, that are part of the same tablet rpc, "
@@ -436,8 +442,29 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
     block_cache_size_bytes = total_ram_avail * FLAGS_db_block_cache_size_percentage / 100;
   }
 
+  int64_t compressed_block_cache_size_bytes = 0;
+  if (FLAGS_db_block_cache_size_bytes != kDbCacheSizeCacheDisabled) {
+    compressed_block_cache_size_bytes = std::max<int64_t>(
+        FLAGS_db_compressed_block_cache_size_bytes, 0);
+  }
+
+  // Compressed blocks are charged to the same memory tracker as uncompressed ones.
   block_based_table_mem_tracker_ = MemTracker::FindOrCreateTracker(
-      block_cache_size_bytes, "BlockBasedTable", server_->mem_tracker());
+      block_cache_size_bytes + compressed_block_cache_size_bytes, "BlockBasedTable",
+      server_->mem_tracker());
+
+  if (compressed_block_cache_size_bytes > 0) {
+    tablet_options_.block_cache_compressed = rocksdb::NewLRUCache(
+        compressed_block_cache_size_bytes, FLAGS_db_block_cache_num_shard_bits);
+    // Separate entity, so compressed block cache has its own block_cache_* metrics.
+    compressed_block_cache_metric_entity_ = METRIC_ENTITY_server.Instantiate(
+        server_->metric_registry(), server_->metric_entity()->id() + ".compressed_block_cache");
+    tablet_options_.block_cache_compressed->SetMetrics(compressed_block_cache_metric_entity_);
+    // Registered first, so compressed blocks are evicted before uncompressed ones.
+    compressed_block_cache_gc_ = std::make_shared<LRUCacheGC>(
+        tablet_options_.block_cache_compressed);
+    block_based_table_mem_tracker_->AddGarbageCollector(compressed_block_cache_gc_);
+  }
 
   if (FLAGS_db_block_cache_size_bytes != kDbCacheSizeCacheDisabled) {
     tablet_options_.block_cache = rocksdb::NewLRUCache(block_cache_size_bytes,
@@ -491,6 +518,8 @@ Status TSTabletManager::Init() {
       FLAGS_tserver_yb_client_default_timeout_ms / 1000, "" /* tserver_uuid */,
       &server_->options(), server_->metric_entity(), server_->mem_tracker(),
       server_->messenger());
+  transaction_status_resolver_ = std::make_unique<tablet::TransactionStatusResolver>(
+      async_client_init_->get_client_future(), server::ClockPtr(server_->clock()));
 
   tablet_options_.env = server_->GetEnv();
   tablet_options_.rocksdb_env = server_->GetRocksDBEnv();
@@ -833,7 +862,8 @@ Status TSTabletManager::StartRemoteBootstrap(const StartRemoteBootstrapRequestPB
   LOG(INFO) << init_msg;
   TRACE(init_msg);
 
-  auto rb_client = std::make_unique<RemoteBootstrapClient>(tablet_id, fs_manager_);
+  auto rb_client = std::make_unique<RemoteBootstrapClient>(
+      tablet_id, fs_manager_, server_->metric_entity());
 
   // Download and persist the remote superblock in TABLET_DATA_COPYING state.
   if (replacing_tablet) {
@@ -923,7 +953,7 @@ Result<TabletPeerPtr> TSTabletManager::CreateAndRegisterTabletPeer(
   TabletPeerPtr tablet_peer(new tablet::TabletPeer(
       meta, local_peer_pb_, scoped_refptr<server::Clock>(server_->clock()), fs_manager_->uuid(),
       Bind(&TSTabletManager::ApplyChange, Unretained(this), meta->raft_group_id()),
-      metric_registry_));
+      metric_registry_, transaction_status_resolver_.get()));
   RETURN_NOT_OK(RegisterTablet(meta->raft_group_id(), tablet_peer, mode));
   return tablet_peer;
 }
@@ -1213,6 +1243,11 @@ void TSTabletManager::StartShutdown() {
       shutting_down_peers_.push_back(peer);
     }
   }
+
+  // Fails status lookups in flight, so shutting down participants don't wait for them.
+  if (transaction_status_resolver_) {
+    transaction_status_resolver_->Shutdown();
+  }
 }
 
 void TSTabletManager::CompleteShutdown() {
@@ -487,13 +487,19 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
 
   boost::optional<yb::client::AsyncClientInitialiser> async_client_init_;
 
+  // Shared by transaction participants of all tablets, to batch their status requests.
+  std::unique_ptr<tablet::TransactionStatusResolver> transaction_status_resolver_;
+
   TabletPeers shutting_down_peers_;
 
   std::shared_ptr<GarbageCollector> block_based_table_gc_;
+  std::shared_ptr<GarbageCollector> compressed_block_cache_gc_;
   std::shared_ptr<GarbageCollector> log_cache_gc_;
 
   std::shared_ptr<MemTracker> block_based_table_mem_tracker_;
 
+  scoped_refptr<MetricEntity> compressed_block_cache_metric_entity_;
+
   DISALLOW_COPY_AND_ASSIGN(TSTabletManager);
 };
 
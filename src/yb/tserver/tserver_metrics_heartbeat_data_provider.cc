@@ -15,6 +15,7 @@
 
 #include "yb/master/master.pb.h"
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
@@ -42,19 +43,48 @@ void TServerMetricsHeartbeatDataProvider::DoAddData(master::TSHeartbeatRequestPB
   metrics->set_total_ram_usage(static_cast<int64_t>(mem_usage));
   VLOG_WITH_PREFIX(4) << "Total Memory Usage: " << mem_usage;
 
+  MonoDelta diff = CoarseMonoClock::Now() - prev_run_time();
+  double_t div = diff.ToSeconds();
+
   uint64_t total_file_sizes = 0;
   uint64_t uncompressed_file_sizes = 0;
   uint64_t num_files = 0;
+  // Loads of individual tablets are used only by the load balancer, when it is configured so.
+  const bool report_tablet_loads = server().report_tablet_loads();
+  std::unordered_map<TabletId, TabletOps> tablet_ops;
   for (const auto& tablet_peer : server().tablet_manager()->GetTabletPeers()) {
     if (tablet_peer) {
       auto tablet = tablet_peer->shared_tablet();
       if (tablet) {
-        total_file_sizes += tablet->GetCurrentVersionSstFilesSize();
+        const uint64_t sst_file_size = tablet->GetCurrentVersionSstFilesSize();
+        total_file_sizes += sst_file_size;
         uncompressed_file_sizes += tablet->GetCurrentVersionSstFilesUncompressedSize();
         num_files += tablet->GetCurrentVersionNumSSTFiles();
+        if (!report_tablet_loads) {
+          continue;
+        }
+
+        // Used by the load balancer to weigh each replica of the tablet.
+        const auto* tablet_metrics = tablet->metrics();
+        TabletOps ops = {
+          tablet_metrics->ql_read_latency->TotalCount() +
+              tablet_metrics->redis_read_latency->TotalCount(),
+          tablet_metrics->write_op_duration_client_propagated_consistency->TotalCount() +
+              tablet_metrics->write_op_duration_commit_wait_consistency->TotalCount()
+        };
+        auto* tablet_load = metrics->add_tablet_loads();
+        tablet_load->set_tablet_id(tablet->tablet_id());
+        tablet_load->set_sst_file_size(sst_file_size);
+        auto prev_it = prev_tablet_ops_.find(tablet->tablet_id());
+        if (div > 0 && prev_it != prev_tablet_ops_.end()) {
+          tablet_load->set_read_ops_per_sec((ops.reads - prev_it->second.reads) / div);
+          tablet_load->set_write_ops_per_sec((ops.writes - prev_it->second.writes) / div);
+        }
+        tablet_ops.emplace(tablet->tablet_id(), ops);
       }
     }
   }
+  prev_tablet_ops_ = std::move(tablet_ops);
   metrics->set_total_sst_file_size(total_file_sizes);
   metrics->set_uncompressed_sst_file_size(uncompressed_file_sizes);
   metrics->set_num_sst_files(num_files);
@@ -69,9 +99,6 @@ void TServerMetricsHeartbeatDataProvider::DoAddData(master::TSHeartbeatRequestPB
   uint64_t num_writes = (writes_hist != nullptr) ? writes_hist->TotalCount() : 0;
 
   // Calculate the read and write ops per second.
-  MonoDelta diff = CoarseMonoClock::Now() - prev_run_time();
-  double_t div = diff.ToSeconds();
-
   double rops_per_sec = (div > 0 && num_reads > 0) ?
       (static_cast<double>(num_reads - prev_reads_) / div) : 0;
 
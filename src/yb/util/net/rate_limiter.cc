@@ -58,17 +58,27 @@ uint64_t RateLimiter::GetRate() {
 }
 
 void RateLimiter::UpdateDataSizeAndMaybeSleep(uint64_t data_size) {
+  SleepFor(UpdateDataSize(data_size));
+}
+
+MonoDelta RateLimiter::UpdateDataSize(uint64_t data_size) {
   auto now = MonoTime::Now();
-  auto elapsed = now.GetDeltaSince(end_time_);
-  end_time_ = now;
+  // end_time_ is in the future while delays returned by previous calls have not passed yet, then
+  // this transmission is accounted after them.
+  MonoDelta elapsed = MonoDelta::kZero;
+  if (end_time_ < now) {
+    elapsed = now.GetDeltaSince(end_time_);
+    end_time_ = now;
+  }
   total_bytes_ += data_size;
   UpdateRate();
-  UpdateTimeSlotSizeAndMaybeSleep(data_size, elapsed);
+  end_time_ += UpdateTimeSlotSize(data_size, elapsed);
+  return end_time_.GetDeltaSince(now);
 }
 
-void RateLimiter::UpdateTimeSlotSizeAndMaybeSleep(uint64_t data_size, MonoDelta elapsed) {
+MonoDelta RateLimiter::UpdateTimeSlotSize(uint64_t data_size, MonoDelta elapsed) {
   if (!active()) {
-    return;
+    return MonoDelta::kZero;
   }
 
   // If the rate is greater than target_rate_, sleep until both rates are equal.
@@ -79,18 +89,17 @@ void RateLimiter::UpdateTimeSlotSizeAndMaybeSleep(uint64_t data_size, MonoDelta
             << " elapsed=" << elapsed.ToMilliseconds()
             << " received size=" << data_size
             << " and sleeping for=" << sleep_time;
-    SleepFor(MonoDelta::FromMilliseconds(sleep_time));
 #if defined(OS_MACOSX)
     total_time_slept_ += MonoDelta::FromMilliseconds(sleep_time);
 #endif
-    end_time_ = MonoTime::Now();
     // If we slept for more than 80% of time_slot_ms_, reduce the size of this time slot.
     if (sleep_time > time_slot_ms_ * 80 / 100) {
       time_slot_ms_ = std::max(min_time_slot_, time_slot_ms_ / 2);
     }
-  } else {
-    time_slot_ms_ = std::min(max_time_slot_, time_slot_ms_ * 2);
+    return MonoDelta::FromMilliseconds(sleep_time);
   }
+  time_slot_ms_ = std::min(max_time_slot_, time_slot_ms_ * 2);
+  return MonoDelta::kZero;
 }
 
 void RateLimiter::UpdateRate() {
@@ -150,8 +159,9 @@ Status RateLimiter::SendOrReceiveData(std::function<Status()> send_rcv_func,
   if (status.ok()) {
     auto data_size = reply_size_func();
     total_bytes_ += data_size;
+    auto sleep_time = UpdateTimeSlotSize(data_size, elapsed);
+    SleepFor(sleep_time);
     end_time_ = MonoTime::Now();
-    UpdateTimeSlotSizeAndMaybeSleep(data_size, elapsed);
   }
   return status;
 }
@@ -58,6 +58,11 @@ class RateLimiter {
   // than the rate provided by target_rate_updater_.
   void UpdateDataSizeAndMaybeSleep(uint64_t data_size);
 
+  // Same as UpdateDataSizeAndMaybeSleep, but returns the time to sleep instead of sleeping. So it
+  // could be called under a lock, while the caller sleeps after releasing it. Delays returned to
+  // concurrent callers are accumulated.
+  MonoDelta UpdateDataSize(uint64_t data_size);
+
   void Init();
 
   // We can only have an active rate limiter if the user has provided a function to update the rate.
@@ -81,7 +86,8 @@ class RateLimiter {
 
  private:
   void UpdateRate();
-  void UpdateTimeSlotSizeAndMaybeSleep(uint64_t data_size, MonoDelta elapsed);
+  // Returns the time to sleep after transmission of data_size bytes in elapsed time.
+  MonoDelta UpdateTimeSlotSize(uint64_t data_size, MonoDelta elapsed);
   uint64_t GetSizeForNextTimeSlot();
 
   bool init_ = false;
@@ -63,6 +63,11 @@ class TaskStream {
 
   CHECKED_STATUS Submit(T* item);
 
+  // Sets the function that is called after the items of a group were processed, before the end of
+  // the group is signaled. If it returns a positive delta, the task stream waits that long for more
+  // items and adds them to the current group. Should be set before the first Submit.
+  void SetGroupWait(std::function<MonoDelta()> group_wait);
+
   CHECKED_STATUS TEST_SubmitFunc(const std::function<void()>& func);
 
  private:
@@ -85,6 +90,7 @@ class TaskStreamImpl {
   void Stop();
 
   CHECKED_STATUS Submit(T* task);
+  void SetGroupWait(std::function<MonoDelta()> group_wait);
   CHECKED_STATUS TEST_SubmitFunc(const std::function<void()>& func);
 
  private:
@@ -112,6 +118,7 @@ class TaskStreamImpl {
 
   std::unique_ptr<ThreadPoolToken> taskstream_pool_token_;
   std::function<void(T*)> process_item_;
+  std::function<MonoDelta()> group_wait_;
 
   // Maximum time to wait for the queue to become non-empty.
   const MonoDelta queue_max_wait_;
@@ -177,6 +184,11 @@ template <typename T> Status TaskStreamImpl<T>::Submit(T *task) {
   return taskstream_pool_token_->SubmitFunc(std::bind(&TaskStreamImpl::Run, this));
 }
 
+template <typename T>
+void TaskStreamImpl<T>::SetGroupWait(std::function<MonoDelta()> group_wait) {
+  group_wait_ = std::move(group_wait);
+}
+
 template <typename T>
 Status TaskStreamImpl<T>::TEST_SubmitFunc(const std::function<void()>& func) {
   return taskstream_pool_token_->SubmitFunc(func);
@@ -192,8 +204,20 @@ template <typename T> void TaskStreamImpl<T>::Run() {
       for (T* item : group) {
         ProcessItem(item);
       }
-      ProcessItem(nullptr);
       group.clear();
+      // Let items that arrive shortly join the current group, if requested.
+      while (group_wait_ && !stop_requested_.load(std::memory_order_acquire)) {
+        const MonoDelta group_wait = group_wait_();
+        if (group_wait <= MonoDelta::kZero ||
+            !queue_.BlockingDrainTo(&group, MonoTime::Now() + group_wait) || group.empty()) {
+          break;
+        }
+        for (T* item : group) {
+          ProcessItem(item);
+        }
+        group.clear();
+      }
+      ProcessItem(nullptr);
       continue;
     }
     // Not processing and queue empty, return from task.
@@ -250,6 +274,10 @@ template <typename T> Status TaskStream<T>::Submit(T* item) {
   return impl_->Submit(item);
 }
 
+template <typename T> void TaskStream<T>::SetGroupWait(std::function<MonoDelta()> group_wait) {
+  impl_->SetGroupWait(std::move(group_wait));
+}
+
 template <typename T> Status TaskStream<T>::TEST_SubmitFunc(const std::function<void()>& func) {
   return impl_->TEST_SubmitFunc(func);
 }
@@ -24,6 +24,7 @@
 #include "yb/rpc/rpc_context.h"
 
 #include "yb/util/crypt.h"
+#include "yb/util/flag_tags.h"
 
 #include "yb/yql/cql/cqlserver/cql_service.h"
 
@@ -71,6 +72,24 @@ METRIC_DEFINE_counter(server, cql_processors_created,
                       yb::MetricUnit::kUnits,
                       "Number of created CQL Processors.");
 
+METRIC_DEFINE_counter(server, cql_auto_parameterized_stmts_cache_hits,
+                      "Number of unprepared queries executed using cached statements.",
+                      yb::MetricUnit::kRequests,
+                      "Number of unprepared queries executed using statements cached for their "
+                      "normalized text.");
+
+METRIC_DEFINE_counter(server, cql_auto_parameterized_stmts_cache_misses,
+                      "Number of unprepared queries whose statements were not cached.",
+                      yb::MetricUnit::kRequests,
+                      "Number of unprepared queries whose normalized text had to be parsed and "
+                      "analyzed.");
+
+DEFINE_bool(cql_auto_parameterize_queries, true,
+            "Replace literals of unprepared DML queries with bind variables and reuse the parse "
+            "tree cached for the normalized query text.");
+TAG_FLAG(cql_auto_parameterize_queries, runtime);
+TAG_FLAG(cql_auto_parameterize_queries, advanced);
+
 DECLARE_bool(use_cassandra_authentication);
 
 namespace yb {
@@ -128,6 +147,10 @@ CQLMetrics::CQLMetrics(const scoped_refptr<yb::MetricEntity>& metric_entity)
       METRIC_yb_cqlserver_CQLServerService_ParsingErrors.Instantiate(metric_entity);
   cql_processors_alive_ = METRIC_cql_processors_alive.Instantiate(metric_entity, 0);
   cql_processors_created_ = METRIC_cql_processors_created.Instantiate(metric_entity);
+  auto_parameterized_stmts_cache_hits_ =
+      METRIC_cql_auto_parameterized_stmts_cache_hits.Instantiate(metric_entity);
+  auto_parameterized_stmts_cache_misses_ =
+      METRIC_cql_auto_parameterized_stmts_cache_misses.Instantiate(metric_entity);
 }
 
 //------------------------------------------------------------------------------------------------
@@ -211,6 +234,8 @@ void CQLProcessor::SendResponse(const CQLResponse& response) {
   request_ = nullptr;
   stmts_.clear();
   parse_trees_.clear();
+  auto_parameterized_stmt_ = nullptr;
+  auto_parameterized_params_ = nullptr;
   SetCurrentSession(nullptr);
   service_impl_->ReturnProcessor(pos_);
 }
@@ -318,10 +343,67 @@ CQLResponse* CQLProcessor::ProcessRequest(const ExecuteRequest& req) {
 
 CQLResponse* CQLProcessor::ProcessRequest(const QueryRequest& req) {
   VLOG(1) << "QUERY " << req.query();
+  if (FLAGS_cql_auto_parameterize_queries && ExecuteAutoParameterized(req)) {
+    return nullptr;
+  }
   RunAsync(req.query(), req.params(), statement_executed_cb_);
   return nullptr;
 }
 
+bool CQLProcessor::ExecuteAutoParameterized(const QueryRequest& req) {
+  if (!req.params().values.empty()) {
+    return false;
+  }
+  string normalized;
+  std::vector<ql::StatementLiteral> literals;
+  if (!ql::NormalizeStatement(req.query(), &normalized, &literals)) {
+    return false;
+  }
+
+  // Allocate and prepare the statement the same way PREPARE does, so concurrent queries with the
+  // same normalized text parse and analyze it only once.
+  const string& keyspace = ql_env_.CurrentKeyspace();
+  const auto query_id = CQLStatement::GetQueryId(keyspace, normalized);
+  if (service_impl_->IsAutoParameterizedStatementRejected(query_id)) {
+    return false;
+  }
+  const shared_ptr<CQLStatement> stmt = service_impl_->AllocateAutoParameterizedStatement(
+      query_id, keyspace, normalized);
+  IncrementCounter(stmt->unprepared() ? cql_metrics_->auto_parameterized_stmts_cache_misses_
+                                      : cql_metrics_->auto_parameterized_stmts_cache_hits_);
+  Status s = stmt->Prepare(this, service_impl_->auto_parameterized_stmts_mem_tracker());
+  if (!s.ok()) {
+    // The normalized text could be rejected while the original one is valid, e.g. when a literal
+    // is used where a bind variable is not allowed. Executing the original text reports the same
+    // error otherwise. The failure is remembered, so such queries are not parsed twice.
+    VLOG(2) << "Failed to prepare normalized query " << normalized << ": " << s;
+    service_impl_->RejectAutoParameterizedStatement(stmt);
+    return false;
+  }
+
+  std::vector<QLValue> values;
+  s = stmt->BindLiterals(literals, &values);
+  if (!s.ok()) {
+    VLOG(2) << "Failed to bind literals of query " << req.query() << ": " << s;
+    if (stmt->stale()) {
+      service_impl_->DeleteAutoParameterizedStatement(stmt);
+    }
+    return false;
+  }
+
+  stmt->clear_reparsed();
+  auto_parameterized_stmt_ = stmt;
+  auto_parameterized_params_ = std::make_unique<ql::NormalizedStatementParameters>(
+      req.params(), std::move(values));
+  s = stmt->ExecuteAsync(this, *auto_parameterized_params_, statement_executed_cb_);
+  if (!s.ok()) {
+    auto_parameterized_stmt_ = nullptr;
+    auto_parameterized_params_ = nullptr;
+    return false;
+  }
+  return true;
+}
+
 CQLResponse* CQLProcessor::ProcessRequest(const BatchRequest& req) {
   VLOG(1) << "BATCH " << req.queries().size();
 
@@ -403,6 +485,11 @@ CQLResponse* CQLProcessor::ProcessError(const Status& s,
     ErrorCode ql_errcode = GetErrorCode(s);
     if (ql_errcode == ErrorCode::UNPREPARED_STATEMENT ||
         ql_errcode == ErrorCode::STALE_METADATA) {
+      // The client does not know the auto-parameterized statement, so it is never reported as
+      // unprepared. Drop it if stale and let the query be retried below.
+      if (auto_parameterized_stmt_ != nullptr && auto_parameterized_stmt_->stale()) {
+        service_impl_->DeleteAutoParameterizedStatement(auto_parameterized_stmt_);
+      }
       // Delete all stale prepared statements from our cache. Since CQL protocol allows only one
       // unprepared query id to be returned, we will return just the last unprepared / stale one
       // we found.
@@ -424,6 +511,8 @@ CQLResponse* CQLProcessor::ProcessError(const Status& s,
       if (++retry_count_ == 1) {
         stmts_.clear();
         parse_trees_.clear();
+        auto_parameterized_stmt_ = nullptr;
+        auto_parameterized_params_ = nullptr;
         Reschedule(&process_request_task_.Bind(this));
         return nullptr;
       }
@@ -50,6 +50,10 @@ class CQLMetrics : public ql::QLMetrics {
 
   scoped_refptr<AtomicGauge<int64_t>> cql_processors_alive_;
   scoped_refptr<Counter> cql_processors_created_;
+
+  // Lookups of unprepared queries in the auto-parameterized statements cache.
+  scoped_refptr<Counter> auto_parameterized_stmts_cache_hits_;
+  scoped_refptr<Counter> auto_parameterized_stmts_cache_misses_;
 };
 
 
@@ -85,6 +89,10 @@ class CQLProcessor : public ql::QLProcessor {
   CQLResponse* ProcessRequest(const AuthResponseRequest& req);
   CQLResponse* ProcessRequest(const RegisterRequest& req);
 
+  // Execute an unprepared query using the cached statement of its normalized text. Returns false
+  // when the query should be parsed and executed as is.
+  bool ExecuteAutoParameterized(const QueryRequest& req);
+
   // Get a prepared statement and adds it to the set of statements currently being executed.
   std::shared_ptr<const CQLStatement> GetPreparedStatement(const CQLMessage::QueryId& id);
 
@@ -117,6 +125,10 @@ class CQLProcessor : public ql::QLProcessor {
   std::unordered_set<std::shared_ptr<const CQLStatement>> stmts_;
   std::unordered_set<ql::ParseTree::UniPtr> parse_trees_;
 
+  // Auto-parameterized statement of the current query and the parameters binding its literals.
+  std::shared_ptr<const CQLStatement> auto_parameterized_stmt_;
+  std::unique_ptr<ql::NormalizedStatementParameters> auto_parameterized_params_;
+
   // Current retry count.
   int retry_count_ = 0;
 
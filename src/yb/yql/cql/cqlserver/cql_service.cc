@@ -30,6 +30,7 @@
 #include "yb/tserver/tablet_server.h"
 
 #include "yb/util/bytes_formatter.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/mem_tracker.h"
 
 using namespace std::placeholders;
@@ -40,6 +41,19 @@ DECLARE_bool(use_cassandra_authentication);
 DEFINE_int64(cql_service_max_prepared_statement_size_bytes, 128_MB,
              "The maximum amount of memory the CQL proxy should use to maintain prepared "
              "statements. 0 or negative means unlimited.");
+DEFINE_int64(cql_service_max_auto_parameterized_statement_size_bytes, 64_MB,
+             "The maximum amount of memory the CQL proxy should use to maintain statements "
+             "prepared from the normalized text of unprepared queries. 0 or negative means "
+             "unlimited.");
+TAG_FLAG(cql_service_max_auto_parameterized_statement_size_bytes, advanced);
+DEFINE_int32(cql_service_max_rejected_auto_parameterized_statements, 1024,
+             "The maximum number of normalized query texts that failed to prepare, and are "
+             "remembered so unprepared queries with such text are executed without normalization.");
+TAG_FLAG(cql_service_max_rejected_auto_parameterized_statements, advanced);
+DEFINE_int32(cql_service_rejected_auto_parameterized_statement_ttl_ms, 60000,
+             "How long a normalized query text that failed to prepare is remembered. After that "
+             "it is tried again, e.g. when the table it refers to has been created.");
+TAG_FLAG(cql_service_rejected_auto_parameterized_statement_ttl_ms, advanced);
 DEFINE_int32(cql_ybclient_reactor_threads, 24,
              "The number of reactor threads to be used for processing ybclient "
              "requests originating in the cql layer");
@@ -81,6 +95,10 @@ CQLServiceImpl::CQLServiceImpl(CQLServer* server, const CQLServerOptions& opts,
       FLAGS_cql_service_max_prepared_statement_size_bytes > 0 ?
       FLAGS_cql_service_max_prepared_statement_size_bytes : -1,
       "CQL prepared statements", server->mem_tracker());
+  auto_parameterized_stmts_mem_tracker_ = MemTracker::CreateTracker(
+      FLAGS_cql_service_max_auto_parameterized_statement_size_bytes > 0 ?
+      FLAGS_cql_service_max_auto_parameterized_statement_size_bytes : -1,
+      "CQL auto-parameterized statements", server->mem_tracker());
 
   auth_prepared_stmt_ = std::make_shared<ql::Statement>(
       "",
@@ -120,6 +138,9 @@ const std::shared_ptr<client::YBMetaDataCache>& CQLServiceImpl::metadata_cache()
 
 void CQLServiceImpl::CompleteInit() {
   prepared_stmts_mem_tracker_->AddGarbageCollector(shared_from_this());
+  // The collector is a member of the service, so it shares the lifetime of the service.
+  auto_parameterized_stmts_mem_tracker_->AddGarbageCollector(
+      std::shared_ptr<GarbageCollector>(shared_from_this(), &auto_parameterized_stmts_gc_));
 }
 
 void CQLServiceImpl::Shutdown() {
@@ -271,6 +292,106 @@ void CQLServiceImpl::CollectGarbage(size_t required) {
           << ", memory usage = " << prepared_stmts_mem_tracker_->consumption();
 }
 
+shared_ptr<CQLStatement> CQLServiceImpl::AllocateAutoParameterizedStatement(
+    const CQLMessage::QueryId& query_id, const string& keyspace, const string& query) {
+  std::lock_guard<std::mutex> guard(auto_parameterized_stmts_mutex_);
+
+  // Same as prepared statements, concurrent queries with the same normalized text contend on the
+  // same statement placeholder, so the statement is parsed and analyzed only once.
+  auto itr = auto_parameterized_stmts_map_.find(query_id);
+  if (itr == auto_parameterized_stmts_map_.end()) {
+    itr = auto_parameterized_stmts_map_.emplace(
+        query_id, std::make_shared<CQLStatement>(
+            keyspace, query, auto_parameterized_stmts_list_.end())).first;
+    itr->second->set_pos(auto_parameterized_stmts_list_.insert(
+        auto_parameterized_stmts_list_.begin(), itr->second));
+  } else {
+    auto_parameterized_stmts_list_.splice(
+        auto_parameterized_stmts_list_.begin(), auto_parameterized_stmts_list_, itr->second->pos());
+  }
+  return itr->second;
+}
+
+void CQLServiceImpl::DeleteAutoParameterizedStatement(
+    const shared_ptr<const CQLStatement>& stmt) {
+  std::lock_guard<std::mutex> guard(auto_parameterized_stmts_mutex_);
+  DeleteAutoParameterizedStatementUnlocked(stmt);
+}
+
+void CQLServiceImpl::DeleteAutoParameterizedStatementUnlocked(
+    const shared_ptr<const CQLStatement> stmt) {
+  // The "stmt" parameter is not a ref intentionally, see DeletePreparedStatementUnlocked.
+  const auto itr = auto_parameterized_stmts_map_.find(stmt->query_id());
+  if (itr != auto_parameterized_stmts_map_.end() && itr->second == stmt) {
+    auto_parameterized_stmts_map_.erase(itr);
+  }
+  if (stmt->pos() != auto_parameterized_stmts_list_.end()) {
+    auto_parameterized_stmts_list_.erase(stmt->pos());
+    stmt->set_pos(auto_parameterized_stmts_list_.end());
+  }
+}
+
+bool CQLServiceImpl::IsAutoParameterizedStatementRejected(const CQLMessage::QueryId& query_id) {
+  std::lock_guard<std::mutex> guard(auto_parameterized_stmts_mutex_);
+  const auto itr = rejected_auto_parameterized_stmts_map_.find(query_id);
+  if (itr == rejected_auto_parameterized_stmts_map_.end()) {
+    return false;
+  }
+  if (itr->second->expiration <= CoarseMonoClock::Now()) {
+    rejected_auto_parameterized_stmts_list_.erase(itr->second);
+    rejected_auto_parameterized_stmts_map_.erase(itr);
+    return false;
+  }
+  return true;
+}
+
+void CQLServiceImpl::RejectAutoParameterizedStatement(const shared_ptr<const CQLStatement>& stmt) {
+  const auto query_id = stmt->query_id();
+  const auto expiration = CoarseMonoClock::Now() + std::chrono::milliseconds(
+      FLAGS_cql_service_rejected_auto_parameterized_statement_ttl_ms);
+  std::lock_guard<std::mutex> guard(auto_parameterized_stmts_mutex_);
+  DeleteAutoParameterizedStatementUnlocked(stmt);
+  if (FLAGS_cql_service_max_rejected_auto_parameterized_statements <= 0) {
+    return;
+  }
+
+  // Rejected texts are kept in the order of expiration, so the oldest one is evicted first.
+  auto itr = rejected_auto_parameterized_stmts_map_.find(query_id);
+  if (itr != rejected_auto_parameterized_stmts_map_.end()) {
+    itr->second->expiration = expiration;
+    rejected_auto_parameterized_stmts_list_.splice(
+        rejected_auto_parameterized_stmts_list_.end(), rejected_auto_parameterized_stmts_list_,
+        itr->second);
+    return;
+  }
+  while (rejected_auto_parameterized_stmts_map_.size() >= static_cast<size_t>(
+             FLAGS_cql_service_max_rejected_auto_parameterized_statements)) {
+    rejected_auto_parameterized_stmts_map_.erase(
+        rejected_auto_parameterized_stmts_list_.front().query_id);
+    rejected_auto_parameterized_stmts_list_.pop_front();
+  }
+  rejected_auto_parameterized_stmts_map_.emplace(
+      query_id, rejected_auto_parameterized_stmts_list_.insert(
+          rejected_auto_parameterized_stmts_list_.end(),
+          RejectedStatement{query_id, expiration}));
+}
+
+void CQLServiceImpl::AutoParameterizedStatementsGC::CollectGarbage(size_t required) {
+  service_->CollectAutoParameterizedStatementsGarbage(required);
+}
+
+void CQLServiceImpl::CollectAutoParameterizedStatementsGarbage(size_t required) {
+  std::lock_guard<std::mutex> guard(auto_parameterized_stmts_mutex_);
+
+  if (!auto_parameterized_stmts_list_.empty()) {
+    DeleteAutoParameterizedStatementUnlocked(auto_parameterized_stmts_list_.back());
+  }
+
+  VLOG(1) << "DeleteLruAutoParameterizedStatement: CQL auto-parameterized statement cache count = "
+          << auto_parameterized_stmts_map_.size() << "/" << auto_parameterized_stmts_list_.size()
+          << ", memory usage = " << auto_parameterized_stmts_mem_tracker_->consumption();
+}
+
 server::Clock* CQLServiceImpl::clock() {
   return server_->clock();
 }
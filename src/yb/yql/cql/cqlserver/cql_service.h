@@ -28,6 +28,7 @@
 #include "yb/yql/cql/cqlserver/cql_server_options.h"
 #include "yb/yql/cql/ql/statement.h"
 
+#include "yb/util/monotime.h"
 #include "yb/util/string_case.h"
 
 #include "yb/client/async_initializer.h"
@@ -79,6 +80,27 @@ class CQLServiceImpl : public CQLServerServiceIf,
     return prepared_stmts_mem_tracker_;
   }
 
+  // Allocate a statement for the normalized text of an unprepared query. If the statement already
+  // exists, return it instead. These statements are cached apart from the prepared ones, so
+  // unprepared queries never evict statements that clients have prepared explicitly.
+  std::shared_ptr<CQLStatement> AllocateAutoParameterizedStatement(
+      const CQLMessage::QueryId& id, const std::string& keyspace, const std::string& query);
+
+  // Delete the auto-parameterized statement from the cache.
+  void DeleteAutoParameterizedStatement(const std::shared_ptr<const CQLStatement>& stmt);
+
+  // Delete the auto-parameterized statement from the cache, because its normalized text failed to
+  // prepare, and remember its id for cql_service_rejected_auto_parameterized_statement_ttl_ms.
+  void RejectAutoParameterizedStatement(const std::shared_ptr<const CQLStatement>& stmt);
+
+  // Whether the normalized text with the given id recently failed to prepare.
+  bool IsAutoParameterizedStatementRejected(const CQLMessage::QueryId& id);
+
+  // Return the memory tracker for auto-parameterized statements.
+  const MemTrackerPtr& auto_parameterized_stmts_mem_tracker() const {
+    return auto_parameterized_stmts_mem_tracker_;
+  }
+
   // Return the YBClient to communicate with either master or tserver.
   client::YBClient* client() const;
 
@@ -118,6 +140,24 @@ class CQLServiceImpl : public CQLServerServiceIf,
   // Delete the least recently used prepared statement from the cache to free up memory.
   void CollectGarbage(size_t required) override;
 
+  // Garbage collector of auto-parameterized statements.
+  class AutoParameterizedStatementsGC : public GarbageCollector {
+   public:
+    explicit AutoParameterizedStatementsGC(CQLServiceImpl* service) : service_(service) {}
+
+    void CollectGarbage(size_t required) override;
+
+   private:
+    CQLServiceImpl* const service_;
+  };
+
+  // Delete an auto-parameterized statement from the cache and the LRU list.
+  // "auto_parameterized_stmts_mutex_" needs to be locked before this call.
+  void DeleteAutoParameterizedStatementUnlocked(const std::shared_ptr<const CQLStatement> stmt);
+
+  // Delete the least recently used auto-parameterized statement from the cache to free up memory.
+  void CollectAutoParameterizedStatementsGarbage(size_t required);
+
   // CQLServer of this service.
   CQLServer* const server_;
 
@@ -153,6 +193,25 @@ class CQLServiceImpl : public CQLServerServiceIf,
   // Tracker to measure and limit memory usage of prepared statements.
   MemTrackerPtr prepared_stmts_mem_tracker_;
 
+  // Auto-parameterized statements cache, LRU list (least recently used one at the end), the mutex
+  // that protects them and the tracker to measure and limit their memory usage.
+  CQLStatementMap auto_parameterized_stmts_map_;
+  CQLStatementList auto_parameterized_stmts_list_;
+  std::mutex auto_parameterized_stmts_mutex_;
+  MemTrackerPtr auto_parameterized_stmts_mem_tracker_;
+  AutoParameterizedStatementsGC auto_parameterized_stmts_gc_{this};
+
+  // Ids of normalized texts that failed to prepare, in the order of expiration. Protected by
+  // "auto_parameterized_stmts_mutex_".
+  struct RejectedStatement {
+    CQLMessage::QueryId query_id;
+    CoarseTimePoint expiration;
+  };
+  using RejectedStatementList = std::list<RejectedStatement>;
+  RejectedStatementList rejected_auto_parameterized_stmts_list_;
+  std::unordered_map<CQLMessage::QueryId, RejectedStatementList::iterator>
+      rejected_auto_parameterized_stmts_map_;
+
   // Metrics to be collected and reported.
   yb::rpc::RpcMethodMetrics metrics_;
 
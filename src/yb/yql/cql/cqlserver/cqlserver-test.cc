@@ -23,11 +23,15 @@
 
 #include "yb/gutil/strings/join.h"
 #include "yb/util/cast.h"
+#include "yb/util/metrics.h"
 #include "yb/util/net/net_util.h"
 #include "yb/util/test_util.h"
 
 DECLARE_bool(cql_server_always_send_events);
 
+METRIC_DECLARE_counter(cql_auto_parameterized_stmts_cache_hits);
+METRIC_DECLARE_counter(cql_auto_parameterized_stmts_cache_misses);
+
 namespace yb {
 namespace cqlserver {
 
@@ -37,6 +41,30 @@ using std::vector;
 using strings::Substitute;
 using yb::integration_tests::YBTableTestBase;
 
+namespace {
+
+constexpr size_t kHeaderLength = 9;
+constexpr char kErrorOpcode = 0x00;
+constexpr char kResultOpcode = 0x08;
+constexpr int32_t kRowsResultKind = 0x0002;
+
+void AppendInt32(int32_t value, string* out) {
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    out->push_back(static_cast<char>((value >> shift) & 0xff));
+  }
+}
+
+int32_t ReadInt32(const string& data, size_t pos) {
+  CHECK_LE(pos + 4, data.size());
+  uint32_t result = 0;
+  for (size_t i = pos; i != pos + 4; ++i) {
+    result = (result << 8) | static_cast<uint8_t>(data[i]);
+  }
+  return static_cast<int32_t>(result);
+}
+
+} // namespace
+
 class TestCQLService : public YBTableTestBase {
  public:
   void SetUp() override;
@@ -49,6 +77,16 @@ class TestCQLService : public YBTableTestBase {
 
   void SendRequestAndExpectResponse(const string& cmd, const string& resp);
 
+  // Sends a QUERY request with the given text and returns the opcode and the body of the response.
+  Result<std::pair<char, string>> SendQuery(const string& query);
+
+  // Sends a QUERY request and checks that it succeeded, returns the body of the RESULT response.
+  Result<string> ExecuteQuery(const string& query);
+
+  int64_t GetCounter(CounterPrototype& prototype) {
+    return prototype.Instantiate(server_->metric_entity())->value();
+  }
+
   int server_port() { return cql_server_port_; }
  private:
   Status SendRequestAndGetResponse(
@@ -147,6 +185,42 @@ void TestCQLService::SendRequestAndExpectResponse(const string& cmd, const strin
   CHECK_EQ(resp, string(reinterpret_cast<char*>(resp_), resp.length()));
 }
 
+Result<std::pair<char, string>> TestCQLService::SendQuery(const string& query) {
+  // QUERY request using version V4: query text, consistency ONE, no flags.
+  string body;
+  AppendInt32(static_cast<int32_t>(query.size()), &body);
+  body += query;
+  body += BINARY_STRING("\x00\x01" "\x00");
+  string request = BINARY_STRING("\x04\x00\x00\x00\x07");
+  AppendInt32(static_cast<int32_t>(body.size()), &request);
+  request += body;
+
+  int32_t bytes_written = 0;
+  RETURN_NOT_OK(client_sock_.Write(
+      util::to_uchar_ptr(request.c_str()), request.length(), &bytes_written));
+  SCHECK_EQ(static_cast<int32_t>(request.length()), bytes_written, IOError, "Short write");
+
+  const auto deadline = MonoTime::Now() + MonoDelta::FromSeconds(60);
+  string header(kHeaderLength, 0);
+  size_t bytes_read = 0;
+  RETURN_NOT_OK(client_sock_.BlockingRecv(
+      util::to_uchar_ptr(&header[0]), kHeaderLength, &bytes_read, deadline));
+  string response(ReadInt32(header, 5), 0);
+  if (!response.empty()) {
+    RETURN_NOT_OK(client_sock_.BlockingRecv(
+        util::to_uchar_ptr(&response[0]), response.size(), &bytes_read, deadline));
+  }
+  return std::make_pair(header[4], std::move(response));
+}
+
+Result<string> TestCQLService::ExecuteQuery(const string& query) {
+  auto response = VERIFY_RESULT(SendQuery(query));
+  if (response.first != kResultOpcode) {
+    return STATUS_FORMAT(RuntimeError, "Query $0 failed: $1", query, response.second);
+  }
+  return std::move(response.second);
+}
+
 // The following test cases test the CQL protocol marshalling/unmarshalling with hand-coded
 // request messages and expected responses. They are good as basic and error-handling tests.
 // These are expected to be few.
@@ -392,6 +466,86 @@ TEST_F(TestCQLService, SchemaChangeEvent) {
   TestSchemaChangeEvent();
 }
 
+// Unprepared queries that differ only in literals share the statement cached for their normalized
+// text.
+TEST_F(TestCQLService, AutoParameterizedQueries) {
+  // Send STARTUP request using version V4.
+  SendRequestAndExpectResponse(
+      BINARY_STRING("\x04\x00\x00\x00\x01" "\x00\x00\x00\x16"
+                    "\x00\x01" "\x00\x0b" "CQL_VERSION"
+                               "\x00\x05" "3.0.0"),
+      BINARY_STRING("\x84\x00\x00\x00\x02" "\x00\x00\x00\x00"));
+
+  auto& hits = METRIC_cql_auto_parameterized_stmts_cache_hits;
+  auto& misses = METRIC_cql_auto_parameterized_stmts_cache_misses;
+  // Reads the only row of a query that selects one int column.
+  auto select_int = [this](const string& query) -> Result<int32_t> {
+    const auto body = VERIFY_RESULT(ExecuteQuery(query));
+    SCHECK_GE(body.size(), 16U, IllegalState, "Result too short");
+    SCHECK_EQ(kRowsResultKind, ReadInt32(body, 0), IllegalState, "Rows expected");
+    SCHECK_EQ(1, ReadInt32(body, body.size() - 12), IllegalState, "One row expected");
+    SCHECK_EQ(4, ReadInt32(body, body.size() - 8), IllegalState, "Int value expected");
+    return ReadInt32(body, body.size() - 4);
+  };
+
+  for (const auto* keyspace : {"ks1", "ks2"}) {
+    ASSERT_OK(ExecuteQuery(Format(
+        "CREATE KEYSPACE $0 WITH REPLICATION = "
+        "{'class': 'SimpleStrategy', 'replication_factor': 1}", keyspace)));
+    ASSERT_OK(ExecuteQuery(Format("USE $0", keyspace)));
+    ASSERT_OK(ExecuteQuery("CREATE TABLE t (k int PRIMARY KEY, v int)"));
+  }
+
+  // The first query with the normalized text misses the cache, the rest hit it.
+  ASSERT_OK(ExecuteQuery("USE ks1"));
+  auto hits_before = GetCounter(hits);
+  auto misses_before = GetCounter(misses);
+  ASSERT_OK(ExecuteQuery("INSERT INTO t (k, v) VALUES (1, 10)"));
+  ASSERT_OK(ExecuteQuery("INSERT INTO t (k, v) VALUES (2, 20)"));
+  ASSERT_EQ(10, ASSERT_RESULT(select_int("SELECT v FROM t WHERE k = 1")));
+  ASSERT_EQ(20, ASSERT_RESULT(select_int("SELECT v FROM t WHERE k = 2")));
+  ASSERT_EQ(hits_before + 2, GetCounter(hits));
+  ASSERT_EQ(misses_before + 2, GetCounter(misses));
+
+  // The same text in another keyspace refers to another table, so it is cached separately.
+  ASSERT_OK(ExecuteQuery("USE ks2"));
+  hits_before = GetCounter(hits);
+  misses_before = GetCounter(misses);
+  ASSERT_OK(ExecuteQuery("INSERT INTO t (k, v) VALUES (1, 100)"));
+  ASSERT_EQ(100, ASSERT_RESULT(select_int("SELECT v FROM t WHERE k = 1")));
+  ASSERT_EQ(hits_before, GetCounter(hits));
+  ASSERT_EQ(misses_before + 2, GetCounter(misses));
+  ASSERT_OK(ExecuteQuery("USE ks1"));
+  ASSERT_EQ(10, ASSERT_RESULT(select_int("SELECT v FROM t WHERE k = 1")));
+  ASSERT_EQ(hits_before + 1, GetCounter(hits));
+
+  // The statement cached before ALTER TABLE is stale, the query is retried with the new schema.
+  const string select_all = "SELECT * FROM t WHERE k = 1";
+  auto body = ASSERT_RESULT(ExecuteQuery(select_all));
+  ASSERT_EQ(kRowsResultKind, ReadInt32(body, 0));
+  ASSERT_EQ(2, ReadInt32(body, 8));
+  ASSERT_OK(ExecuteQuery("ALTER TABLE t ADD w int"));
+  body = ASSERT_RESULT(ExecuteQuery(select_all));
+  ASSERT_EQ(kRowsResultKind, ReadInt32(body, 0));
+  ASSERT_EQ(3, ReadInt32(body, 8));
+  ASSERT_OK(ExecuteQuery("INSERT INTO t (k, v, w) VALUES (1, 11, 12)"));
+  ASSERT_EQ(11, ASSERT_RESULT(select_int("SELECT v FROM t WHERE k = 1")));
+  ASSERT_EQ(12, ASSERT_RESULT(select_int("SELECT w FROM t WHERE k = 1")));
+
+  // Failure to prepare the normalized text is remembered, so the next query with the same text is
+  // executed as is, and reports its own error.
+  const string missing_table = "SELECT v FROM missing WHERE k = 1";
+  hits_before = GetCounter(hits);
+  misses_before = GetCounter(misses);
+  for (int i = 0; i != 2; ++i) {
+    auto response = ASSERT_RESULT(SendQuery(missing_table));
+    ASSERT_EQ(kErrorOpcode, response.first);
+    ASSERT_STR_CONTAINS(response.second, "Object Not Found");
+  }
+  ASSERT_EQ(hits_before, GetCounter(hits));
+  ASSERT_EQ(misses_before + 1, GetCounter(misses));
+}
+
 class TestCQLServiceWithGFlag : public TestCQLService {
  public:
   void SetUp() override {
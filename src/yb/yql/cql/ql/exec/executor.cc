@@ -33,10 +33,17 @@
 
 #include "yb/rpc/thread_pool.h"
 #include "yb/util/decimal.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/random_util.h"
 #include "yb/util/thread_restrictions.h"
 #include "yb/util/trace.h"
+#include "yb/util/yb_partition.h"
+
+DEFINE_bool(cql_parallel_aggregate_scan, true,
+            "Whether aggregate SELECT over the whole table should read all tablets concurrently "
+            "instead of scanning them one after another.");
+TAG_FLAG(cql_parallel_aggregate_scan, advanced);
 
 namespace yb {
 namespace ql {
@@ -936,6 +943,12 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_conte
   select_op->set_yb_consistency_level(tnode->is_system() ? YBConsistencyLevel::STRONG
                                                          : params.yb_consistency_level());
 
+  // Full table aggregate is computed by all tablets concurrently, partial results are combined
+  // when all of them are received.
+  if (CanAggregateTabletsInParallel(tnode, *req, *tnode_context)) {
+    return AddTabletAggregateOperations(select_op, tnode_context);
+  }
+
   // If we have several hash partitions (i.e. IN condition on hash columns) we initialize the
   // start partition here, and then iteratively scan the rest in FetchMoreRows.
   // Otherwise, the request will already have the right hashed column values set.
@@ -1091,6 +1104,67 @@ Result<bool> Executor::FetchMoreRows(const PTSelectStmt* tnode,
   return true;
 }
 
+bool Executor::CanAggregateTabletsInParallel(const PTSelectStmt* tnode,
+                                             const QLReadRequestPB& req,
+                                             const TnodeContext& tnode_context) const {
+  if (!FLAGS_cql_parallel_aggregate_scan || !tnode->is_aggregate() || tnode->is_system() ||
+      tnode->child_select() || tnode->limit() || tnode->offset()) {
+    return false;
+  }
+
+  // Only scans that are not restricted to particular hash keys and do not continue a previous
+  // page are split by tablets.
+  if (!req.hashed_column_values().empty() || tnode_context.UnreadPartitionsRemaining() > 0 ||
+      req.has_paging_state()) {
+    return false;
+  }
+
+  const auto& table = tnode->table();
+  return table->partition_schema().IsHashPartitioning() && table->GetPartitions().size() > 1;
+}
+
+Status Executor::AddTabletAggregateOperations(const YBqlReadOpPtr& select_op,
+                                              TnodeContext* tnode_context) {
+  const auto& partitions = select_op->table()->GetPartitions();
+  const QLReadRequestPB& req = select_op->request();
+
+  // Respect the token range restriction of the statement, if any.
+  const uint32_t min_hash_code = req.has_hash_code() ? req.hash_code() : YBPartition::kMinHashCode;
+  const uint32_t max_hash_code = req.has_max_hash_code() ? req.max_hash_code()
+                                                         : YBPartition::kMaxHashCode;
+  size_t num_ops = 0;
+  for (size_t idx = 0; idx != partitions.size(); ++idx) {
+    uint32_t start = partitions[idx].empty()
+        ? YBPartition::kMinHashCode : PartitionSchema::DecodeMultiColumnHashValue(partitions[idx]);
+    uint32_t end = idx + 1 < partitions.size()
+        ? PartitionSchema::DecodeMultiColumnHashValue(partitions[idx + 1]) - 1
+        : YBPartition::kMaxHashCode;
+    start = std::max(start, min_hash_code);
+    end = std::min(end, max_hash_code);
+    if (start > end) {
+      continue;
+    }
+
+    YBqlReadOpPtr op(select_op->table()->NewQLSelect());
+    QLReadRequestPB* op_req = op->mutable_request();
+    op_req->CopyFrom(req);
+    op_req->set_hash_code(start);
+    op_req->set_max_hash_code(end);
+    // Each tablet returns a single row with partial aggregates, so the whole tablet is read by
+    // one request and there is nothing to page.
+    op_req->clear_limit();
+    op_req->clear_return_paging_state();
+    op->set_yb_consistency_level(select_op->yb_consistency_level());
+    RETURN_NOT_OK(AddOperation(op, tnode_context));
+    ++num_ops;
+  }
+
+  VLOG(3) << "Aggregating " << num_ops << " of " << partitions.size() << " tablets in parallel";
+  if (num_ops == 0) {
+    return AddOperation(select_op, tnode_context);
+  }
+  return Status::OK();
+}
 
 Result<bool> Executor::FetchRowsByKeys(const PTSelectStmt* tnode,
                                        const YBqlReadOpPtr& select_op,
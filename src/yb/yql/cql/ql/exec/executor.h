@@ -220,6 +220,16 @@ class Executor : public QLExprExecutor {
                              TnodeContext* tnode_context,
                              ExecContext* exec_context);
 
+  // Whether a full table aggregate could be computed by reading all tablets concurrently.
+  bool CanAggregateTabletsInParallel(const PTSelectStmt* tnode,
+                                     const QLReadRequestPB& req,
+                                     const TnodeContext& tnode_context) const;
+
+  // Add one read operation per tablet, restricted to hash codes of that tablet, so partial
+  // aggregates from all tablets are computed concurrently and combined in AggregateResultSets.
+  CHECKED_STATUS AddTabletAggregateOperations(const client::YBqlReadOpPtr& select_op,
+                                              TnodeContext* tnode_context);
+
   // Fetch rows for a select statement using primary keys selected from an uncovered index.
   Result<bool> FetchRowsByKeys(const PTSelectStmt* tnode,
                                const client::YBqlReadOpPtr& select_op,
@@ -48,7 +48,8 @@ const std::map<std::string, PTTableProperty::KVProperty> PTTableProperty::kPrope
     {"read_repair_chance", KVProperty::kReadRepairChance},
     {"speculative_retry", KVProperty::kSpeculativeRetry},
     {"transactions", KVProperty::kTransactions},
-    {"tablets", KVProperty::kNumTablets}
+    {"tablets", KVProperty::kNumTablets},
+    {"bloom_filter_range_components", KVProperty::kBloomFilterRangeComponents}
 };
 
 PTTableProperty::PTTableProperty(MemoryContext *memctx,
@@ -243,6 +244,24 @@ CHECKED_STATUS PTTableProperty::Analyze(SemContext *sem_context) {
             this, "Number of tablets exceeds system limit", ErrorCode::INVALID_ARGUMENTS);
       }
       break;
+    case KVProperty::kBloomFilterRangeComponents:
+      RETURN_SEM_CONTEXT_ERROR_NOT_OK(GetIntValueFromExpr(rhs_, table_property_name, &int_val));
+      if (int_val < 0) {
+        return sem_context->Error(this,
+                                  Substitute("$0 must be greater than or equal to 0 (got $1)",
+                                             table_property_name, std::to_string(int_val)).c_str(),
+                                  ErrorCode::INVALID_ARGUMENTS);
+      }
+      // Tablets pick their bloom filter when they are opened. Note that YCQL tables always have
+      // hash columns, so the property only takes effect for YSQL range-keyed tables, see
+      // docdb::BloomFilterRangeComponents.
+      if (sem_context->current_alter_table() != nullptr) {
+        return sem_context->Error(this,
+                                  Substitute("$0 could only be set when the table is created",
+                                             table_property_name).c_str(),
+                                  ErrorCode::INVALID_ARGUMENTS);
+      }
+      break;
   }
 
   PTAlterTable *alter_table = sem_context->current_alter_table();
@@ -408,6 +427,14 @@ Status PTTableProperty::SetTableProperty(yb::TableProperties *table_property) co
       }
       table_property->SetNumTablets(val);
       break;
+    case KVProperty::kBloomFilterRangeComponents: {
+      int64_t val;
+      if (!GetIntValueFromExpr(rhs_, table_property_name, &val).ok()) {
+        return STATUS(InvalidArgument, Substitute("Invalid value for $0", table_property_name));
+      }
+      table_property->SetBloomFilterRangeComponents(val);
+      break;
+    }
   }
   return Status::OK();
 }
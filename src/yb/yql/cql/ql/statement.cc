@@ -83,6 +83,40 @@ Result<const ParseTree&> Statement::GetParseTree() const {
   return static_cast<const ParseTree&>(*parse_tree_);
 }
 
+Status Statement::BindLiterals(const std::vector<StatementLiteral>& literals,
+                               std::vector<QLValue>* values) const {
+  const ParseTree& parse_tree = VERIFY_RESULT_REF(GetParseTree());
+  const TreeNode* stmt = parse_tree.root().get();
+  if (stmt == nullptr) {
+    return STATUS(InvalidArgument, "Empty statement");
+  }
+  switch (stmt->opcode()) {
+    case TreeNodeOpcode::kPTSelectStmt: FALLTHROUGH_INTENDED;
+    case TreeNodeOpcode::kPTInsertStmt: FALLTHROUGH_INTENDED;
+    case TreeNodeOpcode::kPTUpdateStmt: FALLTHROUGH_INTENDED;
+    case TreeNodeOpcode::kPTDeleteStmt:
+      break;
+    default:
+      return STATUS(NotSupported, "Literals could be bound to DML statements only");
+  }
+
+  const auto& bind_variables = static_cast<const PTDmlStmt*>(stmt)->bind_variables();
+  if (bind_variables.size() != literals.size()) {
+    return STATUS_FORMAT(InvalidArgument, "Statement has $0 bind variables, but $1 literals",
+                         bind_variables.size(), literals.size());
+  }
+  values->clear();
+  values->resize(literals.size());
+  for (const PTBindVar* var : bind_variables) {
+    const int64_t pos = var->pos();
+    if (pos < 0 || pos >= literals.size() || var->ql_type() == nullptr) {
+      return STATUS_FORMAT(InvalidArgument, "Unexpected bind variable at position $0", pos);
+    }
+    RETURN_NOT_OK(ConvertStatementLiteral(literals[pos], *var->ql_type(), &(*values)[pos]));
+  }
+  return Status::OK();
+}
+
 Status Statement::ExecuteAsync(QLProcessor* processor, const StatementParameters& params,
                                StatementExecutedCallback cb) const {
   const Result<const ParseTree&> parse_tree = GetParseTree();
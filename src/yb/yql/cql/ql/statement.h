@@ -19,6 +19,7 @@
 #define YB_YQL_CQL_QL_STATEMENT_H_
 
 #include "yb/yql/cql/ql/ptree/parse_tree.h"
+#include "yb/yql/cql/ql/util/statement_normalizer.h"
 #include "yb/yql/cql/ql/util/statement_params.h"
 #include "yb/yql/cql/ql/util/statement_result.h"
 
@@ -54,6 +55,11 @@ class Statement {
   // Validate and return the parse tree.
   Result<const ParseTree&> GetParseTree() const;
 
+  // Convert the literals stripped by NormalizeStatement from the text this statement was prepared
+  // from to the values of its bind variables.
+  CHECKED_STATUS BindLiterals(const std::vector<StatementLiteral>& literals,
+                              std::vector<QLValue>* values) const;
+
   // Is this statement unprepared?
   bool unprepared() const {
     return !prepared_.load(std::memory_order_acquire);
@@ -13,6 +13,7 @@
 #include "yb/common/ql_value.h"
 
 DECLARE_bool(test_tserver_timeout);
+DECLARE_bool(cql_parallel_aggregate_scan);
 
 using std::string;
 using std::unique_ptr;
@@ -1406,6 +1407,70 @@ TEST_F(QLTestSelectedExpr, TestTserverTimeout) {
   CHECK_INVALID_STMT("SELECT count(*) FROM test_table WHERE h = 1;");
 }
 
+TEST_F(QLTestSelectedExpr, TestParallelAggregate) {
+  // Init the simulated cluster.
+  ASSERT_NO_FATALS(CreateSimulatedCluster());
+
+  // Get a processor.
+  TestQLProcessor *processor = GetQLProcessor();
+  LOG(INFO) << "Test aggregates over several tablets read in parallel.";
+
+  CHECK_VALID_STMT("CREATE TABLE test_parallel_aggr(h int, r int, v1 bigint, v2 double,"
+                   "                                primary key(h, r)) WITH tablets = 4;");
+  constexpr int kNumKeys = 100;
+  int64_t v1_total = 0;
+  for (int i = 0; i < kNumKeys; i++) {
+    CHECK_VALID_STMT(strings::Substitute(
+        "INSERT INTO test_parallel_aggr(h, r, v1, v2) VALUES($0, $1, $2, $3);",
+        i, i % 3, i * 10, i + 0.5));
+    v1_total += i * 10;
+  }
+
+  const std::vector<std::string> kStatements = {
+    // All rows.
+    "SELECT count(*), sum(v1), min(v1), max(v1), sum(v2), min(v2), max(v2) "
+    "  FROM test_parallel_aggr;",
+    // Condition on a non-key column.
+    "SELECT count(*), sum(v1), min(v1), max(v1), sum(v2) "
+    "  FROM test_parallel_aggr WHERE v1 > 250;",
+    // Condition on a range column.
+    "SELECT count(v1), sum(v1), min(v2), max(v2) FROM test_parallel_aggr WHERE r = 1;",
+    // Token range covering part of the tablets.
+    "SELECT count(*), sum(v1), min(v1), max(v1) "
+    "  FROM test_parallel_aggr WHERE token(h) > 0;",
+    // Empty result.
+    "SELECT count(*), sum(v1), min(v1), max(v1), sum(v2) "
+    "  FROM test_parallel_aggr WHERE v1 > 1000000;",
+  };
+
+  std::vector<std::string> serial_results;
+  FLAGS_cql_parallel_aggregate_scan = false;
+  for (const auto& stmt : kStatements) {
+    CHECK_VALID_STMT(stmt);
+    serial_results.push_back(processor->row_block()->ToString());
+  }
+
+  FLAGS_cql_parallel_aggregate_scan = true;
+  for (size_t i = 0; i != kStatements.size(); ++i) {
+    CHECK_VALID_STMT(kStatements[i]);
+    std::shared_ptr<QLRowBlock> row_block = processor->row_block();
+    ASSERT_EQ(row_block->row_count(), 1) << kStatements[i];
+    ASSERT_EQ(serial_results[i], row_block->ToString()) << kStatements[i];
+
+    const QLRow& row = row_block->row(0);
+    if (i == 0) {
+      ASSERT_EQ(row.column(0).int64_value(), kNumKeys);
+      ASSERT_EQ(row.column(1).int64_value(), v1_total);
+      ASSERT_EQ(row.column(2).int64_value(), 0);
+      ASSERT_EQ(row.column(3).int64_value(), (kNumKeys - 1) * 10);
+    } else if (i == kStatements.size() - 1) {
+      ASSERT_EQ(row.column(0).int64_value(), 0);
+      ASSERT_TRUE(row.column(2).IsNull());
+      ASSERT_TRUE(row.column(3).IsNull());
+    }
+  }
+}
+
 TEST_F(QLTestSelectedExpr, ScanRangeTest) {
   // Init the simulated cluster.
   ASSERT_NO_FATALS(CreateSimulatedCluster());
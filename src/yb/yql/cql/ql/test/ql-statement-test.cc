@@ -39,8 +39,9 @@ class TestQLStatement : public QLTestBase {
     cb.Run(s);
   }
 
-  Status ExecuteAsync(Statement *stmt, QLProcessor *processor, Callback<void(const Status&)> cb) {
-    return stmt->ExecuteAsync(processor, StatementParameters(),
+  Status ExecuteAsync(Statement *stmt, QLProcessor *processor, Callback<void(const Status&)> cb,
+                      const StatementParameters& params = StatementParameters()) {
+    return stmt->ExecuteAsync(processor, params,
                               Bind(&TestQLStatement::ExecuteAsyncDone, Unretained(this), cb));
   }
 
@@ -121,5 +122,86 @@ TEST_F(TestQLStatement, TestPKIndices) {
   LOG(INFO) << "Done.";
 }
 
+TEST_F(TestQLStatement, TestNormalizeStatement) {
+  string normalized;
+  std::vector<StatementLiteral> literals;
+
+  ASSERT_TRUE(NormalizeStatement(
+      "SELECT * FROM t WHERE h = -1 AND r = 'a''b'\n  AND b = 0xcafe AND v >= 1.5e3;",
+      &normalized, &literals));
+  ASSERT_EQ("SELECT * FROM t WHERE h = ? AND r = ? AND b = ? AND v >= ?", normalized);
+  ASSERT_EQ(4, literals.size());
+  ASSERT_EQ(StatementLiteral::Kind::kInteger, literals[0].kind);
+  ASSERT_EQ("-1", literals[0].text);
+  ASSERT_EQ(StatementLiteral::Kind::kString, literals[1].kind);
+  ASSERT_EQ("a'b", literals[1].text);
+  ASSERT_EQ(StatementLiteral::Kind::kBinary, literals[2].kind);
+  ASSERT_EQ("cafe", literals[2].text);
+  ASSERT_EQ(StatementLiteral::Kind::kDecimal, literals[3].kind);
+  ASSERT_EQ("1.5e3", literals[3].text);
+
+  ASSERT_TRUE(NormalizeStatement(
+      "update ks.t2 set \"V 1\" = v2 - 1 where id = 123e4567-e89b-12d3-a456-426655440000",
+      &normalized, &literals));
+  ASSERT_EQ("update ks.t2 set \"V 1\" = v2 - ? where id = ?", normalized);
+  ASSERT_EQ(2, literals.size());
+  ASSERT_EQ("1", literals[0].text);
+  ASSERT_EQ(StatementLiteral::Kind::kUuid, literals[1].kind);
+
+  // Statements that are executed as is.
+  for (const auto& text : {
+      "create table t (h int primary key)",
+      "select * from t where h = ?",
+      "select * from t where h = :h",
+      "insert into t (h, s) values (1, {1, 2})",
+      "select * from t where h = 1 -- comment",
+      "select * from t where h = 1; select * from t where h = 2",
+      "select * from t where j->'a' = '1'"}) {
+    ASSERT_FALSE(NormalizeStatement(text, &normalized, &literals)) << text;
+  }
+}
+
+TEST_F(TestQLStatement, TestExecuteNormalizedStatement) {
+  // Init the simulated cluster.
+  ASSERT_NO_FATALS(CreateSimulatedCluster());
+
+  // Get a processor.
+  TestQLProcessor *processor = GetQLProcessor();
+
+  EXEC_VALID_STMT("create table t (h int primary key, v text);");
+
+  // Prepare the normalized text once and execute it with the literals of several statements.
+  string normalized;
+  std::vector<StatementLiteral> literals;
+  ASSERT_TRUE(NormalizeStatement("insert into t (h, v) values (1, 'a');", &normalized, &literals));
+  Statement stmt(processor->CurrentKeyspace(), normalized);
+  ASSERT_OK(stmt.Prepare(processor));
+
+  for (int i = 1; i <= 2; ++i) {
+    string other;
+    ASSERT_TRUE(NormalizeStatement(
+        Substitute("insert into t (h, v) values ($0, 'v$0');", i), &other, &literals));
+    ASSERT_EQ(normalized, other);
+    std::vector<QLValue> values;
+    ASSERT_OK(stmt.BindLiterals(literals, &values));
+    const NormalizedStatementParameters params(StatementParameters(), std::move(values));
+
+    Synchronizer sync;
+    ASSERT_OK(ExecuteAsync(&stmt, processor, Bind(&Synchronizer::StatusCB, Unretained(&sync)),
+                           params));
+    ASSERT_OK(sync.Wait());
+  }
+
+  EXEC_VALID_STMT("select v from t where h = 2;");
+  auto row_block = processor->row_block();
+  ASSERT_EQ(1, row_block->row_count());
+  ASSERT_EQ("v2", row_block->row(0).column(0).string_value());
+
+  // Literals that do not match the types of the bind variables are not bound.
+  ASSERT_TRUE(NormalizeStatement("insert into t (h, v) values ('x', 1);", &normalized, &literals));
+  std::vector<QLValue> values;
+  ASSERT_NOK(stmt.BindLiterals(literals, &values));
+}
+
 } // namespace ql
 } // namespace yb
@@ -0,0 +1,475 @@
+//--------------------------------------------------------------------------------------------------
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "yb/yql/cql/ql/util/statement_normalizer.h"
+
+#include <strings.h>
+
+#include "yb/common/jsonb.h"
+#include "yb/common/ql_type.h"
+
+#include "yb/gutil/strings/escaping.h"
+
+#include "yb/util/date_time.h"
+#include "yb/util/decimal.h"
+#include "yb/util/net/inetaddress.h"
+#include "yb/util/stol_utils.h"
+#include "yb/util/uuid.h"
+#include "yb/util/varint.h"
+
+namespace yb {
+namespace ql {
+
+using std::string;
+using std::vector;
+
+namespace {
+
+const char* const kNormalizedStatementTypes[] = { "select", "insert", "update", "delete" };
+
+// Characters that could continue an identifier, see ident_cont in scanner_lex.l.
+bool IsIdentChar(char c) {
+  return isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$' || (c & 0x80) != 0;
+}
+
+bool IsSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\f' || c == '\n' || c == '\r';
+}
+
+bool IsDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+bool IsHexDigit(char c) {
+  return isxdigit(static_cast<unsigned char>(c));
+}
+
+// Returns length of the uuid literal starting at pos, or 0 if there is none.
+size_t MatchUuid(const string& text, size_t pos) {
+  static constexpr size_t kGroupLengths[] = { 8, 4, 4, 4, 12 };
+  size_t end = pos;
+  for (size_t group = 0; group != arraysize(kGroupLengths); ++group) {
+    if (group != 0) {
+      if (end >= text.size() || text[end] != '-') {
+        return 0;
+      }
+      ++end;
+    }
+    for (size_t i = 0; i != kGroupLengths[group]; ++i, ++end) {
+      if (end >= text.size() || !IsHexDigit(text[end])) {
+        return 0;
+      }
+    }
+  }
+  return end < text.size() && IsIdentChar(text[end]) ? 0 : end - pos;
+}
+
+// Returns the last non-space character of the normalized text.
+char LastChar(const string& normalized) {
+  for (auto it = normalized.rbegin(); it != normalized.rend(); ++it) {
+    if (!IsSpace(*it)) {
+      return *it;
+    }
+  }
+  return 0;
+}
+
+bool IsDmlStatement(const string& text, size_t pos) {
+  for (const char* type : kNormalizedStatementTypes) {
+    const size_t len = strlen(type);
+    if (text.size() >= pos + len && strncasecmp(text.c_str() + pos, type, len) == 0 &&
+        (text.size() == pos + len || !IsIdentChar(text[pos + len]))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+bool NormalizeStatement(const string& text,
+                        string* normalized,
+                        vector<StatementLiteral>* literals) {
+  normalized->clear();
+  literals->clear();
+
+  size_t pos = 0;
+  while (pos < text.size() && IsSpace(text[pos])) {
+    ++pos;
+  }
+  if (!IsDmlStatement(text, pos)) {
+    return false;
+  }
+
+  normalized->reserve(text.size());
+  while (pos < text.size()) {
+    const char c = text[pos];
+    const char next = pos + 1 < text.size() ? text[pos + 1] : 0;
+
+    // Collapse whitespaces, so statements that differ only in formatting are normalized the same.
+    if (IsSpace(c)) {
+      while (pos < text.size() && IsSpace(text[pos])) {
+        ++pos;
+      }
+      if (pos < text.size()) {
+        normalized->push_back(' ');
+      }
+      continue;
+    }
+
+    switch (c) {
+      // Bind markers, dollar-quoted strings and parameters.
+      case '?': FALLTHROUGH_INTENDED;
+      case ':': FALLTHROUGH_INTENDED;
+      case '$': FALLTHROUGH_INTENDED;
+      // Collection literals, subscripts and json paths. Literals inside them affect the inferred
+      // types, so they are left to the regular parse.
+      case '{': FALLTHROUGH_INTENDED;
+      case '[':
+        return false;
+
+      case ';':
+        // Only a single trailing statement terminator is allowed. It is dropped.
+        for (++pos; pos < text.size(); ++pos) {
+          if (!IsSpace(text[pos])) {
+            return false;
+          }
+        }
+        while (!normalized->empty() && IsSpace(normalized->back())) {
+          normalized->pop_back();
+        }
+        continue;
+
+      case '"': {
+        // Quoted identifier, copied as is.
+        const size_t start = pos;
+        for (++pos; ; ++pos) {
+          if (pos >= text.size()) {
+            return false;
+          }
+          if (text[pos] == '"') {
+            if (pos + 1 < text.size() && text[pos + 1] == '"') {
+              ++pos;
+              continue;
+            }
+            break;
+          }
+        }
+        ++pos;
+        normalized->append(text, start, pos - start);
+        continue;
+      }
+
+      case '\'': {
+        // String literal prefixed by an identifier character, e.g. x'...', is not a plain string.
+        if (!normalized->empty() && IsIdentChar(normalized->back())) {
+          return false;
+        }
+        StatementLiteral literal{StatementLiteral::Kind::kString, string()};
+        for (++pos; ; ++pos) {
+          if (pos >= text.size()) {
+            return false;
+          }
+          if (text[pos] == '\'') {
+            if (pos + 1 < text.size() && text[pos + 1] == '\'') {
+              literal.text.push_back('\'');
+              ++pos;
+              continue;
+            }
+            break;
+          }
+          literal.text.push_back(text[pos]);
+        }
+        ++pos;
+        // Adjacent string literals are concatenated by the scanner.
+        size_t after = pos;
+        while (after < text.size() && IsSpace(text[after])) {
+          ++after;
+        }
+        if (after < text.size() && text[after] == '\'') {
+          return false;
+        }
+        literals->push_back(std::move(literal));
+        normalized->push_back('?');
+        continue;
+      }
+
+      case '-':
+        if (next == '-' || next == '>') {
+          // Comment or json operator.
+          return false;
+        }
+        break;
+
+      case '/':
+        if (next == '*' || next == '/') {
+          return false;
+        }
+        break;
+
+      case '.':
+        if (IsDigit(next)) {
+          // Number without integer part, or a digit after the dot that follows a literal.
+          return false;
+        }
+        break;
+
+      default:
+        break;
+    }
+
+    if (IsIdentChar(c) && !IsDigit(c)) {
+      const size_t uuid_length = MatchUuid(text, pos);
+      if (uuid_length != 0) {
+        literals->push_back({StatementLiteral::Kind::kUuid, text.substr(pos, uuid_length)});
+        normalized->push_back('?');
+        pos += uuid_length;
+        continue;
+      }
+      // Keyword or identifier, copied as is.
+      const size_t start = pos;
+      while (pos < text.size() && IsIdentChar(text[pos])) {
+        ++pos;
+      }
+      normalized->append(text, start, pos - start);
+      continue;
+    }
+
+    // Sign is a part of the literal only when it is the unary minus of the literal.
+    const char last = LastChar(*normalized);
+    const bool negative =
+        c == '-' && IsDigit(next) && last != 0 && strchr("=<>(,", last) != nullptr;
+    if (!IsDigit(c) && !negative) {
+      normalized->push_back(c);
+      ++pos;
+      continue;
+    }
+
+    if (!negative) {
+      const size_t uuid_length = MatchUuid(text, pos);
+      if (uuid_length != 0) {
+        literals->push_back({StatementLiteral::Kind::kUuid, text.substr(pos, uuid_length)});
+        normalized->push_back('?');
+        pos += uuid_length;
+        continue;
+      }
+      if (c == '0' && (next == 'x' || next == 'X')) {
+        const size_t start = pos + 2;
+        for (pos = start; pos < text.size() && IsHexDigit(text[pos]); ++pos) {}
+        if (pos < text.size() && IsIdentChar(text[pos])) {
+          return false;
+        }
+        literals->push_back({StatementLiteral::Kind::kBinary, text.substr(start, pos - start)});
+        normalized->push_back('?');
+        continue;
+      }
+    }
+
+    const size_t start = pos;
+    StatementLiteral::Kind kind = StatementLiteral::Kind::kInteger;
+    if (negative) {
+      ++pos;
+    }
+    while (pos < text.size() && IsDigit(text[pos])) {
+      ++pos;
+    }
+    if (pos < text.size() && text[pos] == '.') {
+      if (pos + 1 < text.size() && text[pos + 1] == '.') {
+        return false;
+      }
+      kind = StatementLiteral::Kind::kDecimal;
+      for (++pos; pos < text.size() && IsDigit(text[pos]); ++pos) {}
+    }
+    if (pos < text.size() && (text[pos] == 'e' || text[pos] == 'E')) {
+      kind = StatementLiteral::Kind::kDecimal;
+      ++pos;
+      if (pos < text.size() && (text[pos] == '+' || text[pos] == '-')) {
+        ++pos;
+      }
+      if (pos >= text.size() || !IsDigit(text[pos])) {
+        return false;
+      }
+      while (pos < text.size() && IsDigit(text[pos])) {
+        ++pos;
+      }
+    }
+    if (pos < text.size() && (IsIdentChar(text[pos]) || text[pos] == '.')) {
+      return false;
+    }
+    literals->push_back({kind, text.substr(start, pos - start)});
+    normalized->push_back('?');
+  }
+
+  return true;
+}
+
+Status ConvertStatementLiteral(const StatementLiteral& literal,
+                               const QLType& type,
+                               QLValue* value) {
+  const DataType data_type = type.main();
+  switch (literal.kind) {
+    case StatementLiteral::Kind::kInteger:
+      switch (data_type) {
+        case DataType::INT8:
+          value->set_int8_value(VERIFY_RESULT(CheckedStoInt<int8_t>(literal.text)));
+          return Status::OK();
+        case DataType::INT16:
+          value->set_int16_value(VERIFY_RESULT(CheckedStoInt<int16_t>(literal.text)));
+          return Status::OK();
+        case DataType::INT32:
+          value->set_int32_value(VERIFY_RESULT(CheckedStoi(literal.text)));
+          return Status::OK();
+        case DataType::INT64:
+          value->set_int64_value(VERIFY_RESULT(CheckedStoll(literal.text)));
+          return Status::OK();
+        case DataType::VARINT: {
+          util::VarInt varint;
+          RETURN_NOT_OK(varint.FromString(literal.text));
+          value->set_varint_value(varint);
+          return Status::OK();
+        }
+        case DataType::TIMESTAMP: {
+          const int64_t timestamp = VERIFY_RESULT(CheckedStoll(literal.text));
+          value->set_timestamp_value(DateTime::TimestampFromInt(timestamp).ToInt64());
+          return Status::OK();
+        }
+        case DataType::DATE: {
+          const int64_t date = VERIFY_RESULT(CheckedStoll(literal.text));
+          if (date < std::numeric_limits<uint32_t>::min() ||
+              date > std::numeric_limits<uint32_t>::max()) {
+            return STATUS(InvalidArgument, "Invalid date");
+          }
+          value->set_date_value(static_cast<uint32_t>(date));
+          return Status::OK();
+        }
+        case DataType::TIME: {
+          const int64_t time = VERIFY_RESULT(CheckedStoll(literal.text));
+          if (time < DateTime::kMinTime || time > DateTime::kMaxTime) {
+            return STATUS(InvalidArgument, "Invalid time");
+          }
+          value->set_time_value(time);
+          return Status::OK();
+        }
+        default:
+          break;
+      }
+      FALLTHROUGH_INTENDED;
+    case StatementLiteral::Kind::kDecimal:
+      switch (data_type) {
+        case DataType::FLOAT:
+          value->set_float_value(VERIFY_RESULT(CheckedStold(literal.text)));
+          return Status::OK();
+        case DataType::DOUBLE:
+          value->set_double_value(VERIFY_RESULT(CheckedStold(literal.text)));
+          return Status::OK();
+        case DataType::DECIMAL: {
+          util::Decimal decimal;
+          RETURN_NOT_OK(decimal.FromString(literal.text));
+          value->set_decimal_value(decimal.EncodeToComparable());
+          return Status::OK();
+        }
+        default:
+          break;
+      }
+      break;
+
+    case StatementLiteral::Kind::kString:
+      switch (data_type) {
+        case DataType::STRING:
+          value->set_string_value(literal.text);
+          return Status::OK();
+        case DataType::TIMESTAMP:
+          value->set_timestamp_value(
+              VERIFY_RESULT(DateTime::TimestampFromString(literal.text)).ToInt64());
+          return Status::OK();
+        case DataType::DATE:
+          value->set_date_value(VERIFY_RESULT(DateTime::DateFromString(literal.text)));
+          return Status::OK();
+        case DataType::TIME:
+          value->set_time_value(VERIFY_RESULT(DateTime::TimeFromString(literal.text)));
+          return Status::OK();
+        case DataType::INET: {
+          InetAddress address;
+          RETURN_NOT_OK(address.FromString(literal.text));
+          value->set_inetaddress_value(address);
+          return Status::OK();
+        }
+        case DataType::JSONB: {
+          common::Jsonb jsonb;
+          RETURN_NOT_OK(jsonb.FromString(literal.text));
+          value->set_jsonb_value(jsonb.MoveSerializedJsonb());
+          return Status::OK();
+        }
+        default:
+          break;
+      }
+      break;
+
+    case StatementLiteral::Kind::kBinary:
+      if (data_type == DataType::BINARY) {
+        if (literal.text.size() % 2 != 0) {
+          return STATUS(InvalidArgument,
+                        "Invalid binary input, expected even number of hex digits");
+        }
+        string bytes;
+        a2b_hex(literal.text.c_str(), &bytes, static_cast<int>(literal.text.size() / 2));
+        value->set_binary_value(std::move(bytes));
+        return Status::OK();
+      }
+      break;
+
+    case StatementLiteral::Kind::kUuid:
+      if (data_type == DataType::UUID || data_type == DataType::TIMEUUID) {
+        Uuid uuid;
+        RETURN_NOT_OK(uuid.FromString(literal.text));
+        if (data_type == DataType::UUID) {
+          value->set_uuid_value(uuid);
+        } else {
+          RETURN_NOT_OK(uuid.IsTimeUuid());
+          value->set_timeuuid_value(uuid);
+        }
+        return Status::OK();
+      }
+      break;
+  }
+
+  return STATUS_FORMAT(InvalidArgument, "Literal $0 cannot be bound as $1",
+                       literal.text, type.ToString());
+}
+
+NormalizedStatementParameters::NormalizedStatementParameters(const StatementParameters& other,
+                                                             vector<QLValue> values)
+    : StatementParameters(other), values_(std::move(values)) {
+  set_yb_consistency_level(other.yb_consistency_level());
+  set_request_id(other.request_id());
+}
+
+NormalizedStatementParameters::~NormalizedStatementParameters() {
+}
+
+Status NormalizedStatementParameters::GetBindVariable(const string& name,
+                                                      int64_t pos,
+                                                      const std::shared_ptr<QLType>& type,
+                                                      QLValue* value) const {
+  if (pos < 0 || pos >= values_.size()) {
+    // Return error with 1-based position.
+    return STATUS_SUBSTITUTE(RuntimeError, "Bind variable at position $0 not found", pos + 1);
+  }
+  *value = values_[pos];
+  return Status::OK();
+}
+
+} // namespace ql
+} // namespace yb
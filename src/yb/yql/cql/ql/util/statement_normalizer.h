@@ -0,0 +1,81 @@
+//--------------------------------------------------------------------------------------------------
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//
+// Normalization of unprepared DML statements. Literals in the statement text are replaced by
+// positional bind markers, so statements that differ only in their literals share the same
+// normalized text and could share the same parse tree. The stripped literals are then bound back
+// as the values of the bind variables.
+//--------------------------------------------------------------------------------------------------
+
+#ifndef YB_YQL_CQL_QL_UTIL_STATEMENT_NORMALIZER_H_
+#define YB_YQL_CQL_QL_UTIL_STATEMENT_NORMALIZER_H_
+
+#include <string>
+#include <vector>
+
+#include "yb/common/ql_value.h"
+
+#include "yb/yql/cql/ql/util/statement_params.h"
+
+namespace yb {
+namespace ql {
+
+// A literal stripped from the statement text.
+struct StatementLiteral {
+  enum class Kind {
+    kInteger,  // Integer, including its sign.
+    kDecimal,  // Number with fraction or exponent, including its sign.
+    kString,   // Single-quoted string, unescaped.
+    kBinary,   // Hex digits of 0x-prefixed blob.
+    kUuid,     // Unquoted uuid.
+  };
+
+  Kind kind;
+  std::string text;
+};
+
+// Replaces literals of a SELECT, INSERT, UPDATE or DELETE statement with "?" and returns the
+// stripped literals in the order of their bind positions. Returns false when the statement should
+// be executed as is, i.e. it is not a DML statement, already has bind markers or uses constructs
+// whose literals cannot be bound as variables (collections, json operators, comments, etc.).
+bool NormalizeStatement(const std::string& text,
+                        std::string* normalized,
+                        std::vector<StatementLiteral>* literals);
+
+// Converts the literal to a value of the given type the same way the executor converts a constant
+// of the statement text.
+CHECKED_STATUS ConvertStatementLiteral(const StatementLiteral& literal,
+                                       const QLType& type,
+                                       QLValue* value);
+
+// Parameters that bind the literals stripped from the statement text by NormalizeStatement.
+// Other parameters (paging state, page size, consistency) are copied from the original request.
+class NormalizedStatementParameters : public StatementParameters {
+ public:
+  NormalizedStatementParameters(const StatementParameters& other, std::vector<QLValue> values);
+  virtual ~NormalizedStatementParameters();
+
+  CHECKED_STATUS GetBindVariable(const std::string& name,
+                                 int64_t pos,
+                                 const std::shared_ptr<QLType>& type,
+                                 QLValue* value) const override;
+
+ private:
+  const std::vector<QLValue> values_;
+};
+
+} // namespace ql
+} // namespace yb
+
+#endif  // YB_YQL_CQL_QL_UTIL_STATEMENT_NORMALIZER_H_
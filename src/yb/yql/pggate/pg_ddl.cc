@@ -172,6 +172,14 @@ void PgCreateTable::SetColocated(bool colocated) {
   colocated_ = colocated;
 }
 
+Status PgCreateTable::SetBloomFilterRangeComponents(int32_t num_components) {
+  if (num_components < 0) {
+    return STATUS(InvalidArgument, "bloom_filter_range_components must not be negative");
+  }
+  bloom_filter_range_components_ = num_components;
+  return Status::OK();
+}
+
 Status PgCreateTable::Exec() {
   // Construct schema.
   client::YBSchema schema;
@@ -185,6 +193,20 @@ Status PgCreateTable::Exec() {
       transactional ? "transactional" : "non-transactional", table_name_.ToString());
   if (transactional) {
     table_properties.SetTransactional(true);
+  }
+  if (bloom_filter_range_components_ > 0) {
+    if (hash_schema_) {
+      return STATUS(InvalidArgument,
+                    "bloom_filter_range_components requires a table without hash key columns");
+    }
+    if (implicit_cast<size_t>(bloom_filter_range_components_) > range_columns_.size()) {
+      return STATUS_FORMAT(InvalidArgument,
+                           "bloom_filter_range_components $0 exceeds the $1 range key columns",
+                           bloom_filter_range_components_, range_columns_.size());
+    }
+    table_properties.SetBloomFilterRangeComponents(bloom_filter_range_components_);
+  }
+  if (transactional || bloom_filter_range_components_ > 0) {
     schema_builder_.SetTableProperties(table_properties);
   }
 
@@ -169,6 +169,9 @@ class PgCreateTable : public PgDdl {
 
   virtual void SetColocated(bool colocated);
 
+  // Number of leading range key columns to build the SST bloom filter on (0 keeps the default).
+  virtual CHECKED_STATUS SetBloomFilterRangeComponents(int32_t num_components);
+
   // Execute.
   virtual CHECKED_STATUS Exec();
 
@@ -189,6 +192,7 @@ class PgCreateTable : public PgDdl {
   bool is_shared_table_;
   bool if_not_exist_;
   bool colocated_ = true;
+  int32_t bloom_filter_range_components_ = 0;
   boost::optional<YBHashSchema> hash_schema_;
   std::vector<std::string> range_columns_;
   client::YBSchemaBuilder schema_builder_;
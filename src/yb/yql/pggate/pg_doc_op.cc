@@ -194,6 +194,8 @@ void PgDocReadOp::Initialize(const PgExecParameters *exec_params) {
   PgDocOp::Initialize(exec_params);
 
   can_produce_more_ops_ = true;
+  next_op_idx_ = 0;
+  read_ahead_limit_ = 0;
   template_op_->mutable_request()->set_return_paging_state(true);
   SetRequestPrefetchLimit();
   SetRowMark();
@@ -282,20 +284,22 @@ Status PgDocReadOp::SetBatchArgYbctid(const vector<Slice> *ybctids,
   return Status::OK();
 }
 
-void PgDocReadOp::SetRequestPrefetchLimit() {
+int PgDocReadOp::PredictedPrefetchLimit() const {
   // Predict the maximum prefetch-limit using the associated gflags.
-  PgsqlReadRequestPB *req = template_op_->mutable_request();
   int predicted_limit = FLAGS_ysql_prefetch_limit;
-  if (!req->is_forward_scan()) {
+  if (!template_op_->request().is_forward_scan()) {
     // Backward scan is slower than forward scan, so predicted limit is a smaller number.
     predicted_limit = predicted_limit * FLAGS_ysql_backward_prefetch_scale_factor;
   }
 
   // System setting has to be at least 1 while user setting (LIMIT clause) can be anything that
   // is allowed by SQL semantics.
-  if (predicted_limit < 1) {
-    predicted_limit = 1;
-  }
+  return std::max(predicted_limit, 1);
+}
+
+void PgDocReadOp::SetRequestPrefetchLimit() {
+  PgsqlReadRequestPB *req = template_op_->mutable_request();
+  const int predicted_limit = PredictedPrefetchLimit();
 
   // Use statement LIMIT(count + offset) if it is smaller than the predicted limit.
   int64_t limit_count = exec_params_.limit_count + exec_params_.limit_offset;
@@ -315,15 +319,42 @@ void PgDocReadOp::SetRowMark() {
   }
 }
 
+void PgDocReadOp::UpdateReadAheadLimit(int64_t received_rows, size_t received_bytes) {
+  // Do not change the limit specified by the statement, and do not grow it when the scan was
+  // ended by a condition other than the limit.
+  if (!FLAGS_ysql_enable_read_ahead || !exec_params_.limit_use_default || received_rows <= 0) {
+    return;
+  }
+
+  const int64_t current_limit = read_ahead_limit_ > 0 ? read_ahead_limit_
+                                                      : template_op_->request().limit();
+  // Pages of backward scans are scaled down by ysql_backward_prefetch_scale_factor, so is the
+  // read ahead.
+  const int64_t max_limit = std::max<int64_t>(
+      current_limit, static_cast<int64_t>(PredictedPrefetchLimit()) *
+                     std::max(FLAGS_ysql_read_ahead_max_pages, 1));
+  const size_t bytes_per_row = std::max<size_t>(received_bytes / received_rows, 1);
+  const int64_t memory_limit = std::max<int64_t>(FLAGS_ysql_read_ahead_max_bytes / bytes_per_row,
+                                                 1);
+
+  // Double the limit on each round trip, so short scans are not penalized by large requests.
+  read_ahead_limit_ = std::min({current_limit * 2, max_limit, memory_limit});
+  VLOG(3) << "Read ahead limit: " << read_ahead_limit_ << ", bytes per row: " << bytes_per_row;
+}
+
 void PgDocReadOp::InitializeNextOps(int num_ops) {
   if (num_ops <= 0) {
     return;
   }
 
   if (template_op_->request().partition_column_values_size() == 0) {
-    // TODO(dmitry): Use template_op_ directly instead of copy in case of single partition expr.
-    read_ops_.push_back(template_op_->DeepCopy());
-    can_produce_more_ops_ = false;
+    if (IsParallelScanAllowed()) {
+      InitializeParallelScanOps(num_ops);
+    } else {
+      // TODO(dmitry): Use template_op_ directly instead of copy in case of single partition expr.
+      read_ops_.push_back(template_op_->DeepCopy());
+      can_produce_more_ops_ = false;
+    }
   } else {
     if (partition_exprs_.empty()) {
       // Initialize partition_exprs_ on the first call.
@@ -374,6 +405,51 @@ void PgDocReadOp::InitializeNextOps(int num_ops) {
   DCHECK(!read_ops_.empty()) << "read_ops_ should not be empty after setting!";
 }
 
+bool PgDocReadOp::IsParallelScanAllowed() const {
+  if (FLAGS_ysql_parallel_scan_max_tablets <= 1) {
+    return false;
+  }
+
+  // Rows of a backward scan, index scan or scan with LIMIT should be returned in the order of
+  // the keys, so it is not possible to interleave results from different tablets.
+  const PgsqlReadRequestPB& req = template_op_->request();
+  if (!req.is_forward_scan() || req.has_index_request() || req.has_ybctid_column_value() ||
+      !exec_params_.limit_use_default || wait_for_batch_completion_) {
+    return false;
+  }
+
+  const auto* table = template_op_->table();
+  return table->partition_schema().IsHashPartitioning() && table->GetPartitions().size() > 1;
+}
+
+void PgDocReadOp::InitializeParallelScanOps(int num_ops) {
+  const auto& partitions = template_op_->table()->GetPartitions();
+  num_ops = std::min(
+      num_ops, FLAGS_ysql_parallel_scan_max_tablets - static_cast<int>(read_ops_.size()));
+
+  while (num_ops > 0 && next_op_idx_ < partitions.size()) {
+    // Each operation reads hash codes of one tablet: [partition start, next partition start).
+    auto read_op(template_op_->DeepCopy());
+    PgsqlReadRequestPB* req = read_op->mutable_request();
+    const auto& partition_start = partitions[next_op_idx_];
+    req->set_hash_code(
+        partition_start.empty() ? 0 : PartitionSchema::DecodeMultiColumnHashValue(partition_start));
+    if (next_op_idx_ + 1 < partitions.size()) {
+      req->set_max_hash_code(
+          PartitionSchema::DecodeMultiColumnHashValue(partitions[next_op_idx_ + 1]) - 1);
+    }
+    read_ops_.push_back(std::move(read_op));
+    --num_ops;
+    ++next_op_idx_;
+  }
+
+  VLOG(3) << "Scanning " << read_ops_.size() << " of " << partitions.size()
+          << " tablets in parallel";
+  if (next_op_idx_ == partitions.size()) {
+    can_produce_more_ops_ = false;
+  }
+}
+
 Status PgDocReadOp::SendRequestImpl(bool force_non_bufferable) {
   DCHECK(!read_ops_.empty() || can_produce_more_ops_);
   if (can_produce_more_ops_) {
@@ -393,10 +469,15 @@ Status PgDocReadOp::ProcessResponseImpl(const Status& exec_status) {
   }
 
   if (batch_row_orders_.size() == 0) {
+    int64_t received_rows = 0;
+    size_t received_bytes = 0;
     for (auto& read_op : read_ops_) {
       DCHECK(!read_op->rows_data().empty()) << "Read operation should not return empty data";
+      received_bytes += read_op->rows_data().size();
       result_cache_.push_back(make_shared<PgDocResult>(read_op->rows_data()));
+      received_rows += result_cache_.back()->row_count();
     }
+    UpdateReadAheadLimit(received_rows, received_bytes);
   } else {
     for (int partition = 0; partition < batch_ops_.size(); partition++) {
       if (batch_ops_[partition]->mutable_request()->has_ybctid_column_value()) {
@@ -409,8 +490,19 @@ Status PgDocReadOp::ProcessResponseImpl(const Status& exec_status) {
 
   // For each read_op, set up its request for the next batch of data, or remove it from the list
   // if no data is left.
-  read_ops_.erase(std::remove_if(read_ops_.begin(), read_ops_.end(), [](auto& read_op) {
+  const int64_t read_ahead_limit = read_ahead_limit_;
+  read_ops_.erase(std::remove_if(read_ops_.begin(), read_ops_.end(),
+                                 [read_ahead_limit](auto& read_op) {
     auto& res = *read_op->mutable_response();
+    // When a tablet range is scanned, the paging state could point to the next tablet, that is
+    // scanned by another operation.
+    if (res.has_paging_state() && read_op->request().has_max_hash_code() &&
+        res.paging_state().next_row_key().empty() &&
+        !res.paging_state().next_partition_key().empty() &&
+        PartitionSchema::DecodeMultiColumnHashValue(res.paging_state().next_partition_key()) >
+            read_op->request().max_hash_code()) {
+      return true;
+    }
     if (res.has_paging_state()) {
       PgsqlReadRequestPB *req = read_op->mutable_request();
       // Set up paging state for next request.
@@ -428,6 +520,9 @@ Status PgDocReadOp::ProcessResponseImpl(const Status& exec_status) {
       // This allows long-running queries to continue in the presence of other DDL statements
       // as long as they do not affect the table(s) being queried.
       req->clear_ysql_catalog_version();
+      if (read_ahead_limit > 0) {
+        req->set_limit(read_ahead_limit);
+      }
 
       // Keep this read-op and resend for the next paging state.
       return false;
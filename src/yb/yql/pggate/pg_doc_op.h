@@ -185,9 +185,17 @@ class PgDocReadOp : public PgDocOp {
   // Analyze options and pick the appropriate prefetch limit.
   void SetRequestPrefetchLimit();
 
+  // Number of rows per prefetch page, as configured by flags for the direction of this scan.
+  int PredictedPrefetchLimit() const;
+
   // Set the row_mark_type field of our read request based on our exec control parameter.
   void SetRowMark();
 
+  // When read ahead is enabled, grow the limit of the following requests of a paged scan, so
+  // several prefetch pages are fetched per round trip while staying within the memory bound.
+  // Uses size of the data received in the last response to estimate size of a row.
+  void UpdateReadAheadLimit(int64_t received_rows, size_t received_bytes);
+
   // Create batch operators, one per partition.
   CHECKED_STATUS CreateBatchOps(int partition_count);
 
@@ -204,6 +212,14 @@ class PgDocReadOp : public PgDocOp {
   // Also updates the value of can_produce_more_ops_.
   void InitializeNextOps(int num_ops);
 
+  // Whether a scan without partition column binds could read all tablets concurrently.
+  // It is so only when the order of returned rows does not matter.
+  bool IsParallelScanAllowed() const;
+
+  // Initialize up to N operations each scanning hash codes of one tablet of the table.
+  // next_op_idx_ is used as index of the next tablet to scan.
+  void InitializeParallelScanOps(int num_ops);
+
   // Used internally for InitializeNextOps to keep track of which permutation should be used
   // to construct the next read_op.
   // Is valid as long as can_produce_more_ops_ is true.
@@ -227,6 +243,7 @@ class PgDocReadOp : public PgDocOp {
   // True when either:
   // 1) Partition columns are not bound but the request hasn't been sent yet.
   // 2) Partition columns are bound and some permutations remain unprocessed.
+  // 3) Tablets are scanned in parallel and some of them are not scanned yet.
   bool can_produce_more_ops_ = true;
 
   // Operation(s).
@@ -257,6 +274,10 @@ class PgDocReadOp : public PgDocOp {
 
   // The order number of each argument when the operator sends request in batch fashion.
   int64_t batch_row_ordering_counter_ = 0;
+
+  // Limit that is used for the next requests of a paged scan when read ahead is enabled.
+  // 0 means that the limit of the template operation is used.
+  int64_t read_ahead_limit_ = 0;
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -388,6 +388,15 @@ Status PgApiImpl::CreateTableSetColocated(PgStatement *handle, bool colocated) {
   return Status::OK();
 }
 
+Status PgApiImpl::CreateTableSetBloomFilterRangeComponents(PgStatement *handle,
+                                                           int32_t num_components) {
+  if (!PgStatement::IsValidStmt(handle, StmtOp::STMT_CREATE_TABLE)) {
+    // Invalid handle.
+    return STATUS(InvalidArgument, "Invalid statement handle");
+  }
+  return down_cast<PgCreateTable*>(handle)->SetBloomFilterRangeComponents(num_components);
+}
+
 Status PgApiImpl::ExecCreateTable(PgStatement *handle) {
   if (!PgStatement::IsValidStmt(handle, StmtOp::STMT_CREATE_TABLE)) {
     // Invalid handle.
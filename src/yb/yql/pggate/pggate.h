@@ -178,6 +178,9 @@ class PgApiImpl {
 
   CHECKED_STATUS CreateTableSetColocated(PgStatement *handle, bool colocated);
 
+  CHECKED_STATUS CreateTableSetBloomFilterRangeComponents(PgStatement *handle,
+                                                          int32_t num_components);
+
   CHECKED_STATUS ExecCreateTable(PgStatement *handle);
 
   CHECKED_STATUS NewAlterTable(const PgObjectId& table_id,
@@ -19,8 +19,11 @@
 
 #include "yb/util/flags.h"
 #include "yb/util/flag_tags.h"
+#include "yb/util/size_literals.h"
 #include "yb/yql/pggate/pggate_flags.h"
 
+using namespace yb::size_literals;
+
 DEFINE_int32(pgsql_rpc_keepalive_time_ms, 0,
              "If an RPC connection from a client is idle for this amount of time, the server "
              "will disconnect the client. Setting flag to 0 disables this clean up.");
@@ -54,6 +57,22 @@ DEFINE_int32(ysql_prefetch_limit, 1024,
 DEFINE_double(ysql_backward_prefetch_scale_factor, 0.0625 /* 1/16th */,
               "Scale factor to reduce ysql_prefetch_limit for backward scan");
 
+DEFINE_bool(ysql_enable_read_ahead, false,
+            "Whether scans that continue from a paging state should fetch several prefetch pages "
+            "per request to reduce the number of round trips to DocDB");
+
+DEFINE_int32(ysql_read_ahead_max_pages, 8,
+             "Maximum number of ysql_prefetch_limit pages that could be requested at once "
+             "when read ahead is enabled");
+
+DEFINE_int32(ysql_read_ahead_max_bytes, 4_MB,
+             "Maximum size of data that could be requested at once when read ahead is enabled");
+
+DEFINE_int32(ysql_parallel_scan_max_tablets, 0,
+             "Maximum number of tablets that are scanned concurrently by a full scan of a hash "
+             "partitioned table, when the order of the result rows does not matter. "
+             "0 or 1 means that tablets are scanned one after another.");
+
 DEFINE_int32(ysql_session_max_batch_size, 512,
              "Maximum batch size for buffered writes between PostgreSQL server and YugaByte DocDB "
              "services");
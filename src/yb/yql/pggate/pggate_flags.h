@@ -26,6 +26,10 @@ DECLARE_bool(pggate_ignore_tserver_shm);
 DECLARE_int32(ysql_request_limit);
 DECLARE_int32(ysql_prefetch_limit);
 DECLARE_double(ysql_backward_prefetch_scale_factor);
+DECLARE_bool(ysql_enable_read_ahead);
+DECLARE_int32(ysql_read_ahead_max_pages);
+DECLARE_int32(ysql_read_ahead_max_bytes);
+DECLARE_int32(ysql_parallel_scan_max_tablets);
 DECLARE_int32(ysql_session_max_batch_size);
 DECLARE_bool(ysql_non_txn_copy);
 DECLARE_int32(ysql_max_read_restart_attempts);
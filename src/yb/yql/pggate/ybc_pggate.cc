@@ -266,6 +266,11 @@ YBCStatus YBCPgCreateTableSetColocated(YBCPgStatement handle, bool colocated) {
   return ToYBCStatus(pgapi->CreateTableSetColocated(handle, colocated));
 }
 
+YBCStatus YBCPgCreateTableSetBloomFilterRangeComponents(YBCPgStatement handle,
+                                                        int32_t num_components) {
+  return ToYBCStatus(pgapi->CreateTableSetBloomFilterRangeComponents(handle, num_components));
+}
+
 YBCStatus YBCPgExecCreateTable(YBCPgStatement handle) {
   return ToYBCStatus(pgapi->ExecCreateTable(handle));
 }
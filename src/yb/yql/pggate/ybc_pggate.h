@@ -146,6 +146,9 @@ YBCStatus YBCPgCreateTableSetNumTablets(YBCPgStatement handle, int32_t num_table
 
 YBCStatus YBCPgCreateTableSetColocated(YBCPgStatement handle, bool colocated);
 
+YBCStatus YBCPgCreateTableSetBloomFilterRangeComponents(YBCPgStatement handle,
+                                                        int32_t num_components);
+
 YBCStatus YBCPgExecCreateTable(YBCPgStatement handle);
 
 YBCStatus YBCPgNewAlterTable(YBCPgOid database_oid,
@@ -24,6 +24,7 @@
 #include "yb/tserver/tablet_server.h"
 
 #include "yb/util/logging.h"
+#include "yb/util/metrics.h"
 #include "yb/yql/pggate/pggate_flags.h"
 #include "yb/yql/pgwrapper/libpq_utils.h"
 #include "yb/yql/pgwrapper/pg_wrapper.h"
@@ -48,6 +49,8 @@ DECLARE_uint64(max_clock_skew_usec);
 DECLARE_int64(db_write_buffer_size);
 DECLARE_bool(ysql_enable_manual_sys_table_txn_ctl);
 
+METRIC_DECLARE_histogram(handler_latency_yb_tserver_TabletServerService_Read);
+
 namespace yb {
 namespace pgwrapper {
 
@@ -93,6 +96,7 @@ class PgMiniTest : public YBMiniClusterTestBase<MiniCluster> {
               << pg_process_conf.data_dir;
 
     BeforePgProcessStart();
+    pg_process_conf_ = pg_process_conf;
     pg_supervisor_ = std::make_unique<PgSupervisor>(pg_process_conf);
     ASSERT_OK(pg_supervisor_->Start());
 
@@ -114,6 +118,13 @@ class PgMiniTest : public YBMiniClusterTestBase<MiniCluster> {
     return PGConn::Connect(pg_host_port_, dbname);
   }
 
+  // Restarts the postgres process, so it picks up the current values of the flags.
+  CHECKED_STATUS RestartPostgres() {
+    pg_supervisor_->Stop();
+    pg_supervisor_ = std::make_unique<PgSupervisor>(pg_process_conf_);
+    return pg_supervisor_->Start();
+  }
+
   // Have several threads doing updates and several threads doing large scans in parallel.  If
   // deferrable is true, then the scans are in deferrable transactions, so no read restarts are
   // expected.  Otherwise, the scans are in transactions with snapshot isolation, so read restarts
@@ -140,6 +151,7 @@ class PgMiniTest : public YBMiniClusterTestBase<MiniCluster> {
   void TestForeignKey(IsolationLevel isolation);
 
  private:
+  PgProcessConf pg_process_conf_;
   std::unique_ptr<PgSupervisor> pg_supervisor_;
   HostPort pg_host_port_;
 };
@@ -716,6 +728,164 @@ TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(ForeignKeySnapshot)) {
   TestForeignKey(IsolationLevel::SNAPSHOT_ISOLATION);
 }
 
+class PgMiniReadAheadTest : public PgMiniTest {
+ protected:
+  static constexpr int kPrefetchLimit = 100;
+  static constexpr int kReadAheadMaxPages = 8;
+  static constexpr int kSmallValueSize = 8;
+
+  void BeforePgProcessStart() override {
+    FLAGS_ysql_prefetch_limit = kPrefetchLimit;
+    FLAGS_ysql_enable_read_ahead = true;
+    FLAGS_ysql_read_ahead_max_pages = kReadAheadMaxPages;
+    FLAGS_ysql_read_ahead_max_bytes = 64_KB;
+  }
+
+  size_t CountReadRpcs() {
+    size_t result = 0;
+    for (const auto& mini_ts : cluster_->mini_tablet_servers()) {
+      result += METRIC_handler_latency_yb_tserver_TabletServerService_Read.Instantiate(
+          mini_ts->server()->metric_entity())->TotalCount();
+    }
+    return result;
+  }
+
+  // Scans the whole table and checks that keys 1..num_small_rows + num_large_rows are returned
+  // exactly once and in order, with value sizes matching the row kind.
+  // Returns the number of read RPCs used by the scan.
+  Result<size_t> ScanAndCheck(
+      PGConn* conn, const std::string& table, int num_small_rows, int num_large_rows,
+      int large_value_size) {
+    // First scan loads the table metadata, so it is not counted.
+    RETURN_NOT_OK(conn->FetchFormat("SELECT key FROM $0 WHERE key = 1", table));
+
+    auto reads_before = CountReadRpcs();
+    auto res = VERIFY_RESULT(conn->FetchFormat("SELECT key, length(value) FROM $0", table));
+    auto reads = CountReadRpcs() - reads_before;
+
+    const int num_rows = num_small_rows + num_large_rows;
+    SCHECK_EQ(PQntuples(res.get()), num_rows, IllegalState, "Wrong number of rows");
+    for (int row = 0; row != num_rows; ++row) {
+      auto key = VERIFY_RESULT(GetInt32(res.get(), row, 0));
+      SCHECK_EQ(key, row + 1, IllegalState, "Row lost or duplicated");
+      auto length = VERIFY_RESULT(GetInt32(res.get(), row, 1));
+      SCHECK_EQ(length, key <= num_small_rows ? kSmallValueSize : large_value_size, IllegalState,
+                Format("Wrong value length for key $0", key));
+    }
+    LOG(INFO) << table << ": " << num_rows << " rows read with " << reads << " read RPCs";
+    return reads;
+  }
+};
+
+// Checks that the read ahead limit grows while rows are small and shrinks to fit the memory
+// bound when rows become large, without losing or duplicating rows between pages.
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(ReadAhead), PgMiniReadAheadTest) {
+  constexpr int kSmallRows = 4000;
+  constexpr int kLargeRows = 2000;
+  constexpr int kLargeValueSize = 1024;
+
+  auto conn = ASSERT_RESULT(Connect());
+  // Range partitioned tables have a single tablet, so rows are returned in key order.
+  for (const auto* table : {"t_small", "t_mixed"}) {
+    ASSERT_OK(conn.ExecuteFormat(
+        "CREATE TABLE $0 (key INT, value TEXT, PRIMARY KEY (key ASC))", table));
+    ASSERT_OK(conn.ExecuteFormat(
+        "INSERT INTO $0 SELECT i, repeat('s', $1) FROM generate_series(1, $2) i",
+        table, kSmallValueSize, kSmallRows));
+  }
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t_mixed SELECT i, repeat('l', $0) FROM generate_series($1, $2) i",
+      kLargeValueSize, kSmallRows + 1, kSmallRows + kLargeRows));
+
+  // Without read ahead every page would take its own round trip.
+  auto small_reads = ASSERT_RESULT(ScanAndCheck(&conn, "t_small", kSmallRows, 0, 0));
+  ASSERT_LT(small_reads, kSmallRows / kPrefetchLimit / 2);
+
+  // Had the limit stayed at kReadAheadMaxPages pages, the large rows would take only
+  // a few more round trips.
+  auto mixed_reads = ASSERT_RESULT(ScanAndCheck(
+      &conn, "t_mixed", kSmallRows, kLargeRows, kLargeValueSize));
+  ASSERT_GT(mixed_reads,
+            small_reads + kLargeRows / (kPrefetchLimit * kReadAheadMaxPages) + 10);
+}
+
+class PgMiniParallelScanTest : public PgMiniTest {
+ protected:
+  void BeforePgProcessStart() override {
+    // Use small pages, so rows of a parallel scan interleave tablets.
+    FLAGS_ysql_prefetch_limit = 100;
+  }
+
+  // Returns the values of the first column of all result rows, in the order they were returned.
+  Result<std::vector<int64_t>> FetchColumn(PGConn* conn, const std::string& query) {
+    auto res = VERIFY_RESULT(conn->Fetch(query));
+    std::vector<int64_t> result;
+    for (int row = 0; row != PQntuples(res.get()); ++row) {
+      result.push_back(VERIFY_RESULT(GetInt64(res.get(), row, 0)));
+    }
+    return result;
+  }
+
+  Result<std::vector<std::vector<int64_t>>> FetchAll(
+      PGConn* conn, const std::vector<std::string>& queries) {
+    std::vector<std::vector<int64_t>> result;
+    for (const auto& query : queries) {
+      result.push_back(VERIFY_RESULT(FetchColumn(conn, query)));
+    }
+    return result;
+  }
+};
+
+// Compares results of scans of a multi-tablet hash partitioned table with and without parallel
+// tablet scans. Scans with LIMIT should stay serial, so they return rows in the same order.
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(ParallelScan), PgMiniParallelScanTest) {
+  constexpr size_t kRows = 3000;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (key BIGINT PRIMARY KEY, value BIGINT)"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT i, i % 17 FROM generate_series(1, $0) i", kRows));
+
+  const std::vector<std::string> kUnorderedQueries = {
+    "SELECT key FROM t",
+    "SELECT key FROM t WHERE value = 5",
+  };
+  const std::vector<std::string> kOrderedQueries = {
+    "SELECT count(*) FROM t",
+    "SELECT sum(value)::BIGINT FROM t",
+    "SELECT count(*) FROM t WHERE value > 10",
+    "SELECT key FROM t ORDER BY key",
+    "SELECT key FROM t ORDER BY value, key LIMIT 100",
+    // Must stay serial, so rows are returned in the same order as by the serial scan.
+    Format("SELECT key FROM t LIMIT $0", kRows * 2),
+    "SELECT key FROM t LIMIT 150",
+  };
+
+  auto serial_unordered = ASSERT_RESULT(FetchAll(&conn, kUnorderedQueries));
+  auto serial_ordered = ASSERT_RESULT(FetchAll(&conn, kOrderedQueries));
+  ASSERT_EQ(kRows, serial_unordered[0].size());
+
+  FLAGS_ysql_parallel_scan_max_tablets = 8;
+  ASSERT_OK(RestartPostgres());
+  conn = ASSERT_RESULT(Connect());
+
+  auto parallel_unordered = ASSERT_RESULT(FetchAll(&conn, kUnorderedQueries));
+  auto parallel_ordered = ASSERT_RESULT(FetchAll(&conn, kOrderedQueries));
+
+  // Tablets were read concurrently, so pages of different tablets are interleaved.
+  ASSERT_NE(serial_unordered[0], parallel_unordered[0]);
+  for (size_t i = 0; i != kUnorderedQueries.size(); ++i) {
+    SCOPED_TRACE(kUnorderedQueries[i]);
+    std::sort(serial_unordered[i].begin(), serial_unordered[i].end());
+    std::sort(parallel_unordered[i].begin(), parallel_unordered[i].end());
+    ASSERT_EQ(serial_unordered[i], parallel_unordered[i]);
+  }
+  for (size_t i = 0; i != kOrderedQueries.size(); ++i) {
+    SCOPED_TRACE(kOrderedQueries[i]);
+    ASSERT_EQ(serial_ordered[i], parallel_ordered[i]);
+  }
+}
+
 // ------------------------------------------------------------------------------------------------
 // A test performing manual transaction control on system tables.
 // ------------------------------------------------------------------------------------------------
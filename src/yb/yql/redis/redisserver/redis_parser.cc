@@ -560,7 +560,9 @@ CHECKED_STATUS ParseTsBoundArg(const Slice& slice, RedisSubKeyBoundPB* bound_pb,
         bound_pb->mutable_subkey_bound()->set_timestamp_subkey(*ts_bound);
         break;
       }
-      case RedisCollectionGetRangeRequestPB_GetRangeRequestType_ZRANGEBYSCORE: {
+      case RedisCollectionGetRangeRequestPB_GetRangeRequestType_ZRANGEBYSCORE:
+        FALLTHROUGH_INTENDED;
+      case RedisCollectionGetRangeRequestPB_GetRangeRequestType_ZCOUNT: {
         auto double_bound = CheckedStold(slice);
         RETURN_NOT_OK(double_bound);
         bound_pb->mutable_subkey_bound()->set_double_subkey(*double_bound);
@@ -743,6 +745,24 @@ CHECKED_STATUS ParseZRangeByScore(YBRedisReadOp* op, const RedisClientCommand& a
   return ParseRangeByScoreOptions(op, args);
 }
 
+CHECKED_STATUS ParseZCount(YBRedisReadOp* op, const RedisClientCommand& args) {
+  op->mutable_request()->mutable_get_collection_range_request()->set_request_type(
+      RedisCollectionGetRangeRequestPB_GetRangeRequestType_ZCOUNT);
+
+  const auto& key = args[1];
+  RETURN_NOT_OK(ParseTsSubKeyBound(
+      args[2],
+      op->mutable_request()->mutable_subkey_range()->mutable_lower_bound(),
+      RedisCollectionGetRangeRequestPB_GetRangeRequestType_ZCOUNT));
+  RETURN_NOT_OK(ParseTsSubKeyBound(
+      args[3],
+      op->mutable_request()->mutable_subkey_range()->mutable_upper_bound(),
+      RedisCollectionGetRangeRequestPB_GetRangeRequestType_ZCOUNT));
+  op->mutable_request()->mutable_key_value()->set_key(key.ToBuffer());
+
+  return Status::OK();
+}
+
 CHECKED_STATUS ParseIndexBasedQuery(
     YBRedisReadOp* op,
     const RedisClientCommand& args,
@@ -804,6 +824,14 @@ CHECKED_STATUS ParseZScore(YBRedisReadOp* op, const RedisClientCommand& args) {
   return Status::OK();
 }
 
+CHECKED_STATUS ParseZRank(YBRedisReadOp* op, const RedisClientCommand& args) {
+  return ParseHGetLikeCommands(op, args, RedisGetRequestPB_GetRequestType_ZRANK);
+}
+
+CHECKED_STATUS ParseZRevRank(YBRedisReadOp* op, const RedisClientCommand& args) {
+  return ParseHGetLikeCommands(op, args, RedisGetRequestPB_GetRequestType_ZREVRANK);
+}
+
 CHECKED_STATUS ParseHStrLen(YBRedisReadOp* op, const RedisClientCommand& args) {
   return ParseHGetLikeCommands(op, args, RedisGetRequestPB_GetRequestType_HSTRLEN);
 }
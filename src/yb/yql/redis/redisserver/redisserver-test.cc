@@ -51,6 +51,7 @@ DECLARE_uint64(redis_max_queued_bytes);
 DECLARE_int64(redis_rpc_block_size);
 DECLARE_bool(redis_safe_batch);
 DECLARE_bool(emulate_redis_responses);
+DECLARE_bool(redis_sorted_set_rank_index);
 DECLARE_bool(test_tserver_timeout);
 DECLARE_bool(enable_backpressure_mode_for_testing);
 DECLARE_bool(yedis_enable_flush);
@@ -3686,6 +3687,63 @@ TEST_F(TestRedisService, TestZScore) {
   VerifyCallbacks();
 }
 
+TEST_F(TestRedisService, TestZRankAndZCount) {
+  // z_legacy is created without the rank index, so the same queries are served by iterating over
+  // the members.
+  for (const auto& key : {"z_indexed", "z_legacy"}) {
+    FLAGS_redis_sorted_set_rank_index = key == std::string("z_indexed");
+    DoRedisTestInt(__LINE__, {"ZADD", key, "-1.5", "v_neg", "0", "v0", "0", "v0_copy", "1", "v1",
+        "2", "v2", "2", "v2_copy", "3", "v3"}, 7);
+    SyncClient();
+    FLAGS_redis_sorted_set_rank_index = true;
+
+    DoRedisTestInt(__LINE__, {"ZRANK", key, "v_neg"}, 0);
+    DoRedisTestInt(__LINE__, {"ZRANK", key, "v0"}, 1);
+    DoRedisTestInt(__LINE__, {"ZRANK", key, "v0_copy"}, 2);
+    DoRedisTestInt(__LINE__, {"ZRANK", key, "v2_copy"}, 5);
+    DoRedisTestInt(__LINE__, {"ZRANK", key, "v3"}, 6);
+    DoRedisTestInt(__LINE__, {"ZREVRANK", key, "v3"}, 0);
+    DoRedisTestInt(__LINE__, {"ZREVRANK", key, "v0"}, 5);
+    DoRedisTestNull(__LINE__, {"ZRANK", key, "v_no_exist"});
+
+    DoRedisTestInt(__LINE__, {"ZCOUNT", key, "-inf", "+inf"}, 7);
+    DoRedisTestInt(__LINE__, {"ZCOUNT", key, "0", "2"}, 5);
+    DoRedisTestInt(__LINE__, {"ZCOUNT", key, "(0", "(2"}, 1);
+    DoRedisTestInt(__LINE__, {"ZCOUNT", key, "-1", "+inf"}, 6);
+    DoRedisTestInt(__LINE__, {"ZCOUNT", key, "2.5", "1"}, 0);
+
+    DoRedisTestArray(__LINE__, {"ZRANGE", key, "1", "2"}, {"v0", "v0_copy"});
+    DoRedisTestArray(__LINE__, {"ZRANGE", key, "2", "5"}, {"v0_copy", "v1", "v2", "v2_copy"});
+    DoRedisTestArray(__LINE__, {"ZRANGE", key, "4", "4"}, {"v2"});
+    DoRedisTestArray(__LINE__, {"ZREVRANGE", key, "1", "2"}, {"v2_copy", "v2"});
+    DoRedisTestArray(__LINE__, {"ZREVRANGE", key, "-2", "-1"}, {"v0", "v_neg"});
+    SyncClient();
+
+    // Move members between scores and remove some of them.
+    DoRedisTestInt(__LINE__, {"ZADD", key, "CH", "5", "v0", "-2", "v3"}, 2);
+    DoRedisTestInt(__LINE__, {"ZREM", key, "v1", "v2", "v2"}, 2);
+    SyncClient();
+
+    DoRedisTestInt(__LINE__, {"ZRANK", key, "v3"}, 0);
+    DoRedisTestInt(__LINE__, {"ZRANK", key, "v0"}, 4);
+    DoRedisTestNull(__LINE__, {"ZRANK", key, "v1"});
+    DoRedisTestInt(__LINE__, {"ZCOUNT", key, "-inf", "+inf"}, 5);
+    DoRedisTestInt(__LINE__, {"ZCOUNT", key, "-2", "(0"}, 2);
+    DoRedisTestArray(__LINE__, {"ZRANGE", key, "0", "-1"},
+        {"v3", "v_neg", "v0_copy", "v2_copy", "v0"});
+    DoRedisTestArray(__LINE__, {"ZREVRANGE", key, "1", "3"}, {"v2_copy", "v0_copy", "v_neg"});
+    SyncClient();
+  }
+
+  DoRedisTestNull(__LINE__, {"ZRANK", "z_no_exist", "v0"});
+  DoRedisTestInt(__LINE__, {"ZCOUNT", "z_no_exist", "-inf", "+inf"}, 0);
+  DoRedisTestExpectError(__LINE__, {"ZCOUNT", "z_indexed", "abc", "1"});
+  DoRedisTestExpectError(__LINE__, {"ZRANK", "z_indexed"});
+
+  SyncClient();
+  VerifyCallbacks();
+}
+
 TEST_F(TestRedisService, TestTimeSeriesTTL) {
   int64_t ttl_sec = 10;
   TestTSTtl("EXPIRE_IN", ttl_sec, ttl_sec, "test_expire_in");